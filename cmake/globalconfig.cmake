@@ -170,6 +170,9 @@ include(${CMAKE_CURRENT_LIST_DIR}/compileresources.cmake)
 # Calculate and display profiling information
 option(IVW_CFG_PROFILING "Enable profiling" OFF)
 
+# Count heap allocations by replacing the global operator new, see util::AllocationCounter
+option(IVW_CFG_ALLOCATION_COUNTING "Count heap allocations (util::AllocationCounter)" OFF)
+
 # Build unittest for all modules
 include(${CMAKE_CURRENT_LIST_DIR}/unittests.cmake)
 
@@ -60,6 +60,7 @@ namespace inviwo {
 
 class ProcessorNetwork;
 class ProcessorNetworkEvaluator;
+class EvaluationScheduler;
 class CommandLineParser;
 struct AppResourceManagerObserver;
 
@@ -164,6 +165,12 @@ public:
 
     ProcessorNetwork* getProcessorNetwork();
     ProcessorNetworkEvaluator* getProcessorNetworkEvaluator();
+    /**
+     * The scheduler that switches processors to preview mode while the user is interacting.
+     * Configured by the system settings.
+     * @see EvaluationScheduler
+     */
+    EvaluationScheduler* getEvaluationScheduler();
     WorkspaceManager* getWorkspaceManager();
     PropertyPresetManager* getPropertyPresetManager();
     PortInspectorManager* getPortInspectorManager();
@@ -490,6 +497,8 @@ protected:
     WorkspaceManager::SerializationHandle presetsSerializationHandle_;
     WorkspaceManager::DeserializationHandle presetsDeserializationHandle_;
     std::unique_ptr<TimerThread> timerThread_;
+    // uses the timer thread, has to be destroyed before it
+    std::unique_ptr<EvaluationScheduler> evaluationScheduler_;
 
 private:
     friend Singleton<InviwoApplication>;
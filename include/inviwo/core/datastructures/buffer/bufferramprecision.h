@@ -34,11 +34,16 @@
 #include <inviwo/core/util/glm.h>
 
 #include <initializer_list>
+#include <memory>
 
 namespace inviwo {
 
 /**
  * \ingroup datastructures
+ * Copies of a BufferRAMPrecision share the data until one of them is modified, the data is
+ * copied on the first call to a non-const accessor like getDataContainer(), getData(), add() or
+ * operator[]. References and pointers returned by non-const accessors should not be kept while
+ * making new copies, since writes through them will then be visible in the copies as well.
  */
 template <typename T, BufferTarget Target = BufferTarget::Data>
 class BufferRAMPrecision : public BufferRAM {
@@ -99,7 +104,13 @@ public:
     virtual void clear() override;
 
 private:
-    std::vector<T> data_;
+    /**
+     * Make sure the data is not shared with any copy, needs to be called before the data is
+     * handed out for modifications.
+     */
+    void detach();
+
+    std::shared_ptr<std::vector<T>> data_;
 };
 
 using FloatBufferRAM = BufferRAMPrecision<float>;
@@ -111,12 +122,13 @@ using IndexBufferRAM = BufferRAMPrecision<std::uint32_t, BufferTarget::Index>;
 
 template <typename T, BufferTarget Target>
 const T& inviwo::BufferRAMPrecision<T, Target>::operator[](size_t i) const {
-    return data_[i];
+    return (*data_)[i];
 }
 
 template <typename T, BufferTarget Target>
 T& inviwo::BufferRAMPrecision<T, Target>::operator[](size_t i) {
-    return data_[i];
+    detach();
+    return (*data_)[i];
 }
 
 template <typename T, BufferTarget Target>
@@ -125,11 +137,13 @@ BufferRAMPrecision<T, Target>::BufferRAMPrecision(BufferUsage usage)
 
 template <typename T, BufferTarget Target>
 BufferRAMPrecision<T, Target>::BufferRAMPrecision(size_t size, BufferUsage usage)
-    : BufferRAM(DataFormat<T>::get(), usage, Target), data_(size) {}
+    : BufferRAM(DataFormat<T>::get(), usage, Target)
+    , data_(std::make_shared<std::vector<T>>(size)) {}
 
 template <typename T, BufferTarget Target>
 inviwo::BufferRAMPrecision<T, Target>::BufferRAMPrecision(std::vector<T> data, BufferUsage usage)
-    : BufferRAM(DataFormat<T>::get(), usage, Target), data_(std::move(data)) {}
+    : BufferRAM(DataFormat<T>::get(), usage, Target)
+    , data_(std::make_shared<std::vector<T>>(std::move(data))) {}
 
 template <typename T, BufferTarget Target>
 BufferRAMPrecision<T, Target>* BufferRAMPrecision<T, Target>::clone() const {
@@ -138,159 +152,188 @@ BufferRAMPrecision<T, Target>* BufferRAMPrecision<T, Target>::clone() const {
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setSize(size_t size) {
-    return data_.resize(size);
+    detach();
+    return data_->resize(size);
 }
 
 template <typename T, BufferTarget Target>
 size_t BufferRAMPrecision<T, Target>::getSize() const {
-    return data_.size();
+    return data_->size();
 }
 
 template <typename T, BufferTarget Target>
 void* BufferRAMPrecision<T, Target>::getData() {
-    return (data_.empty() ? nullptr : data_.data());
+    detach();
+    return (data_->empty() ? nullptr : data_->data());
 }
 
 template <typename T, BufferTarget Target>
 const void* BufferRAMPrecision<T, Target>::getData() const {
-    return (data_.empty() ? nullptr : data_.data());
+    return (data_->empty() ? nullptr : data_->data());
 }
 
 template <typename T, BufferTarget Target>
 std::vector<T>& inviwo::BufferRAMPrecision<T, Target>::getDataContainer() {
-    return data_;
+    detach();
+    return *data_;
 }
 
 template <typename T, BufferTarget Target>
 const std::vector<T>& BufferRAMPrecision<T, Target>::getDataContainer() const {
-    return data_;
+    return *data_;
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::reserve(size_t size) {
-    data_.reserve(size);
+    detach();
+    data_->reserve(size);
 }
 
 template <typename T, BufferTarget Target>
 double BufferRAMPrecision<T, Target>::getAsDouble(const size_t& pos) const {
-    return util::glm_convert<double>(data_[pos]);
+    return util::glm_convert<double>((*data_)[pos]);
 }
 
 template <typename T, BufferTarget Target>
 dvec2 BufferRAMPrecision<T, Target>::getAsDVec2(const size_t& pos) const {
-    return util::glm_convert<dvec2>(data_[pos]);
+    return util::glm_convert<dvec2>((*data_)[pos]);
 }
 
 template <typename T, BufferTarget Target>
 dvec3 BufferRAMPrecision<T, Target>::getAsDVec3(const size_t& pos) const {
-    return util::glm_convert<dvec3>(data_[pos]);
+    return util::glm_convert<dvec3>((*data_)[pos]);
 }
 
 template <typename T, BufferTarget Target>
 dvec4 BufferRAMPrecision<T, Target>::getAsDVec4(const size_t& pos) const {
-    return util::glm_convert<dvec4>(data_[pos]);
+    return util::glm_convert<dvec4>((*data_)[pos]);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setFromDouble(const size_t& pos, double val) {
-    data_[pos] = util::glm_convert<T>(val);
+    detach();
+    (*data_)[pos] = util::glm_convert<T>(val);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setFromDVec2(const size_t& pos, dvec2 val) {
-    data_[pos] = util::glm_convert<T>(val);
+    detach();
+    (*data_)[pos] = util::glm_convert<T>(val);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setFromDVec3(const size_t& pos, dvec3 val) {
-    data_[pos] = util::glm_convert<T>(val);
+    detach();
+    (*data_)[pos] = util::glm_convert<T>(val);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setFromDVec4(const size_t& pos, dvec4 val) {
-    data_[pos] = util::glm_convert<T>(val);
+    detach();
+    (*data_)[pos] = util::glm_convert<T>(val);
 }
 
 template <typename T, BufferTarget Target>
 double BufferRAMPrecision<T, Target>::getAsNormalizedDouble(const size_t& pos) const {
-    return util::glm_convert_normalized<double>(data_[pos]);
+    return util::glm_convert_normalized<double>((*data_)[pos]);
 }
 
 template <typename T, BufferTarget Target>
 dvec2 BufferRAMPrecision<T, Target>::getAsNormalizedDVec2(const size_t& pos) const {
-    return util::glm_convert_normalized<dvec2>(data_[pos]);
+    return util::glm_convert_normalized<dvec2>((*data_)[pos]);
 }
 
 template <typename T, BufferTarget Target>
 dvec3 BufferRAMPrecision<T, Target>::getAsNormalizedDVec3(const size_t& pos) const {
-    return util::glm_convert_normalized<dvec3>(data_[pos]);
+    return util::glm_convert_normalized<dvec3>((*data_)[pos]);
 }
 
 template <typename T, BufferTarget Target>
 dvec4 BufferRAMPrecision<T, Target>::getAsNormalizedDVec4(const size_t& pos) const {
-    return util::glm_convert_normalized<dvec4>(data_[pos]);
+    return util::glm_convert_normalized<dvec4>((*data_)[pos]);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setFromNormalizedDouble(const size_t& pos, double val) {
-    data_[pos] = util::glm_convert_normalized<T>(val);
+    detach();
+    (*data_)[pos] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setFromNormalizedDVec2(const size_t& pos, dvec2 val) {
-    data_[pos] = util::glm_convert_normalized<T>(val);
+    detach();
+    (*data_)[pos] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setFromNormalizedDVec3(const size_t& pos, dvec3 val) {
-    data_[pos] = util::glm_convert_normalized<T>(val);
+    detach();
+    (*data_)[pos] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setFromNormalizedDVec4(const size_t& pos, dvec4 val) {
-    data_[pos] = util::glm_convert_normalized<T>(val);
+    detach();
+    (*data_)[pos] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::add(const T& item) {
-    data_.push_back(item);
+    detach();
+    data_->push_back(item);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::add(std::initializer_list<T> data) {
+    detach();
     for (auto& elem : data) {
-        data_.push_back(elem);
+        data_->push_back(elem);
     }
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::append(const std::vector<T>* data) {
-    data_.insert(data_.end(), data->begin(), data->end());
+    detach();
+    data_->insert(data_->end(), data->begin(), data->end());
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::append(const std::vector<T>& data) {
-    data_.insert(data_.end(), data.begin(), data.end());
+    detach();
+    data_->insert(data_->end(), data.begin(), data.end());
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::set(size_t index, const T& item) {
-    data_[index] = item;
+    detach();
+    (*data_)[index] = item;
 }
 
 template <typename T, BufferTarget Target>
 T BufferRAMPrecision<T, Target>::get(size_t index) const {
-    return data_[index];
+    return (*data_)[index];
 }
 
 template <typename T, BufferTarget Target>
 T& BufferRAMPrecision<T, Target>::get(size_t index) {
-    return data_[index];
+    detach();
+    return (*data_)[index];
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::clear() {
-    data_.clear();
+    if (data_.use_count() > 1) {
+        data_ = std::make_shared<std::vector<T>>();
+    } else {
+        data_->clear();
+    }
+}
+
+template <typename T, BufferTarget Target>
+void BufferRAMPrecision<T, Target>::detach() {
+    if (data_.use_count() > 1) {
+        data_ = std::make_shared<std::vector<T>>(*data_);
+    }
 }
 
 }  // namespace inviwo
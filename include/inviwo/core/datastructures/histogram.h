@@ -32,7 +32,9 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/util/glm.h>
 
+#include <array>
 #include <iterator>
+#include <limits>
 #include <vector>
 
 namespace inviwo {
@@ -73,11 +75,53 @@ protected:
     double maximumBinCount_;
 };
 
+namespace detail {
+
+/**
+ * Accumulates the bin counts and statistics of the values added to it, one histogram per
+ * component of T. Used to build a HistogramContainer from values that are not available as a
+ * single range, for example with a count for repeated values.
+ */
+template <typename T>
+class HistogramAccumulator {
+public:
+    // a double type with the same extent as T
+    using D = typename util::same_extent<T, double>::type;
+    // a size_t type with same extent as T
+    using I = typename util::same_extent<T, size_t>::type;
+    static constexpr size_t extent = util::rank<T>::value > 0 ? util::extent<T>::value : 1;
+
+    HistogramAccumulator(dvec2 dataRange, size_t bins);
+
+    /**
+     * Add \p count occurrences of \p value.
+     */
+    void add(const T& value, size_t count = 1);
+
+    std::vector<NormalizedHistogram> finish();
+
+private:
+    dvec2 dataRange_;
+    size_t bins_;
+    std::array<std::vector<double>, extent> histData_;
+    D min_;
+    D max_;
+    D sum_;
+    D sum2_;
+    size_t count_;
+    D rangeMin_;
+    D rangeScaleFactor_;
+};
+
+}  // namespace detail
+
 class IVW_CORE_API HistogramContainer {
 public:
     HistogramContainer() = default;
     template <typename FirstIter, typename LastIter>
     HistogramContainer(dvec2 range, size_t bins, FirstIter begin, LastIter end);
+    template <typename T>
+    explicit HistogramContainer(detail::HistogramAccumulator<T>&& accumulator);
 
     const NormalizedHistogram& operator[](size_t i) const;
     const NormalizedHistogram& get(size_t i) const;
@@ -94,66 +138,78 @@ private:
     std::vector<NormalizedHistogram> histograms_;
 };
 
-template <typename FirstIter, typename LastIter>
-HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter begin,
-                                       LastIter end) {
-    using T = typename std::iterator_traits<FirstIter>::value_type;
-
-    // a double type with the same extent as T
-    using D = typename util::same_extent<T, double>::type;
-    // a size_t type with same extent as T
-    using I = typename util::same_extent<T, size_t>::type;
-
-    constexpr size_t extent = util::rank<T>::value > 0 ? util::extent<T>::value : 1;
+template <typename T>
+detail::HistogramAccumulator<T>::HistogramAccumulator(dvec2 dataRange, size_t bins)
+    : dataRange_{dataRange}
+    , bins_{bins}
+    , min_(std::numeric_limits<double>::max())
+    , max_(std::numeric_limits<double>::lowest())
+    , sum_(0)
+    , sum2_(0)
+    , count_(0)
+    , rangeMin_(dataRange.x) {
 
     // check whether number of bins exceeds the data range only if it is an integral type
     if constexpr (!util::is_floating_point<typename util::value_type<T>::type>::value) {
-        bins = std::min(bins, static_cast<std::size_t>(dataRange.y - dataRange.x + 1));
+        bins_ = std::min(bins_, static_cast<std::size_t>(dataRange.y - dataRange.x + 1));
     }
+    rangeScaleFactor_ = D(static_cast<double>(bins_ - 1) / (dataRange.y - dataRange.x));
 
-    std::array<std::vector<double>, extent> histData;
     for (size_t i = 0; i < extent; ++i) {
-        histData[i].resize(bins, 0.0);
+        histData_[i].resize(bins_, 0.0);
     }
+}
 
-    D min(std::numeric_limits<double>::max());
-    D max(std::numeric_limits<double>::lowest());
-    D sum(0);
-    D sum2(0);
-    size_t count(0);
-
-    const D rangeMin(dataRange.x);
-    const D rangeScaleFactor(static_cast<double>(bins - 1) / (dataRange.y - dataRange.x));
-
-    for (; begin != end; ++begin) {
-
-        const auto val = static_cast<D>(*begin);
+template <typename T>
+void detail::HistogramAccumulator<T>::add(const T& value, size_t count) {
+    const auto val = static_cast<D>(value);
+    const auto n = static_cast<double>(count);
 
-        min = glm::min(min, val);
-        max = glm::max(max, val);
-        sum += val;
-        sum2 += val * val;
-        count++;
+    min_ = glm::min(min_, val);
+    max_ = glm::max(max_, val);
+    sum_ += val * n;
+    sum2_ += val * val * n;
+    count_ += count;
 
-        const auto ind = static_cast<I>((val - rangeMin) * rangeScaleFactor);
+    const auto ind = static_cast<I>((val - rangeMin_) * rangeScaleFactor_);
 
-        for (size_t i = 0; i < extent; ++i) {
-            const auto v = util::glmcomp(ind, i);
-            if (v < bins) {
-                histData[i][v]++;
-            }
+    for (size_t i = 0; i < extent; ++i) {
+        const auto v = util::glmcomp(ind, i);
+        if (v < bins_) {
+            histData_[i][v] += n;
         }
     }
+}
 
-    const auto dcount = static_cast<double>(count);
-    const auto mean = sum / dcount;
-    const auto stddev = glm::sqrt((dcount * sum2 - sum * sum) / (dcount * (dcount - D{1})));
+template <typename T>
+std::vector<NormalizedHistogram> detail::HistogramAccumulator<T>::finish() {
+    const auto dcount = static_cast<double>(count_);
+    const auto mean = sum_ / dcount;
+    const auto stddev = glm::sqrt((dcount * sum2_ - sum_ * sum_) / (dcount * (dcount - D{1})));
 
+    std::vector<NormalizedHistogram> histograms;
     for (size_t i = 0; i < extent; ++i) {
-        histograms_.emplace_back(dataRange, std::move(histData[i]), util::glmcomp(min, i),
-                                 util::glmcomp(max, i), util::glmcomp(mean, i),
-                                 util::glmcomp(stddev, i));
+        histograms.emplace_back(dataRange_, std::move(histData_[i]), util::glmcomp(min_, i),
+                                util::glmcomp(max_, i), util::glmcomp(mean, i),
+                                util::glmcomp(stddev, i));
     }
+    return histograms;
 }
 
+template <typename FirstIter, typename LastIter>
+HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter begin,
+                                       LastIter end) {
+    using T = typename std::iterator_traits<FirstIter>::value_type;
+
+    detail::HistogramAccumulator<T> accumulator(dataRange, bins);
+    for (; begin != end; ++begin) {
+        accumulator.add(*begin);
+    }
+    histograms_ = accumulator.finish();
+}
+
+template <typename T>
+HistogramContainer::HistogramContainer(detail::HistogramAccumulator<T>&& accumulator)
+    : histograms_{accumulator.finish()} {}
+
 }  // namespace inviwo
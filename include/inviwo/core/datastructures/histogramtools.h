@@ -35,12 +35,14 @@
 #include <inviwo/core/datastructures/volume/volumeram.h>
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <vector>
 
 namespace inviwo {
 
 class HistogramSupplier;
+class VolumeSparse;
 
 class IVW_CORE_API HistogramCalculationState {
 public:
@@ -92,8 +94,16 @@ public:
 protected:
     std::shared_ptr<HistogramCalculationState> startCalculation(
         std::shared_ptr<const VolumeRAM> volumeRam, dvec2 dataRange, size_t bins) const;
+    /**
+     * Calculate the histograms from the active voxels of \p volumeSparse, the background voxels
+     * are added as a single count.
+     */
+    std::shared_ptr<HistogramCalculationState> startCalculation(
+        std::shared_ptr<const VolumeSparse> volumeSparse, dvec2 dataRange, size_t bins) const;
 
 private:
+    std::shared_ptr<HistogramCalculationState> startCalculation(
+        dvec2 dataRange, size_t bins, std::function<HistogramContainer()> calculate) const;
     static void done(std::shared_ptr<HistogramCalculationState> state,
                      HistogramContainer histograms);
 
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/util/ramallocator.h>
 
 #include <algorithm>
 
@@ -37,6 +38,9 @@ namespace inviwo {
 
 /**
  * \ingroup datastructures
+ * Copies of a LayerRAMPrecision share the pixel data until one of them is modified, the data is
+ * copied on the first call to a non-const accessor like getDataTyped(), getData() or
+ * setFromDouble(). See VolumeRAMPrecision for details.
  */
 template <typename T>
 class LayerRAMPrecision : public LayerRAM {
@@ -48,6 +52,18 @@ public:
                                const SwizzleMask& swizzleMask = swizzlemasks::rgba,
                                InterpolationType interpolation = InterpolationType::Linear,
                                const Wrapping2D& wrap = wrapping2d::clampAll);
+    /**
+     * Create a layer whose data is allocated using \p init. Use util::RAMInit::Uninitialized
+     * to avoid clearing the data when all pixels will be overwritten anyway.
+     */
+    LayerRAMPrecision(size2_t dimensions, util::RAMInit init, LayerType type = LayerType::Color,
+                      const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                      InterpolationType interpolation = InterpolationType::Linear,
+                      const Wrapping2D& wrap = wrapping2d::clampAll);
+    /**
+     * Create a layer taking ownership of \p data, which has to be allocated with new[]. If
+     * \p data is nullptr the data is allocated and cleared.
+     */
     LayerRAMPrecision(T* data, size2_t dimensions, LayerType type = LayerType::Color,
                       const SwizzleMask& swizzleMask = swizzlemasks::rgba,
                       InterpolationType interpolation = InterpolationType::Linear,
@@ -101,8 +117,14 @@ public:
     virtual void setFromNormalizedDVec4(const size2_t& pos, dvec4 val) override;
 
 private:
+    /**
+     * Make sure the data is not shared with any copy, needs to be called before the data is
+     * handed out for modifications.
+     */
+    void detach();
+
     size2_t dimensions_;
-    std::unique_ptr<T[]> data_;
+    util::SharedRAMPtr<T> data_;
     SwizzleMask swizzleMask_;
     InterpolationType interpolation_;
     Wrapping2D wrapping_;
@@ -132,7 +154,7 @@ LayerRAMPrecision<T>::LayerRAMPrecision(size2_t dimensions, LayerType type,
                                         InterpolationType interpolation, const Wrapping2D& wrapping)
     : LayerRAM(type, DataFormat<T>::get())
     , dimensions_(dimensions)
-    , data_(new T[dimensions_.x * dimensions_.y]())
+    , data_(util::allocateRAMData<T>(glm::compMul(dimensions_), util::RAMInit::Uninitialized))
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
     , wrapping_{wrapping} {
@@ -140,13 +162,26 @@ LayerRAMPrecision<T>::LayerRAMPrecision(size2_t dimensions, LayerType type,
               (type == LayerType::Depth) ? T{1} : T{0});
 }
 
+template <typename T>
+LayerRAMPrecision<T>::LayerRAMPrecision(size2_t dimensions, util::RAMInit init, LayerType type,
+                                        const SwizzleMask& swizzleMask,
+                                        InterpolationType interpolation, const Wrapping2D& wrapping)
+    : LayerRAM(type, DataFormat<T>::get())
+    , dimensions_(dimensions)
+    , data_(util::allocateRAMData<T>(glm::compMul(dimensions_), init))
+    , swizzleMask_(swizzleMask)
+    , interpolation_{interpolation}
+    , wrapping_{wrapping} {}
+
 template <typename T>
 LayerRAMPrecision<T>::LayerRAMPrecision(T* data, size2_t dimensions, LayerType type,
                                         const SwizzleMask& swizzleMask,
                                         InterpolationType interpolation, const Wrapping2D& wrapping)
     : LayerRAM(type, DataFormat<T>::get())
     , dimensions_(dimensions)
-    , data_(data ? data : new T[dimensions_.x * dimensions_.y]())
+    , data_(data ? util::RAMPtr<T>(data)
+                 : util::allocateRAMData<T>(glm::compMul(dimensions_),
+                                            util::RAMInit::Uninitialized))
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
     , wrapping_{wrapping} {
@@ -160,23 +195,16 @@ template <typename T>
 LayerRAMPrecision<T>::LayerRAMPrecision(const LayerRAMPrecision<T>& rhs)
     : LayerRAM(rhs)
     , dimensions_(rhs.dimensions_)
-    , data_(new T[dimensions_.x * dimensions_.y])
+    , data_(rhs.data_)
     , swizzleMask_(rhs.swizzleMask_)
     , interpolation_{rhs.interpolation_}
-    , wrapping_{rhs.wrapping_} {
-    std::memcpy(data_.get(), rhs.data_.get(), dimensions_.x * dimensions_.y * sizeof(T));
-}
+    , wrapping_{rhs.wrapping_} {}
 
 template <typename T>
 LayerRAMPrecision<T>& LayerRAMPrecision<T>::operator=(const LayerRAMPrecision<T>& that) {
     if (this != &that) {
         LayerRAM::operator=(that);
-
-        const auto dim = that.dimensions_;
-        auto data = std::make_unique<T[]>(dim.x * dim.y);
-        std::memcpy(data.get(), that.data_.get(), dim.x * dim.y * sizeof(T));
-        data_.swap(data);
-
+        data_ = that.data_;
         dimensions_ = that.dimensions_;
         swizzleMask_ = that.swizzleMask_;
         interpolation_ = that.interpolation_;
@@ -192,6 +220,7 @@ LayerRAMPrecision<T>* LayerRAMPrecision<T>::clone() const {
 
 template <typename T>
 T* inviwo::LayerRAMPrecision<T>::getDataTyped() {
+    detach();
     return data_.get();
 }
 
@@ -202,6 +231,7 @@ const T* inviwo::LayerRAMPrecision<T>::getDataTyped() const {
 
 template <typename T>
 void* LayerRAMPrecision<T>::getData() {
+    detach();
     return data_.get();
 }
 template <typename T>
@@ -211,20 +241,23 @@ const void* LayerRAMPrecision<T>::getData() const {
 
 template <typename T>
 void inviwo::LayerRAMPrecision<T>::setData(void* d, size2_t dimensions) {
-    std::unique_ptr<T[]> data(static_cast<T*>(d));
-    data_.swap(data);
-    std::swap(dimensions_, dimensions);
+    data_ = util::RAMPtr<T>(static_cast<T*>(d));
+    dimensions_ = dimensions;
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setDimensions(size2_t dimensions) {
     if (dimensions != dimensions_) {
-        auto data = std::make_unique<T[]>(dimensions.x * dimensions.y);
-        data_.swap(data);
-        std::swap(dimensions, dimensions_);
+        data_ = util::allocateRAMData<T>(glm::compMul(dimensions));
+        dimensions_ = dimensions;
     }
 }
 
+template <typename T>
+void LayerRAMPrecision<T>::detach() {
+    util::detachRAMData(data_, glm::compMul(dimensions_));
+}
+
 template <typename T>
 const size2_t& LayerRAMPrecision<T>::getDimensions() const {
     return dimensions_;
@@ -282,21 +315,25 @@ dvec4 LayerRAMPrecision<T>::getAsDVec4(const size2_t& pos) const {
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDouble(const size2_t& pos, double val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDVec2(const size2_t& pos, dvec2 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDVec3(const size2_t& pos, dvec3 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDVec4(const size2_t& pos, dvec4 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
@@ -322,21 +359,25 @@ dvec4 LayerRAMPrecision<T>::getAsNormalizedDVec4(const size2_t& pos) const {
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDouble(const size2_t& pos, double val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDVec2(const size2_t& pos, dvec2 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDVec3(const size2_t& pos, dvec3 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDVec4(const size2_t& pos, dvec4 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
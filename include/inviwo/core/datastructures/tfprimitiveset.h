@@ -260,6 +260,19 @@ public:
      */
     void interpolateAndStoreColors(vec4* dataArray, const size_t size) const;
 
+    /**
+     * Same as interpolateAndStoreColors(vec4*, size_t) but only the entries within the index
+     * range [first, last) of dataArray are written. The result is identical to the corresponding
+     * range of a full update, which makes it possible to update a lookup table incrementally.
+     *
+     * @param dataArray   write location for interpolated colors
+     * @param size   size of dataArray
+     * @param first   index of the first entry to update
+     * @param last    index one past the last entry to update, clamped to size
+     */
+    void interpolateAndStoreColors(vec4* dataArray, const size_t size, size_t first,
+                                   size_t last) const;
+
 protected:
     void add(std::unique_ptr<TFPrimitive> primitive);
     bool remove(std::vector<std::unique_ptr<TFPrimitive>>::iterator it);
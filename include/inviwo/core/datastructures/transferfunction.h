@@ -35,6 +35,10 @@
 #include <inviwo/core/datastructures/tfprimitiveset.h>
 #include <inviwo/core/util/fileextension.h>
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
 namespace inviwo {
 
 class Layer;
@@ -93,6 +97,24 @@ public:
      */
     vec4 sample(float v) const;
 
+    /**
+     * Map all \p size values of \p src through the transfer function and write the resulting
+     * colors to \p dst. Each value v is first normalized using \p range, i.e.
+     * (v - range.x) / (range.y - range.x), and then looked up in the cached transfer function
+     * table (see getData()) with linear interpolation between neighboring table entries. In
+     * contrast to sample(double), the mask of the transfer function is taken into account, which
+     * matches the sampling done on the GPU. Large inputs are split into jobs which are processed
+     * in parallel by the thread pool.
+     *
+     * @param src     pointer to the scalar input values
+     * @param dst     pointer to the output colors, has to hold at least \p size elements
+     * @param size    number of values
+     * @param range   value range mapped onto [0,1]. If the range is empty or not finite, all
+     *                values are mapped to the first table entry, as are NaN values.
+     */
+    template <typename T>
+    void sample(const T* src, vec4* dst, size_t size, dvec2 range = dvec2{0.0, 1.0}) const;
+
     friend bool operator==(const TransferFunction& lhs, const TransferFunction& rhs);
 
     virtual std::vector<FileExtension> getSupportedExtensions() const override;
@@ -114,6 +136,19 @@ public:
 protected:
     void calcTransferValues() const;
 
+    /**
+     * Returns the cached transfer function table of getTextureSize() entries. The table is
+     * updated first if necessary.
+     */
+    const vec4* getTableData() const;
+
+    /**
+     * Calls \p func for consecutive index ranges [begin, end) covering [0, size). If the range is
+     * large enough and the thread pool is available, the ranges are processed in parallel and the
+     * function returns once all of them are done.
+     */
+    static void forEachChunk(size_t size, const std::function<void(size_t, size_t)>& func);
+
     virtual std::string_view serializationKey() const override;
     virtual std::string_view serializationItemKey() const override;
 
@@ -124,8 +159,46 @@ private:
     mutable bool invalidData_;
     std::shared_ptr<LayerRAMPrecision<vec4>> dataRepr_;
     std::unique_ptr<Layer> data_;
+
+    // state of primitives and mask used for the current content of dataRepr_, makes it possible
+    // to only update the part of the table affected by a change.
+    mutable std::vector<TFPrimitiveData> tableState_;
+    mutable dvec2 tableMask_;
 };
 
+template <typename T>
+void TransferFunction::sample(const T* src, vec4* dst, size_t size, dvec2 range) const {
+    static_assert(util::rank<T>::value == 0, "Only scalar values are supported");
+
+    const vec4* table = getTableData();
+    const size_t tableSize = getTextureSize();
+    if (tableSize == 0) {
+        std::fill(dst, dst + size, vec4(0.0f));
+        return;
+    }
+
+    const double scale = static_cast<double>(tableSize - 1) / (range.y - range.x);
+    const double offset = -range.x * scale;
+    // A degenerate range, i.e. a constant input, has no meaningful mapping, use the first entry
+    if (!std::isfinite(scale) || !std::isfinite(offset)) {
+        std::fill(dst, dst + size, table[0]);
+        return;
+    }
+    const float maxIndex = static_cast<float>(tableSize - 1);
+
+    forEachChunk(size, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const float v = static_cast<float>(static_cast<double>(src[i]) * scale + offset);
+            // NaN is not affected by clamp, map it to the first entry like a too small value
+            const float x = std::isnan(v) ? 0.0f : glm::clamp(v, 0.0f, maxIndex);
+            const size_t i0 = static_cast<size_t>(x);
+            const size_t i1 = std::min(i0 + 1, tableSize - 1);
+            const float t = x - static_cast<float>(i0);
+            dst[i] = table[i0] + (table[i1] - table[i0]) * t;
+        }
+    });
+}
+
 bool operator==(const TransferFunction& lhs, const TransferFunction& rhs);
 bool operator!=(const TransferFunction& lhs, const TransferFunction& rhs);
 
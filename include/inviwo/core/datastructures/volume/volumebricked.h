@@ -0,0 +1,140 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/datastructures/volume/volumerepresentation.h>
+#include <inviwo/core/datastructures/geometry/geometrytype.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/formats.h>
+#include <inviwo/core/util/formatdispatching.h>
+
+namespace inviwo {
+
+/**
+ * \ingroup datastructures
+ * A CPU representation of a volume where the voxels are stored in bricks of brickSize^3 voxels
+ * instead of in one linear array. The bricks are stored in x, y, z order and the voxels within a
+ * brick in Morton (Z-order), such that neighboring voxels along any axis are close in memory.
+ * Accessing a slice orthogonal to x or y then touches about as many cache lines as a slice
+ * orthogonal to z, while a VolumeRAM reads a new cache line for each voxel of an x slice.
+ * Memory use is the same as for a VolumeRAM, apart from padding of the border bricks.
+ *
+ * Use VolumeBrickedPrecision<T> for typed access, it can be retrieved using dispatch(). A
+ * VolumeBricked can be converted to and from VolumeRAM by the representation converters.
+ * @see VolumeBrickedPrecision
+ */
+class IVW_CORE_API VolumeBricked : public VolumeRepresentation {
+public:
+    /// Number of voxels along each axis of a brick
+    static constexpr size_t brickSize = 8;
+
+    VolumeBricked(const DataFormatBase* format);
+    VolumeBricked(const VolumeBricked& rhs) = default;
+    VolumeBricked& operator=(const VolumeBricked& that) = default;
+    virtual VolumeBricked* clone() const override = 0;
+    virtual ~VolumeBricked() = default;
+
+    virtual double getAsDouble(const size3_t& pos) const = 0;
+    virtual dvec2 getAsDVec2(const size3_t& pos) const = 0;
+    virtual dvec3 getAsDVec3(const size3_t& pos) const = 0;
+    virtual dvec4 getAsDVec4(const size3_t& pos) const = 0;
+
+    virtual void setFromDouble(const size3_t& pos, double val) = 0;
+    virtual void setFromDVec4(const size3_t& pos, dvec4 val) = 0;
+
+    /// Number of bricks along each axis
+    virtual size3_t getBrickDimensions() const = 0;
+
+    /// Memory used by the bricks
+    virtual size_t getNumberOfBytes() const = 0;
+
+    /**
+     * Dimensions of the slice orthogonal to \p axis as returned by copySlice: (z, y) for x,
+     * (x, z) for y, and (x, y) for z.
+     */
+    size2_t getSliceDimensions(CartesianCoordinateAxis axis) const;
+
+    virtual std::type_index getTypeIndex() const override final;
+
+    /**
+     * Dispatch functionality to retrieve the actual underlaying VolumeBrickedPrecision, see
+     * VolumeRAM::dispatch.
+     */
+    template <typename Result, template <class> class Predicate = dispatching::filter::All,
+              typename Callable, typename... Args>
+    auto dispatch(Callable&& callable, Args&&... args) -> Result;
+
+    /**
+     *	Const overload. Callable will be called with a const VolumeBrickedPrecision<T> pointer.
+     */
+    template <typename Result, template <class> class Predicate = dispatching::filter::All,
+              typename Callable, typename... Args>
+    auto dispatch(Callable&& callable, Args&&... args) const -> Result;
+};
+
+template <typename T>
+class VolumeBrickedPrecision;
+
+namespace detail {
+struct VolumeBrickedDispatcher {
+    template <typename Result, typename Format, typename Callable, typename... Args>
+    Result operator()(Callable&& obj, VolumeBricked* volume, Args... args) {
+        return obj(static_cast<VolumeBrickedPrecision<typename Format::type>*>(volume),
+                   std::forward<Args>(args)...);
+    }
+};
+
+struct VolumeBrickedConstDispatcher {
+    template <typename Result, typename Format, typename Callable, typename... Args>
+    Result operator()(Callable&& obj, const VolumeBricked* volume, Args... args) {
+        return obj(static_cast<const VolumeBrickedPrecision<typename Format::type>*>(volume),
+                   std::forward<Args>(args)...);
+    }
+};
+}  // namespace detail
+
+template <typename Result, template <class> class Predicate, typename Callable, typename... Args>
+auto VolumeBricked::dispatch(Callable&& callable, Args&&... args) -> Result {
+    detail::VolumeBrickedDispatcher dispatcher;
+    return dispatching::dispatch<Result, Predicate>(getDataFormatId(), dispatcher,
+                                                    std::forward<Callable>(callable), this,
+                                                    std::forward<Args>(args)...);
+}
+
+template <typename Result, template <class> class Predicate, typename Callable, typename... Args>
+auto VolumeBricked::dispatch(Callable&& callable, Args&&... args) const -> Result {
+    detail::VolumeBrickedConstDispatcher dispatcher;
+    return dispatching::dispatch<Result, Predicate>(getDataFormatId(), dispatcher,
+                                                    std::forward<Callable>(callable), this,
+                                                    std::forward<Args>(args)...);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,406 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/datastructures/volume/volumebricked.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/util/glm.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \ingroup datastructures
+ * Typed bricked volume, see VolumeBricked for a description of the layout.
+ * Voxels are read using get() and written using set(). To traverse all voxels use forEachVoxel()
+ * or forEachBrick(), which visit the voxels in memory order, and copySlice() to extract axis
+ * aligned slices.
+ *
+ * Example of summing all voxels
+ * ```{.cpp}
+ * double sum = 0.0;
+ * bricked.forEachVoxel([&](const size3_t&, const T& value) { sum += value; });
+ * ```
+ */
+template <typename T>
+class VolumeBrickedPrecision : public VolumeBricked {
+public:
+    using type = T;
+    /// Number of voxels in a brick
+    static constexpr size_t brickVoxels = brickSize * brickSize * brickSize;
+
+    explicit VolumeBrickedPrecision(size3_t dimensions = size3_t(128, 128, 128),
+                                    const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                                    InterpolationType interpolation = InterpolationType::Linear,
+                                    const Wrapping3D& wrapping = wrapping3d::clampAll);
+    VolumeBrickedPrecision(const VolumeBrickedPrecision<T>& rhs) = default;
+    VolumeBrickedPrecision<T>& operator=(const VolumeBrickedPrecision<T>& that) = default;
+    virtual VolumeBrickedPrecision<T>* clone() const override;
+    virtual ~VolumeBrickedPrecision() = default;
+
+    /**
+     * Index of the voxel at position \p local (each component less than brickSize) within the
+     * data of a brick.
+     */
+    static size_t voxelIndex(const size3_t& local);
+
+    /**
+     * Returns the value of voxel \p pos, which has to be inside the volume.
+     */
+    const T& get(const size3_t& pos) const;
+    /**
+     * Set voxel \p pos, which has to be inside the volume, to \p value.
+     */
+    void set(const size3_t& pos, const T& value);
+
+    /**
+     * Replace all voxels with the \p data of a linear volume with the same dimensions, i.e. a
+     * VolumeRAM with x fastest.
+     */
+    void setFromLinear(const T* data);
+
+    /**
+     * Write all voxels into the \p data of a linear volume with the same dimensions.
+     */
+    void copyToLinear(T* data) const;
+
+    /**
+     * Write the slice orthogonal to \p axis at index \p slice into \p dest, which has to hold
+     * getSliceDimensions(axis) voxels, stored with the first slice dimension fastest. Only the
+     * bricks intersecting the slice are read.
+     */
+    void copySlice(CartesianCoordinateAxis axis, size_t slice, T* dest) const;
+
+    /**
+     * Call \p callback for each brick as `callback(const size3_t& origin, const T* data)` where
+     * origin is the position of the first voxel of the brick and data points to its brickVoxels
+     * voxels, use voxelIndex() to find a voxel. Bricks at the border of the volume extend past
+     * the dimensions, the voxels outside of the volume are zero.
+     */
+    template <typename Callback>
+    void forEachBrick(Callback callback) const;
+
+    /**
+     * Call \p callback as `callback(const size3_t& pos, const T& value)` for each voxel of the
+     * volume in memory order.
+     */
+    template <typename Callback>
+    void forEachVoxel(Callback callback) const;
+
+    virtual const size3_t& getDimensions() const override;
+    /**
+     * Set new dimensions, this clears all the voxels.
+     */
+    virtual void setDimensions(size3_t dimensions) override;
+
+    virtual void setSwizzleMask(const SwizzleMask& mask) override;
+    virtual SwizzleMask getSwizzleMask() const override;
+
+    virtual void setInterpolation(InterpolationType interpolation) override;
+    virtual InterpolationType getInterpolation() const override;
+
+    virtual void setWrapping(const Wrapping3D& wrapping) override;
+    virtual Wrapping3D getWrapping() const override;
+
+    virtual double getAsDouble(const size3_t& pos) const override;
+    virtual dvec2 getAsDVec2(const size3_t& pos) const override;
+    virtual dvec3 getAsDVec3(const size3_t& pos) const override;
+    virtual dvec4 getAsDVec4(const size3_t& pos) const override;
+
+    virtual void setFromDouble(const size3_t& pos, double val) override;
+    virtual void setFromDVec4(const size3_t& pos, dvec4 val) override;
+
+    virtual size3_t getBrickDimensions() const override;
+    virtual size_t getNumberOfBytes() const override;
+
+private:
+    static_assert(brickSize == 8, "The Morton table assumes 8^3 bricks");
+    /// The bits of a local coordinate spread out to every third bit
+    static constexpr std::array<std::uint16_t, brickSize> morton_{0, 1, 8, 9, 64, 65, 72, 73};
+
+    size_t brickIndex(const size3_t& brick) const;
+    size_t index(const size3_t& pos) const;
+    size3_t brickExtent(const size3_t& origin) const;
+
+    size3_t dimensions_;
+    size3_t brickDimensions_;
+    std::vector<T> data_;  ///< brickVoxels voxels per brick
+    SwizzleMask swizzleMask_;
+    InterpolationType interpolation_;
+    Wrapping3D wrapping_;
+};
+
+/**
+ * Create a bricked volume with all the voxels of \p ram.
+ */
+IVW_CORE_API std::shared_ptr<VolumeBricked> createVolumeBricked(const VolumeRAM& ram);
+
+/**
+ * Create a linear volume with all the voxels of \p bricked.
+ */
+IVW_CORE_API std::shared_ptr<VolumeRAM> createVolumeRAM(const VolumeBricked& bricked);
+
+template <typename T>
+VolumeBrickedPrecision<T>::VolumeBrickedPrecision(size3_t dimensions,
+                                                  const SwizzleMask& swizzleMask,
+                                                  InterpolationType interpolation,
+                                                  const Wrapping3D& wrapping)
+    : VolumeBricked(DataFormat<T>::get())
+    , swizzleMask_(swizzleMask)
+    , interpolation_{interpolation}
+    , wrapping_{wrapping} {
+    setDimensions(dimensions);
+}
+
+template <typename T>
+VolumeBrickedPrecision<T>* VolumeBrickedPrecision<T>::clone() const {
+    return new VolumeBrickedPrecision<T>(*this);
+}
+
+template <typename T>
+size_t VolumeBrickedPrecision<T>::voxelIndex(const size3_t& local) {
+    return static_cast<size_t>(morton_[local.x]) | (static_cast<size_t>(morton_[local.y]) << 1) |
+           (static_cast<size_t>(morton_[local.z]) << 2);
+}
+
+template <typename T>
+size_t VolumeBrickedPrecision<T>::brickIndex(const size3_t& brick) const {
+    return brick.x + brickDimensions_.x * (brick.y + brickDimensions_.y * brick.z);
+}
+
+template <typename T>
+size_t VolumeBrickedPrecision<T>::index(const size3_t& pos) const {
+    return brickIndex(pos / brickSize) * brickVoxels + voxelIndex(pos % brickSize);
+}
+
+template <typename T>
+size3_t VolumeBrickedPrecision<T>::brickExtent(const size3_t& origin) const {
+    return glm::min(size3_t{brickSize}, dimensions_ - origin);
+}
+
+template <typename T>
+const T& VolumeBrickedPrecision<T>::get(const size3_t& pos) const {
+    return data_[index(pos)];
+}
+
+template <typename T>
+void VolumeBrickedPrecision<T>::set(const size3_t& pos, const T& value) {
+    data_[index(pos)] = value;
+}
+
+template <typename T>
+void VolumeBrickedPrecision<T>::setFromLinear(const T* data) {
+    size3_t brick{0};
+    for (brick.z = 0; brick.z < brickDimensions_.z; ++brick.z) {
+        for (brick.y = 0; brick.y < brickDimensions_.y; ++brick.y) {
+            for (brick.x = 0; brick.x < brickDimensions_.x; ++brick.x) {
+                const size3_t origin = brick * brickSize;
+                const size3_t extent = brickExtent(origin);
+                T* dest = data_.data() + brickIndex(brick) * brickVoxels;
+                for (size_t z = 0; z < extent.z; ++z) {
+                    for (size_t y = 0; y < extent.y; ++y) {
+                        const T* row =
+                            data + VolumeRAM::posToIndex(origin + size3_t{0, y, z}, dimensions_);
+                        for (size_t x = 0; x < extent.x; ++x) {
+                            dest[voxelIndex(size3_t{x, y, z})] = row[x];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+void VolumeBrickedPrecision<T>::copyToLinear(T* data) const {
+    forEachBrick([&](const size3_t& origin, const T* src) {
+        const size3_t extent = brickExtent(origin);
+        for (size_t z = 0; z < extent.z; ++z) {
+            for (size_t y = 0; y < extent.y; ++y) {
+                T* row = data + VolumeRAM::posToIndex(origin + size3_t{0, y, z}, dimensions_);
+                for (size_t x = 0; x < extent.x; ++x) {
+                    row[x] = src[voxelIndex(size3_t{x, y, z})];
+                }
+            }
+        }
+    });
+}
+
+template <typename T>
+void VolumeBrickedPrecision<T>::copySlice(CartesianCoordinateAxis axis, size_t slice,
+                                          T* dest) const {
+    // the two axes of the slice, u fastest in dest, and the axis orthogonal to it
+    const auto [u, v, w] = [&]() -> std::array<size_t, 3> {
+        switch (axis) {
+            case CartesianCoordinateAxis::X:
+                return {2, 1, 0};
+            case CartesianCoordinateAxis::Y:
+                return {0, 2, 1};
+            case CartesianCoordinateAxis::Z:
+            default:
+                return {0, 1, 2};
+        }
+    }();
+    const size_t width = dimensions_[u];
+
+    size3_t brick{0};
+    size3_t local{0};
+    brick[w] = slice / brickSize;
+    local[w] = slice % brickSize;
+    for (brick[v] = 0; brick[v] < brickDimensions_[v]; ++brick[v]) {
+        for (brick[u] = 0; brick[u] < brickDimensions_[u]; ++brick[u]) {
+            const size3_t origin = brick * brickSize;
+            const size3_t extent = brickExtent(origin);
+            const T* src = data_.data() + brickIndex(brick) * brickVoxels;
+            for (local[v] = 0; local[v] < extent[v]; ++local[v]) {
+                T* row = dest + (origin[v] + local[v]) * width + origin[u];
+                for (local[u] = 0; local[u] < extent[u]; ++local[u]) {
+                    row[local[u]] = src[voxelIndex(local)];
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+template <typename Callback>
+void VolumeBrickedPrecision<T>::forEachBrick(Callback callback) const {
+    size3_t brick{0};
+    for (brick.z = 0; brick.z < brickDimensions_.z; ++brick.z) {
+        for (brick.y = 0; brick.y < brickDimensions_.y; ++brick.y) {
+            for (brick.x = 0; brick.x < brickDimensions_.x; ++brick.x) {
+                callback(brick * brickSize, data_.data() + brickIndex(brick) * brickVoxels);
+            }
+        }
+    }
+}
+
+template <typename T>
+template <typename Callback>
+void VolumeBrickedPrecision<T>::forEachVoxel(Callback callback) const {
+    forEachBrick([&](const size3_t& origin, const T* src) {
+        const size3_t extent = brickExtent(origin);
+        for (size_t z = 0; z < extent.z; ++z) {
+            for (size_t y = 0; y < extent.y; ++y) {
+                for (size_t x = 0; x < extent.x; ++x) {
+                    const size3_t local{x, y, z};
+                    callback(origin + local, src[voxelIndex(local)]);
+                }
+            }
+        }
+    });
+}
+
+template <typename T>
+const size3_t& VolumeBrickedPrecision<T>::getDimensions() const {
+    return dimensions_;
+}
+
+template <typename T>
+void VolumeBrickedPrecision<T>::setDimensions(size3_t dimensions) {
+    dimensions_ = dimensions;
+    brickDimensions_ = (dimensions_ + size3_t{brickSize - 1}) / brickSize;
+    data_.assign(glm::compMul(brickDimensions_) * brickVoxels, T{0});
+}
+
+template <typename T>
+void VolumeBrickedPrecision<T>::setSwizzleMask(const SwizzleMask& mask) {
+    swizzleMask_ = mask;
+}
+
+template <typename T>
+SwizzleMask VolumeBrickedPrecision<T>::getSwizzleMask() const {
+    return swizzleMask_;
+}
+
+template <typename T>
+void VolumeBrickedPrecision<T>::setInterpolation(InterpolationType interpolation) {
+    interpolation_ = interpolation;
+}
+
+template <typename T>
+InterpolationType VolumeBrickedPrecision<T>::getInterpolation() const {
+    return interpolation_;
+}
+
+template <typename T>
+void VolumeBrickedPrecision<T>::setWrapping(const Wrapping3D& wrapping) {
+    wrapping_ = wrapping;
+}
+
+template <typename T>
+Wrapping3D VolumeBrickedPrecision<T>::getWrapping() const {
+    return wrapping_;
+}
+
+template <typename T>
+double VolumeBrickedPrecision<T>::getAsDouble(const size3_t& pos) const {
+    return util::glm_convert<double>(get(pos));
+}
+
+template <typename T>
+dvec2 VolumeBrickedPrecision<T>::getAsDVec2(const size3_t& pos) const {
+    return util::glm_convert<dvec2>(get(pos));
+}
+
+template <typename T>
+dvec3 VolumeBrickedPrecision<T>::getAsDVec3(const size3_t& pos) const {
+    return util::glm_convert<dvec3>(get(pos));
+}
+
+template <typename T>
+dvec4 VolumeBrickedPrecision<T>::getAsDVec4(const size3_t& pos) const {
+    return util::glm_convert<dvec4>(get(pos));
+}
+
+template <typename T>
+void VolumeBrickedPrecision<T>::setFromDouble(const size3_t& pos, double val) {
+    set(pos, util::glm_convert<T>(val));
+}
+
+template <typename T>
+void VolumeBrickedPrecision<T>::setFromDVec4(const size3_t& pos, dvec4 val) {
+    set(pos, util::glm_convert<T>(val));
+}
+
+template <typename T>
+size3_t VolumeBrickedPrecision<T>::getBrickDimensions() const {
+    return brickDimensions_;
+}
+
+template <typename T>
+size_t VolumeBrickedPrecision<T>::getNumberOfBytes() const {
+    return data_.size() * sizeof(T);
+}
+
+}  // namespace inviwo
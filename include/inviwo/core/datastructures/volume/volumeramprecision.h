@@ -32,11 +32,28 @@
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/util/glm.h>
 #include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/util/ramallocator.h>
+#include <inviwo/core/util/exception.h>
+
+#include <atomic>
+#include <mutex>
 
 namespace inviwo {
 
 /**
  * \ingroup datastructures
+ * Copies of a VolumeRAMPrecision, i.e. from clone() or the copy constructor, share the voxel data
+ * until one of them is modified. The data is copied on the first call to a non-const accessor
+ * like getDataTyped(), getData() or setFromDouble() of a copy, hence such functions should only
+ * be used on representations from getEditableRepresentation. Pointers returned by non-const
+ * accessors should not be kept while making new copies, since writes through them will then
+ * be visible in the copies as well.
+ *
+ * A VolumeRAMPrecision can also be created as a view of a sub-box of another one, optionally
+ * with a stride, see the view constructor and createVolumeRAMView. A view shares the data of its
+ * parent and reads voxels directly from it in the getAs* functions, i.e. also when used with a
+ * VolumeSampler. Only when contiguous data is requested, using getDataTyped() or getData(), the
+ * view is materialized into its own buffer.
  */
 template <typename T>
 class VolumeRAMPrecision : public VolumeRAM {
@@ -47,10 +64,31 @@ public:
                                 const SwizzleMask& swizzleMask = swizzlemasks::rgba,
                                 InterpolationType interpolation = InterpolationType::Linear,
                                 const Wrapping3D& wrapping = wrapping3d::clampAll);
+    /**
+     * Create a volume whose data is allocated using \p init. Use util::RAMInit::Uninitialized
+     * to avoid clearing the data when all voxels will be overwritten anyway.
+     */
+    VolumeRAMPrecision(size3_t dimensions, util::RAMInit init,
+                       const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                       InterpolationType interpolation = InterpolationType::Linear,
+                       const Wrapping3D& wrapping = wrapping3d::clampAll);
+    /**
+     * Create a volume taking ownership of \p data, which has to be allocated with new[]. If
+     * \p data is nullptr the data is allocated and set to zero.
+     */
     VolumeRAMPrecision(T* data, size3_t dimensions,
                        const SwizzleMask& swizzleMask = swizzlemasks::rgba,
                        InterpolationType interpolation = InterpolationType::Linear,
                        const Wrapping3D& wrapping = wrapping3d::clampAll);
+    /**
+     * Create a view of the sub-box of \p parent starting at \p offset. Voxel `pos` of the view
+     * corresponds to voxel `offset + pos * stride` of \p parent. The data of \p parent is shared
+     * and not copied until contiguous data is requested. Later modifications of \p parent are not
+     * visible in the view.
+     * @throw Exception if the view does not fit inside \p parent
+     */
+    VolumeRAMPrecision(const VolumeRAMPrecision<T>& parent, const size3_t& offset,
+                       const size3_t& dimensions, const size3_t& stride = size3_t{1});
     VolumeRAMPrecision(const VolumeRAMPrecision<T>& rhs);
     VolumeRAMPrecision<T>& operator=(const VolumeRAMPrecision<T>& that);
     virtual VolumeRAMPrecision<T>* clone() const override;
@@ -108,10 +146,52 @@ public:
 
     virtual size_t getNumberOfBytes() const override;
 
+    /**
+     * Returns true if this is a view of another volume that reads its voxels from the data of
+     * the parent, see the view constructor.
+     */
+    bool isView() const;
+
 private:
+    /**
+     * Make sure the data is not shared with any copy, needs to be called before the data is
+     * handed out for modifications. A view is materialized and turned into a regular volume.
+     */
+    void detach();
+
+    /**
+     * Copy the voxels of a view into data_, does nothing if already done.
+     */
+    void materialize() const;
+    const T& voxel(const size3_t& pos) const;
+
+    /**
+     * Source of the voxels of a view and the state of its materialization. Only allocated for
+     * views, to not add the mutex to every volume.
+     */
+    struct View {
+        View(util::SharedRAMPtr<T> aData, size3_t aDimensions, size3_t aOffset, size3_t aStride)
+            : data{std::move(aData)}, dimensions{aDimensions}, offset{aOffset}, stride{aStride} {}
+        /// Needs to be called with the mutex of \p rhs locked
+        View(const View& rhs)
+            : data{rhs.data}
+            , dimensions{rhs.dimensions}
+            , offset{rhs.offset}
+            , stride{rhs.stride}
+            , materialized{rhs.materialized.load()} {}
+        View& operator=(const View&) = delete;
+
+        const util::SharedRAMPtr<T> data;
+        const size3_t dimensions;  ///< dimensions of the parent data
+        const size3_t offset;
+        const size3_t stride;
+        std::atomic<bool> materialized{false};  ///< data_ holds a copy of the voxels
+        std::mutex mutex;                       ///< guards materialization
+    };
+
     size3_t dimensions_;
-    bool ownsDataPtr_;
-    std::unique_ptr<T[]> data_;
+    mutable util::SharedRAMPtr<T> data_;
+    std::unique_ptr<View> view_;
     SwizzleMask swizzleMask_;
     InterpolationType interpolation_;
     Wrapping3D wrapping_;
@@ -135,14 +215,61 @@ IVW_CORE_API std::shared_ptr<VolumeRAM> createVolumeRAM(
     InterpolationType interpolation = InterpolationType::Linear,
     const Wrapping3D& wrapping = wrapping3d::clampAll);
 
+/**
+ * Factory for volumes.
+ * Creates an VolumeRAM with data type specified by format and data allocated using \p init.
+ *
+ * @param dimensions of volume to create.
+ * @param format of volume to create.
+ * @param init initialization of the allocated data, util::RAMInit::Uninitialized avoids clearing
+ *        the data when it will be overwritten anyway.
+ * @param swizzleMask of volume to create.
+ * @param interpolation of volume to create.
+ * @param wrapping of volume to create.
+ * @return nullptr if no valid format was specified.
+ */
+IVW_CORE_API std::shared_ptr<VolumeRAM> createVolumeRAM(
+    const size3_t& dimensions, const DataFormatBase* format, util::RAMInit init,
+    const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+    InterpolationType interpolation = InterpolationType::Linear,
+    const Wrapping3D& wrapping = wrapping3d::clampAll);
+
+/**
+ * Factory for volume views.
+ * Creates a view of the sub-box of \p parent starting at \p offset with the given dimensions
+ * and stride, without copying any data. The view is materialized when contiguous data is
+ * requested. See the view constructor of VolumeRAMPrecision.
+ *
+ * @param parent volume to create the view of, has to be a VolumeRAMPrecision.
+ * @param offset in voxels of the first voxel of the view in \p parent.
+ * @param dimensions of the view.
+ * @param stride in voxels between consecutive voxels of the view in \p parent.
+ * @throw Exception if the view does not fit inside \p parent
+ */
+IVW_CORE_API std::shared_ptr<VolumeRAM> createVolumeRAMView(const VolumeRAM& parent,
+                                                            const size3_t& offset,
+                                                            const size3_t& dimensions,
+                                                            const size3_t& stride = size3_t{1});
+
 template <typename T>
 VolumeRAMPrecision<T>::VolumeRAMPrecision(size3_t dimensions, const SwizzleMask& swizzleMask,
                                           InterpolationType interpolation,
                                           const Wrapping3D& wrapping)
     : VolumeRAM(DataFormat<T>::get())
     , dimensions_(dimensions)
-    , ownsDataPtr_(true)
-    , data_(new T[dimensions_.x * dimensions_.y * dimensions_.z]())
+    , data_(util::allocateRAMData<T>(glm::compMul(dimensions_)))
+    , swizzleMask_(swizzleMask)
+    , interpolation_{interpolation}
+    , wrapping_{wrapping} {}
+
+template <typename T>
+VolumeRAMPrecision<T>::VolumeRAMPrecision(size3_t dimensions, util::RAMInit init,
+                                          const SwizzleMask& swizzleMask,
+                                          InterpolationType interpolation,
+                                          const Wrapping3D& wrapping)
+    : VolumeRAM(DataFormat<T>::get())
+    , dimensions_(dimensions)
+    , data_(util::allocateRAMData<T>(glm::compMul(dimensions_), init))
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
     , wrapping_{wrapping} {}
@@ -154,35 +281,65 @@ VolumeRAMPrecision<T>::VolumeRAMPrecision(T* data, size3_t dimensions,
                                           const Wrapping3D& wrapping)
     : VolumeRAM(DataFormat<T>::get())
     , dimensions_(dimensions)
-    , ownsDataPtr_(true)
-    , data_(data ? data : new T[dimensions_.x * dimensions_.y * dimensions_.z]())
+    , data_(data ? util::RAMPtr<T>(data) : util::allocateRAMData<T>(glm::compMul(dimensions_)))
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
     , wrapping_{wrapping} {}
 
+template <typename T>
+VolumeRAMPrecision<T>::VolumeRAMPrecision(const VolumeRAMPrecision<T>& parent,
+                                          const size3_t& offset, const size3_t& dimensions,
+                                          const size3_t& stride)
+    : VolumeRAM(parent)
+    , dimensions_(dimensions)
+    , swizzleMask_(parent.swizzleMask_)
+    , interpolation_{parent.interpolation_}
+    , wrapping_{parent.wrapping_} {
+    if (glm::any(glm::equal(dimensions, size3_t{0})) ||
+        glm::any(glm::equal(stride, size3_t{0})) ||
+        glm::any(glm::greaterThanEqual(offset + (dimensions - size3_t{1}) * stride,
+                                       parent.dimensions_))) {
+        throw Exception("Volume view is outside of the parent volume",
+                        IVW_CONTEXT_CUSTOM("VolumeRAMPrecision"));
+    }
+
+    if (const auto& pv = parent.view_) {
+        view_ = std::make_unique<View>(pv->data, pv->dimensions, pv->offset + offset * pv->stride,
+                                       pv->stride * stride);
+    } else {
+        view_ = std::make_unique<View>(parent.data_, parent.dimensions_, offset, stride);
+    }
+}
+
 template <typename T>
 VolumeRAMPrecision<T>::VolumeRAMPrecision(const VolumeRAMPrecision<T>& rhs)
     : VolumeRAM(rhs)
     , dimensions_(rhs.dimensions_)
-    , ownsDataPtr_(true)
-    , data_(new T[dimensions_.x * dimensions_.y * dimensions_.z])
     , swizzleMask_(rhs.swizzleMask_)
     , interpolation_{rhs.interpolation_}
     , wrapping_{rhs.wrapping_} {
-    std::memcpy(data_.get(), rhs.data_.get(),
-                dimensions_.x * dimensions_.y * dimensions_.z * sizeof(T));
+    if (rhs.view_) {
+        std::scoped_lock lock{rhs.view_->mutex};
+        view_ = std::make_unique<View>(*rhs.view_);
+        data_ = rhs.data_;
+    } else {
+        data_ = rhs.data_;
+    }
 }
 
 template <typename T>
 VolumeRAMPrecision<T>& VolumeRAMPrecision<T>::operator=(const VolumeRAMPrecision<T>& that) {
     if (this != &that) {
         VolumeRAM::operator=(that);
-        auto dim = that.dimensions_;
-        auto data = std::make_unique<T[]>(dim.x * dim.y * dim.z);
-        std::memcpy(data.get(), that.data_.get(), dim.x * dim.y * dim.z * sizeof(T));
-        data_.swap(data);
-        std::swap(dim, dimensions_);
-        ownsDataPtr_ = true;
+        dimensions_ = that.dimensions_;
+        if (that.view_) {
+            std::scoped_lock lock{that.view_->mutex};
+            view_ = std::make_unique<View>(*that.view_);
+            data_ = that.data_;
+        } else {
+            view_.reset();
+            data_ = that.data_;
+        }
         swizzleMask_ = that.swizzleMask_;
         interpolation_ = that.interpolation_;
         wrapping_ = that.wrapping_;
@@ -191,9 +348,7 @@ VolumeRAMPrecision<T>& VolumeRAMPrecision<T>::operator=(const VolumeRAMPrecision
 }
 
 template <typename T>
-VolumeRAMPrecision<T>::~VolumeRAMPrecision() {
-    if (!ownsDataPtr_) data_.release();
-}
+VolumeRAMPrecision<T>::~VolumeRAMPrecision() = default;
 
 template <typename T>
 VolumeRAMPrecision<T>* VolumeRAMPrecision<T>::clone() const {
@@ -202,46 +357,52 @@ VolumeRAMPrecision<T>* VolumeRAMPrecision<T>::clone() const {
 
 template <typename T>
 const T* inviwo::VolumeRAMPrecision<T>::getDataTyped() const {
+    materialize();
     return data_.get();
 }
 
 template <typename T>
 T* inviwo::VolumeRAMPrecision<T>::getDataTyped() {
+    detach();
     return data_.get();
 }
 
 template <typename T>
 void* VolumeRAMPrecision<T>::getData() {
+    detach();
     return data_.get();
 }
 template <typename T>
 const void* VolumeRAMPrecision<T>::getData() const {
+    materialize();
     return const_cast<const T*>(data_.get());
 }
 
 template <typename T>
 void* VolumeRAMPrecision<T>::getData(size_t pos) {
+    detach();
     return data_.get() + pos;
 }
 
 template <typename T>
 const void* VolumeRAMPrecision<T>::getData(size_t pos) const {
+    materialize();
     return const_cast<const T*>(data_.get()) + pos;
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setData(void* d, size3_t dimensions) {
-    std::unique_ptr<T[]> data(static_cast<T*>(d));
-    data_.swap(data);
-    std::swap(dimensions_, dimensions);
-
-    if (!ownsDataPtr_) data.release();
-    ownsDataPtr_ = true;
+    data_ = util::RAMPtr<T>(static_cast<T*>(d));
+    dimensions_ = dimensions;
+    view_.reset();
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::removeDataOwnership() {
-    ownsDataPtr_ = false;
+    detach();
+    if (auto deleter = std::get_deleter<util::RAMDeleter<T>>(data_)) {
+        deleter->source = util::RAMDeleter<T>::Source::External;
+    }
 }
 
 template <typename T>
@@ -257,11 +418,61 @@ size_t VolumeRAMPrecision<T>::getNumberOfBytes() const {
 template <typename T>
 void VolumeRAMPrecision<T>::setDimensions(size3_t dimensions) {
     if (dimensions_ != dimensions) {
-        auto data = std::make_unique<T[]>(dimensions.x * dimensions.y * dimensions.z);
-        data_.swap(data);
+        data_ = util::allocateRAMData<T>(glm::compMul(dimensions));
         dimensions_ = dimensions;
-        if (!ownsDataPtr_) data.release();
-        ownsDataPtr_ = true;
+        view_.reset();
+    }
+}
+
+template <typename T>
+bool VolumeRAMPrecision<T>::isView() const {
+    return view_ != nullptr;
+}
+
+template <typename T>
+void VolumeRAMPrecision<T>::detach() {
+    if (view_) {
+        materialize();
+        view_.reset();
+    }
+    util::detachRAMData(data_, glm::compMul(dimensions_));
+}
+
+template <typename T>
+void VolumeRAMPrecision<T>::materialize() const {
+    if (!view_ || view_->materialized.load(std::memory_order_acquire)) return;
+
+    auto& view = *view_;
+    std::scoped_lock lock{view.mutex};
+    if (view.materialized.load(std::memory_order_relaxed)) return;
+
+    auto data = util::allocateRAMData<T>(glm::compMul(dimensions_), util::RAMInit::Uninitialized);
+    auto dst = data.get();
+    for (size_t z = 0; z < dimensions_.z; ++z) {
+        for (size_t y = 0; y < dimensions_.y; ++y) {
+            const auto src = view.data.get() +
+                             posToIndex(view.offset + size3_t{0, y, z} * view.stride,
+                                        view.dimensions);
+            if (view.stride.x == 1) {
+                std::copy(src, src + dimensions_.x, dst);
+            } else {
+                for (size_t x = 0; x < dimensions_.x; ++x) {
+                    dst[x] = src[x * view.stride.x];
+                }
+            }
+            dst += dimensions_.x;
+        }
+    }
+    data_ = std::move(data);
+    view.materialized.store(true, std::memory_order_release);
+}
+
+template <typename T>
+const T& VolumeRAMPrecision<T>::voxel(const size3_t& pos) const {
+    if (view_) {
+        return view_->data[posToIndex(view_->offset + pos * view_->stride, view_->dimensions)];
+    } else {
+        return data_[posToIndex(pos, dimensions_)];
     }
 }
 
@@ -297,81 +508,89 @@ Wrapping3D VolumeRAMPrecision<T>::getWrapping() const {
 
 template <typename T>
 double VolumeRAMPrecision<T>::getAsDouble(const size3_t& pos) const {
-    return util::glm_convert<double>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert<double>(voxel(pos));
 }
 
 template <typename T>
 dvec2 VolumeRAMPrecision<T>::getAsDVec2(const size3_t& pos) const {
-    return util::glm_convert<dvec2>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert<dvec2>(voxel(pos));
 }
 
 template <typename T>
 dvec3 VolumeRAMPrecision<T>::getAsDVec3(const size3_t& pos) const {
-    return util::glm_convert<dvec3>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert<dvec3>(voxel(pos));
 }
 
 template <typename T>
 dvec4 VolumeRAMPrecision<T>::getAsDVec4(const size3_t& pos) const {
-    return util::glm_convert<dvec4>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert<dvec4>(voxel(pos));
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDouble(const size3_t& pos, double val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec2(const size3_t& pos, dvec2 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec3(const size3_t& pos, dvec3 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec4(const size3_t& pos, dvec4 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 double VolumeRAMPrecision<T>::getAsNormalizedDouble(const size3_t& pos) const {
-    return util::glm_convert_normalized<double>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert_normalized<double>(voxel(pos));
 }
 
 template <typename T>
 dvec2 VolumeRAMPrecision<T>::getAsNormalizedDVec2(const size3_t& pos) const {
-    return util::glm_convert_normalized<dvec2>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert_normalized<dvec2>(voxel(pos));
 }
 
 template <typename T>
 dvec3 VolumeRAMPrecision<T>::getAsNormalizedDVec3(const size3_t& pos) const {
-    return util::glm_convert_normalized<dvec3>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert_normalized<dvec3>(voxel(pos));
 }
 
 template <typename T>
 dvec4 VolumeRAMPrecision<T>::getAsNormalizedDVec4(const size3_t& pos) const {
-    return util::glm_convert_normalized<dvec4>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert_normalized<dvec4>(voxel(pos));
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDouble(const size3_t& pos, double val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec2(const size3_t& pos, dvec2 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec3(const size3_t& pos, dvec3 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec4(const size3_t& pos, dvec4 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
@@ -0,0 +1,153 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/datastructures/volume/volumerepresentation.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/formats.h>
+#include <inviwo/core/util/formatdispatching.h>
+
+namespace inviwo {
+
+/**
+ * \ingroup datastructures
+ * A sparse CPU representation of a volume for data where most voxels have the same background
+ * value, like segmentations or simulations with a small region of interest.
+ * The voxels are stored in dense leaf bricks of leafSize^3 voxels. Only bricks that contain
+ * voxels that differ from the background are allocated. The bricks are found through a shallow
+ * tree: a dense root grid of internal nodes, each covering nodeSize^3 leaves. Memory and the
+ * cost of iterating the voxels hence scale with the number of active voxels rather than the
+ * bounding box of the volume. A voxel is active if its value differs from the background value.
+ *
+ * Use VolumeSparsePrecision<T> for typed access, it can be retrieved using dispatch(). A
+ * VolumeSparse can be converted to and from VolumeRAM by the representation converters.
+ * @see VolumeSparsePrecision
+ */
+class IVW_CORE_API VolumeSparse : public VolumeRepresentation {
+public:
+    /// Number of voxels along each axis of a leaf brick
+    static constexpr size_t leafSize = 8;
+    /// Number of leaves along each axis of an internal node
+    static constexpr size_t nodeSize = 16;
+
+    VolumeSparse(const DataFormatBase* format);
+    VolumeSparse(const VolumeSparse& rhs) = default;
+    VolumeSparse& operator=(const VolumeSparse& that) = default;
+    virtual VolumeSparse* clone() const override = 0;
+    virtual ~VolumeSparse() = default;
+
+    virtual double getAsDouble(const size3_t& pos) const = 0;
+    virtual dvec2 getAsDVec2(const size3_t& pos) const = 0;
+    virtual dvec3 getAsDVec3(const size3_t& pos) const = 0;
+    virtual dvec4 getAsDVec4(const size3_t& pos) const = 0;
+
+    virtual void setFromDouble(const size3_t& pos, double val) = 0;
+    virtual void setFromDVec4(const size3_t& pos, dvec4 val) = 0;
+
+    virtual dvec4 getBackgroundAsDVec4() const = 0;
+
+    /**
+     * Returns true if voxel \p pos is in an allocated leaf. Voxels outside of allocated leaves
+     * all have the background value.
+     */
+    virtual bool isAllocated(const size3_t& pos) const = 0;
+
+    /// Number of allocated leaf bricks
+    virtual size_t getLeafCount() const = 0;
+
+    /// Number of voxels that differ from the background value
+    virtual size_t getActiveVoxelCount() const = 0;
+
+    /// Memory used by the leaves and the tree
+    virtual size_t getNumberOfBytes() const = 0;
+
+    /**
+     * Remove all leaves that only contain background voxels, for example after voxels have been
+     * set to the background value.
+     */
+    virtual void prune() = 0;
+
+    virtual std::type_index getTypeIndex() const override final;
+
+    /**
+     * Dispatch functionality to retrieve the actual underlaying VolumeSparsePrecision, see
+     * VolumeRAM::dispatch.
+     */
+    template <typename Result, template <class> class Predicate = dispatching::filter::All,
+              typename Callable, typename... Args>
+    auto dispatch(Callable&& callable, Args&&... args) -> Result;
+
+    /**
+     *	Const overload. Callable will be called with a const VolumeSparsePrecision<T> pointer.
+     */
+    template <typename Result, template <class> class Predicate = dispatching::filter::All,
+              typename Callable, typename... Args>
+    auto dispatch(Callable&& callable, Args&&... args) const -> Result;
+};
+
+template <typename T>
+class VolumeSparsePrecision;
+
+namespace detail {
+struct VolumeSparseDispatcher {
+    template <typename Result, typename Format, typename Callable, typename... Args>
+    Result operator()(Callable&& obj, VolumeSparse* volume, Args... args) {
+        return obj(static_cast<VolumeSparsePrecision<typename Format::type>*>(volume),
+                   std::forward<Args>(args)...);
+    }
+};
+
+struct VolumeSparseConstDispatcher {
+    template <typename Result, typename Format, typename Callable, typename... Args>
+    Result operator()(Callable&& obj, const VolumeSparse* volume, Args... args) {
+        return obj(static_cast<const VolumeSparsePrecision<typename Format::type>*>(volume),
+                   std::forward<Args>(args)...);
+    }
+};
+}  // namespace detail
+
+template <typename Result, template <class> class Predicate, typename Callable, typename... Args>
+auto VolumeSparse::dispatch(Callable&& callable, Args&&... args) -> Result {
+    detail::VolumeSparseDispatcher dispatcher;
+    return dispatching::dispatch<Result, Predicate>(getDataFormatId(), dispatcher,
+                                                    std::forward<Callable>(callable), this,
+                                                    std::forward<Args>(args)...);
+}
+
+template <typename Result, template <class> class Predicate, typename Callable, typename... Args>
+auto VolumeSparse::dispatch(Callable&& callable, Args&&... args) const -> Result {
+    detail::VolumeSparseConstDispatcher dispatcher;
+    return dispatching::dispatch<Result, Predicate>(getDataFormatId(), dispatcher,
+                                                    std::forward<Callable>(callable), this,
+                                                    std::forward<Args>(args)...);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,474 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/datastructures/volume/volumesparse.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/util/glm.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \ingroup datastructures
+ * Typed sparse volume, see VolumeSparse for a description of the layout.
+ * Voxels are read using get() and written using set(), writing a non background value into an
+ * unallocated leaf allocates it. Use forEachActiveVoxel() or forEachLeaf() to visit the data,
+ * those only touch the allocated leaves.
+ *
+ * Example of finding the bounding box of all voxels with a label
+ * ```{.cpp}
+ * size3_t lower{std::numeric_limits<size_t>::max()};
+ * size3_t upper{0};
+ * sparse.forEachActiveVoxel([&](const size3_t& pos, const T&) {
+ *     lower = glm::min(lower, pos);
+ *     upper = glm::max(upper, pos);
+ * });
+ * ```
+ */
+template <typename T>
+class VolumeSparsePrecision : public VolumeSparse {
+public:
+    using type = T;
+    /// Number of voxels in a leaf brick
+    static constexpr size_t leafVoxels = leafSize * leafSize * leafSize;
+    /// Number of leaves of an internal node
+    static constexpr size_t nodeLeaves = nodeSize * nodeSize * nodeSize;
+
+    explicit VolumeSparsePrecision(size3_t dimensions = size3_t(128, 128, 128),
+                                   const T& background = T{0},
+                                   const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                                   InterpolationType interpolation = InterpolationType::Linear,
+                                   const Wrapping3D& wrapping = wrapping3d::clampAll);
+    VolumeSparsePrecision(const VolumeSparsePrecision<T>& rhs) = default;
+    VolumeSparsePrecision<T>& operator=(const VolumeSparsePrecision<T>& that) = default;
+    virtual VolumeSparsePrecision<T>* clone() const override;
+    virtual ~VolumeSparsePrecision() = default;
+
+    /**
+     * Returns the value of voxel \p pos, which has to be inside the volume.
+     */
+    const T& get(const size3_t& pos) const;
+    /**
+     * Set voxel \p pos, which has to be inside the volume, to \p value. The leaf of the voxel is
+     * allocated if needed, setting a voxel in an unallocated leaf to the background value does
+     * not allocate anything.
+     */
+    void set(const size3_t& pos, const T& value);
+
+    const T& getBackground() const;
+
+    /**
+     * Replace all voxels with the contiguous \p data of a volume with the same dimensions, only
+     * the leaves that contain voxels different from the background are allocated.
+     */
+    void setFromDense(const T* data);
+
+    /**
+     * Write all voxels into the contiguous \p data of a volume with the same dimensions.
+     */
+    void copyToDense(T* data) const;
+
+    /**
+     * Call \p callback for each allocated leaf as `callback(const size3_t& origin, const T* data)`
+     * where origin is the position of the first voxel of the leaf and data points to its
+     * leafSize^3 voxels, stored with x fastest. Leaves at the border of the volume extend past the
+     * dimensions, the voxels outside of the volume have the background value.
+     */
+    template <typename Callback>
+    void forEachLeaf(Callback callback) const;
+
+    /**
+     * Call \p callback as `callback(const size3_t& pos, const T& value)` for each voxel that
+     * differs from the background value. Only the allocated leaves are visited.
+     */
+    template <typename Callback>
+    void forEachActiveVoxel(Callback callback) const;
+
+    virtual const size3_t& getDimensions() const override;
+    /**
+     * Set new dimensions, this removes all the voxels.
+     */
+    virtual void setDimensions(size3_t dimensions) override;
+
+    virtual void setSwizzleMask(const SwizzleMask& mask) override;
+    virtual SwizzleMask getSwizzleMask() const override;
+
+    virtual void setInterpolation(InterpolationType interpolation) override;
+    virtual InterpolationType getInterpolation() const override;
+
+    virtual void setWrapping(const Wrapping3D& wrapping) override;
+    virtual Wrapping3D getWrapping() const override;
+
+    virtual double getAsDouble(const size3_t& pos) const override;
+    virtual dvec2 getAsDVec2(const size3_t& pos) const override;
+    virtual dvec3 getAsDVec3(const size3_t& pos) const override;
+    virtual dvec4 getAsDVec4(const size3_t& pos) const override;
+
+    virtual void setFromDouble(const size3_t& pos, double val) override;
+    virtual void setFromDVec4(const size3_t& pos, dvec4 val) override;
+
+    virtual dvec4 getBackgroundAsDVec4() const override;
+    virtual bool isAllocated(const size3_t& pos) const override;
+    virtual size_t getLeafCount() const override;
+    virtual size_t getActiveVoxelCount() const override;
+    virtual size_t getNumberOfBytes() const override;
+    virtual void prune() override;
+
+private:
+    static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+    static size_t voxelIndex(const size3_t& pos);
+    size_t rootIndex(const size3_t& pos) const;
+    static size_t nodeIndex(const size3_t& pos);
+
+    std::uint32_t findLeaf(const size3_t& pos) const;
+    std::uint32_t allocateLeaf(const size3_t& pos);
+    std::uint32_t& leafSlot(const size3_t& pos);
+    size3_t leafExtent(const size3_t& origin) const;
+
+    size3_t dimensions_;
+    size3_t rootDimensions_;
+    T background_;
+    std::vector<std::uint32_t> root_;   ///< index of the node, or none, for each root cell
+    std::vector<std::uint32_t> nodes_;  ///< nodeLeaves leaf indices, or none, per node
+    std::vector<T> leaves_;             ///< leafVoxels voxels per leaf
+    std::vector<size3_t> leafOrigins_;
+    SwizzleMask swizzleMask_;
+    InterpolationType interpolation_;
+    Wrapping3D wrapping_;
+};
+
+/**
+ * Create a sparse volume from \p ram, the voxels equal to \p background will not be stored.
+ */
+IVW_CORE_API std::shared_ptr<VolumeSparse> createVolumeSparse(const VolumeRAM& ram,
+                                                              dvec4 background = dvec4{0.0});
+
+/**
+ * Create a dense volume with all the voxels of \p sparse.
+ */
+IVW_CORE_API std::shared_ptr<VolumeRAM> createVolumeRAM(const VolumeSparse& sparse);
+
+template <typename T>
+VolumeSparsePrecision<T>::VolumeSparsePrecision(size3_t dimensions, const T& background,
+                                                const SwizzleMask& swizzleMask,
+                                                InterpolationType interpolation,
+                                                const Wrapping3D& wrapping)
+    : VolumeSparse(DataFormat<T>::get())
+    , background_(background)
+    , swizzleMask_(swizzleMask)
+    , interpolation_{interpolation}
+    , wrapping_{wrapping} {
+    setDimensions(dimensions);
+}
+
+template <typename T>
+VolumeSparsePrecision<T>* VolumeSparsePrecision<T>::clone() const {
+    return new VolumeSparsePrecision<T>(*this);
+}
+
+template <typename T>
+size_t VolumeSparsePrecision<T>::voxelIndex(const size3_t& pos) {
+    const size3_t p = pos % leafSize;
+    return p.x + leafSize * (p.y + leafSize * p.z);
+}
+
+template <typename T>
+size_t VolumeSparsePrecision<T>::rootIndex(const size3_t& pos) const {
+    const size3_t p = pos / (leafSize * nodeSize);
+    return p.x + rootDimensions_.x * (p.y + rootDimensions_.y * p.z);
+}
+
+template <typename T>
+size_t VolumeSparsePrecision<T>::nodeIndex(const size3_t& pos) {
+    const size3_t p = (pos / leafSize) % nodeSize;
+    return p.x + nodeSize * (p.y + nodeSize * p.z);
+}
+
+template <typename T>
+std::uint32_t VolumeSparsePrecision<T>::findLeaf(const size3_t& pos) const {
+    const auto node = root_[rootIndex(pos)];
+    if (node == none) return none;
+    return nodes_[node * nodeLeaves + nodeIndex(pos)];
+}
+
+template <typename T>
+std::uint32_t& VolumeSparsePrecision<T>::leafSlot(const size3_t& pos) {
+    auto& node = root_[rootIndex(pos)];
+    if (node == none) {
+        node = static_cast<std::uint32_t>(nodes_.size() / nodeLeaves);
+        nodes_.resize(nodes_.size() + nodeLeaves, none);
+    }
+    return nodes_[node * nodeLeaves + nodeIndex(pos)];
+}
+
+template <typename T>
+std::uint32_t VolumeSparsePrecision<T>::allocateLeaf(const size3_t& pos) {
+    auto& leaf = leafSlot(pos);
+    if (leaf == none) {
+        leaf = static_cast<std::uint32_t>(leafOrigins_.size());
+        leaves_.resize(leaves_.size() + leafVoxels, background_);
+        leafOrigins_.push_back((pos / leafSize) * leafSize);
+    }
+    return leaf;
+}
+
+template <typename T>
+size3_t VolumeSparsePrecision<T>::leafExtent(const size3_t& origin) const {
+    return glm::min(size3_t{leafSize}, dimensions_ - origin);
+}
+
+template <typename T>
+const T& VolumeSparsePrecision<T>::get(const size3_t& pos) const {
+    const auto leaf = findLeaf(pos);
+    return leaf == none ? background_ : leaves_[leaf * leafVoxels + voxelIndex(pos)];
+}
+
+template <typename T>
+void VolumeSparsePrecision<T>::set(const size3_t& pos, const T& value) {
+    auto leaf = findLeaf(pos);
+    if (leaf == none) {
+        if (value == background_) return;
+        leaf = allocateLeaf(pos);
+    }
+    leaves_[leaf * leafVoxels + voxelIndex(pos)] = value;
+}
+
+template <typename T>
+const T& VolumeSparsePrecision<T>::getBackground() const {
+    return background_;
+}
+
+template <typename T>
+void VolumeSparsePrecision<T>::setFromDense(const T* data) {
+    setDimensions(dimensions_);
+
+    const auto isBackground = [&](const T& v) { return v == background_; };
+    const auto rowStart = [&](const size3_t& pos) {
+        return data + VolumeRAM::posToIndex(pos, dimensions_);
+    };
+
+    const size3_t leafDims = (dimensions_ + size3_t{leafSize - 1}) / leafSize;
+    for (size_t lz = 0; lz < leafDims.z; ++lz) {
+        for (size_t ly = 0; ly < leafDims.y; ++ly) {
+            for (size_t lx = 0; lx < leafDims.x; ++lx) {
+                const size3_t origin = size3_t{lx, ly, lz} * leafSize;
+                const size3_t extent = leafExtent(origin);
+
+                bool active = false;
+                for (size_t z = 0; z < extent.z && !active; ++z) {
+                    for (size_t y = 0; y < extent.y && !active; ++y) {
+                        const T* row = rowStart(origin + size3_t{0, y, z});
+                        active = !std::all_of(row, row + extent.x, isBackground);
+                    }
+                }
+                if (!active) continue;
+
+                const auto index = allocateLeaf(origin);
+                T* leaf = leaves_.data() + index * leafVoxels;
+                for (size_t z = 0; z < extent.z; ++z) {
+                    for (size_t y = 0; y < extent.y; ++y) {
+                        const T* row = rowStart(origin + size3_t{0, y, z});
+                        std::copy(row, row + extent.x, leaf + leafSize * (y + leafSize * z));
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+void VolumeSparsePrecision<T>::copyToDense(T* data) const {
+    std::fill(data, data + glm::compMul(dimensions_), background_);
+    forEachLeaf([&](const size3_t& origin, const T* leaf) {
+        const size3_t extent = leafExtent(origin);
+        for (size_t z = 0; z < extent.z; ++z) {
+            for (size_t y = 0; y < extent.y; ++y) {
+                const T* row = leaf + leafSize * (y + leafSize * z);
+                std::copy(row, row + extent.x,
+                          data + VolumeRAM::posToIndex(origin + size3_t{0, y, z}, dimensions_));
+            }
+        }
+    });
+}
+
+template <typename T>
+template <typename Callback>
+void VolumeSparsePrecision<T>::forEachLeaf(Callback callback) const {
+    for (size_t i = 0; i < leafOrigins_.size(); ++i) {
+        callback(leafOrigins_[i], leaves_.data() + i * leafVoxels);
+    }
+}
+
+template <typename T>
+template <typename Callback>
+void VolumeSparsePrecision<T>::forEachActiveVoxel(Callback callback) const {
+    forEachLeaf([&](const size3_t& origin, const T* leaf) {
+        const size3_t extent = leafExtent(origin);
+        for (size_t z = 0; z < extent.z; ++z) {
+            for (size_t y = 0; y < extent.y; ++y) {
+                const T* row = leaf + leafSize * (y + leafSize * z);
+                for (size_t x = 0; x < extent.x; ++x) {
+                    if (!(row[x] == background_)) callback(origin + size3_t{x, y, z}, row[x]);
+                }
+            }
+        }
+    });
+}
+
+template <typename T>
+const size3_t& VolumeSparsePrecision<T>::getDimensions() const {
+    return dimensions_;
+}
+
+template <typename T>
+void VolumeSparsePrecision<T>::setDimensions(size3_t dimensions) {
+    dimensions_ = dimensions;
+    rootDimensions_ = (dimensions_ + size3_t{leafSize * nodeSize - 1}) / (leafSize * nodeSize);
+    root_.assign(glm::compMul(rootDimensions_), none);
+    nodes_.clear();
+    leaves_.clear();
+    leafOrigins_.clear();
+}
+
+template <typename T>
+void VolumeSparsePrecision<T>::setSwizzleMask(const SwizzleMask& mask) {
+    swizzleMask_ = mask;
+}
+
+template <typename T>
+SwizzleMask VolumeSparsePrecision<T>::getSwizzleMask() const {
+    return swizzleMask_;
+}
+
+template <typename T>
+void VolumeSparsePrecision<T>::setInterpolation(InterpolationType interpolation) {
+    interpolation_ = interpolation;
+}
+
+template <typename T>
+InterpolationType VolumeSparsePrecision<T>::getInterpolation() const {
+    return interpolation_;
+}
+
+template <typename T>
+void VolumeSparsePrecision<T>::setWrapping(const Wrapping3D& wrapping) {
+    wrapping_ = wrapping;
+}
+
+template <typename T>
+Wrapping3D VolumeSparsePrecision<T>::getWrapping() const {
+    return wrapping_;
+}
+
+template <typename T>
+double VolumeSparsePrecision<T>::getAsDouble(const size3_t& pos) const {
+    return util::glm_convert<double>(get(pos));
+}
+
+template <typename T>
+dvec2 VolumeSparsePrecision<T>::getAsDVec2(const size3_t& pos) const {
+    return util::glm_convert<dvec2>(get(pos));
+}
+
+template <typename T>
+dvec3 VolumeSparsePrecision<T>::getAsDVec3(const size3_t& pos) const {
+    return util::glm_convert<dvec3>(get(pos));
+}
+
+template <typename T>
+dvec4 VolumeSparsePrecision<T>::getAsDVec4(const size3_t& pos) const {
+    return util::glm_convert<dvec4>(get(pos));
+}
+
+template <typename T>
+void VolumeSparsePrecision<T>::setFromDouble(const size3_t& pos, double val) {
+    set(pos, util::glm_convert<T>(val));
+}
+
+template <typename T>
+void VolumeSparsePrecision<T>::setFromDVec4(const size3_t& pos, dvec4 val) {
+    set(pos, util::glm_convert<T>(val));
+}
+
+template <typename T>
+dvec4 VolumeSparsePrecision<T>::getBackgroundAsDVec4() const {
+    return util::glm_convert<dvec4>(background_);
+}
+
+template <typename T>
+bool VolumeSparsePrecision<T>::isAllocated(const size3_t& pos) const {
+    return findLeaf(pos) != none;
+}
+
+template <typename T>
+size_t VolumeSparsePrecision<T>::getLeafCount() const {
+    return leafOrigins_.size();
+}
+
+template <typename T>
+size_t VolumeSparsePrecision<T>::getActiveVoxelCount() const {
+    size_t count = 0;
+    forEachActiveVoxel([&](const size3_t&, const T&) { ++count; });
+    return count;
+}
+
+template <typename T>
+size_t VolumeSparsePrecision<T>::getNumberOfBytes() const {
+    return root_.size() * sizeof(std::uint32_t) + nodes_.size() * sizeof(std::uint32_t) +
+           leaves_.size() * sizeof(T) + leafOrigins_.size() * sizeof(size3_t);
+}
+
+template <typename T>
+void VolumeSparsePrecision<T>::prune() {
+    std::vector<T> leaves;
+    std::vector<size3_t> origins;
+    root_.assign(root_.size(), none);
+    nodes_.clear();
+
+    for (size_t i = 0; i < leafOrigins_.size(); ++i) {
+        const auto begin = leaves_.begin() + i * leafVoxels;
+        if (std::all_of(begin, begin + leafVoxels, [&](const T& v) { return v == background_; })) {
+            continue;
+        }
+        leafSlot(leafOrigins_[i]) = static_cast<std::uint32_t>(origins.size());
+        origins.push_back(leafOrigins_[i]);
+        leaves.insert(leaves.end(), begin, begin + leafVoxels);
+    }
+    leaves_ = std::move(leaves);
+    leafOrigins_ = std::move(origins);
+}
+
+}  // namespace inviwo
@@ -80,6 +80,14 @@ public:
      */
     vec3 getColor(size_t id = 0) const;
 
+    /**
+     * The RGBA picking color to use for the object with local index id, needed when the picking
+     * index does not fit in 24 bits.
+     * This is eqvivalent to PickingManager::indexToRGBA(getPickingId(id))/255.0
+     * \param id the local picking index
+     */
+    vec4 getColorRGBA(size_t id = 0) const;
+
     /**
      *	The number of picking indices in this picking object.
      */
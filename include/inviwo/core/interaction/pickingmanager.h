@@ -34,12 +34,28 @@
 #include <inviwo/core/util/callback.h>
 #include <inviwo/core/interaction/pickingaction.h>
 
+#include <map>
+#include <optional>
+#include <unordered_map>
+
 namespace inviwo {
 
 class PickingEvent;
 
 /** \class PickingManager
  * Manager for picking objects.
+ *
+ * Picking indices are handed out in contiguous ranges, one per PickingAction. Registration reuses
+ * the smallest unregistered action with enough capacity, and the index lookup uses a table over
+ * blocks of indices to only search the few actions that overlap the block of the index.
+ *
+ * The first 2^24 indices fit in the RGB channels of a picking color (see indexToColor), larger
+ * indices also need the alpha channel (see indexToRGBA), up to maxIndex. Indices from 0xFF000000
+ * and up would need an alpha of 0, which is reserved for "no picking", and can not be represented.
+ * Registering actions beyond maxIndex logs a warning and those indices will never be picked.
+ *
+ * Renderers writing RGBA picking colors must not blend the picking buffer since that changes the
+ * alpha channel and with it the index, see utilgl::PickingBlendState.
  */
 class IVW_CORE_API PickingManager : public Singleton<PickingManager> {
 public:
@@ -68,21 +84,56 @@ public:
     bool unregisterPickingAction(const PickingAction*);
     bool pickingEnabled();
 
+    /**
+     * The largest picking index that can be represented by an RGBA8 picking color, i.e.
+     * 0xFEFFFFFF. The indices above would map to an alpha of 0 which means "no picking".
+     */
+    static constexpr size_t maxIndex = 255 * (size_t{1} << 24) - 1;
+    /**
+     * The largest picking index that can be represented by an RGB picking color, i.e. by
+     * PickingAction::getColor.
+     */
+    static constexpr size_t maxRGBIndex = (size_t{1} << 24) - 1;
+
+    /**
+     * Encode the lower 24 bits of \p index as an RGB color.
+     */
     static uvec3 indexToColor(size_t index);
     static size_t colorToIndex(uvec3 color);
 
+    /**
+     * Encode \p index as an RGBA color. The RGB channels are the same as for indexToColor and
+     * the alpha channel holds 255 minus the upper bits, i.e. an alpha of 255 is compatible with
+     * the RGB encoding and an alpha of 0 means no picking. \p index has to be at most maxIndex.
+     */
+    static uvec4 indexToRGBA(size_t index);
+    static size_t colorToIndex(uvec4 color);
+
     Result getPickingActionFromColor(const uvec3& color);
     Result getPickingActionFromIndex(size_t index);
 
     bool isPickingActionRegistered(const PickingAction* action) const;
 
 private:
+    using UnusedObjects = std::multimap<size_t, PickingAction*>;
+    struct Slot {
+        size_t position;                               //< Position in pickingActions_
+        std::optional<UnusedObjects::iterator> unused;  //< Entry in unusedObjects_ if unused
+    };
+    void removeLastAction();
+
+    // Number of bits of the picking index used to select an entry in blockLookup_
+    static constexpr size_t blockBits = 10;
+
     // start indexing at 1, 0 maps to black {0,0,0} and indicated no picking.
     size_t lastIndex_ = 1;
-    // pickingObjects_ should be sorted on the start index.
+    // pickingActions_ is sorted on the start index, actions are only added or removed at the end.
     std::vector<std::unique_ptr<PickingAction>> pickingActions_;
-    // unusedObjects_ should be sorted on capacity.
-    std::vector<PickingAction*> unusedObjects_;
+    // unregistered picking actions ordered by capacity.
+    UnusedObjects unusedObjects_;
+    std::unordered_map<const PickingAction*, Slot> slots_;
+    // position of the first picking action overlapping each block of 2^blockBits indices.
+    std::vector<size_t> blockLookup_;
 
     bool enabled_ = false;
     const BaseCallBack* enableCallback_ = nullptr;
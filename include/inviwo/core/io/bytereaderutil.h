@@ -34,10 +34,40 @@
 
 namespace inviwo {
 
+class DataFormatBase;
+
 namespace util {
 
-void IVW_CORE_API readBytesIntoBuffer(const std::string& file, size_t offset, size_t bytes,
+/**
+ * Reverse the byte order of each element of size \p elementSize in \p data.
+ * \p bytes has to be a multiple of \p elementSize.
+ */
+IVW_CORE_API void swapBytes(void* data, size_t bytes, size_t elementSize);
+
+/**
+ * Read \p bytes bytes starting at \p offset in \p file into \p dest. If the data is big endian
+ * the byte order of each element of size \p elementSize is reversed. Note that \p elementSize
+ * is the size of a single component, i.e. 4 for a vec3 of floats.
+ * The file is read in chunks and the byte swapping of one chunk is done on the thread pool while
+ * the next chunk is read.
+ * @throws DataReaderException if the file could not be read.
+ */
+IVW_CORE_API void readBytesIntoBuffer(const std::string& file, size_t offset, size_t bytes,
                                       bool littleEndian, size_t elementSize, void* dest);
+
+/**
+ * Read \p count elements of format \p srcFormat starting at \p offset in \p file and convert
+ * them to \p dstFormat into \p dest. Each component is converted using a static_cast, no
+ * normalization is applied. \p dest has to have room for \p count elements of \p dstFormat.
+ * The file is read in chunks, byte swapping and conversion of one chunk is done on the thread
+ * pool while the next chunk is read.
+ * @throws DataReaderException if the file could not be read or if the number of components of
+ * the two formats differ.
+ */
+IVW_CORE_API void readBytesIntoBuffer(const std::string& file, size_t offset, size_t count,
+                                      bool littleEndian, const DataFormatBase* srcFormat,
+                                      const DataFormatBase* dstFormat, void* dest);
+
 }  // namespace util
 
 }  // namespace inviwo
@@ -0,0 +1,163 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/network/processornetworkobserver.h>
+#include <inviwo/core/network/processornetworkevaluationobserver.h>
+#include <inviwo/core/processors/processorobserver.h>
+#include <inviwo/core/util/timer.h>
+
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+namespace inviwo {
+
+class Processor;
+class ProcessorNetwork;
+class ProcessorNetworkEvaluator;
+
+/**
+ * \ingroup network
+ * Keeps the network responsive while the user interacts with it. The scheduler measures the
+ * process() time of every processor in the network. While the user is interacting, i.e. until
+ * the idle delay has passed since the last call to interact(), processors that support a preview
+ * (Processor::isPreviewSupported) are switched to preview mode, the most expensive first, until
+ * the expected evaluation time of the network fits the frame time budget. Once the interaction
+ * has ended all processors in preview mode are switched back to full quality and invalidated.
+ *
+ * The modes are only changed after an evaluation, the evaluation that revealed that the network
+ * is too slow is not repeated. Within one interaction processors are only switched to preview
+ * mode, never back, to avoid alternating between the two.
+ *
+ * Canvas events and property changes made outside of the network evaluation count as
+ * interaction.
+ * @see Processor::isPreview
+ */
+class IVW_CORE_API EvaluationScheduler : public ProcessorNetworkObserver,
+                                         public ProcessorObserver,
+                                         public ProcessorNetworkEvaluationObserver {
+public:
+    using clock_t = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::milliseconds;
+    using Duration = std::chrono::duration<double, std::milli>;
+
+    /**
+     * Moving averages of the process() time of a processor, in full quality and in preview mode.
+     */
+    struct Timing {
+        Duration full{0};
+        Duration preview{0};
+        size_t fullCount = 0;
+        size_t previewCount = 0;
+    };
+
+    EvaluationScheduler(ProcessorNetwork* network, ProcessorNetworkEvaluator* evaluator,
+                        TimerThread& timerThread = util::getDefaultTimerThread());
+    EvaluationScheduler(const EvaluationScheduler&) = delete;
+    EvaluationScheduler& operator=(const EvaluationScheduler&) = delete;
+    virtual ~EvaluationScheduler();
+
+    /**
+     * Enable or disable preview modes, disabling switches all processors back to full quality.
+     * The timings are recorded in either case.
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    void setFrameTimeBudget(Milliseconds budget);
+    Milliseconds getFrameTimeBudget() const;
+
+    /**
+     * The time without interaction after which the interaction is considered to be over.
+     */
+    void setIdleDelay(Milliseconds delay);
+    Milliseconds getIdleDelay() const;
+
+    /**
+     * Signal that the user is interacting with the network, e.g. dragging in a canvas.
+     */
+    void interact();
+    bool isInteracting() const;
+
+    /**
+     * The recorded process() times of \p processor, or nullptr if it has not been processed.
+     */
+    const Timing* getTiming(const Processor* processor) const;
+    /**
+     * The wall time of the last network evaluation.
+     */
+    Duration getLastEvaluationTime() const;
+
+private:
+    // ProcessorNetworkObserver overrides
+    virtual void onProcessorNetworkDidAddProcessor(Processor* processor) override;
+    virtual void onProcessorNetworkWillRemoveProcessor(Processor* processor) override;
+
+    // ProcessorObserver overrides
+    virtual void onAboutPropertyChange(Property*) override;
+    virtual void onProcessorAboutToProcess(Processor*) override;
+    virtual void onProcessorFinishedProcess(Processor*) override;
+
+    // ProcessorNetworkEvaluationObserver overrides
+    virtual void onProcessorNetworkEvaluationBegin() override;
+    virtual void onProcessorNetworkEvaluationEnd() override;
+
+    /**
+     * Switch processors processed in the last evaluation to preview mode until the expected
+     * evaluation time fits the budget.
+     */
+    void updatePreviews();
+    /**
+     * End the interaction, switch all processors back to full quality and invalidate them.
+     */
+    void endInteraction();
+
+    struct Entry {
+        Timing timing;
+        clock_t::time_point start;
+    };
+
+    ProcessorNetwork* network_;
+    ProcessorNetworkEvaluator* evaluator_;
+    bool enabled_;
+    bool interacting_;
+    bool evaluating_;
+    Milliseconds budget_;
+    std::unordered_map<const Processor*, Entry> entries_;
+    std::vector<Processor*> processed_;  //< processors processed in the last evaluation
+    std::vector<Processor*> previews_;   //< processors switched to preview mode
+    clock_t::time_point evaluationStart_;
+    Duration lastEvaluationTime_;
+    Delay idle_;
+};
+
+}  // namespace inviwo
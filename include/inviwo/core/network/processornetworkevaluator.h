@@ -34,6 +34,12 @@
 #include <inviwo/core/processors/processorobserver.h>
 #include <inviwo/core/network/processornetworkevaluationobserver.h>
 #include <inviwo/core/network/evaluationerrorhandler.h>
+#include <inviwo/core/network/portconnection.h>
+#include <inviwo/core/util/allocationcounter.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace inviwo {
 
@@ -50,6 +56,13 @@ public:
     virtual ~ProcessorNetworkEvaluator() = default;
     void setExceptionHandler(EvaluationErrorHandler handler);
 
+    /**
+     * The heap allocations made during the last evaluation of the network, including the ones
+     * made by the processors. Only counted if util::isAllocationCountingEnabled(). The
+     * evaluation itself does not allocate as long as the network topology is unchanged.
+     */
+    const util::AllocationStats& getLastEvaluationAllocations() const;
+
 private:
     // ProcessorNetworkObserver overrides
     virtual void onProcessorNetworkEvaluateRequest() override;
@@ -60,17 +73,59 @@ private:
     virtual void onProcessorNetworkDidRemoveConnection(const PortConnection& connection) override;
 
     // ProcessorObserver overrides
+    virtual void onProcessorInvalidationEnd(Processor*) override;
     virtual void onProcessorSinkChanged(Processor*) override;
     virtual void onProcessorActiveConnectionsChanged(Processor*) override;
 
     void requestEvaluate();
+    /**
+     * Evaluate the invalid processors that are connected to a sink in topological order. Instead
+     * of visiting every processor, only the processors in dirty_ are considered. Sinks that are not
+     * currently demanded, e.g. hidden canvases, report isSink() == false, which excludes all
+     * processors only upstream of them.
+     */
     void evaluate();
+    void evaluateProcessor(Processor* processor);
+    void markDirty(Processor* processor);
+
+    /**
+     * Apply all network changes since the last update to the processor order. Added connections
+     * are inserted incrementally into the existing order, a full sort is only done for large
+     * batches of changes, e.g. when loading a workspace while the network is locked.
+     */
+    void updateProcessorOrder();
+    /**
+     * Reorder processorOrder_ such that \p src comes before \p dst, only the processors between
+     * the two are affected (Pearce-Kelly). Returns false if the edge would introduce a cycle.
+     */
+    bool insertEdge(Processor* src, Processor* dst);
+    void sortAll();
 
     ProcessorNetwork* processorNetwork_;
-    // the sorted list of processors obtained through topological sorting
-    std::vector<Processor*> processorsSorted_;
+    // topological order of all processors, removed processors are set to nullptr until the next
+    // update of the order
+    std::vector<Processor*> processorOrder_;
+    std::unordered_map<Processor*, size_t> orderIndex_;
+    // changes not yet applied to processorOrder_
+    std::vector<PortConnection> addedConnections_;
+    std::vector<Processor*> activeConnectionsChanged_;
+    bool orderModified_;
+    bool fullSortNeeded_;
+    // the processors that are connected to a sink
+    std::unordered_set<Processor*> demanded_;
+    // processors that have been invalidated and not yet successfully processed, in the order they
+    // were invalidated. isDirty_ holds the same processors to keep dirty_ free of duplicates while
+    // the network is locked. Vectors are used for dirty_ and evaluationQueue_ to reuse their
+    // memory between evaluations.
+    std::vector<Processor*> dirty_;
+    std::unordered_set<Processor*> isDirty_;
+    // min-heap of the order indices of the processors left to process in the current evaluation
+    std::vector<size_t> evaluationQueue_;
+    bool evaluating_;
+    size_t evaluationPosition_;
     bool evaulationQueued_;
     EvaluationErrorHandler exceptionHandler_;
+    util::AllocationStats lastEvaluationAllocations_;
 };
 
 }  // namespace inviwo
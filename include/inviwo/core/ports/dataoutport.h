@@ -126,7 +126,7 @@ std::shared_ptr<const T> DataOutport<T>::getData() const {
 
 template <typename T>
 void DataOutport<T>::setData(std::shared_ptr<const T> data) {
-    data_ = data;
+    data_ = std::move(data);
     isReady_.update();
 }
 
@@ -147,7 +147,7 @@ std::shared_ptr<const T> DataOutport<T>::detachData() {
 template <typename T>
 template <typename, typename>
 void DataOutport<T>::setData(T&& data) {
-    setData(std::make_shared<T>(data));
+    setData(std::make_shared<T>(std::move(data)));
 }
 
 template <typename T>
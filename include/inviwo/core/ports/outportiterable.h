@@ -34,6 +34,8 @@
 
 #include <vector>
 #include <memory>
+#include <new>
+#include <type_traits>
 
 namespace inviwo {
 
@@ -57,18 +59,25 @@ struct OutportIterable {
         using reference = std::shared_ptr<const T>;
         using iterator_category = std::forward_iterator_tag;
 
-        const_iterator() : self_(nullptr){};
+        const_iterator() = default;
         template <typename Wrapper>
-        const_iterator(Wrapper wrapper) : self_(std::make_unique<Model<Wrapper>>(wrapper)) {}
-        const_iterator(const const_iterator& rhs)
-            : self_(rhs.self_ ? rhs.self_->clone() : nullptr) {}
+        const_iterator(Wrapper wrapper) {
+            if constexpr (fitsInBuffer<Model<Wrapper>>()) {
+                self_ = new (&buffer_) Model<Wrapper>(std::move(wrapper));
+                local_ = true;
+            } else {
+                self_ = new Model<Wrapper>(std::move(wrapper));
+            }
+        }
+        const_iterator(const const_iterator& rhs) { copyFrom(rhs); }
         const_iterator& operator=(const const_iterator& that) {
             if (this != &that) {
-                std::unique_ptr<Concept> s(that.self_ ? that.self_->clone() : nullptr);
-                std::swap(s, self_);
+                reset();
+                copyFrom(that);
             }
             return *this;
         }
+        ~const_iterator() { reset(); }
 
         const_iterator& operator++() {
             self_->inc();
@@ -99,7 +108,8 @@ struct OutportIterable {
     private:
         struct Concept {
             virtual ~Concept() = default;
-            virtual Concept* clone() = 0;
+            // Copy into buffer if it fits, otherwise allocate
+            virtual Concept* clone(void* buffer) const = 0;
             virtual void inc() = 0;
             virtual std::shared_ptr<const T> get() = 0;
             virtual bool equal(const Concept& that) const = 0;
@@ -109,9 +119,14 @@ struct OutportIterable {
         template <typename U>
         class Model : public Concept {
         public:
-            Model(U data) : data_(data) {}
-
-            virtual Model<U>* clone() override { return new Model<U>(*this); };
+            Model(U data) : data_(std::move(data)) {}
+            virtual Concept* clone(void* buffer) const override {
+                if constexpr (fitsInBuffer<Model<U>>()) {
+                    return new (buffer) Model<U>(*this);
+                } else {
+                    return new Model<U>(*this);
+                }
+            };
             virtual void inc() override { data_.inc(); };
             virtual std::shared_ptr<const T> get() override { return data_.get(); };
             virtual bool equal(const Concept& that) const override {
@@ -123,7 +138,36 @@ struct OutportIterable {
             U data_;
         };
 
-        std::unique_ptr<Concept> self_;
+        // Iterators are created for every access of the data of flat inports, the wrappers are
+        // stored inline to avoid allocating for each of them
+        static constexpr size_t bufferSize = 8 * sizeof(void*);
+        using Buffer = std::aligned_storage_t<bufferSize, alignof(std::max_align_t)>;
+
+        template <typename M>
+        static constexpr bool fitsInBuffer() {
+            return sizeof(M) <= sizeof(Buffer) && alignof(M) <= alignof(Buffer) &&
+                   std::is_nothrow_copy_constructible_v<M>;
+        }
+
+        void copyFrom(const const_iterator& rhs) {
+            if (rhs.self_) {
+                self_ = rhs.self_->clone(&buffer_);
+                local_ = rhs.local_;
+            }
+        }
+        void reset() {
+            if (local_) {
+                self_->~Concept();
+            } else {
+                delete self_;
+            }
+            self_ = nullptr;
+            local_ = false;
+        }
+
+        Buffer buffer_;
+        Concept* self_ = nullptr;
+        bool local_ = false;
     };
 
     virtual const_iterator begin() const = 0;
@@ -42,11 +42,15 @@
 #include <inviwo/core/metadata/processorwidgetmetadata.h>
 #include <inviwo/core/util/fileextension.h>
 #include <inviwo/core/network/networkvisitor.h>
+#include <inviwo/core/util/timer.h>
+
+#include <chrono>
 
 namespace inviwo {
 
 class Canvas;
 class CanvasProcessorWidget;
+class ResizeEvent;
 class ProcessorNetworkEvaluator;
 template <typename T>
 class DataWriterType;
@@ -106,6 +110,8 @@ public:
     IntSize2Property customInputDimensions_;
     BoolProperty keepAspectRatio_;
     FloatProperty aspectRatioScaling_;
+    BoolProperty progressiveResize_;
+    FloatProperty progressiveResizeScale_;
     IntVec2Property position_;
     TemplateOptionProperty<LayerType> visibleLayer_;
     IntProperty colorLayer_;
@@ -123,8 +129,17 @@ public:
 private:
     void sizeChanged();
     size2_t calcSize();
+    /**
+     * While the canvas is continuously resized, request images at a reduced resolution and
+     * schedule a full resolution request once the resizing has settled.
+     * @return true if the resize event was handled
+     */
+    bool progressiveResize(const ResizeEvent& resizeEvent);
 
     size2_t previousImageSize_;
+    size2_t progressiveSize_;
+    std::chrono::steady_clock::time_point lastResize_;
+    Delay progressiveResizeDelay_;
     ProcessorWidgetMetaData* widgetMetaData_;
 };
 
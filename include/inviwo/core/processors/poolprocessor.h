@@ -37,11 +37,18 @@
 #include <inviwo/core/processors/progressbarowner.h>
 #include <inviwo/core/util/timer.h>
 #include <inviwo/core/util/assertion.h>
+#include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/rendercontext.h>
+#include <inviwo/core/util/threadarena.h>
 #include <inviwo/core/network/processornetwork.h>
 
 #include <atomic>
 #include <chrono>
+#include <functional>
+#include <list>
+#include <map>
+#include <optional>
+#include <vector>
 
 namespace inviwo {
 
@@ -58,6 +65,9 @@ struct StateTemplate;
 
 }  // namespace detail
 
+template <typename Key, typename Result>
+class SpeculativeCache;
+
 /**
  * A class to signal if a background calculation should stop or be aborted.
  * Generally used by the background jobs to abort a calculation early:
@@ -170,6 +180,8 @@ public:
      *     * pool::Progress a callback to report progress of the calculation. The progress is
      *       represented as a float in the interval [0.0, 1.0].
      * If the job takes a progress callback the processor will show a progress bar.
+     * Temporary data in the job can be allocated from Processor::scratchMemory(), the arena of
+     * the worker thread is released when the job returns, so the result must not refer to it.
      * The second functor done is called with the result when the background job is finished. It
      * will be executed on the main thread, and only if the processor is still valid and the job has
      * not been stopped. Hence it is safe to refer to the processor in this functor.
@@ -203,7 +215,8 @@ public:
      *       represented as a float in the interval [0.0, 1.0]. The progress is automatically
      *       normalized across all the jobs
      * If the jobs takes a progress callback the processor will show a progress bar. The progress
-     * from all the jobs will automatically be merged and normalized
+     * from all the jobs will automatically be merged and normalized. As for dispatchOne each job
+     * runs within a scope of the arena returned by Processor::scratchMemory().
      *
      * The second functor 'done' is called with the results when the background jobs are finished.
      * It will be executed on the main thread, and only if the processor is still valid and the jobs
@@ -228,6 +241,37 @@ public:
     template <typename Job, typename Done>
     void dispatchMany(std::vector<Job> jobs, Done&& done);
 
+    /**
+     * Dispatch a job for \p key and precompute the results for \p neighbours, the keys that are
+     * likely to be requested next, e.g. the adjacent slices or timesteps. If the result for \p key
+     * is in \p cache, done is called directly with it and no job is dispatched. If a speculative
+     * job for \p key is already running, done is called with its result instead of computing it
+     * again. Otherwise the job created by `makeJob(key)` is dispatched as by dispatchOne and its
+     * result is added to the cache. Afterwards, jobs for the neighbours that are not yet cached are
+     * submitted to the idle threads of the thread pool, one per idle thread at most, and their
+     * results are only added to the cache. Errors in these speculative jobs are ignored, a request
+     * waiting for a failed speculative job dispatches the job again.
+     *
+     * The cache has to outlive the jobs, i.e. be a member of the processor, and has to be cleared
+     * whenever the results depend on anything else than the key.
+     *
+     * \code{.cpp}
+     * const auto makeJob = [volume = inport_.getData()](size_t slice) {
+     *     return [volume, slice](pool::Stop stop) { return extractSlice(volume, slice, stop); };
+     * };
+     * dispatchSpeculative(cache_, slice, {slice + 1, slice - 1}, makeJob,
+     *                     [this](std::shared_ptr<const Image> result) {
+     *                         outport_.setData(result);
+     *                         newResults();
+     *                     });
+     * \endcode
+     * \see pool::SpeculativeCache
+     */
+    template <typename Key, typename Result, typename MakeJob, typename Done>
+    void dispatchSpeculative(pool::SpeculativeCache<Key, Result>& cache,
+                             const typename pool::SpeculativeCache<Key, Result>::key_type& key,
+                             const std::vector<Key>& neighbours, MakeJob makeJob, Done&& done);
+
     /**
      * handleError is called on the main thread whenever there has be an error in a background
      * calculation this will by default just log the error message, and clear any outports. Deriving
@@ -307,6 +351,10 @@ private:
     static void callDone(InviwoApplication* app,
                          std::shared_ptr<pool::detail::StateTemplate<Result, Done>> state);
 
+    template <typename Key, typename Result, typename MakeJob>
+    void speculate(pool::SpeculativeCache<Key, Result>& cache, const std::vector<Key>& keys,
+                   const MakeJob& makeJob);
+
     pool::Options options_;
     std::vector<std::shared_ptr<pool::detail::State>> states_;
     util::OnScopeExit notifyRemainingJobsFinish_;
@@ -373,6 +421,157 @@ struct JobTraits {
 
 }  // namespace pool::detail
 
+namespace pool {
+
+/**
+ * Statistics of a pool::SpeculativeCache
+ */
+struct CacheStats {
+    size_t hits = 0;          ///< Requests served from the cache
+    size_t misses = 0;        ///< Requests that had to be computed
+    size_t speculations = 0;  ///< Speculative jobs submitted
+    size_t evictions = 0;     ///< Results removed to stay within the memory cap
+    size_t memory = 0;        ///< Estimated memory used by the cached results in bytes
+
+    double hitRate() const {
+        const auto requests = hits + misses;
+        return requests == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(requests);
+    }
+};
+
+/**
+ * A cache of the results of a PoolProcessor for different values of a key, e.g. a slice index,
+ * a timestep, or an iso value, filled by PoolProcessor::dispatchSpeculative. The least recently
+ * used results are evicted when the estimated memory use exceeds the memory cap, the size of a
+ * result is estimated by the given function. Should only be used from the main thread.
+ * \see PoolProcessor::dispatchSpeculative
+ */
+template <typename Key, typename Result>
+class SpeculativeCache {
+public:
+    using key_type = Key;
+    using result_type = Result;
+    using SizeFunction = std::function<size_t(const Result&)>;
+
+    /**
+     * @param memoryCap maximum estimated size of all cached results in bytes
+     * @param sizeOf estimates the size of a result in bytes
+     */
+    SpeculativeCache(size_t memoryCap, SizeFunction sizeOf)
+        : memoryCap_{memoryCap}, sizeOf_{std::move(sizeOf)} {}
+    SpeculativeCache(const SpeculativeCache&) = delete;
+    SpeculativeCache& operator=(const SpeculativeCache&) = delete;
+    ~SpeculativeCache() { clear(); }
+
+    /**
+     * Look up the result for \p key, counted as a hit or a miss.
+     * @return a pointer to the result or nullptr, valid until the cache is modified
+     */
+    const Result* find(const Key& key) {
+        const auto it = items_.find(key);
+        if (it == items_.end()) {
+            ++stats_.misses;
+            return nullptr;
+        }
+        ++stats_.hits;
+        lru_.splice(lru_.begin(), lru_, it->second.lru);
+        return &it->second.result;
+    }
+
+    bool contains(const Key& key) const { return items_.count(key) != 0; }
+    bool isPending(const Key& key) const { return pending_.count(key) != 0; }
+    size_t size() const { return items_.size(); }
+
+    /**
+     * Add \p result for \p key, results larger than the memory cap are not cached.
+     */
+    void insert(const Key& key, Result result) {
+        erase(key);
+        const auto size = sizeOf_(result);
+        if (size > memoryCap_) return;
+        lru_.push_front(key);
+        items_.emplace(key, Item{std::move(result), size, lru_.begin()});
+        stats_.memory += size;
+        evict();
+    }
+
+    /**
+     * Remove all results and stop the speculative jobs that are still running. Call this
+     * whenever the results would change for reasons other than the key, like new input data.
+     */
+    void clear() {
+        for (auto& item : pending_) item.second->stop = true;
+        pending_.clear();
+        waiter_.reset();
+        items_.clear();
+        lru_.clear();
+        stats_.memory = 0;
+        ++generation_;
+    }
+
+    void setMemoryCap(size_t memoryCap) {
+        memoryCap_ = memoryCap;
+        evict();
+    }
+    size_t getMemoryCap() const { return memoryCap_; }
+
+    const CacheStats& getStats() const { return stats_; }
+    void resetStats() { stats_ = CacheStats{0, 0, 0, 0, stats_.memory}; }
+
+private:
+    friend PoolProcessor;
+
+    struct Item {
+        Result result;
+        size_t size;
+        typename std::list<Key>::iterator lru;
+    };
+
+    /**
+     * A request for a key that is computed by a speculative job. Only the latest request is kept,
+     * busy signals the background work of the processor while waiting.
+     */
+    struct Waiter {
+        Key key;
+        std::function<void(Result)> done;
+        std::function<void()> retry;
+        util::OnScopeExit busy;
+    };
+
+    std::optional<Waiter> takeWaiter(const Key& key) {
+        if (!waiter_ || waiter_->key != key) return std::nullopt;
+        std::optional<Waiter> waiter{std::move(waiter_)};
+        waiter_.reset();
+        return waiter;
+    }
+
+    void erase(const Key& key) {
+        const auto it = items_.find(key);
+        if (it == items_.end()) return;
+        stats_.memory -= it->second.size;
+        lru_.erase(it->second.lru);
+        items_.erase(it);
+    }
+
+    void evict() {
+        while (stats_.memory > memoryCap_ && !lru_.empty()) {
+            erase(lru_.back());
+            ++stats_.evictions;
+        }
+    }
+
+    size_t memoryCap_;
+    SizeFunction sizeOf_;
+    std::map<Key, Item> items_;
+    std::list<Key> lru_;  ///< most recently used first
+    std::map<Key, std::shared_ptr<detail::State>> pending_;
+    std::optional<Waiter> waiter_;
+    size_t generation_ = 0;  ///< incremented by clear to discard the results of older jobs
+    CacheStats stats_;
+};
+
+}  // namespace pool
+
 template <typename Result, typename Done>
 inline void PoolProcessor::callDone(
     InviwoApplication* app, std::shared_ptr<pool::detail::StateTemplate<Result, Done>> state) {
@@ -452,6 +651,7 @@ void PoolProcessor::dispatchMany(std::vector<Job> jobs, Done&& done) {
             if (!state->stop) {
                 // This code will run in a background thread, make sure the local context is active
                 RenderContext::getPtr()->activateLocalRenderContext();
+                util::ArenaScope arena;
                 (*task)();
             }
             callDone(app, state);
@@ -500,6 +700,7 @@ void PoolProcessor::dispatchOne(Job&& job, Done&& done) {
                    {[state, task, app]() {
                        if (!state->stop) {
                            RenderContext::getPtr()->activateLocalRenderContext();
+                           util::ArenaScope arena;
                            (*task)();
                        }
                        callDone(app, state);
@@ -525,6 +726,110 @@ void PoolProcessor::dispatchOne(Job&& job, Done&& done) {
     }
 }
 
+template <typename Key, typename Result, typename MakeJob, typename Done>
+void PoolProcessor::dispatchSpeculative(
+    pool::SpeculativeCache<Key, Result>& cache,
+    const typename pool::SpeculativeCache<Key, Result>::key_type& key,
+    const std::vector<Key>& neighbours, MakeJob makeJob, Done&& done) {
+    using Job = std::invoke_result_t<MakeJob, Key>;
+    static_assert(std::is_same_v<typename pool::detail::JobTraits<Job>::Result, Result>,
+                  "The jobs should return the result type of the cache");
+
+    if (const auto result = cache.find(key)) {
+        // Results of older jobs would replace the cached one
+        stopJobs();
+        queue_.clear();
+        cache.waiter_.reset();
+        done(*result);
+        speculate(cache, neighbours, makeJob);
+        return;
+    }
+
+    auto deliver = std::make_shared<std::function<void(Result)>>(
+        [this, &cache, neighbours, makeJob, done = std::forward<Done>(done)](Result result) {
+            done(std::move(result));
+            speculate(cache, neighbours, makeJob);
+        });
+    const auto dispatch = [this, &cache, key, makeJob, deliver]() {
+        dispatchOne(makeJob(key), [&cache, key, deliver](Result result) {
+            cache.insert(key, result);
+            (*deliver)(std::move(result));
+        });
+    };
+
+    if (cache.isPending(key)) {
+        // Attach to the running speculative job instead of computing the same result again
+        stopJobs();
+        queue_.clear();
+        notifyObserversStartBackgroundWork(this, 1);
+        cache.waiter_.emplace(typename pool::SpeculativeCache<Key, Result>::Waiter{
+            key, [deliver](Result result) { (*deliver)(std::move(result)); }, dispatch,
+            util::OnScopeExit{[this]() { notifyObserversFinishBackgroundWork(this, 1); }}});
+        return;
+    }
+
+    cache.waiter_.reset();
+    dispatch();
+}
+
+template <typename Key, typename Result, typename MakeJob>
+void PoolProcessor::speculate(pool::SpeculativeCache<Key, Result>& cache,
+                              const std::vector<Key>& keys, const MakeJob& makeJob) {
+    auto app = getNetwork()->getApplication();
+    auto& threadPool = app->getThreadPool();
+    // Only use idle threads, speculation should never delay other work
+    size_t idle = threadPool.getIdleCount();
+
+    for (const auto& key : keys) {
+        if (idle == 0) break;
+        if (cache.contains(key) || cache.isPending(key)) continue;
+
+        auto state = std::make_shared<pool::detail::State>(wrapper_, 1);
+        auto task = makeTask<Result>(makeJob(key), state->getStop(), state->getProgress(0));
+        auto result = task->get_future().share();
+        cache.pending_[key] = state;
+        ++cache.stats_.speculations;
+        --idle;
+
+        threadPool.enqueueRaw([state, task, result, app, &cache, key,
+                               generation = cache.generation_]() {
+            if (!state->stop) {
+                RenderContext::getPtr()->activateLocalRenderContext();
+                util::ArenaScope arena;
+                (*task)();
+            }
+            app->dispatchFrontAndForget([state, result, &cache, key, generation]() {
+                // The cache is owned by the processor, only touch it if it still exists
+                const auto wrapper = state->processor.lock();
+                if (!wrapper || generation != cache.generation_) return;
+                cache.pending_.erase(key);
+                auto waiter = cache.takeWaiter(key);
+                if (state->stop) return;
+
+                std::optional<Result> value;
+                try {
+                    value = result.get();
+                } catch (...) {
+                    // Speculative results are optional, the job is run again if requested
+                }
+                if (!value) {
+                    if (waiter) waiter->retry();
+                    return;
+                }
+                cache.insert(key, *value);
+                if (waiter) {
+                    RenderContext::getPtr()->activateDefaultRenderContext();
+                    try {
+                        waiter->done(std::move(*value));
+                    } catch (...) {
+                        wrapper->processor.handleError();
+                    }
+                }
+            });
+        });
+    }
+}
+
 template <typename Job>
 inline void PoolProcessor::setupProgress() {
     updateProgress(0.0f);
@@ -40,6 +40,7 @@
 #include <inviwo/core/processors/processortags.h>
 #include <inviwo/core/util/statecoordinator.h>
 #include <inviwo/core/util/dispatcher.h>
+#include <inviwo/core/util/threadarena.h>
 
 namespace inviwo {
 
@@ -270,7 +271,8 @@ public:
      * Returns whether the processor is a sink. I.e. whether it pulls data from the network.
      * By default a processor is a sink if it has no outports. This behavior can be customized by
      * setting the isSink_ update functor. For a processor to be evaluated there have to be a sink
-     * among its descendants.
+     * among its descendants. A sink whose output is currently not needed, like a hidden canvas,
+     * should return false here, then the processors only feeding that sink are not evaluated.
      * @see StateCoordinator
      */
     bool isSink() const;
@@ -294,6 +296,19 @@ public:
      */
     virtual void process() {}
 
+    /**
+     * Memory resource for temporary data used within process(). Allocations are served from a
+     * per-thread arena that is released in bulk once process() returns, which avoids contention
+     * in the global allocator when many processors run at once. In a PoolProcessor background
+     * job the arena of the worker thread is used, and it is released when the job finishes.
+     * Containers using the arena must not outlive the call they were created in.
+     * ```{.cpp}
+     * std::pmr::vector<vec3> positions{scratchMemory()};
+     * ```
+     * @see util::ArenaScope
+     */
+    static std::pmr::memory_resource* scratchMemory() { return util::threadArena(); }
+
     /**
      * This function is called by the ProcessorNetworkEvaluator when the network is evaluated and
      * the processor is neither ready or valid.
@@ -301,6 +316,29 @@ public:
      */
     virtual void doIfNotReady() {}
 
+    /**
+     * Returns whether process() can produce a cheaper preview of its result, e.g. by using a lower
+     * sampling rate or a subsampled input.
+     * @see setPreviewSupported
+     * @see isPreview
+     */
+    bool isPreviewSupported() const;
+
+    /**
+     * Returns whether process() should produce a preview instead of the full quality result. The
+     * EvaluationScheduler switches processors that support it to preview mode while the user
+     * is interacting and the network does not fit the frame time budget, and back to full
+     * quality once the interaction has ended.
+     * @see EvaluationScheduler
+     */
+    bool isPreview() const;
+
+    /**
+     * Switch between preview and full quality. Ignored if the processor does not support
+     * previews. The processor is not invalidated, that is left to the caller.
+     */
+    void setPreview(bool preview);
+
     /**
      * Called by the network after Processor::process has been called.
      * This will set the following to valid
@@ -440,6 +478,12 @@ protected:
      */
     void removePortFromGroups(Port* port);
 
+    /**
+     * Declare that process() can produce a preview, should be called in the constructor.
+     * @see isPreview
+     */
+    void setPreviewSupported(bool supported);
+
 private:
     void addPortInternal(Inport* port, std::string_view portGroup);
     void addPortInternal(Outport* port, std::string_view portGroup);
@@ -456,6 +500,8 @@ private:
     std::unordered_map<Port*, std::string> portGroups_;
 
     ProcessorNetwork* network_;
+    bool previewSupported_ = false;
+    bool preview_ = false;
 
     NameDispatcher identifierDispatcher_;
     NameDispatcher displayNameDispatcher_;
@@ -60,6 +60,13 @@ public:
      */
     virtual void updateFromProperty() = 0;
 
+    /**
+     * Called by the property when it has been modified. The default implementation calls
+     * updateFromProperty directly. Widgets can override it to defer the update, for example
+     * while they are hidden, or to limit how often they update.
+     */
+    virtual void requestUpdateFromProperty();
+
     virtual PropertyEditorWidget* getEditorWidget() const;
     virtual bool hasEditorWidget() const;
     virtual Property* getProperty();
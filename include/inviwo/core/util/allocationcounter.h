@@ -0,0 +1,107 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <cstddef>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * Number of heap allocations and allocated bytes.
+ */
+struct AllocationStats {
+    size_t allocations = 0;
+    size_t bytes = 0;
+
+    AllocationStats& operator+=(const AllocationStats& rhs) {
+        allocations += rhs.allocations;
+        bytes += rhs.bytes;
+        return *this;
+    }
+    AllocationStats& operator-=(const AllocationStats& rhs) {
+        allocations -= rhs.allocations;
+        bytes -= rhs.bytes;
+        return *this;
+    }
+    friend AllocationStats operator+(AllocationStats lhs, const AllocationStats& rhs) {
+        return lhs += rhs;
+    }
+    friend AllocationStats operator-(AllocationStats lhs, const AllocationStats& rhs) {
+        return lhs -= rhs;
+    }
+};
+
+/**
+ * Returns true if allocations are counted. This requires building with the CMake option
+ * IVW_CFG_ALLOCATION_COUNTING, which replaces the global operator new and delete in
+ * inviwo-core. With shared libraries on Windows only allocations made from within inviwo-core
+ * are counted, on other platforms the replacement applies to the whole application.
+ */
+IVW_CORE_API bool isAllocationCountingEnabled();
+
+/**
+ * The number of allocations made by the calling thread since it started. Always zero if
+ * allocation counting is not enabled.
+ */
+IVW_CORE_API AllocationStats threadAllocationStats();
+
+/**
+ * Counts the heap allocations made by the current thread during the lifetime of the counter.
+ * Example:
+ * ```{.cpp}
+ * util::AllocationCounter counter;
+ * someFunction();
+ * LogInfo("someFunction allocated " << counter.get().allocations << " times");
+ * ```
+ * @see isAllocationCountingEnabled
+ */
+class IVW_CORE_API AllocationCounter {
+public:
+    AllocationCounter();
+    AllocationStats get() const;
+    void reset();
+
+private:
+    AllocationStats start_;
+};
+
+namespace detail {
+
+IVW_CORE_API void countAllocation(size_t bytes) noexcept;
+
+}  // namespace detail
+
+}  // namespace util
+
+}  // namespace inviwo
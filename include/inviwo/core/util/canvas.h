@@ -34,6 +34,8 @@
 #include <inviwo/core/interaction/pickingcontroller.h>
 #include <inviwo/core/util/glmvec.h>
 
+#include <memory>
+
 namespace inviwo {
 
 class ProcessorNetworkEvaluator;
@@ -50,8 +52,29 @@ class GestureEvent;
 
 class IVW_CORE_API Canvas {
 public:
+    /**
+     * Counts of events received by the canvas and of events actually propagated into the network.
+     * Resize and mouse move events are coalesced per frame when the "Coalesce canvas events"
+     * system setting is enabled, i.e. only the latest pending event of each kind is propagated.
+     */
+    struct EventMetrics {
+        size_t resizeEvents = 0;
+        size_t resizePropagations = 0;
+        size_t moveEvents = 0;
+        size_t movePropagations = 0;
+
+        /**
+         * Number of event propagations into the network that were skipped by coalescing. This is
+         * an upper bound of the network evaluations avoided, a propagated event does not
+         * necessarily lead to an evaluation.
+         */
+        size_t skippedPropagations() const {
+            return (resizeEvents - resizePropagations) + (moveEvents - movePropagations);
+        }
+    };
+
     Canvas(size2_t dimensions);
-    virtual ~Canvas() = default;
+    virtual ~Canvas();
 
     virtual void render(std::shared_ptr<const Image>, LayerType layerType = LayerType::Color,
                         size_t idx = 0) = 0;
@@ -82,8 +105,21 @@ public:
      * @see setFullScreenInternal
      */
     void setFullScreen(bool fullscreen);
+    /**
+     * Propagate \p e into the network. When events are coalesced, a mouse move event is not
+     * propagated directly but a copy is queued until the next round of the event loop, the
+     * original is then marked as used. Hence whether a processor used a coalesced move can not be
+     * determined from \p e.
+     * @see flushEvents
+     */
     void propagateEvent(Event* e);
 
+    /**
+     * Propagate any pending coalesced resize or mouse move event immediately.
+     */
+    void flushEvents();
+    const EventMetrics& getEventMetrics() const;
+
 protected:
     /**
      * Derived classes should override to implement actual window state.
@@ -95,6 +131,17 @@ protected:
     PickingController pickingController_;
     ProcessorWidget* ownerWidget_;  //< non-owning reference
     bool isFullScreen_ = false;
+
+private:
+    static bool isInteraction(const Event& event);
+    bool coalesceEvents() const;
+    void scheduleFlush();
+
+    bool pendingResize_ = false;
+    size2_t pendingPreviousDimensions_{0};
+    std::unique_ptr<MouseEvent> pendingMove_;
+    std::shared_ptr<bool> flushToken_;  //< Guards scheduled flushes against canvas deletion
+    EventMetrics metrics_;
 };
 
 }  // namespace inviwo
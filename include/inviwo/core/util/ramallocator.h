@@ -0,0 +1,156 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * Initialization of memory allocated by allocateRAM
+ */
+enum class RAMInit {
+    Zero,          ///< All bytes are set to zero
+    Uninitialized  ///< The content is undefined, use when all data will be overwritten anyway
+};
+
+/**
+ * Global settings used by allocateRAM, i.e. for the data of VolumeRAMPrecision and
+ * LayerRAMPrecision. Changes only affect subsequent allocations.
+ * @see ramAllocatorSettings and setRAMAllocatorSettings
+ */
+struct IVW_CORE_API RAMAllocatorSettings {
+    /// Alignment of all allocations in bytes, has to be a power of two.
+    size_t alignment = 64;
+    /// Advise the operating system to back allocations of at least 2 MB with transparent huge
+    /// pages (Linux only). Such allocations are aligned to 2 MB.
+    bool transparentHugePages = true;
+    /// Touch the pages of allocations larger than parallelTouchThreshold from several threads.
+    /// On NUMA systems with a first-touch policy this spreads the pages over the memory of
+    /// several nodes instead of placing all of them on the node of the allocating thread.
+    bool parallelFirstTouch = false;
+    size_t parallelTouchThreshold = size_t{64} << 20;
+};
+
+/**
+ * A copy of the current settings used by allocateRAM. Allocations happen concurrently on the pool
+ * threads, the settings are therefore only accessed through ramAllocatorSettings and
+ * setRAMAllocatorSettings which are thread safe.
+ */
+IVW_CORE_API RAMAllocatorSettings ramAllocatorSettings();
+/**
+ * Replace the settings used by subsequent calls to allocateRAM.
+ */
+IVW_CORE_API void setRAMAllocatorSettings(const RAMAllocatorSettings& settings);
+
+/**
+ * Allocate \p bytes of memory according to the ramAllocatorSettings(). The memory has to be
+ * released using deallocateRAM.
+ * @throw std::bad_alloc if the allocation fails
+ */
+IVW_CORE_API void* allocateRAM(size_t bytes, RAMInit init = RAMInit::Zero);
+IVW_CORE_API void deallocateRAM(void* ptr) noexcept;
+
+/**
+ * Deleter for the data owned by RAM representations. Data from allocateRAM is released using
+ * deallocateRAM, data handed over to a representation from outside is by convention allocated
+ * with new[] and released with delete[]. Data with Source::External is owned elsewhere and not
+ * released at all.
+ */
+template <typename T>
+struct RAMDeleter {
+    enum class Source { NewArray, Allocator, External };
+
+    constexpr RAMDeleter(Source aSource = Source::NewArray) noexcept : source{aSource} {}
+
+    void operator()(T* ptr) const noexcept {
+        if (source == Source::Allocator) {
+            deallocateRAM(ptr);
+        } else if (source == Source::NewArray) {
+            delete[] ptr;
+        }
+    }
+
+    Source source;
+};
+
+template <typename T>
+using RAMPtr = std::unique_ptr<T[], RAMDeleter<T>>;
+
+/**
+ * Data shared between copies of a RAM representation. The data is only copied when one of the
+ * copies is about to be modified, see detachRAMData.
+ */
+template <typename T>
+using SharedRAMPtr = std::shared_ptr<T[]>;
+
+/**
+ * Allocate an array of \p size elements of type T using allocateRAM. T has to be trivially
+ * copyable since no constructors or destructors are called.
+ */
+template <typename T>
+RAMPtr<T> allocateRAMData(size_t size, RAMInit init = RAMInit::Zero) {
+    return RAMPtr<T>(static_cast<T*>(allocateRAM(size * sizeof(T), init)),
+                     RAMDeleter<T>{RAMDeleter<T>::Source::Allocator});
+}
+
+/**
+ * Make sure that \p data, holding \p size elements, is not shared with anyone else by replacing
+ * it with a copy if needed. Has to be called before modifying data that might be shared, the RAM
+ * representations call it from all of their non-const data accessors.
+ *
+ * Different copies sharing the same data can be detached concurrently from different threads.
+ * But, as for any other modification, \p data itself must not be copied, e.g. by cloning the
+ * representation, while it is detached or modified. Otherwise the new copy can end up sharing
+ * data that is being written.
+ */
+template <typename T>
+void detachRAMData(SharedRAMPtr<T>& data, size_t size) {
+    if (data.use_count() > 1) {
+        auto copy = allocateRAMData<T>(size, RAMInit::Uninitialized);
+        std::copy(data.get(), data.get() + size, copy.get());
+        data = std::move(copy);
+    } else {
+        // use_count is a relaxed load, synchronize with the release of the last other owner so
+        // that its reads of the data happen before our writes
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+}
+
+}  // namespace util
+
+}  // namespace inviwo
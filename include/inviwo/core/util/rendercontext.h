@@ -81,7 +81,8 @@ public:
 
     /**
      * @brief Activate the thread local Inviwo render context.
-     * Will activate the inviwo render context associated with the calling thread
+     * Will activate the inviwo render context associated with the calling thread. Does nothing
+     * if there is no default render context, e.g. in applications without OpenGL.
      */
     void activateLocalRenderContext() const;
     Canvas::ContextID activeContext() const;
@@ -55,6 +55,10 @@ public:
     IntProperty portInspectorSize_;
     BoolProperty enableTouchProperty_;
     BoolProperty enablePickingProperty_;
+    BoolProperty coalesceCanvasEvents_;
+    BoolProperty previewWhileInteracting_;
+    IntProperty frameTimeBudget_;
+    IntProperty interactionIdleDelay_;
     BoolProperty enableSoundProperty_;
     BoolProperty logStackTraceProperty_;
     BoolProperty runtimeModuleReloading_;
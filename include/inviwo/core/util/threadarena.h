@@ -0,0 +1,100 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * Opens a scope on the per-thread arena. While a scope is open on a thread, threadArena()
+ * returns a monotonic memory resource, allocations from it are pointer bumps into a thread local
+ * buffer and deallocation does nothing. All memory is released in bulk when the outermost scope
+ * on the thread closes. The buffer is kept and grown to the high water mark of previous scopes,
+ * so a thread that repeatedly runs the same work will not touch the global heap at all after the
+ * first run.
+ *
+ * The network evaluator opens a scope around Processor::process and the PoolProcessor around
+ * each background job, hence processors normally do not have to open one themselves.
+ * Data allocated in the arena must not outlive the scope, i.e. never keep it in members or put
+ * it on outports.
+ * ```{.cpp}
+ * util::ArenaScope scope;
+ * std::pmr::vector<vec3> positions{scope.resource()};
+ * ```
+ */
+class IVW_CORE_API ArenaScope {
+public:
+    ArenaScope();
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope(ArenaScope&&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+    ArenaScope& operator=(ArenaScope&&) = delete;
+    ~ArenaScope();
+
+    std::pmr::memory_resource* resource() const noexcept { return resource_; }
+
+private:
+    std::pmr::memory_resource* resource_;
+};
+
+/**
+ * The arena of the calling thread if there is an open ArenaScope, otherwise
+ * std::pmr::get_default_resource(). Hence it is always safe to use, but only gives arena
+ * allocations inside a scope.
+ */
+IVW_CORE_API std::pmr::memory_resource* threadArena() noexcept;
+
+/**
+ * Size of the buffer retained by the arena of the calling thread, 0 if no scope has been opened
+ * on the thread yet.
+ */
+IVW_CORE_API size_t threadArenaCapacity() noexcept;
+
+/**
+ * Shorthand for a std::pmr::vector allocated in the arena of the calling thread
+ * @see threadArena
+ */
+template <typename T>
+std::pmr::vector<T> arenaVector(size_t reserve = 0) {
+    std::pmr::vector<T> res{threadArena()};
+    res.reserve(reserve);
+    return res;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
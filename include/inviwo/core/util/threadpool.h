@@ -98,6 +98,12 @@ public:
 
     size_t getQueueSize();
 
+    /**
+     * The number of workers that are waiting for tasks minus the number of queued tasks, i.e.
+     * the number of tasks that could be started right away. Zero when there are no workers.
+     */
+    size_t getIdleCount();
+
 private:
     enum class State {
         Free,     //< Worker is waiting for tasks.
@@ -0,0 +1,181 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * An inverted index for case insensitive substring search over the texts of a set of keys.
+ * Every text is split into all its n-grams of length one to three, and for each n-gram the index
+ * keeps the set of keys that have it. A query looks up the n-grams of the query, takes the
+ * smallest of their key sets as candidates, and only checks the texts of those. Keys can be added
+ * and removed at any time, which makes it easy to keep the index up to date incrementally.
+ * ```{.cpp}
+ * util::TrigramIndex<Processor*> index;
+ * index.insert(processor, processor->getIdentifier());
+ * index.insert(processor, processor->getDisplayName());
+ * index.find("ray", [](Processor* p) { ... });
+ * ```
+ */
+template <typename Key, typename Hash = std::hash<Key>>
+class TrigramIndex {
+public:
+    TrigramIndex() = default;
+
+    /**
+     * Add \p text to the texts of \p key.
+     */
+    void insert(const Key& key, std::string_view text) {
+        auto& texts = texts_[key];
+        texts.push_back(toLower(text));
+        forEachGram(texts.back(), [&](std::uint32_t gram) { grams_[gram].insert(key); });
+    }
+
+    /**
+     * Remove \p key and all its texts.
+     */
+    void erase(const Key& key) {
+        auto it = texts_.find(key);
+        if (it == texts_.end()) return;
+        for (const auto& text : it->second) {
+            forEachGram(text, [&](std::uint32_t gram) {
+                if (auto git = grams_.find(gram); git != grams_.end()) {
+                    git->second.erase(key);
+                    if (git->second.empty()) grams_.erase(git);
+                }
+            });
+        }
+        texts_.erase(it);
+    }
+
+    bool contains(const Key& key) const { return texts_.find(key) != texts_.end(); }
+    size_t size() const { return texts_.size(); }
+    bool empty() const { return texts_.empty(); }
+
+    void clear() {
+        texts_.clear();
+        grams_.clear();
+    }
+
+    /**
+     * Check if any of the texts of \p key contains \p query, ignoring case.
+     */
+    bool matches(const Key& key, std::string_view query) const {
+        auto it = texts_.find(key);
+        return it != texts_.end() && matchesAny(it->second, toLower(query));
+    }
+
+    /**
+     * Call \p callback for each key with a text that contains \p query, ignoring case.
+     * An empty query matches all keys.
+     */
+    template <typename Callback>
+    void find(std::string_view query, Callback callback) const {
+        const auto lower = toLower(query);
+        if (lower.empty()) {
+            for (const auto& item : texts_) callback(item.first);
+            return;
+        }
+
+        const std::unordered_set<Key, Hash>* candidates = nullptr;
+        const auto n = std::min(lower.size(), maxGram);
+        for (size_t i = 0; i + n <= lower.size(); ++i) {
+            auto it = grams_.find(gram(lower, i, n));
+            if (it == grams_.end()) return;
+            if (!candidates || it->second.size() < candidates->size()) candidates = &it->second;
+        }
+
+        for (const auto& key : *candidates) {
+            // A query of at most maxGram characters is itself an n-gram, no need to check it.
+            if (lower.size() <= maxGram || matchesAny(texts_.at(key), lower)) callback(key);
+        }
+    }
+
+    /**
+     * The keys with a text that contains \p query, ignoring case, in no particular order.
+     */
+    std::vector<Key> find(std::string_view query) const {
+        std::vector<Key> res;
+        find(query, [&](const Key& key) { res.push_back(key); });
+        return res;
+    }
+
+private:
+    static constexpr size_t maxGram = 3;
+
+    static std::string toLower(std::string_view str) {
+        std::string res(str);
+        std::transform(res.begin(), res.end(), res.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return res;
+    }
+
+    // The length is stored in the upper bits to tell "a" from "\0a".
+    static std::uint32_t gram(std::string_view str, size_t pos, size_t n) {
+        std::uint32_t res = static_cast<std::uint32_t>(n);
+        for (size_t i = pos; i < pos + n; ++i) {
+            res = (res << 8) | static_cast<unsigned char>(str[i]);
+        }
+        return res;
+    }
+
+    template <typename Callback>
+    static void forEachGram(std::string_view str, Callback callback) {
+        for (size_t n = 1; n <= maxGram; ++n) {
+            for (size_t i = 0; i + n <= str.size(); ++i) callback(gram(str, i, n));
+        }
+    }
+
+    static bool matchesAny(const std::vector<std::string>& texts, const std::string& lower) {
+        return std::any_of(texts.begin(), texts.end(), [&](const std::string& text) {
+            return text.find(lower) != std::string::npos;
+        });
+    }
+
+    std::unordered_map<Key, std::vector<std::string>, Hash> texts_;
+    std::unordered_map<std::uint32_t, std::unordered_set<Key, Hash>> grams_;
+};
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,130 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/interpolation.h>
+#include <inviwo/core/util/spatialsampler.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumebricked.h>
+
+namespace inviwo {
+
+/**
+ * \class VolumeBrickedDoubleSampler
+ * Samples a volume using its VolumeBricked representation, like VolumeDoubleSampler does with the
+ * VolumeRAM representation. The eight voxels of a sample are close in memory independent of the
+ * direction the volume is traversed in.
+ */
+template <unsigned int DataDims>
+class VolumeBrickedDoubleSampler : public SpatialSampler<3, DataDims, double> {
+public:
+    VolumeBrickedDoubleSampler(std::shared_ptr<const Volume> vol,
+                               CoordinateSpace space = CoordinateSpace::Data);
+    VolumeBrickedDoubleSampler(const Volume& vol, CoordinateSpace space = CoordinateSpace::Data);
+    virtual ~VolumeBrickedDoubleSampler() = default;
+
+    virtual Vector<DataDims, double> sampleDataSpace(const dvec3& pos) const override;
+    virtual bool withinBoundsDataSpace(const dvec3& pos) const override;
+
+protected:
+    Vector<DataDims, double> getVoxel(const size3_t& pos) const;
+
+    std::shared_ptr<const Volume> volume_;
+    const VolumeBricked* bricked_;
+    size3_t dims_;
+};
+
+using VolumeBrickedSampler = VolumeBrickedDoubleSampler<4>;
+
+template <unsigned int DataDims>
+VolumeBrickedDoubleSampler<DataDims>::VolumeBrickedDoubleSampler(
+    std::shared_ptr<const Volume> vol, CoordinateSpace space)
+    : VolumeBrickedDoubleSampler(*vol, space) {
+    volume_ = vol;
+}
+
+template <unsigned int DataDims>
+VolumeBrickedDoubleSampler<DataDims>::VolumeBrickedDoubleSampler(const Volume& vol,
+                                                                 CoordinateSpace space)
+    : SpatialSampler<3, DataDims, double>(vol, space)
+    , bricked_(vol.getRepresentation<VolumeBricked>())
+    , dims_(vol.getDimensions()) {}
+
+template <unsigned int DataDims>
+Vector<DataDims, double> VolumeBrickedDoubleSampler<DataDims>::sampleDataSpace(
+    const dvec3& pos) const {
+    if (!withinBoundsDataSpace(pos)) {
+        return Vector<DataDims, double>(0.0);
+    }
+    const dvec3 samplePos = pos * dvec3(dims_ - size3_t(1));
+    const size3_t indexPos = size3_t(samplePos);
+    const dvec3 interpolants = samplePos - dvec3(indexPos);
+
+    Vector<DataDims, double> samples[8];
+    samples[0] = getVoxel(indexPos);
+    samples[1] = getVoxel(indexPos + size3_t(1, 0, 0));
+    samples[2] = getVoxel(indexPos + size3_t(0, 1, 0));
+    samples[3] = getVoxel(indexPos + size3_t(1, 1, 0));
+
+    samples[4] = getVoxel(indexPos + size3_t(0, 0, 1));
+    samples[5] = getVoxel(indexPos + size3_t(1, 0, 1));
+    samples[6] = getVoxel(indexPos + size3_t(0, 1, 1));
+    samples[7] = getVoxel(indexPos + size3_t(1, 1, 1));
+
+    return Interpolation<Vector<DataDims, double>>::trilinear(samples, interpolants);
+}
+
+template <>
+inline Vector<1, double> VolumeBrickedDoubleSampler<1>::getVoxel(const size3_t& pos) const {
+    return bricked_->getAsDouble(glm::clamp(pos, size3_t(0), dims_ - size3_t(1)));
+}
+
+template <>
+inline Vector<2, double> VolumeBrickedDoubleSampler<2>::getVoxel(const size3_t& pos) const {
+    return bricked_->getAsDVec2(glm::clamp(pos, size3_t(0), dims_ - size3_t(1)));
+}
+
+template <>
+inline Vector<3, double> VolumeBrickedDoubleSampler<3>::getVoxel(const size3_t& pos) const {
+    return bricked_->getAsDVec3(glm::clamp(pos, size3_t(0), dims_ - size3_t(1)));
+}
+
+template <>
+inline Vector<4, double> VolumeBrickedDoubleSampler<4>::getVoxel(const size3_t& pos) const {
+    return bricked_->getAsDVec4(glm::clamp(pos, size3_t(0), dims_ - size3_t(1)));
+}
+
+template <unsigned int DataDims>
+bool VolumeBrickedDoubleSampler<DataDims>::withinBoundsDataSpace(const dvec3& pos) const {
+    return !(glm::any(glm::lessThan(pos, dvec3(0.0))) ||
+             glm::any(glm::greaterThan(pos, dvec3(1.0))));
+}
+
+}  // namespace inviwo
@@ -33,6 +33,7 @@
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/util/spatial4dsampler.h>
 #include <inviwo/core/util/volumesampler.h>
+#include <inviwo/core/util/volumesequenceutils.h>
 
 namespace inviwo {
 
@@ -75,6 +76,7 @@ protected:
 
 private:
     std::vector<std::shared_ptr<Wrapper>> wrappers_;
+    util::TimeIndex timeIndex_;  ///< timestamps of the wrappers, which are in sorted order
 
     bool allowLooping_;
     dvec2 timeRange_;
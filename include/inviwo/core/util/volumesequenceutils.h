@@ -31,6 +31,7 @@
 
 #include <inviwo/core/common/inviwocoredefine.h>
 
+#include <cstddef>
 #include <vector>
 #include <memory>
 
@@ -50,12 +51,107 @@ std::pair<double, double> IVW_CORE_API getTimestampRange(const VolumeSequence& s
 bool IVW_CORE_API isSorted(const VolumeSequence& seq);
 VolumeSequence IVW_CORE_API sortSequence(const VolumeSequence& seq);
 
+/**
+ * The volumes of \p seq enclosing \p t. If \p sorted is false a TimeIndex is built on each call,
+ * use the overload taking a TimeIndex for repeated lookups in unsorted sequences.
+ */
 std::pair<SharedVolume, SharedVolume> IVW_CORE_API getVolumesForTimestep(const VolumeSequence& seq,
                                                                          double t,
                                                                          bool sorted = true);
 
 bool IVW_CORE_API hasTimestamp(SharedVolume vol);
 double IVW_CORE_API getTimestamp(SharedVolume vol);
+
+/**
+ * Sorted timestamps of a volume sequence for repeated lookups. The timestamps are read from the
+ * "timestamp" meta data once on construction, lookups are then done with a binary search. If not
+ * all volumes have a timestamp, the volumes are assumed to be evenly spaced in [0, 1] in sequence
+ * order. The index has to be rebuilt when the sequence changes, compare with the sequence using
+ * isIndexOf.
+ */
+class IVW_CORE_API TimeIndex {
+public:
+    /**
+     * Two neighboring volumes, as indices into the sequence, and the weight of the second one for
+     * linear interpolation.
+     */
+    struct Interval {
+        size_t first;
+        size_t second;
+        double weight;
+    };
+
+    TimeIndex() = default;
+    explicit TimeIndex(const VolumeSequence& seq);
+    /**
+     * Index of the elements of a sequence with the given \p timestamps.
+     */
+    explicit TimeIndex(std::vector<double> timestamps);
+
+    size_t size() const { return timestamps_.size(); }
+    bool empty() const { return timestamps_.empty(); }
+    /**
+     * True if the timestamps were read from the meta data of the volumes
+     */
+    bool hasTimestamps() const { return hasTimestamps_; }
+
+    /**
+     * The smallest and largest timestamp, (0, 1) if empty
+     */
+    std::pair<double, double> getRange() const;
+
+    /**
+     * Timestamps in increasing order
+     */
+    const std::vector<double>& getTimestamps() const { return timestamps_; }
+    /**
+     * Sequence index of the \p i:th smallest timestamp
+     */
+    size_t getSequenceIndex(size_t i) const { return order_[i]; }
+
+    /**
+     * Position in getTimestamps() of the last timestamp not greater than \p t, zero if \p t is
+     * smaller than all timestamps.
+     * @throw RangeException if the index is empty
+     */
+    size_t find(double t) const;
+
+    /**
+     * The volumes enclosing \p t, first has a timestamp not greater than t and second the next
+     * larger timestamp. Outside of the range both refer to the first or last volume and the
+     * weight is zero.
+     * @throw RangeException if the index is empty
+     */
+    Interval interpolate(double t) const;
+
+    /**
+     * The volumes of \p seq enclosing \p t, @see interpolate. A pair of nullptr if the index is
+     * empty.
+     */
+    std::pair<SharedVolume, SharedVolume> getVolumes(const VolumeSequence& seq, double t) const;
+
+    /**
+     * Check if this is an index of \p seq, i.e. built from a sequence with the same volumes with
+     * the same timestamps
+     */
+    bool isIndexOf(const VolumeSequence& seq) const;
+
+private:
+    std::vector<double> timestamps_;
+    std::vector<size_t> order_;
+    std::vector<std::weak_ptr<const Volume>> volumes_;
+    bool hasTimestamps_ = false;
+};
+
+/**
+ * The volumes of \p seq enclosing \p t, looked up in \p index. The index is only rebuilt if it is
+ * not an index of \p seq, keep it between calls to avoid sorting the timestamps for every lookup.
+ * @see TimeIndex::getVolumes
+ */
+std::pair<SharedVolume, SharedVolume> IVW_CORE_API getVolumesForTimestep(const VolumeSequence& seq,
+                                                                         double t,
+                                                                         TimeIndex& index);
+
 }  // namespace util
 
 }  // namespace inviwo
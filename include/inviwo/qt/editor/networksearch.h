@@ -32,10 +32,19 @@
 
 #include <inviwo/qt/editor/inviwoqteditordefine.h>
 #include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/network/processornetworkobserver.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/processorfactory.h>
+#include <inviwo/core/processors/processorfactoryobject.h>
+#include <inviwo/core/processors/processorobserver.h>
+#include <inviwo/core/properties/propertyobserver.h>
+#include <inviwo/core/properties/propertyownerobserver.h>
+#include <inviwo/core/util/trigramindex.h>
 
 #include <functional>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <warn/push>
 #include <warn/ignore/all>
@@ -50,8 +59,18 @@ class InviwoMainWindow;
 
 /**
  * Widget for searching the processor network. Will highlight matching processors.
+ * The searchable texts of each processor are kept in one util::TrigramIndex per search key. The
+ * indices are updated incrementally, processors are re-indexed on the next search after they,
+ * their ports, their properties, or property identifiers changed. Tags, code state, and module
+ * come from the processor factory and are re-indexed when processors are registered or
+ * unregistered there.
  */
-class IVW_QTEDITOR_API NetworkSearch : public QWidget {
+class IVW_QTEDITOR_API NetworkSearch : public QWidget,
+                                       public ProcessorNetworkObserver,
+                                       public ProcessorObserver,
+                                       public PropertyOwnerObserver,
+                                       public PropertyObserver,
+                                       public FactoryObserver<ProcessorFactoryObject> {
 public:
     NetworkSearch(InviwoMainWindow* win);
 
@@ -69,15 +88,44 @@ private:
         std::string shortcut;
         std::string description;
         bool global;
-        std::function<bool(Processor*, const std::string&)> match;
+        std::function<std::vector<std::string>(Processor*)> texts;
     };
+
+    // ProcessorNetworkObserver overrides
+    virtual void onProcessorNetworkDidAddProcessor(Processor* processor) override;
+    virtual void onProcessorNetworkWillRemoveProcessor(Processor* processor) override;
+
+    // ProcessorObserver overrides
+    virtual void onProcessorPortAdded(Processor* processor, Port*) override;
+    virtual void onProcessorPortRemoved(Processor* processor, Port*) override;
+
+    // PropertyOwnerObserver overrides
+    virtual void onDidAddProperty(Property* property, size_t index) override;
+    virtual void onWillRemoveProperty(Property* property, size_t index) override;
+
+    // PropertyObserver overrides
+    virtual void onSetIdentifier(Property* property, const std::string& identifier) override;
+
+    // FactoryObserver overrides
+    virtual void onRegister(ProcessorFactoryObject* item) override;
+    virtual void onUnRegister(ProcessorFactoryObject* item) override;
+
+    void addPropertyObservation(Property* property);
+    void addPropertyOwnerObservation(PropertyOwner* po);
+    void markDirty(Processor* processor);
+    void markDirty(const std::string& classIdentifier);
+    void updateIndex();
+
     static std::vector<std::pair<std::string, std::string>> tokenize(const std::string& str);
     static std::unordered_map<std::string, std::string> getModuleMap(InviwoApplication* app);
-    static bool find(const std::string& cont, const std::string& s);
     InviwoMainWindow* win_;
     QLineEdit* edit_;
     std::vector<Item> items_;
-    std::unordered_map<std::string, std::function<bool(Processor*, const std::string&)>> map_;
+    std::unordered_map<std::string, size_t> map_;  //< key or shortcut to index in items_
+    std::vector<util::TrigramIndex<Processor*>> indices_;
+    std::unordered_set<Processor*> dirty_;
+    std::unordered_map<Processor*, std::vector<Processor::NameDispatcherHandle>> nameHandles_;
+    std::unordered_map<std::string, std::string> moduleMap_;
 };
 
 }  // namespace inviwo
@@ -34,6 +34,9 @@
 #include <modules/qtwidgets/inviwodockwidget.h>
 #include <inviwo/core/processors/processorfactoryobject.h>
 #include <inviwo/core/processors/processorfactory.h>
+#include <inviwo/core/util/trigramindex.h>
+
+#include <unordered_set>
 
 #include <warn/push>
 #include <warn/ignore/all>
@@ -109,6 +112,12 @@ private:
     void currentItemChanged(QTreeWidgetItem* current, QTreeWidgetItem* previous);
 
     void extractInfoAndAddProcessor(ProcessorFactoryObject* processor, InviwoModule* elem);
+    void indexProcessor(ProcessorFactoryObject* processor);
+    /**
+     * The processors whose display name, class identifier, or tags contain all the space
+     * separated terms of the filter.
+     */
+    std::unordered_set<ProcessorFactoryObject*> findProcessors(const QString& filter);
     QTreeWidgetItem* addToplevelItemTo(QString title, const std::string& desc);
 
     virtual void onRegister(ProcessorFactoryObject* item) override;
@@ -132,6 +141,7 @@ private:
 
     std::unordered_map<std::string, size_t> useCounts_;
     std::unordered_map<std::string, std::time_t> useTimes_;
+    util::TrigramIndex<ProcessorFactoryObject*> filterIndex_;
 
     // Called after modules have been registered
     std::shared_ptr<std::function<void()>> onModulesDidRegister_;
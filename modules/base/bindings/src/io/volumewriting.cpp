@@ -44,8 +44,21 @@ namespace inviwo {
 void exposeVolumeWriteMethods(pybind11::module& m) {
 
     m.def("saveDatVolume", &util::writeDatVolume);
-    m.def("saveIvfVolume", &util::writeIvfVolume);
-    m.def("saveIvfVolumeSequence", &util::writeIvfVolumeSequence);
+    m.def(
+        "saveIvfVolume",
+        [](const Volume& volume, const std::string& filePath, bool overwrite, bool compress) {
+            util::IvfCompression compression;
+            compression.enabled = compress;
+            util::writeIvfVolume(volume, filePath, overwrite, compression);
+        },
+        pybind11::arg("volume"), pybind11::arg("filePath"), pybind11::arg("overwrite") = false,
+        pybind11::arg("compress") = false);
+    m.def("saveIvfVolumeSequence",
+          [](const VolumeSequence& seq, std::string name, std::string path,
+             std::string reltivePathToTimesteps, bool overwrite) {
+              return util::writeIvfVolumeSequence(seq, name, path, reltivePathToTimesteps,
+                                                  overwrite);
+          });
     m.def("saveIvfVolumeSequence", [](pybind11::list list, std::string name, std::string path,
                                       std::string reltivePathToTimesteps, bool overwrite) {
         VolumeSequence seq;
@@ -36,6 +36,7 @@
 #include <inviwo/core/datastructures/geometry/mesh.h>
 #include <inviwo/core/datastructures/geometry/plane.h>
 #include <functional>
+#include <memory_resource>
 #include <optional>
 #include <vector>
 
@@ -67,11 +68,15 @@ IVW_MODULE_BASE_API std::optional<glm::u32vec2> sutherlandHodgman(
     glm::u32vec3 triangle, const Plane& plane, const std::vector<vec3>& positions,
     std::vector<std::uint32_t>& indices, const InterpolateFunctor& addInterpolatedVertex);
 
-IVW_MODULE_BASE_API void removeDuplicateEdges(std::vector<glm::u32vec2>& cuts,
+IVW_MODULE_BASE_API void removeDuplicateEdges(std::pmr::vector<glm::u32vec2>& cuts,
                                               const std::vector<vec3>& positions, float eps);
 
-IVW_MODULE_BASE_API std::vector<std::vector<std::uint32_t>> gatherLoops(
-    std::vector<glm::u32vec2>& edges, const std::vector<vec3>& positions, float eps);
+/**
+ * Connect the edges into closed loops. The edges are consumed, the loops are allocated using the
+ * memory resource of the edges.
+ */
+IVW_MODULE_BASE_API std::pmr::vector<std::pmr::vector<std::uint32_t>> gatherLoops(
+    std::pmr::vector<glm::u32vec2>& edges, const std::vector<vec3>& positions, float eps);
 
 }  // namespace detail
 
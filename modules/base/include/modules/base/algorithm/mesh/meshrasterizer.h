@@ -0,0 +1,81 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/util/glm.h>
+#include <modules/base/algorithm/shading.h>
+
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+class Mesh;
+class Image;
+class Camera;
+
+namespace util {
+
+/**
+ * Settings for rasterizeMeshes
+ */
+struct IVW_MODULE_BASE_API MeshRasterizationSettings {
+    LightingSettings lighting;
+    /// Shade triangles using their face normal instead of the interpolated vertex normals
+    bool flatShading = false;
+    /// Color used for meshes without a color buffer
+    vec4 defaultColor{0.7f, 0.7f, 0.7f, 1.0f};
+    float pointSize = 3.0f;    ///< Size of points in pixels
+    size2_t tileSize{64, 64};  ///< Size of the image tiles dispatched to the thread pool
+};
+
+/**
+ * Renders \p meshes on the CPU, the result corresponds to the MeshRenderer of the OpenGL module
+ * without blending. Vertices are transformed and clipped against the near plane before the
+ * primitives are binned into image tiles, which are then rasterized in parallel using the thread
+ * pool. All draw types and connectivity types of the meshes are supported. Triangles are shaded
+ * using \p settings.lighting, lines and points are drawn in their vertex color. Triangles of meshes
+ * without normals are always flat shaded, in which case the face normal faces the camera.
+ *
+ * @param meshes      meshes to render, in data space given by their coordinate transformer
+ * @param camera      camera used for rendering
+ * @param dimensions  dimensions of the resulting image
+ * @param settings    rasterization and lighting settings
+ * @return image with a RGBA8 color layer, a depth layer, and a picking layer holding the picking
+ *         colors of meshes with a picking buffer
+ */
+IVW_MODULE_BASE_API std::shared_ptr<Image> rasterizeMeshes(
+    const std::vector<std::shared_ptr<const Mesh>>& meshes, const Camera& camera,
+    size2_t dimensions, const MeshRasterizationSettings& settings);
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,98 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/util/glm.h>
+
+#include <memory>
+
+namespace inviwo {
+
+class VolumeRAM;
+class LayerRAM;
+
+namespace util {
+
+enum class MorphologyOperation {
+    Erode,   ///< minimum over the structuring element
+    Dilate,  ///< maximum over the structuring element
+    Open,    ///< erode followed by dilate
+    Close    ///< dilate followed by erode
+};
+
+enum class MorphologyShape {
+    Box,     ///< all offsets with |d_i| <= radius_i
+    Sphere,  ///< all offsets with sum (d_i / radius_i)^2 <= 1, i.e. an ellipsoid for unequal radii
+};
+
+/**
+ * Grayscale morphology, applied to each channel independently. Voxels outside of the volume do
+ * not contribute. Box kernels are separated into one van Herk/Gil-Werman running min/max per
+ * axis, which costs a constant number of comparisons per voxel regardless of the radius. Sphere
+ * kernels are decomposed into lines along x, one running min/max per distinct line length, and
+ * cost O(radius.y * radius.z) per voxel. The work is split into slabs of lines on the thread pool.
+ * @return a new volume with the same format as the input
+ */
+IVW_MODULE_BASE_API std::shared_ptr<VolumeRAM> volumeMorphology(const VolumeRAM* volume,
+                                                                MorphologyOperation operation,
+                                                                MorphologyShape shape,
+                                                                size3_t radius);
+
+/**
+ * Binary morphology of the voxels whose first channel lies within the closed \p foreground
+ * range. Sphere kernels use a separable Euclidean distance transform, i.e. linear time in the
+ * number of voxels regardless of the radius.
+ * @return a DataUInt8 mask where foreground is 255 and background 0
+ */
+IVW_MODULE_BASE_API std::shared_ptr<VolumeRAM> volumeBinaryMorphology(
+    const VolumeRAM* volume, dvec2 foreground, MorphologyOperation operation,
+    MorphologyShape shape, size3_t radius);
+
+/**
+ * @see volumeMorphology
+ */
+IVW_MODULE_BASE_API std::shared_ptr<LayerRAM> layerMorphology(const LayerRAM* layer,
+                                                              MorphologyOperation operation,
+                                                              MorphologyShape shape,
+                                                              size2_t radius);
+
+/**
+ * @see volumeBinaryMorphology
+ */
+IVW_MODULE_BASE_API std::shared_ptr<LayerRAM> layerBinaryMorphology(const LayerRAM* layer,
+                                                                    dvec2 foreground,
+                                                                    MorphologyOperation operation,
+                                                                    MorphologyShape shape,
+                                                                    size2_t radius);
+
+}  // namespace util
+
+}  // namespace inviwo
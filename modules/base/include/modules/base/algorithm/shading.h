@@ -0,0 +1,70 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/properties/simplelightingproperty.h>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * Light and shading parameters for CPU shading, corresponds to the LightParameters used in
+ * modules/opengl/glsl/utils/shading.glsl.
+ */
+struct IVW_MODULE_BASE_API LightingSettings {
+    ShadingMode::Modes shadingMode = ShadingMode::None;
+    vec3 lightPosition{0.0f};  ///< light position in world space
+    vec3 ambientColor{0.15f};
+    vec3 diffuseColor{0.6f};
+    vec3 specularColor{0.4f};
+    float specularExponent = 60.0f;
+};
+
+/**
+ * Extract the current settings of \p property with the light position transformed into world
+ * space.
+ */
+IVW_MODULE_BASE_API LightingSettings lightingSettings(const SimpleLightingProperty& property);
+
+/**
+ * Shade a point on a surface, the CPU equivalent of the APPLY_LIGHTING macro of the OpenGL
+ * module. All positions and directions should be in world space.
+ */
+IVW_MODULE_BASE_API vec3 applyLighting(const LightingSettings& light, const vec3& materialAmbient,
+                                       const vec3& materialDiffuse, const vec3& materialSpecular,
+                                       const vec3& position, const vec3& normal,
+                                       const vec3& toCameraDir);
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -49,6 +49,9 @@ namespace util {
  *
  * Note: Share interface with util::marchingtetrahedron
  *
+ * If the volume has a VolumeSparse representation, and \p enclose is false, only the cells
+ * touching its allocated leaves are evaluated and the volume is never made dense.
+ *
  * @param volume the scalar volume
  * @param iso iso-value for the extracted surface
  * @param color the color of the resulting surface
@@ -38,6 +38,9 @@
 
 #include <modules/base/datastructures/kdtree.h>
 
+#include <memory_resource>
+#include <vector>
+
 namespace inviwo {
 /*
 Common functions used in MarchingCubes and MarchingTetrahedron
@@ -51,21 +54,46 @@ double getValue(const T* src, size3_t pos, size3_t dim, double iso, bool invert)
 
 glm::vec3 interpolate(const glm::vec3& p0, double v0, const glm::vec3& p1, double v1);
 
+/*
+The vertex functions are instantiated for std::vector<vec3> and std::pmr::vector<vec3>, the latter
+lets the callers keep temporary positions and normals in the per-thread arena.
+*/
+template <typename Vec3s>
 void evaluateTriangle(K3DTree<size_t, float>& vertexTree, IndexBufferRAM* indexBuffer,
-                      std::vector<vec3>& positions, std::vector<vec3>& normals, const glm::vec3& p0,
-                      double v0, const glm::vec3& p1, double v1, const glm::vec3& p2, double v2);
+                      Vec3s& positions, Vec3s& normals, const glm::vec3& p0, double v0,
+                      const glm::vec3& p1, double v1, const glm::vec3& p2, double v2);
 
-size_t addVertex(K3DTree<size_t, float>& vertexTree, std::vector<vec3>& positions,
-                 std::vector<vec3>& normals, const vec3 pos);
+template <typename Vec3s>
+size_t addVertex(K3DTree<size_t, float>& vertexTree, Vec3s& positions, Vec3s& normals,
+                 const vec3 pos);
 
+template <typename Vec3s>
 void addTriangle(K3DTree<size_t, float>& vertexTree, IndexBufferRAM* indexBuffer,
-                 std::vector<vec3>& positions, std::vector<vec3>& normals, const glm::vec3& a,
-                 const glm::vec3& b, const glm::vec3& c);
-
-template <typename T>
+                 Vec3s& positions, Vec3s& normals, const glm::vec3& a, const glm::vec3& b,
+                 const glm::vec3& c);
+
+extern template void evaluateTriangle(K3DTree<size_t, float>&, IndexBufferRAM*,
+                                      std::vector<vec3>&, std::vector<vec3>&, const glm::vec3&,
+                                      double, const glm::vec3&, double, const glm::vec3&, double);
+extern template void evaluateTriangle(K3DTree<size_t, float>&, IndexBufferRAM*,
+                                      std::pmr::vector<vec3>&, std::pmr::vector<vec3>&,
+                                      const glm::vec3&, double, const glm::vec3&, double,
+                                      const glm::vec3&, double);
+extern template size_t addVertex(K3DTree<size_t, float>&, std::vector<vec3>&, std::vector<vec3>&,
+                                 const vec3);
+extern template size_t addVertex(K3DTree<size_t, float>&, std::pmr::vector<vec3>&,
+                                 std::pmr::vector<vec3>&, const vec3);
+extern template void addTriangle(K3DTree<size_t, float>&, IndexBufferRAM*, std::vector<vec3>&,
+                                 std::vector<vec3>&, const glm::vec3&, const glm::vec3&,
+                                 const glm::vec3&);
+extern template void addTriangle(K3DTree<size_t, float>&, IndexBufferRAM*,
+                                 std::pmr::vector<vec3>&, std::pmr::vector<vec3>&,
+                                 const glm::vec3&, const glm::vec3&, const glm::vec3&);
+
+template <typename T, typename Vec3s>
 void encloseSurfce(const T* src, const size3_t& dim, IndexBufferRAM* indexBuffer,
-                   std::vector<vec3>& positions, std::vector<vec3>& normals, double iso,
-                   bool invert, double dx, double dy, double dz) {
+                   Vec3s& positions, Vec3s& normals, double iso, bool invert, double dx,
+                   double dy, double dz) {
     auto cubeEdgeIndices = [](size_t n) -> std::vector<size_t> {
         if (n == 1) return {size_t(0)};
         return {size_t(0), n - 1};
@@ -0,0 +1,94 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/util/glm.h>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+class Volume;
+class VolumeRAM;
+
+namespace util {
+
+/**
+ * Neighborhood used to decide whether two foreground voxels are connected. Face connectivity
+ * considers the 6 voxels sharing a face, Edge the 18 voxels sharing a face or an edge, and Vertex
+ * all 26 surrounding voxels.
+ */
+enum class VoxelConnectivity { Face = 6, Edge = 18, Vertex = 26 };
+
+/**
+ * Statistics of one connected component. Positions are given in voxel index space.
+ */
+struct IVW_MODULE_BASE_API ComponentStatistics {
+    size_t voxelCount = 0;
+    size3_t lower{std::numeric_limits<size_t>::max()};  ///< inclusive lower bound
+    size3_t upper{0};                                   ///< inclusive upper bound
+    dvec3 centroid{0.0};
+    double meanIntensity = 0.0;
+};
+
+struct IVW_MODULE_BASE_API ConnectedComponents {
+    /**
+     * Label volume of type DataUInt32 with the same dimensions and basis as the input. Background
+     * voxels are 0 and the components are numbered from 1 in raster order of their first voxel.
+     */
+    std::shared_ptr<Volume> labels;
+    /// Statistics of each component, the entry at index i belongs to label i + 1
+    std::vector<ComponentStatistics> components;
+};
+
+/**
+ * Label the connected components of the voxels whose first channel lies within the closed
+ * \p foreground range. The volume is split into slabs along z that are labeled in parallel on the
+ * thread pool, the provisional labels are then merged across slab boundaries using DisjointSets.
+ * The mean intensity of each component is computed from the first channel.
+ * @throw Exception if the number of components does not fit into the label volume
+ */
+IVW_MODULE_BASE_API ConnectedComponents
+volumeConnectedComponents(const Volume& volume, dvec2 foreground,
+                          VoxelConnectivity connectivity = VoxelConnectivity::Face);
+
+/**
+ * @see volumeConnectedComponents(const Volume&, dvec2, VoxelConnectivity)
+ */
+IVW_MODULE_BASE_API ConnectedComponents
+volumeConnectedComponents(const VolumeRAM& volume, dvec2 foreground,
+                          VoxelConnectivity connectivity = VoxelConnectivity::Face);
+
+}  // namespace util
+
+}  // namespace inviwo
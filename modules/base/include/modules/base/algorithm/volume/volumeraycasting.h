@@ -0,0 +1,114 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/util/glm.h>
+#include <modules/base/algorithm/shading.h>
+
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+class Volume;
+class Image;
+class Camera;
+class TransferFunction;
+
+namespace util {
+
+/**
+ * \brief Min/max values of bricks of a volume, used for empty space skipping.
+ *
+ * The volume is divided into bricks of brickSize^3 voxels. For each brick the minimum and
+ * maximum normalized value (see DataMapper::dataRange) of the given channel is stored. Each brick
+ * includes the first voxel layer of its neighbors in the positive directions, since those are
+ * needed for trilinear interpolation of any sample located inside the brick.
+ */
+class IVW_MODULE_BASE_API VolumeMinMaxBricks {
+public:
+    VolumeMinMaxBricks() = default;
+    VolumeMinMaxBricks(const Volume& volume, size_t channel = 0, size_t brickSize = 8);
+
+    size3_t getVolumeDimensions() const { return volumeDims_; }
+    size3_t getBrickDimensions() const { return brickDims_; }
+    size_t getBrickSize() const { return brickSize_; }
+    size_t getChannel() const { return channel_; }
+
+    /**
+     * Normalized min and max value of the brick at \p brick (in brick coordinates)
+     */
+    const vec2& get(const size3_t& brick) const {
+        return minMax_[brick.x + brickDims_.x * (brick.y + brickDims_.y * brick.z)];
+    }
+
+private:
+    size3_t volumeDims_{0};
+    size3_t brickDims_{0};
+    size_t brickSize_{8};
+    size_t channel_{0};
+    std::vector<vec2> minMax_;
+};
+
+/**
+ * Settings for raycastVolume
+ */
+struct IVW_MODULE_BASE_API VolumeRaycastingSettings {
+    size_t channel = 0;
+    float samplingRate = 2.0f;  ///< Number of samples per voxel along the ray
+    size2_t tileSize{32, 32};   ///< Size of the image tiles dispatched to the thread pool
+    LightingSettings lighting;
+};
+
+/**
+ * Renders \p volume by means of direct volume rendering on the CPU, the result matches the
+ * raycasting.frag shader of the VolumeRaycaster with DVR compositing. Rays are traversed tile by
+ * tile using the thread pool. Bricks which are classified as fully transparent by \p tf are skipped
+ * using \p bricks and rays are terminated once their opacity exceeds 0.99.
+ *
+ * @param volume       input volume
+ * @param tf           transfer function applied to the normalized volume values
+ * @param camera       camera used for generating the rays
+ * @param dimensions   dimensions of the resulting image
+ * @param settings     raycasting and lighting settings
+ * @param bricks       optional min/max bricks of \p volume for empty space skipping. Needs to
+ *                     match the dimensions of \p volume and settings.channel, otherwise it is
+ *                     ignored.
+ * @return image with a RGBA8 color layer (premultiplied alpha) and a depth layer holding the
+ *         depth of the first non-transparent sample
+ */
+IVW_MODULE_BASE_API std::shared_ptr<Image> raycastVolume(
+    const Volume& volume, const TransferFunction& tf, const Camera& camera, size2_t dimensions,
+    const VolumeRaycastingSettings& settings, const VolumeMinMaxBricks* bricks = nullptr);
+
+}  // namespace util
+
+}  // namespace inviwo
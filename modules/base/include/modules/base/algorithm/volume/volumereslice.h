@@ -0,0 +1,116 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/datastructures/image/imagetypes.h>
+
+#include <memory>
+
+namespace inviwo {
+
+class Volume;
+class Layer;
+class Plane;
+
+namespace util {
+
+/**
+ * Projection of the samples across a slab, see VolumeResliceSettings::thickness
+ */
+enum class SlabProjection { Maximum, Minimum, Average };
+
+/**
+ * A rectangle in world space which defines the image plane of resliceVolume. Pixel (0,0) is
+ * located at the origin, the image x axis along uAxis, and the image y axis along vAxis.
+ */
+struct IVW_MODULE_BASE_API ResliceRect {
+    vec3 origin{0.0f};             ///< world position of the outer corner of the first pixel
+    vec3 uAxis{1.0f, 0.0f, 0.0f};  ///< world space edge along the image x axis
+    vec3 vAxis{0.0f, 1.0f, 0.0f};  ///< world space edge along the image y axis
+
+    /**
+     * Unit normal of the rectangle, i.e. normalize(cross(uAxis, vAxis))
+     */
+    vec3 normal() const;
+    /**
+     * Transformation from the texture coordinates of the resliced layer to world space. The third
+     * coordinate is the offset along the unit normal.
+     */
+    mat4 getTextureToWorldMatrix() const;
+};
+
+/**
+ * Smallest rectangle in \p plane that covers the projection of the bounding box of \p volume.
+ * The image y axis is aligned with the projection of \p up onto the plane, and the normal of the
+ * rectangle matches the plane normal. If \p up is parallel to the normal another axis is used.
+ */
+IVW_MODULE_BASE_API ResliceRect fitResliceRect(const Volume& volume, const Plane& plane,
+                                               const vec3& up);
+
+/**
+ * Settings for resliceVolume
+ */
+struct IVW_MODULE_BASE_API VolumeResliceSettings {
+    InterpolationType interpolation = InterpolationType::Linear;
+    /// World space thickness of a slab centered on the plane, zero samples only the plane
+    float thickness = 0.0f;
+    SlabProjection projection = SlabProjection::Maximum;
+    /// Number of samples across the slab, zero gives about one sample per voxel
+    size_t slabSamples = 0;
+    double fillValue = 0.0;  ///< value of pixels outside of the volume
+    /// Map the values from the data range of the volume to [0, 1]. Values of a volume with an
+    /// empty data range are only shifted by its lower bound.
+    bool normalize = false;
+    size2_t tileSize{32, 32};  ///< Size of the image tiles dispatched to the thread pool
+};
+
+/**
+ * Resamples \p volume in the plane of \p rect, or in a slab around it, on the CPU. The image is
+ * sampled in tiles using the thread pool. Each pixel is sampled at its center, with nearest or
+ * trilinear interpolation of the voxels (clamp-to-edge), samples outside of the volume are
+ * ignored by the slab projection and pixels without any samples inside get the fill value.
+ *
+ * @param volume       input volume
+ * @param rect         world space rectangle of the image, see fitResliceRect
+ * @param dimensions   dimensions of the resulting layer
+ * @param settings     interpolation, slab, and value settings
+ * @return a float layer with the same number of channels as \p volume. The basis of the layer
+ *         has the world space size of \p rect, use ResliceRect::getTextureToWorldMatrix to place
+ *         it in 3D.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<Layer> resliceVolume(
+    const Volume& volume, const ResliceRect& rect, size2_t dimensions,
+    const VolumeResliceSettings& settings = VolumeResliceSettings{});
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -34,6 +34,7 @@
 #include <inviwo/core/util/assertion.h>
 
 #include <cstddef>
+#include <type_traits>
 #include <vector>
 
 namespace inviwo {
@@ -45,11 +46,21 @@ namespace inviwo {
 template <typename T = int>
 class DisjointSets {
 public:
+    /**
+     * Construct an empty DisjointSets, use add() to add sets.
+     */
+    DisjointSets() = default;
+
     /**
      * Construct size disjoint sets with 1 member in each set.
      */
     explicit DisjointSets(T size);
 
+    /**
+     * Add a new set with 1 member and return the element.
+     */
+    T add();
+
     /**
      * Join the sets of element r and s.
      * Requires r and s to be positive and less than size.
@@ -86,6 +97,13 @@ inline DisjointSets<T>::DisjointSets(T size) : array_(size, T{-1}) {
     IVW_ASSERT(size > 0, "Size should be greater than 0");
 }
 
+template <typename T>
+inline T DisjointSets<T>::add() {
+    static_assert(std::is_signed<T>::value, "T must be a signed type");
+    array_.push_back(T{-1});
+    return static_cast<T>(array_.size() - 1);
+}
+
 template <typename T>
 inline bool DisjointSets<T>::join(T r, T s) {
     IVW_ASSERT(r >= 0, "r should be greater than or equal to 0");
@@ -0,0 +1,140 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/diskrepresentation.h>
+#include <inviwo/core/datastructures/volume/volumerepresentation.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * Describes how the voxels of a volume are split into chunks for compressed storage. The chunks
+ * are ordered with x fastest, the last chunk along each axis may be smaller than
+ * chunkDimensions. Within a chunk the voxels are stored with x fastest as well.
+ *
+ * The compressed data is stored as:
+ *  * magic "IVWC" and a uint32 version
+ *  * uint64 number of chunks N
+ *  * N + 1 uint64 offsets, relative to the start of the magic, chunk i occupies
+ *    [offset[i], offset[i + 1])
+ *  * the zlib compressed chunks
+ */
+struct IVW_MODULE_BASE_API VolumeChunks {
+    size3_t dimensions{0};
+    size3_t chunkDimensions{64};
+    size_t bytesPerVoxel = 1;
+
+    /**
+     * Number of chunks along each axis
+     */
+    size3_t count() const;
+    /**
+     * Total number of chunks
+     */
+    size_t size() const;
+    /**
+     * Position of the first voxel of the chunk
+     */
+    size3_t chunkOffset(size_t chunk) const;
+    /**
+     * Dimensions of the chunk
+     */
+    size3_t chunkExtent(size_t chunk) const;
+};
+
+/**
+ * Compress the voxels in @p data in chunks and write them to @p file, see VolumeChunks for the
+ * layout. The chunks are compressed in parallel using the thread pool, while earlier chunks are
+ * being written.
+ * @param file the file to write, will be overwritten
+ * @param data the voxels of the whole volume
+ * @param chunks the chunk layout
+ * @param level the zlib compression level, 1 (fastest) to 9 (smallest)
+ * @throws DataWriterException if the file could not be written or the compression failed
+ */
+IVW_MODULE_BASE_API void writeVolumeChunks(const std::string& file, const void* data,
+                                           const VolumeChunks& chunks, int level = 1);
+
+/**
+ * Read the chunk index of a file written by writeVolumeChunks
+ * @param file the file to read
+ * @param byteOffset position of the compressed data in the file
+ * @param chunks the chunk layout
+ * @return the N + 1 chunk offsets, relative to byteOffset
+ * @throws DataReaderException if the index is missing or does not match the layout
+ */
+IVW_MODULE_BASE_API std::vector<std::uint64_t> readVolumeChunkIndex(const std::string& file,
+                                                                    size_t byteOffset,
+                                                                    const VolumeChunks& chunks);
+
+/**
+ * Read the sub-region [offset, offset + dimensions) from a file written by writeVolumeChunks
+ * into @p dest. Only the chunks intersecting the region are read, and they are decompressed in
+ * parallel using the thread pool while the next chunks are read from disk.
+ * @param dest buffer of glm::compMul(dimensions) * chunks.bytesPerVoxel bytes
+ * @throws DataReaderException if the file could not be read or the data is corrupt
+ */
+IVW_MODULE_BASE_API void readVolumeChunks(const std::string& file, size_t byteOffset,
+                                          const VolumeChunks& chunks, const size3_t& offset,
+                                          const size3_t& dimensions, void* dest);
+
+}  // namespace util
+
+/**
+ * \class ChunkedVolumeRAMLoader
+ * \brief A loader of volumes stored in compressed chunks, see util::VolumeChunks.
+ * Used by the IvfVolumeReader to create VolumeRAM representations.
+ */
+class IVW_MODULE_BASE_API ChunkedVolumeRAMLoader
+    : public DiskRepresentationLoader<VolumeRepresentation> {
+public:
+    ChunkedVolumeRAMLoader(const std::string& file, size_t byteOffset,
+                           const size3_t& chunkDimensions);
+    virtual ChunkedVolumeRAMLoader* clone() const override;
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
+        const VolumeRepresentation& src) const override;
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
+                                      const VolumeRepresentation& src) const override;
+
+private:
+    std::string file_;
+    size_t byteOffset_;
+    size3_t chunkDimensions_;
+};
+
+}  // namespace inviwo
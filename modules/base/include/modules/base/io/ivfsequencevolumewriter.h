@@ -96,9 +96,17 @@ public:
     void setOverwrite(bool overwrite) { overwrite_ = overwrite; }
     bool getOverwrite() const { return overwrite_; }
 
+    /**
+     * Store the voxels of the sequence elements in compressed chunks
+     * @see util::IvfCompression
+     */
+    void setCompression(const util::IvfCompression& compression) { compression_ = compression; }
+    const util::IvfCompression& getCompression() const { return compression_; }
+
 private:
     IvfVolumeWriter writer_;
     bool overwrite_;
+    util::IvfCompression compression_;
 };
 
 namespace util {
@@ -123,7 +131,8 @@ namespace util {
 IVW_MODULE_BASE_API std::string writeIvfVolumeSequence(const VolumeSequence& volumes,
                                                        std::string name, std::string path,
                                                        std::string reltivePathToElements = "",
-                                                       bool overwrite = true);
+                                                       bool overwrite = true,
+                                                       const IvfCompression& compression = {});
 }  // namespace util
 
 }  // namespace inviwo
@@ -50,6 +50,21 @@ public:
     virtual std::shared_ptr<Volume> readData(const std::string& filePath) override;
 };
 
+namespace util {
+
+/**
+ * Read the sub-region [offset, offset + dimensions) of an ivf volume. The basis and offset of the
+ * returned volume are adjusted to place it where the region is in the full volume. For volumes
+ * written with util::IvfCompression only the chunks intersecting the region are read, otherwise
+ * the whole volume is read and a view of the region is returned.
+ * @throws DataReaderException if the file could not be read or the region is outside the volume
+ */
+IVW_MODULE_BASE_API std::shared_ptr<Volume> readIvfVolumeRegion(const std::string& filePath,
+                                                                const size3_t& offset,
+                                                                const size3_t& dimensions);
+
+}  // namespace util
+
 }  // namespace inviwo
 
 #endif  // IVW_IVFVOLUMEREADER_H
@@ -37,6 +37,22 @@
 
 namespace inviwo {
 
+namespace util {
+
+/**
+ * Settings for storing the voxels of an ivf volume in zlib compressed chunks. The chunks are
+ * compressed in parallel when writing, and decompressed in parallel when reading. The chunk
+ * index also allows reading sub-regions without decompressing the whole volume, see
+ * util::readIvfVolumeRegion.
+ */
+struct IvfCompression {
+    bool enabled = false;
+    int level = 1;  ///< zlib compression level, 1 (fastest) to 9 (smallest)
+    size3_t chunkDimensions{64};
+};
+
+}  // namespace util
+
 /**
  * \ingroup dataio
  */
@@ -49,11 +65,18 @@ public:
     virtual ~IvfVolumeWriter() {}
 
     virtual void writeData(const Volume* data, const std::string filePath) const;
+
+    void setCompression(const util::IvfCompression& compression);
+    const util::IvfCompression& getCompression() const;
+
+private:
+    util::IvfCompression compression_;
 };
 
 namespace util {
 IVW_MODULE_BASE_API void writeIvfVolume(const Volume& data, const std::string filePath,
-                                        bool overwrite = false);
+                                        bool overwrite = false,
+                                        const IvfCompression& compression = {});
 }
 
 }  // namespace inviwo
@@ -0,0 +1,84 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/ports/imageport.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/minmaxproperty.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <modules/base/algorithm/morphology.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.ImageMorphology, Image Morphology}
+ * ![](org.inviwo.ImageMorphology.png?classIdentifier=org.inviwo.ImageMorphology)
+ * Erosion, dilation, opening, and closing of the color layer of an image on the CPU,
+ * @see util::layerMorphology.
+ *
+ * ### Inports
+ *   * __inputImage__ input image
+ *
+ * ### Outports
+ *   * __outputImage__ the result, with the same format as the input or a DataUInt8 mask in
+ *                     binary mode
+ *
+ * ### Properties
+ *   * __Operation__ erode, dilate, open, or close
+ *   * __Shape__ box or disk (ellipse for unequal radii) structuring element
+ *   * __Radius__ radius of the structuring element in pixels along each axis
+ *   * __Binary__ operate on a mask of the pixels within the foreground range instead of the
+ *                values of each channel
+ *   * __Foreground Range__ range of the first channel that is foreground
+ */
+class IVW_MODULE_BASE_API ImageMorphology : public Processor {
+public:
+    ImageMorphology();
+    virtual ~ImageMorphology() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    ImageInport inport_;
+    ImageOutport outport_;
+
+    TemplateOptionProperty<util::MorphologyOperation> operation_;
+    TemplateOptionProperty<util::MorphologyShape> shape_;
+    IntSize2Property radius_;
+    BoolProperty binary_;
+    DoubleMinMaxProperty foreground_;
+};
+
+}  // namespace inviwo
@@ -0,0 +1,86 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/cameraproperty.h>
+#include <inviwo/core/properties/simplelightingproperty.h>
+#include <inviwo/core/interaction/cameratrackball.h>
+#include <inviwo/core/ports/imageport.h>
+#include <inviwo/core/ports/meshport.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.MeshRasterizerCPU, Mesh Renderer CPU}
+ * ![](org.inviwo.MeshRasterizerCPU.png?classIdentifier=org.inviwo.MeshRasterizerCPU)
+ * Renders the input meshes on the CPU. The rendering corresponds to the MeshRenderer without
+ * blending but does not require OpenGL, and thus can be used for headless rendering, e.g. of
+ * thumbnails together with the ImageExport. The image is divided into tiles which are rasterized
+ * in parallel using the thread pool.
+ *
+ * ### Inports
+ *   * __geometry__ input meshes
+ *
+ * ### Outports
+ *   * __image__ output image containing the rendered meshes, their depth, and picking colors
+ *
+ * ### Properties
+ *   * __Camera__         camera used for rendering
+ *   * __Lighting__       lighting properties applied to triangles
+ *   * __Flat Shading__   shade triangles using their face normal
+ *   * __Default Color__  color of meshes without a color buffer
+ *   * __Point Size__     size of points in pixels
+ */
+class IVW_MODULE_BASE_API MeshRasterizerCPU : public Processor {
+public:
+    MeshRasterizerCPU();
+    virtual ~MeshRasterizerCPU() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    MeshFlatMultiInport inport_;
+    ImageOutport outport_;
+
+    CameraProperty camera_;
+    SimpleLightingProperty lighting_;
+    CameraTrackball trackball_;
+    BoolProperty flatShading_;
+    FloatVec4Property defaultColor_;
+    FloatProperty pointSize_;
+};
+
+}  // namespace inviwo
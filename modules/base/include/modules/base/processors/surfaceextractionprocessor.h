@@ -58,6 +58,10 @@ namespace inviwo {
  * ### Properties
  *   * __ISO Value__ ...
  *   * __Triangle Color__ ...
+ *   * __Precompute Neighbouring ISO Values__ Extract the surfaces for the next and previous step
+ *     of the ISO value in the background, such that stepping through ISO values is served from
+ *     a cache.
+ *   * __Cache Size (MB)__ Memory limit of the cached surfaces.
  *
  */
 class IVW_MODULE_BASE_API SurfaceExtraction : public PoolProcessor {
@@ -78,6 +82,8 @@ public:
 
     virtual void process() override;
 
+    const pool::CacheStats& getCacheStats() const;
+
 protected:
     void updateColors();
     vec4 getColor(size_t i) const;
@@ -91,6 +97,11 @@ protected:
     BoolProperty invertIso_;
     BoolProperty encloseSurface_;
     CompositeProperty colors_;
+    BoolProperty speculate_;
+    IntSizeTProperty cacheSize_;
+
+    // surfaces of all volumes for ISO values on the increment grid, keyed by the ISO value
+    pool::SpeculativeCache<double, std::vector<std::shared_ptr<Mesh>>> cache_;
 };
 
 }  // namespace inviwo
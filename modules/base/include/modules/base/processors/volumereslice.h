@@ -0,0 +1,98 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/ports/imageport.h>
+#include <inviwo/core/ports/volumeport.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <modules/base/algorithm/volume/volumereslice.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.VolumeReslice, Volume Reslice}
+ * ![](org.inviwo.VolumeReslice.png?classIdentifier=org.inviwo.VolumeReslice)
+ * Resamples an arbitrary plane, or a slab around it, through a volume on the CPU,
+ * @see util::resliceVolume. The image covers the projection of the volume onto the plane.
+ *
+ * ### Inports
+ *   * __inputVolume__ input volume
+ *
+ * ### Outports
+ *   * __outputImage__ float image with the same number of channels as the volume
+ *
+ * ### Properties
+ *   * __View__ axial (xy), coronal (xz), sagittal (yz) plane in world space, or custom
+ *   * __Plane Position__ a point on the plane in texture coordinates of the volume
+ *   * __Plane Normal__ world space normal of a custom plane
+ *   * __Up Vector__ world space direction of the image y axis of a custom plane
+ *   * __Zoom__ magnification around the center of the image
+ *   * __Output Dimensions__ dimensions of the output image
+ *   * __Interpolation__ nearest or trilinear interpolation
+ *   * __Slab Thickness__ world space thickness of the slab, zero for a plane
+ *   * __Slab Projection__ maximum, minimum, or average of the samples across the slab
+ *   * __Normalize__ map the values from the data range of the volume to [0, 1]
+ *   * __Fill Value__ value of pixels outside of the volume
+ */
+class IVW_MODULE_BASE_API VolumeReslice : public Processor {
+public:
+    enum class View { Axial, Coronal, Sagittal, Custom };
+
+    VolumeReslice();
+    virtual ~VolumeReslice() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    void updateView();
+
+    VolumeInport inport_;
+    ImageOutport outport_;
+
+    TemplateOptionProperty<View> view_;
+    FloatVec3Property position_;
+    FloatVec3Property normal_;
+    FloatVec3Property up_;
+    FloatProperty zoom_;
+    IntSize2Property dimensions_;
+    TemplateOptionProperty<InterpolationType> interpolation_;
+    FloatProperty thickness_;
+    TemplateOptionProperty<util::SlabProjection> projection_;
+    BoolProperty normalize_;
+    DoubleProperty fillValue_;
+};
+
+}  // namespace inviwo
@@ -38,6 +38,7 @@
 #include <inviwo/core/util/spatialsampler.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/util/volumesampler.h>
+#include <inviwo/core/util/volumesequenceutils.h>
 
 namespace inviwo {
 
@@ -100,6 +101,8 @@ private:
     DataOutport<SpatialSampler<3, 3, double>> sampler_;
 
     DoubleProperty timestamp_;
+
+    util::TimeIndex timeIndex_;
 };
 
 }  // namespace inviwo
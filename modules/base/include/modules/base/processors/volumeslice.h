@@ -57,6 +57,9 @@ namespace inviwo {
  * ### Properties
  *   * __sliceAlongAxis_ Defines the volume axis for the output slice
  *   * __sliceNumber_ Defines the slice number for the output slice
+ *   * __Use Bricked Layout__ Extract the slice from a bricked copy of the volume. The copy is
+ *     created once and kept with the volume, after which slices along any axis are read with
+ *     the same locality. Useful when slicing large volumes along x.
  */
 
 /**
@@ -90,6 +93,7 @@ private:
 
     TemplateOptionProperty<CartesianCoordinateAxis> sliceAlongAxis_;
     IntSizeTProperty sliceNumber_;
+    BoolProperty useBrickedLayout_;
 
     BoolProperty handleInteractionEvents_;
 
@@ -31,8 +31,10 @@
 #include <inviwo/core/datastructures/geometry/mesh.h>
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/threadarena.h>
 
 #include <algorithm>
+#include <array>
 
 namespace inviwo {
 
@@ -58,8 +60,11 @@ std::optional<glm::u32vec2> sutherlandHodgman(glm::u32vec3 triangle, const Plane
                                               std::vector<std::uint32_t>& indices,
                                               const InterpolateFunctor& addInterpolatedVertex) {
 
-    std::vector<std::uint32_t> newIndices;
-    std::vector<std::uint32_t> newEdge;
+    // A clipped triangle has at most 4 vertices and one new edge
+    std::array<std::uint32_t, 4> newIndices{};
+    size_t nIndices = 0;
+    std::array<std::uint32_t, 2> newEdge{};
+    size_t nEdge = 0;
 
     for (size_t i = 0; i < 3; ++i) {
         const auto i1 = triangle[i];
@@ -69,28 +74,28 @@ std::optional<glm::u32vec2> sutherlandHodgman(glm::u32vec3 triangle, const Plane
 
         if (plane.isInside(v1)) {
             if (plane.isInside(v2)) {  // Case 1
-                newIndices.push_back(i2);
+                newIndices[nIndices++] = i2;
             } else {  // Case 2
                 const auto weight = *plane.getIntersectionWeight(v1, v2);
                 const auto newIndex =
                     addInterpolatedVertex({i1, i2}, {1.0f - weight, weight}, std::nullopt);
-                newIndices.push_back(newIndex);
-                newEdge.push_back(newIndex);
+                newIndices[nIndices++] = newIndex;
+                newEdge[nEdge++] = newIndex;
             }
         } else if (plane.isInside(v2)) {  // Case 3
             const auto weight = *plane.getIntersectionWeight(v1, v2);
             const auto newIndex =
                 addInterpolatedVertex({i1, i2}, {1.0f - weight, weight}, std::nullopt);
-            newIndices.push_back(newIndex);
-            newEdge.push_back(newIndex);
-            newIndices.push_back(i2);
+            newIndices[nIndices++] = newIndex;
+            newEdge[nEdge++] = newIndex;
+            newIndices[nIndices++] = i2;
         }
     }
-    if (newIndices.size() == 3) {
+    if (nIndices == 3) {
         indices.push_back(newIndices[0]);
         indices.push_back(newIndices[1]);
         indices.push_back(newIndices[2]);
-    } else if (newIndices.size() == 4) {
+    } else if (nIndices == 4) {
         indices.push_back(newIndices[0]);
         indices.push_back(newIndices[1]);
         indices.push_back(newIndices[2]);
@@ -99,15 +104,15 @@ std::optional<glm::u32vec2> sutherlandHodgman(glm::u32vec3 triangle, const Plane
         indices.push_back(newIndices[2]);
         indices.push_back(newIndices[3]);
     }
-    if (newEdge.size() == 2) {
+    if (nEdge == 2) {
         return glm::u32vec2{newEdge[0], newEdge[1]};
     } else {
         return std::nullopt;
     }
 }
 
-void removeDuplicateEdges(std::vector<glm::u32vec2>& cuts, const std::vector<vec3>& positions,
-                          float eps) {
+void removeDuplicateEdges(std::pmr::vector<glm::u32vec2>& cuts,
+                          const std::vector<vec3>& positions, float eps) {
 
     cuts.erase(
         std::remove_if(cuts.begin(), cuts.end(),
@@ -145,11 +150,12 @@ void removeDuplicateEdges(std::vector<glm::u32vec2>& cuts, const std::vector<vec
                cuts.end());
 }
 
-std::vector<std::vector<std::uint32_t>> gatherLoops(std::vector<glm::u32vec2>& edges,
-                                                    const std::vector<vec3>& positions, float eps) {
-    std::vector<std::vector<std::uint32_t>> loops;
+std::pmr::vector<std::pmr::vector<std::uint32_t>> gatherLoops(
+    std::pmr::vector<glm::u32vec2>& edges, const std::vector<vec3>& positions, float eps) {
+    std::pmr::vector<std::pmr::vector<std::uint32_t>> loops{edges.get_allocator()};
 
-    auto findMatch = [eps, &positions](std::vector<glm::u32vec2>& edges, std::uint32_t index) {
+    auto findMatch = [eps, &positions](std::pmr::vector<glm::u32vec2>& edges,
+                                       std::uint32_t index) {
         const auto it1 = std::find_if(edges.begin(), edges.end(), [&](glm::u32vec2 edge) {
             return glm::all(glm::equal(positions[edge[0]], positions[index], eps));
         });
@@ -250,7 +256,7 @@ vec2 polygonCentroid(const std::vector<vec2>& polygon) {
     return center;
 }
 
-void capHoles(std::vector<glm::u32vec2>& edges, const Plane& plane,
+void capHoles(std::pmr::vector<glm::u32vec2>& edges, const Plane& plane,
               const std::vector<vec3>& positions, std::vector<std::uint32_t>& indices,
               const InterpolateFunctor& addInterpolatedVertex) {
 
@@ -291,7 +297,8 @@ void capHoles(std::vector<glm::u32vec2>& edges, const Plane& plane,
             glm::cross(positions[loop[0]] - center, positions[loop[1]] - center);
         const auto dir = glm::dot(plane.getNormal(), orientation);
 
-        const auto centerIndex = addInterpolatedVertex(loop, weights, -plane.getNormal());
+        const auto centerIndex = addInterpolatedVertex(
+            std::vector<std::uint32_t>(loop.begin(), loop.end()), weights, -plane.getNormal());
         for (size_t i = 0; i < loop.size(); ++i) {
             const auto j = (i + 1) % loop.size();
             indices.push_back(centerIndex);
@@ -303,13 +310,13 @@ void capHoles(std::vector<glm::u32vec2>& edges, const Plane& plane,
     }
 }
 
-std::vector<glm::u32vec2> clipIndices(const Mesh::MeshInfo& meshInfo,
-                                      std::shared_ptr<Mesh>& clippedMesh,
-                                      const std::vector<uint32_t>& indices, const Plane& plane,
-                                      const std::vector<vec3>& positions,
-                                      const InterpolateFunctor& addInterpolatedVertex) {
+std::pmr::vector<glm::u32vec2> clipIndices(const Mesh::MeshInfo& meshInfo,
+                                           std::shared_ptr<Mesh>& clippedMesh,
+                                           const std::vector<uint32_t>& indices,
+                                           const Plane& plane, const std::vector<vec3>& positions,
+                                           const InterpolateFunctor& addInterpolatedVertex) {
 
-    std::vector<glm::u32vec2> newEdges;
+    std::pmr::vector<glm::u32vec2> newEdges{util::threadArena()};
 
     if (meshInfo.dt == DrawType::Points) {
         auto outIndices = clippedMesh->addIndexBuffer(DrawType::Points, meshInfo.ct);
@@ -321,7 +328,7 @@ std::vector<glm::u32vec2> clipIndices(const Mesh::MeshInfo& meshInfo,
 
     } else if (meshInfo.dt == DrawType::Lines) {
         if (meshInfo.ct == ConnectivityType::None) {
-            if (indices.size() < 2) return {};
+            if (indices.size() < 2) return newEdges;
             auto outIndices = clippedMesh->addIndexBuffer(DrawType::Lines, ConnectivityType::None);
             for (unsigned int l = 0; l < indices.size() - 1; l += 2) {
                 const auto i1 = indices[l];
@@ -546,8 +553,10 @@ std::shared_ptr<Mesh> clipMeshAgainstPlane(const Mesh& mesh, const Plane& worldS
                         IVW_CONTEXT_CUSTOM("MeshClipping"));
     }
 
+    // The cut edges and loops are only needed during the clipping, keep them in the arena
+    util::ArenaScope arena;
     const auto& positions = posBuffer->getDataContainer();
-    std::vector<glm::u32vec2> newEdges;
+    std::pmr::vector<glm::u32vec2> newEdges{arena.resource()};
 
     for (const auto& item : mesh.getIndexBuffers()) {
         const auto meshInfo = item.first;
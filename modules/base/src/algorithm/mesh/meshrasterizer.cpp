@@ -0,0 +1,605 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/mesh/meshrasterizer.h>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/datastructures/camera/camera.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/datastructures/image/image.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/interaction/pickingmanager.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <numeric>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+/**
+ * Vertex after the vertex transformation, in clip space
+ */
+struct ClipVertex {
+    vec4 clip;
+    vec3 world;
+    vec3 normal;
+    vec4 color;
+    std::uint32_t picking;
+};
+
+ClipVertex mix(const ClipVertex& a, const ClipVertex& b, float t) {
+    return {glm::mix(a.clip, b.clip, t), glm::mix(a.world, b.world, t),
+            glm::mix(a.normal, b.normal, t), glm::mix(a.color, b.color, t), b.picking};
+}
+
+// signed distance to the near plane in clip space, positive on the visible side
+float nearDistance(const ClipVertex& v) { return v.clip.z + v.clip.w; }
+
+/**
+ * Vertex in screen space. The attributes are divided by w for perspective correct interpolation.
+ */
+struct ScreenVertex {
+    vec3 pos;  ///< x and y in pixels, z is the depth in [0,1]
+    float invW;
+    vec3 world;
+    vec3 normal;
+    vec4 color;
+    std::uint32_t picking;
+};
+
+enum class PrimitiveType : std::uint8_t { Point, Line, Triangle };
+
+struct Primitive {
+    PrimitiveType type;
+    bool vertexNormals;  ///< Use the interpolated vertex normals instead of the face normal
+    bool picking;
+    std::array<std::uint32_t, 3> vertices;  ///< Indices of the screen vertices
+    vec3 faceNormal;
+};
+
+template <typename Result>
+std::vector<Result> toVectors(const BufferBase& buffer, const Result& defaultValue) {
+    return buffer.getRepresentation<BufferRAM>()->dispatch<std::vector<Result>>([&](auto br) {
+        using ValueType = util::PrecisionValueType<decltype(br)>;
+        constexpr size_t components =
+            std::min(util::extent<ValueType>::value, util::extent<Result>::value);
+        const auto& data = br->getDataContainer();
+
+        std::vector<Result> res(data.size(), defaultValue);
+        for (size_t i = 0; i < data.size(); ++i) {
+            for (size_t c = 0; c < components; ++c) {
+                res[i][static_cast<glm::length_t>(c)] =
+                    static_cast<float>(util::glmcomp(data[i], c));
+            }
+        }
+        return res;
+    });
+}
+
+std::vector<std::uint32_t> toIds(const BufferBase& buffer) {
+    return buffer.getRepresentation<BufferRAM>()->dispatch<std::vector<std::uint32_t>>(
+        [&](auto br) {
+            const auto& data = br->getDataContainer();
+            std::vector<std::uint32_t> res(data.size());
+            std::transform(data.begin(), data.end(), res.begin(), [](const auto& v) {
+                return static_cast<std::uint32_t>(static_cast<double>(util::glmcomp(v, 0)));
+            });
+            return res;
+        });
+}
+
+/**
+ * Calls \p point, \p line, or \p triangle for each primitive given by \p indices, following the
+ * primitive assembly of OpenGL for the corresponding draw mode (see MeshDrawerGL::getDrawMode).
+ */
+template <typename PointFunc, typename LineFunc, typename TriangleFunc>
+void assemblePrimitives(DrawType dt, ConnectivityType ct, const std::vector<std::uint32_t>& indices,
+                        PointFunc point, LineFunc line, TriangleFunc triangle) {
+    const auto& ind = indices;
+    const size_t n = ind.size();
+
+    if (dt == DrawType::Triangles) {
+        switch (ct) {
+            case ConnectivityType::None:
+                for (size_t i = 0; i + 2 < n; i += 3) triangle(ind[i], ind[i + 1], ind[i + 2]);
+                return;
+            case ConnectivityType::Strip:
+                for (size_t i = 0; i + 2 < n; ++i) {
+                    if (i % 2 == 0) {
+                        triangle(ind[i], ind[i + 1], ind[i + 2]);
+                    } else {
+                        triangle(ind[i + 1], ind[i], ind[i + 2]);
+                    }
+                }
+                return;
+            case ConnectivityType::Fan:
+                for (size_t i = 1; i + 1 < n; ++i) triangle(ind[0], ind[i], ind[i + 1]);
+                return;
+            case ConnectivityType::Adjacency:
+                for (size_t i = 0; i + 5 < n; i += 6) triangle(ind[i], ind[i + 2], ind[i + 4]);
+                return;
+            case ConnectivityType::StripAdjacency:
+                for (size_t i = 0; 2 * i + 5 < n; ++i) {
+                    if (i % 2 == 0) {
+                        triangle(ind[2 * i], ind[2 * i + 2], ind[2 * i + 4]);
+                    } else {
+                        triangle(ind[2 * i + 2], ind[2 * i], ind[2 * i + 4]);
+                    }
+                }
+                return;
+            default:
+                break;
+        }
+    } else if (dt == DrawType::Lines) {
+        switch (ct) {
+            case ConnectivityType::None:
+                for (size_t i = 0; i + 1 < n; i += 2) line(ind[i], ind[i + 1]);
+                return;
+            case ConnectivityType::Strip:
+                for (size_t i = 0; i + 1 < n; ++i) line(ind[i], ind[i + 1]);
+                return;
+            case ConnectivityType::Loop:
+                for (size_t i = 0; i + 1 < n; ++i) line(ind[i], ind[i + 1]);
+                if (n > 1) line(ind[n - 1], ind[0]);
+                return;
+            case ConnectivityType::Adjacency:
+                for (size_t i = 0; i + 3 < n; i += 4) line(ind[i + 1], ind[i + 2]);
+                return;
+            case ConnectivityType::StripAdjacency:
+                for (size_t i = 1; i + 2 < n; ++i) line(ind[i], ind[i + 1]);
+                return;
+            default:
+                break;
+        }
+    }
+    // Points, and invalid combinations of draw and connectivity type, are drawn as points
+    for (auto i : ind) point(i);
+}
+
+/**
+ * Transforms, clips, and bins the primitives of the meshes into image tiles
+ */
+class PrimitiveSetup {
+public:
+    PrimitiveSetup(const Camera& camera, size2_t dimensions,
+                   const MeshRasterizationSettings& settings)
+        : worldToClip_{camera.getProjectionMatrix() * camera.getViewMatrix()}
+        , dimensions_{dimensions}
+        , tileSize_{glm::max(settings.tileSize, size2_t{1})}
+        , tiles_{(dimensions + tileSize_ - size2_t{1}) / tileSize_}
+        , pointRadius_{0.5f * std::max(settings.pointSize, 1.0f)}
+        , settings_{settings}
+        , bins_(tiles_.x * tiles_.y) {}
+
+    void add(const Mesh& mesh) {
+        const auto posBuffer = mesh.findBuffer(BufferType::PositionAttrib).first;
+        if (!posBuffer || posBuffer->getSize() == 0) return;
+
+        const auto positions = toVectors(*posBuffer, vec4{0.0f, 0.0f, 0.0f, 1.0f});
+        const size_t size = positions.size();
+
+        const auto getAttrib = [&](BufferType type, const auto& defaultValue) {
+            using T = std::decay_t<decltype(defaultValue)>;
+            const auto buffer = mesh.findBuffer(type).first;
+            if (buffer && buffer->getSize() >= size) return toVectors(*buffer, defaultValue);
+            return std::vector<T>{};
+        };
+        const auto normals = getAttrib(BufferType::NormalAttrib, vec3{0.0f});
+        const auto colors = getAttrib(BufferType::ColorAttrib, vec4{0.0f, 0.0f, 0.0f, 1.0f});
+        std::vector<std::uint32_t> pickingIds;
+        if (const auto buffer = mesh.findBuffer(BufferType::PickingAttrib).first;
+            buffer && buffer->getSize() >= size) {
+            pickingIds = toIds(*buffer);
+        }
+
+        const mat4 dataToWorld{mesh.getCoordinateTransformer().getDataToWorldMatrix()};
+        const mat3 normalToWorld{glm::transpose(glm::inverse(mat3(dataToWorld)))};
+
+        base_ = static_cast<std::uint32_t>(vertices_.size());
+        clipVertices_.resize(size);
+        for (size_t i = 0; i < size; ++i) {
+            const vec4 world = dataToWorld * positions[i];
+            auto& v = clipVertices_[i];
+            v.clip = worldToClip_ * world;
+            v.world = vec3(world) / world.w;
+            v.normal = normals.empty() ? vec3{0.0f} : normalToWorld * normals[i];
+            v.color = colors.empty() ? settings_.defaultColor : colors[i];
+            v.picking = pickingIds.empty() ? 0 : pickingIds[i];
+            vertices_.push_back(project(v));
+        }
+        vertexNormals_ = !normals.empty() && !settings_.flatShading;
+        picking_ = !pickingIds.empty();
+
+        const auto assemble = [&](DrawType dt, ConnectivityType ct,
+                                  const std::vector<std::uint32_t>& indices) {
+            assemblePrimitives(
+                dt, ct, indices, [&](std::uint32_t a) { addPoint(a); },
+                [&](std::uint32_t a, std::uint32_t b) { addLine(a, b); },
+                [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) { addTriangle(a, b, c); });
+        };
+
+        if (mesh.getNumberOfIndicies() == 0) {
+            std::vector<std::uint32_t> indices(size);
+            std::iota(indices.begin(), indices.end(), 0);
+            const auto info = mesh.getDefaultMeshInfo();
+            assemble(info.dt, info.ct, indices);
+        } else {
+            for (const auto& [info, indexBuffer] : mesh.getIndexBuffers()) {
+                auto indices = indexBuffer->getRAMRepresentation()->getDataContainer();
+                // ignore out of range indices
+                indices.erase(std::remove_if(indices.begin(), indices.end(),
+                                             [&](std::uint32_t i) { return i >= size; }),
+                              indices.end());
+                assemble(info.dt, info.ct, indices);
+            }
+        }
+    }
+
+    size2_t getTileSize() const { return tileSize_; }
+    size2_t getTiles() const { return tiles_; }
+    const std::vector<ScreenVertex>& getVertices() const { return vertices_; }
+    const std::vector<Primitive>& getPrimitives() const { return primitives_; }
+    const std::vector<std::uint32_t>& getBin(size_t tile) const { return bins_[tile]; }
+
+private:
+    ScreenVertex project(const ClipVertex& v) const {
+        const float invW = v.clip.w != 0.0f ? 1.0f / v.clip.w : 0.0f;
+        const vec3 ndc = vec3(v.clip) * invW;
+        const vec2 screen = (vec2(ndc) * 0.5f + 0.5f) * vec2(dimensions_);
+        return {vec3(screen, ndc.z * 0.5f + 0.5f), invW,    v.world * invW,
+                v.normal * invW,                   v.color * invW, v.picking};
+    }
+
+    std::uint32_t addVertex(const ClipVertex& v) {
+        vertices_.push_back(project(v));
+        return static_cast<std::uint32_t>(vertices_.size() - 1);
+    }
+
+    void addPoint(std::uint32_t a) {
+        const auto& v = clipVertices_[a];
+        if (nearDistance(v) < 0.0f || v.clip.z > v.clip.w) return;
+        const vec2 pos{vertices_[base_ + a].pos};
+        bin({PrimitiveType::Point, false, picking_, {base_ + a, 0, 0}, vec3{0.0f}},
+            pos - pointRadius_, pos + pointRadius_);
+    }
+
+    void addLine(std::uint32_t a, std::uint32_t b) {
+        const auto& va = clipVertices_[a];
+        const auto& vb = clipVertices_[b];
+        const float da = nearDistance(va);
+        const float db = nearDistance(vb);
+        if (da < 0.0f && db < 0.0f) return;
+
+        std::uint32_t ia = base_ + a;
+        std::uint32_t ib = base_ + b;
+        if (da < 0.0f) {
+            ia = addVertex(mix(va, vb, da / (da - db)));
+        } else if (db < 0.0f) {
+            ib = addVertex(mix(va, vb, da / (da - db)));
+        }
+        const vec2 pa{vertices_[ia].pos};
+        const vec2 pb{vertices_[ib].pos};
+        bin({PrimitiveType::Line, false, picking_, {ia, ib, 0}, vec3{0.0f}},
+            glm::min(pa, pb) - 1.0f, glm::max(pa, pb) + 1.0f);
+    }
+
+    void addTriangle(std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+        const std::array<const ClipVertex*, 3> v{&clipVertices_[a], &clipVertices_[b],
+                                                 &clipVertices_[c]};
+        const std::array<float, 3> d{nearDistance(*v[0]), nearDistance(*v[1]),
+                                     nearDistance(*v[2])};
+        if (d[0] < 0.0f && d[1] < 0.0f && d[2] < 0.0f) return;
+
+        const vec3 faceNormal = [&]() {
+            const vec3 n = glm::cross(v[1]->world - v[0]->world, v[2]->world - v[0]->world);
+            const float length = glm::length(n);
+            return length > 0.0f ? n / length : vec3{0.0f};
+        }();
+
+        if (d[0] >= 0.0f && d[1] >= 0.0f && d[2] >= 0.0f) {
+            emitTriangle({base_ + a, base_ + b, base_ + c}, faceNormal);
+            return;
+        }
+
+        // Clip the triangle against the near plane, resulting in one or two triangles
+        std::array<std::uint32_t, 4> polygon{};
+        size_t count = 0;
+        const std::array<std::uint32_t, 3> indices{a, b, c};
+        for (size_t i = 0; i < 3; ++i) {
+            const size_t j = (i + 1) % 3;
+            if (d[i] >= 0.0f) polygon[count++] = base_ + indices[i];
+            if ((d[i] >= 0.0f) != (d[j] >= 0.0f)) {
+                polygon[count++] = addVertex(mix(*v[i], *v[j], d[i] / (d[i] - d[j])));
+            }
+        }
+        for (size_t i = 1; i + 1 < count; ++i) {
+            emitTriangle({polygon[0], polygon[i], polygon[i + 1]}, faceNormal);
+        }
+    }
+
+    void emitTriangle(const std::array<std::uint32_t, 3>& indices, const vec3& faceNormal) {
+        const vec2 p0{vertices_[indices[0]].pos};
+        const vec2 p1{vertices_[indices[1]].pos};
+        const vec2 p2{vertices_[indices[2]].pos};
+        bin({PrimitiveType::Triangle, vertexNormals_, picking_, indices, faceNormal},
+            glm::min(p0, glm::min(p1, p2)), glm::max(p0, glm::max(p1, p2)));
+    }
+
+    void bin(const Primitive& primitive, vec2 bboxMin, vec2 bboxMax) {
+        const vec2 dims{dimensions_};
+        // also rejects bounding boxes containing NaNs
+        if (!(bboxMax.x >= 0.0f && bboxMax.y >= 0.0f && bboxMin.x < dims.x &&
+              bboxMin.y < dims.y)) {
+            return;
+        }
+        const size2_t first{glm::clamp(bboxMin, vec2{0.0f}, dims - 1.0f)};
+        const size2_t last{glm::clamp(bboxMax, vec2{0.0f}, dims - 1.0f)};
+        const size2_t firstTile = first / tileSize_;
+        const size2_t lastTile = last / tileSize_;
+
+        const auto index = static_cast<std::uint32_t>(primitives_.size());
+        primitives_.push_back(primitive);
+        for (size_t y = firstTile.y; y <= lastTile.y; ++y) {
+            for (size_t x = firstTile.x; x <= lastTile.x; ++x) {
+                bins_[x + y * tiles_.x].push_back(index);
+            }
+        }
+    }
+
+    mat4 worldToClip_;
+    size2_t dimensions_;
+    size2_t tileSize_;
+    size2_t tiles_;
+    float pointRadius_;
+    const MeshRasterizationSettings& settings_;
+
+    std::vector<ScreenVertex> vertices_;
+    std::vector<Primitive> primitives_;
+    std::vector<std::vector<std::uint32_t>> bins_;
+
+    // state of the mesh currently being added
+    std::vector<ClipVertex> clipVertices_;
+    std::uint32_t base_ = 0;
+    bool vertexNormals_ = false;
+    bool picking_ = false;
+};
+
+}  // namespace
+
+std::shared_ptr<Image> rasterizeMeshes(const std::vector<std::shared_ptr<const Mesh>>& meshes,
+                                       const Camera& camera, size2_t dimensions,
+                                       const MeshRasterizationSettings& settings) {
+    auto colorRep = std::make_shared<LayerRAMPrecision<glm::u8vec4>>(dimensions);
+    auto depthRep = std::make_shared<LayerRAMPrecision<float>>(dimensions, LayerType::Depth);
+    auto pickingRep =
+        std::make_shared<LayerRAMPrecision<glm::u8vec4>>(dimensions, LayerType::Picking);
+    auto colorData = colorRep->getDataTyped();
+    auto depthData = depthRep->getDataTyped();
+    auto pickingData = pickingRep->getDataTyped();
+    std::fill(colorData, colorData + glm::compMul(dimensions), glm::u8vec4{0});
+    std::fill(depthData, depthData + glm::compMul(dimensions), 1.0f);
+    std::fill(pickingData, pickingData + glm::compMul(dimensions), glm::u8vec4{0});
+
+    auto image = std::make_shared<Image>(std::vector<std::shared_ptr<Layer>>{
+        std::make_shared<Layer>(colorRep), std::make_shared<Layer>(depthRep),
+        std::make_shared<Layer>(pickingRep)});
+
+    if (glm::compMul(dimensions) == 0) return image;
+
+    PrimitiveSetup setup{camera, dimensions, settings};
+    for (const auto& mesh : meshes) {
+        if (mesh) setup.add(*mesh);
+    }
+    const auto& vertices = setup.getVertices();
+    const auto& primitives = setup.getPrimitives();
+    if (primitives.empty()) return image;
+
+    const vec3 cameraPos = camera.getLookFrom();
+
+    const auto writeFragment = [&](const size2_t& pixel, float depth, const vec4& color,
+                                   const Primitive& primitive, std::uint32_t pickingId) {
+        const size_t index = pixel.x + pixel.y * dimensions.x;
+        // depth test, equivalent to GL_LESS with depth clipping
+        if (!(depth >= 0.0f && depth <= 1.0f && depth < depthData[index])) return;
+        depthData[index] = depth;
+        colorData[index] =
+            glm::u8vec4(glm::clamp(color * 255.0f + 0.5f, vec4(0.0f), vec4(255.0f)));
+        pickingData[index] =
+            primitive.picking ? glm::u8vec4(PickingManager::indexToRGBA(pickingId))
+                              : glm::u8vec4{0};
+    };
+
+    const auto edge = [](const vec2& a, const vec2& b, const vec2& p) {
+        return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+    };
+
+    const auto drawTriangle = [&](const Primitive& primitive, const size2_t& begin,
+                                  const size2_t& end) {
+        const auto& v0 = vertices[primitive.vertices[0]];
+        const auto& v1 = vertices[primitive.vertices[1]];
+        const auto& v2 = vertices[primitive.vertices[2]];
+        const vec2 p0{v0.pos};
+        const vec2 p1{v1.pos};
+        const vec2 p2{v2.pos};
+        const float area = edge(p0, p1, p2);
+        if (area == 0.0f || !std::isfinite(area)) return;
+
+        const vec2 bboxMin = glm::max(glm::min(p0, glm::min(p1, p2)), vec2(begin));
+        const vec2 bboxMax = glm::min(glm::max(p0, glm::max(p1, p2)), vec2(end));
+        if (bboxMin.x >= bboxMax.x || bboxMin.y >= bboxMax.y) return;
+        // pixel centers within the bounding box
+        const size2_t first{glm::max(glm::ceil(bboxMin - 0.5f), vec2(begin))};
+        const size2_t last{glm::min(glm::floor(bboxMax - 0.5f) + 1.0f, vec2(end))};
+
+        size2_t pixel;
+        for (pixel.y = first.y; pixel.y < last.y; ++pixel.y) {
+            for (pixel.x = first.x; pixel.x < last.x; ++pixel.x) {
+                const vec2 p = vec2(pixel) + 0.5f;
+                const vec3 b = vec3{edge(p1, p2, p), edge(p2, p0, p), edge(p0, p1, p)} / area;
+                if (b.x < 0.0f || b.y < 0.0f || b.z < 0.0f) continue;
+
+                const float depth = b.x * v0.pos.z + b.y * v1.pos.z + b.z * v2.pos.z;
+                const float invW = b.x * v0.invW + b.y * v1.invW + b.z * v2.invW;
+                const float w = 1.0f / invW;
+                const vec3 worldPos = (b.x * v0.world + b.y * v1.world + b.z * v2.world) * w;
+                const vec4 color = (b.x * v0.color + b.y * v1.color + b.z * v2.color) * w;
+                const vec3 toCameraDir = glm::normalize(cameraPos - worldPos);
+
+                vec3 normal = primitive.faceNormal;
+                if (primitive.vertexNormals) {
+                    const vec3 n = b.x * v0.normal + b.y * v1.normal + b.z * v2.normal;
+                    const float length = glm::length(n);
+                    if (length > 0.0f) normal = n / length;
+                } else if (glm::dot(normal, toCameraDir) < 0.0f) {
+                    normal = -normal;
+                }
+
+                // Same material colors as in meshrendering.frag
+                const vec3 shaded =
+                    util::applyLighting(settings.lighting, vec3(color), vec3(color), vec3(1.0f),
+                                        worldPos, normal, toCameraDir);
+                writeFragment(pixel, depth, vec4(shaded, color.a), primitive, v2.picking);
+            }
+        }
+    };
+
+    const auto drawLine = [&](const Primitive& primitive, const size2_t& begin,
+                              const size2_t& end) {
+        const auto& v0 = vertices[primitive.vertices[0]];
+        const auto& v1 = vertices[primitive.vertices[1]];
+        const vec2 p0{v0.pos};
+        const vec2 delta = vec2{v1.pos} - p0;
+        const auto steps = static_cast<size_t>(std::ceil(glm::compMax(glm::abs(delta))));
+        if (steps == 0) return;
+
+        // restrict the line parameter to the tile (Liang-Barsky)
+        float t0 = 0.0f;
+        float t1 = 1.0f;
+        for (glm::length_t i = 0; i < 2; ++i) {
+            const float lower = static_cast<float>(begin[i]) - p0[i];
+            const float upper = static_cast<float>(end[i]) - p0[i];
+            if (delta[i] == 0.0f) {
+                if (lower > 0.0f || upper <= 0.0f) return;
+            } else {
+                const float a = lower / delta[i];
+                const float b = upper / delta[i];
+                t0 = std::max(t0, std::min(a, b));
+                t1 = std::min(t1, std::max(a, b));
+            }
+        }
+        if (t0 > t1) return;
+
+        const auto firstStep = static_cast<size_t>(std::ceil(t0 * steps));
+        const auto lastStep = static_cast<size_t>(std::floor(t1 * steps));
+        for (size_t step = firstStep; step <= lastStep; ++step) {
+            const float t = static_cast<float>(step) / static_cast<float>(steps);
+            const vec2 p = p0 + t * delta;
+            if (p.x < begin.x || p.y < begin.y || p.x >= end.x || p.y >= end.y) continue;
+
+            const float invW = glm::mix(v0.invW, v1.invW, t);
+            const vec4 color = glm::mix(v0.color, v1.color, t) / invW;
+            writeFragment(size2_t{p}, glm::mix(v0.pos.z, v1.pos.z, t), color, primitive,
+                          v1.picking);
+        }
+    };
+
+    const auto drawPoint = [&](const Primitive& primitive, const size2_t& begin,
+                               const size2_t& end) {
+        const auto& v = vertices[primitive.vertices[0]];
+        const float radius = 0.5f * std::max(settings.pointSize, 1.0f);
+        const vec2 center{v.pos};
+        const size2_t first{
+            glm::clamp(glm::ceil(center - radius - 0.5f), vec2(begin), vec2(end))};
+        const size2_t last{
+            glm::clamp(glm::floor(center + radius - 0.5f) + 1.0f, vec2(begin), vec2(end))};
+        const vec4 color = v.color / v.invW;
+
+        size2_t pixel;
+        for (pixel.y = first.y; pixel.y < last.y; ++pixel.y) {
+            for (pixel.x = first.x; pixel.x < last.x; ++pixel.x) {
+                writeFragment(pixel, v.pos.z, color, primitive, v.picking);
+            }
+        }
+    };
+
+    // Each tile is rasterized by a single thread, primitives are drawn in the order of the meshes
+    const size2_t tileSize = setup.getTileSize();
+    const size2_t tiles = setup.getTiles();
+    const size_t numTiles = tiles.x * tiles.y;
+    std::atomic<size_t> nextTile{0};
+    const auto worker = [&]() {
+        for (size_t tile = nextTile++; tile < numTiles; tile = nextTile++) {
+            const size2_t begin = size2_t{tile % tiles.x, tile / tiles.x} * tileSize;
+            const size2_t end = glm::min(begin + tileSize, dimensions);
+            for (auto index : setup.getBin(tile)) {
+                const auto& primitive = primitives[index];
+                switch (primitive.type) {
+                    case PrimitiveType::Triangle:
+                        drawTriangle(primitive, begin, end);
+                        break;
+                    case PrimitiveType::Line:
+                        drawLine(primitive, begin, end);
+                        break;
+                    case PrimitiveType::Point:
+                        drawPoint(primitive, begin, end);
+                        break;
+                }
+            }
+        }
+    };
+
+    const size_t poolSize =
+        InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+    if (poolSize == 0) {
+        worker();
+    } else {
+        std::vector<std::future<void>> futures;
+        for (size_t i = 0; i < std::min(poolSize, numTiles); ++i) {
+            futures.push_back(dispatchPool(worker));
+        }
+        for (auto& f : futures) {
+            f.get();
+        }
+    }
+
+    return image;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,442 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/morphology.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+constexpr std::uint8_t binaryForeground = 255;
+
+/*
+ * Call func(begin, end) for ranges covering [0, count) on the thread pool, or serially if there
+ * is no pool. Returns when all ranges are done.
+ */
+template <typename Func>
+void parallelRanges(size_t count, Func func) {
+    const size_t poolSize =
+        InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+    const size_t jobs = std::min(count, 4 * poolSize);
+
+    if (jobs <= 1) {
+        if (count > 0) func(size_t{0}, count);
+        return;
+    }
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(jobs);
+    std::exception_ptr error;
+    try {
+        for (size_t job = 0; job < jobs; ++job) {
+            const size_t begin = count * job / jobs;
+            const size_t end = count * (job + 1) / jobs;
+            futures.push_back(dispatchPool([&func, begin, end]() { func(begin, end); }));
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+    // wait for all jobs before returning, they reference func
+    for (auto& f : futures) {
+        try {
+            f.get();
+        } catch (...) {
+            if (!error) error = std::current_exception();
+        }
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+/*
+ * The lines of a volume along one axis. Line l starts at offset(l) and has length elements that
+ * are stride apart.
+ */
+struct Lines {
+    Lines(const size3_t& dims, size_t axis) {
+        const size3_t strides{1, dims.x, dims.x * dims.y};
+        const size_t a = axis == 0 ? 1 : 0;
+        const size_t b = axis == 2 ? 1 : 2;
+        count = dims[a] * dims[b];
+        length = dims[axis];
+        stride = strides[axis];
+        inner = dims[a];
+        innerStride = strides[a];
+        outerStride = strides[b];
+    }
+    size_t offset(size_t line) const {
+        return (line % inner) * innerStride + (line / inner) * outerStride;
+    }
+
+    size_t count;
+    size_t length;
+    size_t stride;
+    size_t inner;
+    size_t innerStride;
+    size_t outerStride;
+};
+
+template <typename T, bool Max>
+struct Extremum {
+    using V = typename util::value_type<T>::type;
+
+    static T identity() {
+        const V v = Max ? std::numeric_limits<V>::lowest() : std::numeric_limits<V>::max();
+        if constexpr (util::rank<T>::value == 0) {
+            return v;
+        } else {
+            return T(v);
+        }
+    }
+    static T apply(const T& a, const T& b) {
+        if constexpr (util::rank<T>::value == 0) {
+            return select(a, b);
+        } else {
+            T res;
+            for (size_t i = 0; i < util::extent<T>::value; ++i) res[i] = select(a[i], b[i]);
+            return res;
+        }
+    }
+    static V select(const V& a, const V& b) {
+        if constexpr (Max) {
+            return a < b ? b : a;
+        } else {
+            return b < a ? b : a;
+        }
+    }
+};
+
+/*
+ * Running min/max with a window of 2 * radius + 1 along one line, in place. Van Herk/Gil-Werman:
+ * the padded line is split into blocks of the window size, with prefix extrema g and suffix
+ * extrema h within each block the result for the window starting at j is Op(h[j], g[j + 2r]).
+ */
+template <typename Op, typename T>
+void vanHerk(T* data, size_t n, size_t stride, size_t radius, std::vector<T>& h,
+             std::vector<T>& g) {
+    const size_t k = 2 * radius + 1;
+    const size_t m = n + 2 * radius;
+    h.assign(m, Op::identity());
+    g.resize(m);
+    for (size_t i = 0; i < n; ++i) h[i + radius] = data[i * stride];
+    for (size_t j = 0; j < m; ++j) {
+        g[j] = j % k == 0 ? h[j] : Op::apply(g[j - 1], h[j]);
+    }
+    for (size_t j = m - 1; j-- > 0;) {
+        if (j % k != k - 1) h[j] = Op::apply(h[j + 1], h[j]);
+    }
+    for (size_t i = 0; i < n; ++i) data[i * stride] = Op::apply(h[i], g[i + 2 * radius]);
+}
+
+template <typename Op, typename T>
+void box(T* data, const size3_t& dims, const size3_t& radius) {
+    for (size_t axis = 0; axis < 3; ++axis) {
+        if (radius[axis] == 0 || dims[axis] < 2) continue;
+        const Lines lines{dims, axis};
+        parallelRanges(lines.count, [&](size_t begin, size_t end) {
+            std::vector<T> h;
+            std::vector<T> g;
+            for (size_t l = begin; l < end; ++l) {
+                vanHerk<Op>(data + lines.offset(l), lines.length, lines.stride, radius[axis], h, g);
+            }
+        });
+    }
+}
+
+/*
+ * Spherical kernels as a union of lines along x, the lines are grouped by length such that only
+ * one running min/max along x is needed per length.
+ */
+template <typename Op, typename T>
+void sphere(T* data, const size3_t& dims, const size3_t& radius) {
+    using i64 = std::int64_t;
+    const i64vec3 r{radius};
+    std::map<size_t, std::vector<i64vec2>> linesByLength;
+    for (i64 dz = -r.z; dz <= r.z; ++dz) {
+        for (i64 dy = -r.y; dy <= r.y; ++dy) {
+            const double qy = r.y == 0 ? 0.0 : static_cast<double>(dy * dy) / (r.y * r.y);
+            const double qz = r.z == 0 ? 0.0 : static_cast<double>(dz * dz) / (r.z * r.z);
+            if (qy + qz > 1.0) continue;
+            const auto halfWidth = static_cast<size_t>(
+                std::floor(static_cast<double>(r.x) * std::sqrt(1.0 - qy - qz) + 1.0e-9));
+            linesByLength[halfWidth].emplace_back(dy, dz);
+        }
+    }
+
+    const size_t size = dims.x * dims.y * dims.z;
+    const size_t rows = dims.y * dims.z;
+    std::vector<T> src(data, data + size);
+    std::vector<T> lines(size);
+    std::fill(data, data + size, Op::identity());
+
+    for (const auto& [halfWidth, offsets] : linesByLength) {
+        std::copy(src.begin(), src.end(), lines.begin());
+        box<Op>(lines.data(), dims, size3_t{halfWidth, 0, 0});
+
+        parallelRanges(rows, [&, &offsets = offsets](size_t begin, size_t end) {
+            for (size_t row = begin; row < end; ++row) {
+                const auto y = static_cast<i64>(row % dims.y);
+                const auto z = static_cast<i64>(row / dims.y);
+                T* out = data + row * dims.x;
+                for (const auto& offset : offsets) {
+                    const auto yy = y + offset.x;
+                    const auto zz = z + offset.y;
+                    if (yy < 0 || zz < 0 || yy >= static_cast<i64>(dims.y) ||
+                        zz >= static_cast<i64>(dims.z)) {
+                        continue;
+                    }
+                    const T* in = lines.data() + (yy + zz * static_cast<i64>(dims.y)) * dims.x;
+                    for (size_t x = 0; x < dims.x; ++x) out[x] = Op::apply(out[x], in[x]);
+                }
+            }
+        });
+    }
+}
+
+template <typename T>
+void grayscale(T* data, const size3_t& dims, bool dilate, MorphologyShape shape,
+               const size3_t& radius) {
+    if (shape == MorphologyShape::Box) {
+        if (dilate) {
+            box<Extremum<T, true>>(data, dims, radius);
+        } else {
+            box<Extremum<T, false>>(data, dims, radius);
+        }
+    } else {
+        if (dilate) {
+            sphere<Extremum<T, true>>(data, dims, radius);
+        } else {
+            sphere<Extremum<T, false>>(data, dims, radius);
+        }
+    }
+}
+
+/*
+ * Squared Euclidean distance transform of f in place, f is 0 for features and infinity
+ * elsewhere. The squared distance along each axis is scaled by weights, axes with zero weight are
+ * skipped, i.e. only features at the same position along that axis count. One pass per axis of
+ * the lower envelope algorithm from P. Felzenszwalb and D. Huttenlocher, Distance Transforms of
+ * Sampled Functions, Theory of Computing 8(19), 2012.
+ */
+void distanceTransform(float* f, const size3_t& dims, const dvec3& weights) {
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    for (size_t axis = 0; axis < 3; ++axis) {
+        if (weights[axis] == 0.0 || dims[axis] < 2) continue;
+        const double w = weights[axis];
+        const Lines lines{dims, axis};
+        parallelRanges(lines.count, [&](size_t begin, size_t end) {
+            const size_t n = lines.length;
+            std::vector<float> line(n);
+            std::vector<size_t> v(n);
+            std::vector<double> z(n + 1);
+            for (size_t l = begin; l < end; ++l) {
+                float* data = f + lines.offset(l);
+                for (size_t i = 0; i < n; ++i) line[i] = data[i * lines.stride];
+
+                auto parabola = [&](size_t q) {
+                    const auto x = static_cast<double>(q);
+                    return static_cast<double>(line[q]) + w * x * x;
+                };
+                size_t k = 0;
+                bool found = false;
+                for (size_t q = 0; q < n; ++q) {
+                    if (line[q] == inf) continue;
+                    if (!found) {
+                        found = true;
+                        v[0] = q;
+                        z[0] = -std::numeric_limits<double>::infinity();
+                        z[1] = std::numeric_limits<double>::infinity();
+                        continue;
+                    }
+                    double s = 0.0;
+                    while (true) {
+                        s = (parabola(q) - parabola(v[k])) /
+                            (2.0 * w * static_cast<double>(q - v[k]));
+                        if (s > z[k] || k == 0) break;
+                        --k;
+                    }
+                    ++k;
+                    v[k] = q;
+                    z[k] = s;
+                    z[k + 1] = std::numeric_limits<double>::infinity();
+                }
+                if (!found) continue;
+
+                k = 0;
+                for (size_t q = 0; q < n; ++q) {
+                    while (z[k + 1] < static_cast<double>(q)) ++k;
+                    const auto d = static_cast<double>(q) - static_cast<double>(v[k]);
+                    data[q * lines.stride] = static_cast<float>(w * d * d + line[v[k]]);
+                }
+            }
+        });
+    }
+}
+
+void binary(std::uint8_t* mask, const size3_t& dims, bool dilate, MorphologyShape shape,
+            const size3_t& radius) {
+    if (shape == MorphologyShape::Box) {
+        grayscale(mask, dims, dilate, shape, radius);
+        return;
+    }
+
+    // Dilation marks everything within the kernel radius of the foreground, erosion is the
+    // complement of the dilation of the background. Distances are scaled by the largest radius
+    // to keep them integral for spheres.
+    const double rmax = static_cast<double>(glm::compMax(radius));
+    if (rmax == 0.0) return;
+    dvec3 weights{0.0};
+    for (size_t i = 0; i < 3; ++i) {
+        if (radius[i] > 0) weights[i] = rmax * rmax / static_cast<double>(radius[i] * radius[i]);
+    }
+    const auto threshold = static_cast<float>(rmax * rmax * (1.0 + 1.0e-6));
+
+    const size_t size = dims.x * dims.y * dims.z;
+    std::vector<float> dist(size);
+    const std::uint8_t source = dilate ? binaryForeground : 0;
+    parallelRanges(size, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            dist[i] = mask[i] == source ? 0.0f : std::numeric_limits<float>::infinity();
+        }
+    });
+    distanceTransform(dist.data(), dims, weights);
+    parallelRanges(size, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            mask[i] = (dist[i] <= threshold) == dilate ? binaryForeground : 0;
+        }
+    });
+}
+
+template <typename Func>
+void applyOperation(MorphologyOperation operation, Func func) {
+    switch (operation) {
+        case MorphologyOperation::Erode:
+            func(false);
+            break;
+        case MorphologyOperation::Dilate:
+            func(true);
+            break;
+        case MorphologyOperation::Open:
+            func(false);
+            func(true);
+            break;
+        case MorphologyOperation::Close:
+            func(true);
+            func(false);
+            break;
+    }
+}
+
+template <typename T>
+void createMask(const T* data, std::uint8_t* mask, size_t size, const dvec2& foreground) {
+    parallelRanges(size, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const auto value = static_cast<double>(util::glmcomp(data[i], 0));
+            mask[i] = value >= foreground.x && value <= foreground.y ? binaryForeground : 0;
+        }
+    });
+}
+
+}  // namespace
+
+std::shared_ptr<VolumeRAM> volumeMorphology(const VolumeRAM* volume, MorphologyOperation operation,
+                                            MorphologyShape shape, size3_t radius) {
+    auto result = std::shared_ptr<VolumeRAM>(volume->clone());
+    const auto dims = volume->getDimensions();
+    result->dispatch<void>([&](auto vr) {
+        auto data = vr->getDataTyped();
+        applyOperation(operation, [&](bool dilate) {
+            grayscale(data, dims, dilate, shape, radius);
+        });
+    });
+    return result;
+}
+
+std::shared_ptr<VolumeRAM> volumeBinaryMorphology(const VolumeRAM* volume, dvec2 foreground,
+                                                  MorphologyOperation operation,
+                                                  MorphologyShape shape, size3_t radius) {
+    const auto dims = volume->getDimensions();
+    auto result = std::make_shared<VolumeRAMPrecision<std::uint8_t>>(
+        dims, util::RAMInit::Uninitialized, swizzlemasks::luminance, InterpolationType::Nearest,
+        volume->getWrapping());
+    auto mask = result->getDataTyped();
+    volume->dispatch<void>([&](auto vr) {
+        createMask(vr->getDataTyped(), mask, glm::compMul(dims), foreground);
+    });
+    applyOperation(operation,
+                   [&](bool dilate) { binary(mask, dims, dilate, shape, radius); });
+    return result;
+}
+
+std::shared_ptr<LayerRAM> layerMorphology(const LayerRAM* layer, MorphologyOperation operation,
+                                          MorphologyShape shape, size2_t radius) {
+    auto result = std::shared_ptr<LayerRAM>(layer->clone());
+    const size3_t dims{layer->getDimensions(), 1};
+    result->dispatch<void>([&](auto lr) {
+        auto data = lr->getDataTyped();
+        applyOperation(operation, [&](bool dilate) {
+            grayscale(data, dims, dilate, shape, size3_t{radius, 0});
+        });
+    });
+    return result;
+}
+
+std::shared_ptr<LayerRAM> layerBinaryMorphology(const LayerRAM* layer, dvec2 foreground,
+                                                MorphologyOperation operation,
+                                                MorphologyShape shape, size2_t radius) {
+    const size3_t dims{layer->getDimensions(), 1};
+    auto result = std::make_shared<LayerRAMPrecision<std::uint8_t>>(
+        layer->getDimensions(), util::RAMInit::Uninitialized, LayerType::Color,
+        swizzlemasks::luminance, InterpolationType::Nearest, layer->getWrapping());
+    auto mask = result->getDataTyped();
+    layer->dispatch<void>([&](auto lr) {
+        createMask(lr->getDataTyped(), mask, glm::compMul(dims), foreground);
+    });
+    applyOperation(operation, [&](bool dilate) {
+        binary(mask, dims, dilate, shape, size3_t{radius, 0});
+    });
+    return result;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
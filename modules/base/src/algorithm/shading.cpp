@@ -0,0 +1,91 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/shading.h>
+
+namespace inviwo {
+
+namespace util {
+
+LightingSettings lightingSettings(const SimpleLightingProperty& property) {
+    LightingSettings settings;
+    settings.shadingMode = static_cast<ShadingMode::Modes>(property.shadingMode_.get());
+    settings.lightPosition = property.getTransformedPosition();
+    settings.ambientColor = property.ambientColor_.get();
+    settings.diffuseColor = property.diffuseColor_.get();
+    settings.specularColor = property.specularColor_.get();
+    settings.specularExponent = property.specularExponent_.get();
+    return settings;
+}
+
+vec3 applyLighting(const LightingSettings& light, const vec3& materialAmbient,
+                   const vec3& materialDiffuse, const vec3& materialSpecular, const vec3& position,
+                   const vec3& normal, const vec3& toCameraDir) {
+    // see modules/opengl/glsl/utils/shading.glsl
+    const vec3 toLightDir = glm::normalize(light.lightPosition - position);
+
+    const auto ambient = [&]() { return materialAmbient * light.ambientColor; };
+    const auto diffuse = [&]() {
+        return materialDiffuse * light.diffuseColor * std::max(glm::dot(normal, toLightDir), 0.0f);
+    };
+    const auto specularBlinnPhong = [&]() {
+        const vec3 halfway = toCameraDir + toLightDir;
+        // check for special case where the light source is exactly opposite to the view direction
+        if (glm::dot(halfway, halfway) < 1.0e-6f) return vec3(0.0f);
+        return materialSpecular * light.specularColor *
+               std::pow(std::max(glm::dot(normal, glm::normalize(halfway)), 0.0f),
+                        light.specularExponent);
+    };
+    const auto specularPhong = [&]() {
+        if (glm::dot(toLightDir, normal) < 0.0f) return vec3(0.0f);
+        const vec3 r = glm::reflect(-toLightDir, normal);
+        return materialSpecular * light.specularColor *
+               std::pow(std::max(glm::dot(r, toCameraDir), 0.0f), light.specularExponent * 0.25f);
+    };
+
+    switch (light.shadingMode) {
+        case ShadingMode::Ambient:
+            return ambient();
+        case ShadingMode::Diffuse:
+            return diffuse();
+        case ShadingMode::Specular:
+            return specularPhong();
+        case ShadingMode::BlinnPhong:
+            return ambient() + diffuse() + specularBlinnPhong();
+        case ShadingMode::Phong:
+            return ambient() + diffuse() + specularPhong();
+        case ShadingMode::None:
+        default:
+            return materialAmbient;
+    }
+}
+
+}  // namespace util
+
+}  // namespace inviwo
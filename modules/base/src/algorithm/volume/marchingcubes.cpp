@@ -29,6 +29,10 @@
 
 #include <modules/base/algorithm/volume/marchingcubes.h>
 #include <modules/base/algorithm/volume/surfaceextraction.h>
+#include <inviwo/core/util/threadarena.h>
+#include <inviwo/core/datastructures/volume/volumesparseprecision.h>
+
+#include <tuple>
 
 namespace inviwo {
 
@@ -533,7 +537,7 @@ std::array<std::vector<Triangle>, 256> cases = {
     std::vector<Triangle>{}};
 
 void evaluateCube(K3DTree<size_t, float>& vertexTree, IndexBufferRAM* indexBuffer,
-                  std::vector<vec3>& positions, std::vector<vec3>& normals,
+                  std::pmr::vector<vec3>& positions, std::pmr::vector<vec3>& normals,
                   const std::array<vec3, 8>& pos, const std::array<double, 8>& values) {
     int index = 0;
 
@@ -568,6 +572,109 @@ void evaluateCube(K3DTree<size_t, float>& vertexTree, IndexBufferRAM* indexBuffe
     }
 }
 
+void addVertices(BasicMesh& mesh, const std::pmr::vector<vec3>& positions,
+                 const std::pmr::vector<vec3>& normals, const vec4& color) {
+    ivwAssert(positions.size() == normals.size(), "positions_ and normals_ must be equal");
+    std::vector<BasicMesh::Vertex> vertices;
+    vertices.reserve(positions.size());
+
+    for (auto pit = positions.begin(), nit = normals.begin(); pit != positions.end();
+         ++pit, ++nit) {
+        vertices.push_back({*pit, glm::normalize(*nit), *pit, color});
+    }
+
+    mesh.addVertices(vertices);
+}
+
+/*
+ * Only cells that touch an allocated leaf can contain the surface, all other cells have the
+ * background value in all corners. The cells are visited in bricks of leafSize^3 cells, a brick
+ * is evaluated if the leaf at the same position or one of the leaves with a larger index
+ * along any axis is allocated, since its cells reach one voxel into those.
+ */
+std::shared_ptr<Mesh> extractSparse(const Volume& volume, const VolumeSparse& sparse, double iso,
+                                    const vec4& color, bool invert,
+                                    const std::function<void(float)>& progressCallback,
+                                    const std::function<bool(const size3_t&)>& maskingCallback) {
+    return sparse.dispatch<std::shared_ptr<Mesh>>([&](auto vs) {
+        using T = util::PrecisionValueType<decltype(vs)>;
+        constexpr size_t leafSize = VolumeSparse::leafSize;
+        if (progressCallback) progressCallback(0.0f);
+
+        K3DTree<size_t, float> vertexTree;
+
+        auto mesh = std::make_shared<BasicMesh>();
+        auto indexBuffer = mesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::None);
+
+        util::ArenaScope arena;
+        std::pmr::vector<vec3> positions{arena.resource()};
+        std::pmr::vector<vec3> normals{arena.resource()};
+
+        mesh->setModelMatrix(volume.getModelMatrix());
+        mesh->setWorldMatrix(volume.getWorldMatrix());
+
+        const size3_t dim{volume.getDimensions()};
+        double dx, dy, dz;
+        dx = 1.0 / static_cast<double>(std::max(size_t(1), (dim.x - 1)));
+        dy = 1.0 / static_cast<double>(std::max(size_t(1), (dim.y - 1)));
+        dz = 1.0 / static_cast<double>(std::max(size_t(1), (dim.z - 1)));
+
+        std::pmr::vector<size3_t> bricks{arena.resource()};
+        vs->forEachLeaf([&](const size3_t& origin, const T*) {
+            const size3_t leaf = origin / leafSize;
+            for (const auto& o : offs) {
+                if (glm::all(glm::greaterThanEqual(leaf, o))) bricks.push_back(leaf - o);
+            }
+        });
+        const auto zyx = [](const size3_t& a, const size3_t& b) {
+            return std::tie(a.z, a.y, a.x) < std::tie(b.z, b.y, b.x);
+        };
+        std::sort(bricks.begin(), bricks.end(), zyx);
+        bricks.erase(std::unique(bricks.begin(), bricks.end()), bricks.end());
+
+        const auto getValue = [&](const size3_t& pos) {
+            const double v = util::glm_convert<double>(vs->get(pos));
+            return invert ? v - iso : -(v - iso);
+        };
+
+        for (size_t b = 0; b < bricks.size(); ++b) {
+            const size3_t begin = bricks[b] * leafSize;
+            const size3_t end = glm::min(begin + size3_t{leafSize}, dim - size3_t{1});
+            for (size_t k = begin.z; k < end.z; k++) {
+                for (size_t j = begin.y; j < end.y; j++) {
+                    for (size_t i = begin.x; i < end.x; i++) {
+                        if (!maskingCallback({i, j, k})) continue;
+                        double x = dx * i;
+                        double y = dy * j;
+                        double z = dz * k;
+
+                        std::array<vec3, 8> pos;
+                        std::array<double, 8> values;
+
+                        for (int l = 0; l < 8; l++) {
+                            const auto& o = offs[l];
+                            pos[l] = glm::vec3(x + dx * o.x, y + dy * o.y, z + dz * o.z);
+                            values[l] = getValue(size3_t(i, j, k) + o);
+                        }
+
+                        evaluateCube(vertexTree, indexBuffer.get(), positions, normals, pos,
+                                     values);
+                    }
+                }
+            }
+            if (progressCallback) {
+                progressCallback(static_cast<float>(b + 1) / static_cast<float>(bricks.size()));
+            }
+        }
+
+        addVertices(*mesh, positions, normals, color);
+
+        if (progressCallback) progressCallback(1.0f);
+
+        return mesh;
+    });
+}
+
 }  // namespace marchingcubes
 
 namespace util {
@@ -576,21 +683,30 @@ std::shared_ptr<Mesh> marchingcubes(std::shared_ptr<const Volume> volume, double
                                     std::function<void(float)> progressCallback,
                                     std::function<bool(const size3_t&)> maskingCallback) {
 
+    if (!maskingCallback) {
+        throw Exception("Masking callback not set", IVW_CONTEXT_CUSTOM("util::marchingcubes"));
+    }
+
+    // Sparse volumes are not made dense, unless the boundary needs to be enclosed
+    if (!enclose && volume->hasRepresentation<VolumeSparse>()) {
+        return marchingcubes::extractSparse(*volume, *volume->getRepresentation<VolumeSparse>(),
+                                            iso, color, invert, progressCallback,
+                                            maskingCallback);
+    }
+
     return volume->getRepresentation<VolumeRAM>()->dispatch<std::shared_ptr<Mesh>>([&](auto ram) {
         using T = util::PrecisionValueType<decltype(ram)>;
         if (progressCallback) progressCallback(0.0f);
 
-        if (!maskingCallback) {
-            throw Exception("Masking callback not set", IVW_CONTEXT_CUSTOM("util::marchingcubes"));
-        }
-
         K3DTree<size_t, float> vertexTree;
 
         auto mesh = std::make_shared<BasicMesh>();
         auto indexBuffer = mesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::None);
 
-        std::vector<vec3> positions;
-        std::vector<vec3> normals;
+        // positions and normals are only needed to build the vertices, keep them in the arena
+        util::ArenaScope arena;
+        std::pmr::vector<vec3> positions{arena.resource()};
+        std::pmr::vector<vec3> normals{arena.resource()};
 
         mesh->setModelMatrix(volume->getModelMatrix());
         mesh->setWorldMatrix(volume->getWorldMatrix());
@@ -639,16 +755,7 @@ std::shared_ptr<Mesh> marchingcubes(std::shared_ptr<const Volume> volume, double
                                     dx, dy, dz);
         }
 
-        ivwAssert(positions.size() == normals.size(), "positions_ and normals_ must be equal");
-        std::vector<BasicMesh::Vertex> vertices;
-        vertices.reserve(positions.size());
-
-        for (auto pit = positions.begin(), nit = normals.begin(); pit != positions.end();
-             ++pit, ++nit) {
-            vertices.push_back({*pit, glm::normalize(*nit), *pit, color});
-        }
-
-        mesh->addVertices(vertices);
+        marchingcubes::addVertices(*mesh, positions, normals, color);
 
         if (progressCallback) progressCallback(1.0f);
 
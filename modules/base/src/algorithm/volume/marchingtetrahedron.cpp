@@ -29,6 +29,7 @@
 
 #include <modules/base/algorithm/volume/marchingtetrahedron.h>
 #include <modules/base/algorithm/volume/surfaceextraction.h>
+#include <inviwo/core/util/threadarena.h>
 
 namespace inviwo {
 
@@ -61,9 +62,9 @@ const static std::array<std::array<size_t, 4>, 6> tetras = {
     std::array<size_t, 4>{7, 4, 3, 5}, std::array<size_t, 4>{7, 6, 5, 3}};
 
 void evaluateTetra(K3DTree<size_t, float>& vertexTree, IndexBufferRAM* indexBuffer,
-                   std::vector<vec3>& positions, std::vector<vec3>& normals, const glm::vec3& p0,
-                   double v0, const glm::vec3& p1, double v1, const glm::vec3& p2, double v2,
-                   const glm::vec3& p3, double v3) {
+                   std::pmr::vector<vec3>& positions, std::pmr::vector<vec3>& normals,
+                   const glm::vec3& p0, double v0, const glm::vec3& p1, double v1,
+                   const glm::vec3& p2, double v2, const glm::vec3& p3, double v3) {
     int index = 0;
     if (v0 > 0) index = index | 1;
     if (v1 > 0) index = index | 2;
@@ -173,8 +174,10 @@ std::shared_ptr<Mesh> marchingtetrahedron(std::shared_ptr<const Volume> volume,
         auto mesh = std::make_shared<BasicMesh>();
         auto indexBuffer = mesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::None);
 
-        std::vector<vec3> positions;
-        std::vector<vec3> normals;
+        // positions and normals are only needed to build the vertices, keep them in the arena
+        util::ArenaScope arena;
+        std::pmr::vector<vec3> positions{arena.resource()};
+        std::pmr::vector<vec3> normals{arena.resource()};
 
         mesh->setModelMatrix(volume->getModelMatrix());
         mesh->setWorldMatrix(volume->getWorldMatrix());
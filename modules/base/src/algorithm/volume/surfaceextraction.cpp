@@ -40,9 +40,10 @@ glm::vec3 interpolate(const glm::vec3& p0, double v0, const glm::vec3& p1, doubl
     return p0 + t * (p1 - p0);
 }
 
+template <typename Vec3s>
 void evaluateTriangle(K3DTree<size_t, float>& vertexTree, IndexBufferRAM* indexBuffer,
-                      std::vector<vec3>& positions, std::vector<vec3>& normals, const glm::vec3& p0,
-                      double v0, const glm::vec3& p1, double v1, const glm::vec3& p2, double v2) {
+                      Vec3s& positions, Vec3s& normals, const glm::vec3& p0, double v0,
+                      const glm::vec3& p1, double v1, const glm::vec3& p2, double v2) {
     int index = 0;
     if (v0 <= 0.0) index += 1;
     if (v1 <= 0.0) index += 2;
@@ -82,8 +83,9 @@ void evaluateTriangle(K3DTree<size_t, float>& vertexTree, IndexBufferRAM* indexB
     }
 }
 
-size_t addVertex(K3DTree<size_t, float>& vertexTree, std::vector<vec3>& positions,
-                 std::vector<vec3>& normals, const vec3 pos) {
+template <typename Vec3s>
+size_t addVertex(K3DTree<size_t, float>& vertexTree, Vec3s& positions, Vec3s& normals,
+                 const vec3 pos) {
     auto nearest = vertexTree.findNearest(vec3(pos));
     const auto nearestPos = [&]() {
         return vec3{nearest->getPosition()[0], nearest->getPosition()[1],
@@ -97,9 +99,10 @@ size_t addVertex(K3DTree<size_t, float>& vertexTree, std::vector<vec3>& position
     return nearest->get();
 }
 
+template <typename Vec3s>
 void addTriangle(K3DTree<size_t, float>& vertexTree, IndexBufferRAM* indexBuffer,
-                 std::vector<vec3>& positions, std::vector<vec3>& normals, const glm::vec3& a,
-                 const glm::vec3& b, const glm::vec3& c) {
+                 Vec3s& positions, Vec3s& normals, const glm::vec3& a, const glm::vec3& b,
+                 const glm::vec3& c) {
     size_t i0 = addVertex(vertexTree, positions, normals, a);
     size_t i1 = addVertex(vertexTree, positions, normals, b);
     size_t i2 = addVertex(vertexTree, positions, normals, c);
@@ -122,5 +125,22 @@ void addTriangle(K3DTree<size_t, float>& vertexTree, IndexBufferRAM* indexBuffer
     normals[i2] += n;
 }
 
+template void evaluateTriangle(K3DTree<size_t, float>&, IndexBufferRAM*, std::vector<vec3>&,
+                               std::vector<vec3>&, const glm::vec3&, double, const glm::vec3&,
+                               double, const glm::vec3&, double);
+template void evaluateTriangle(K3DTree<size_t, float>&, IndexBufferRAM*, std::pmr::vector<vec3>&,
+                               std::pmr::vector<vec3>&, const glm::vec3&, double,
+                               const glm::vec3&, double, const glm::vec3&, double);
+template size_t addVertex(K3DTree<size_t, float>&, std::vector<vec3>&, std::vector<vec3>&,
+                          const vec3);
+template size_t addVertex(K3DTree<size_t, float>&, std::pmr::vector<vec3>&,
+                          std::pmr::vector<vec3>&, const vec3);
+template void addTriangle(K3DTree<size_t, float>&, IndexBufferRAM*, std::vector<vec3>&,
+                          std::vector<vec3>&, const glm::vec3&, const glm::vec3&,
+                          const glm::vec3&);
+template void addTriangle(K3DTree<size_t, float>&, IndexBufferRAM*, std::pmr::vector<vec3>&,
+                          std::pmr::vector<vec3>&, const glm::vec3&, const glm::vec3&,
+                          const glm::vec3&);
+
 }  // namespace marching
 }  // namespace inviwo
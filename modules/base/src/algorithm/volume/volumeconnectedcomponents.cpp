@@ -0,0 +1,321 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/volume/volumeconnectedcomponents.h>
+#include <modules/base/datastructures/disjointsets.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <future>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+// Approximate number of voxels labeled by each task
+constexpr size_t slabVoxels = size_t{1} << 20;
+constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+struct Accumulator {
+    void add(const size3_t& pos, double value) {
+        ++count;
+        lower = glm::min(lower, pos);
+        upper = glm::max(upper, pos);
+        sum += dvec3{pos};
+        intensity += value;
+    }
+    void add(const Accumulator& other) {
+        count += other.count;
+        lower = glm::min(lower, other.lower);
+        upper = glm::max(upper, other.upper);
+        sum += other.sum;
+        intensity += other.intensity;
+    }
+
+    size_t count = 0;
+    size3_t lower{std::numeric_limits<size_t>::max()};
+    size3_t upper{0};
+    dvec3 sum{0.0};
+    double intensity = 0.0;
+};
+
+struct Neighbor {
+    glm::i64vec3 offset;
+    std::int64_t index;
+};
+
+/*
+ * The neighbors preceding a voxel in raster order for the given connectivity, i.e. the ones
+ * already labeled when the voxel is visited.
+ */
+std::vector<Neighbor> previousNeighbors(VoxelConnectivity connectivity, const size3_t& dims) {
+    const std::int64_t maxDist = connectivity == VoxelConnectivity::Face   ? 1
+                                 : connectivity == VoxelConnectivity::Edge ? 2
+                                                                           : 3;
+    const auto nx = static_cast<std::int64_t>(dims.x);
+    const auto nxy = nx * static_cast<std::int64_t>(dims.y);
+    std::vector<Neighbor> neighbors;
+    for (std::int64_t z = -1; z <= 0; ++z) {
+        for (std::int64_t y = -1; y <= 1; ++y) {
+            for (std::int64_t x = -1; x <= 1; ++x) {
+                if (z == 0 && (y > 0 || (y == 0 && x >= 0))) continue;
+                if (std::abs(x) + std::abs(y) + std::abs(z) > maxDist) continue;
+                neighbors.push_back({{x, y, z}, x + y * nx + z * nxy});
+            }
+        }
+    }
+    return neighbors;
+}
+
+inline bool inside(const size3_t& pos, const glm::i64vec3& offset, const size3_t& dims) {
+    for (int i = 0; i < 3; ++i) {
+        const auto p = static_cast<std::int64_t>(pos[i]) + offset[i];
+        if (p < 0 || p >= static_cast<std::int64_t>(dims[i])) return false;
+    }
+    return true;
+}
+
+/*
+ * Labels of one slab of z-slices. While labeling, the label volume holds provisional labels
+ * (1-based) that are local to the slab, table maps them to the compact ids of the connected
+ * components within the slab, which index stats.
+ */
+struct Slab {
+    size_t z0;
+    size_t z1;
+    std::vector<std::uint32_t> table;
+    std::vector<Accumulator> stats;
+};
+
+template <typename T>
+void labelSlab(const T* data, std::uint32_t* labels, const size3_t& dims, const dvec2& foreground,
+               const std::vector<Neighbor>& neighbors, Slab& slab) {
+    DisjointSets<std::int64_t> sets;
+    std::vector<Accumulator> stats;
+
+    size_t index = slab.z0 * dims.x * dims.y;
+    for (size3_t pos{0, 0, slab.z0}; pos.z < slab.z1; ++pos.z) {
+        for (pos.y = 0; pos.y < dims.y; ++pos.y) {
+            for (pos.x = 0; pos.x < dims.x; ++pos.x, ++index) {
+                const auto value = static_cast<double>(util::glmcomp(data[index], 0));
+                if (value < foreground.x || value > foreground.y) {
+                    labels[index] = 0;
+                    continue;
+                }
+
+                std::uint32_t label = 0;
+                for (const auto& n : neighbors) {
+                    if (pos.z == slab.z0 && n.offset.z < 0) continue;
+                    if (!inside(pos, n.offset, dims)) continue;
+                    const auto neighbor = labels[static_cast<std::int64_t>(index) + n.index];
+                    if (neighbor == 0 || neighbor == label) continue;
+                    if (label == 0) {
+                        label = neighbor;
+                    } else {
+                        sets.join(label - 1, neighbor - 1);
+                    }
+                }
+                if (label == 0) {
+                    if (stats.size() >= none - 1) {
+                        throw Exception("Too many components for a 32-bit label volume",
+                                        IVW_CONTEXT_CUSTOM("volumeConnectedComponents"));
+                    }
+                    label = static_cast<std::uint32_t>(sets.add() + 1);
+                    stats.emplace_back();
+                }
+                labels[index] = label;
+                stats[label - 1].add(pos, value);
+            }
+        }
+    }
+
+    // Number the components of the slab in the order of their first voxel
+    std::vector<std::uint32_t> compact(stats.size(), none);
+    slab.table.resize(stats.size());
+    for (std::int64_t p = 0; p < static_cast<std::int64_t>(stats.size()); ++p) {
+        auto& id = compact[sets.find(p)];
+        if (id == none) {
+            id = static_cast<std::uint32_t>(slab.stats.size());
+            slab.stats.emplace_back();
+        }
+        slab.table[p] = id;
+        slab.stats[id].add(stats[p]);
+    }
+}
+
+/*
+ * Call func(slab) for each slab on the thread pool, or serially if there is no pool.
+ */
+template <typename Func>
+void forEachSlab(std::vector<Slab>& slabs, Func func) {
+    const size_t poolSize =
+        InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+
+    if (poolSize == 0 || slabs.size() == 1) {
+        for (auto& slab : slabs) func(slab);
+        return;
+    }
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(slabs.size());
+    try {
+        for (auto& slab : slabs) {
+            futures.push_back(dispatchPool([&func, &slab]() { func(slab); }));
+        }
+    } catch (...) {
+        for (auto& f : futures) f.wait();
+        throw;
+    }
+    // wait for all jobs before rethrowing, they reference slabs
+    std::exception_ptr error;
+    for (auto& f : futures) {
+        try {
+            f.get();
+        } catch (...) {
+            if (!error) error = std::current_exception();
+        }
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+}  // namespace
+
+ConnectedComponents volumeConnectedComponents(const VolumeRAM& volume, dvec2 foreground,
+                                              VoxelConnectivity connectivity) {
+    const auto dims = volume.getDimensions();
+    const size_t sliceSize = dims.x * dims.y;
+
+    auto labelRAM = std::make_shared<VolumeRAMPrecision<std::uint32_t>>(
+        dims, util::RAMInit::Uninitialized, swizzlemasks::luminance, InterpolationType::Nearest,
+        volume.getWrapping());
+    auto labels = labelRAM->getDataTyped();
+
+    const auto neighbors = previousNeighbors(connectivity, dims);
+
+    std::vector<Slab> slabs;
+    const size_t thickness = std::max(size_t{1}, slabVoxels / std::max(sliceSize, size_t{1}));
+    for (size_t z = 0; z < dims.z; z += thickness) {
+        slabs.push_back({z, std::min(z + thickness, dims.z), {}, {}});
+    }
+
+    volume.dispatch<void>([&](auto vr) {
+        using T = util::PrecisionValueType<decltype(vr)>;
+        const T* data = vr->getDataTyped();
+        forEachSlab(slabs, [&](Slab& slab) {
+            labelSlab(data, labels, dims, foreground, neighbors, slab);
+        });
+    });
+
+    // Global ids of the slab components
+    std::vector<std::int64_t> offsets(slabs.size() + 1, 0);
+    for (size_t s = 0; s < slabs.size(); ++s) {
+        offsets[s + 1] = offsets[s] + static_cast<std::int64_t>(slabs[s].stats.size());
+    }
+    const auto total = offsets.back();
+
+    ConnectedComponents result;
+    if (total > 0) {
+        // Merge the components across slab boundaries
+        DisjointSets<std::int64_t> sets(total);
+        for (size_t s = 1; s < slabs.size(); ++s) {
+            size_t index = slabs[s].z0 * sliceSize;
+            for (size3_t pos{0, 0, slabs[s].z0}; pos.y < dims.y; ++pos.y) {
+                for (pos.x = 0; pos.x < dims.x; ++pos.x, ++index) {
+                    const auto label = labels[index];
+                    if (label == 0) continue;
+                    const auto id = offsets[s] + slabs[s].table[label - 1];
+                    for (const auto& n : neighbors) {
+                        if (n.offset.z == 0 || !inside(pos, n.offset, dims)) continue;
+                        const auto neighbor = labels[static_cast<std::int64_t>(index) + n.index];
+                        if (neighbor == 0) continue;
+                        sets.join(id, offsets[s - 1] + slabs[s - 1].table[neighbor - 1]);
+                    }
+                }
+            }
+        }
+
+        // Final labels in the order of the first voxel of each component
+        std::vector<std::uint32_t> finalLabels(total);
+        std::vector<std::uint32_t> rootLabel(total, 0);
+        std::vector<Accumulator> stats;
+        for (size_t s = 0; s < slabs.size(); ++s) {
+            for (size_t i = 0; i < slabs[s].stats.size(); ++i) {
+                const auto id = offsets[s] + static_cast<std::int64_t>(i);
+                auto& label = rootLabel[sets.find(id)];
+                if (label == 0) {
+                    stats.emplace_back();
+                    label = static_cast<std::uint32_t>(stats.size());
+                }
+                finalLabels[id] = label;
+                stats[label - 1].add(slabs[s].stats[i]);
+            }
+        }
+
+        forEachSlab(slabs, [&](Slab& slab) {
+            const auto offset = offsets[&slab - slabs.data()];
+            for (size_t i = slab.z0 * sliceSize; i < slab.z1 * sliceSize; ++i) {
+                if (labels[i] != 0) labels[i] = finalLabels[offset + slab.table[labels[i] - 1]];
+            }
+        });
+
+        result.components.reserve(stats.size());
+        for (const auto& acc : stats) {
+            const auto count = static_cast<double>(acc.count);
+            result.components.push_back(
+                {acc.count, acc.lower, acc.upper, acc.sum / count, acc.intensity / count});
+        }
+    }
+
+    result.labels = std::make_shared<Volume>(labelRAM);
+    const dvec2 range{0.0, static_cast<double>(std::max<size_t>(result.components.size(), 1))};
+    result.labels->dataMap_.dataRange = range;
+    result.labels->dataMap_.valueRange = range;
+    return result;
+}
+
+ConnectedComponents volumeConnectedComponents(const Volume& volume, dvec2 foreground,
+                                              VoxelConnectivity connectivity) {
+    auto result = volumeConnectedComponents(*volume.getRepresentation<VolumeRAM>(), foreground,
+                                            connectivity);
+    result.labels->setModelMatrix(volume.getModelMatrix());
+    result.labels->setWorldMatrix(volume.getWorldMatrix());
+    return result;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
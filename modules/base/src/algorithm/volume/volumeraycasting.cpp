@@ -0,0 +1,374 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/volume/volumeraycasting.h>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/camera/camera.h>
+#include <inviwo/core/datastructures/image/image.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/datastructures/transferfunction.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/volumeramutils.h>
+
+#include <atomic>
+#include <future>
+#include <limits>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+// see REF_SAMPLING_INTERVAL in modules/opengl/glsl/utils/compositing.glsl
+constexpr float refSamplingInterval = 150.0f;
+// threshold for early ray termination, see raycasting.frag
+constexpr float ertThreshold = 0.99f;
+
+/**
+ * Access to the normalized values of one channel of the volume data using the data range of the
+ * volume. Sampling is done in texture space using trilinear interpolation and clamp-to-edge, which
+ * corresponds to the sampling of a 3D texture.
+ */
+template <typename T>
+class NormalizedVoxels {
+public:
+    NormalizedVoxels(const T* data, size3_t dims, size_t channel, dvec2 dataRange)
+        : data_{data}
+        , dims_{dims}
+        , channel_{channel}
+        , scale_{1.0 / (dataRange.y - dataRange.x)}
+        , offset_{-dataRange.x / (dataRange.y - dataRange.x)} {}
+
+    float operator()(size_t x, size_t y, size_t z) const {
+        const auto& v = data_[x + dims_.x * (y + dims_.y * z)];
+        return static_cast<float>(static_cast<double>(util::glmcomp(v, channel_)) * scale_ +
+                                  offset_);
+    }
+
+    float sample(const vec3& texPos) const {
+        const vec3 p =
+            glm::clamp(texPos * vec3(dims_) - 0.5f, vec3(0.0f), vec3(dims_ - size3_t(1)));
+        const size3_t i0{p};
+        const size3_t i1 = glm::min(i0 + size3_t(1), dims_ - size3_t(1));
+        const vec3 f = p - vec3(i0);
+
+        const auto& v = *this;
+        const float c00 = glm::mix(v(i0.x, i0.y, i0.z), v(i1.x, i0.y, i0.z), f.x);
+        const float c10 = glm::mix(v(i0.x, i1.y, i0.z), v(i1.x, i1.y, i0.z), f.x);
+        const float c01 = glm::mix(v(i0.x, i0.y, i1.z), v(i1.x, i0.y, i1.z), f.x);
+        const float c11 = glm::mix(v(i0.x, i1.y, i1.z), v(i1.x, i1.y, i1.z), f.x);
+        return glm::mix(glm::mix(c00, c10, f.y), glm::mix(c01, c11, f.y), f.z);
+    }
+
+    // Central differences in texture space
+    vec3 gradient(const vec3& texPos) const {
+        const vec3 h = 1.0f / vec3(dims_);
+        return vec3{sample(texPos + vec3(h.x, 0.0f, 0.0f)) - sample(texPos - vec3(h.x, 0.0f, 0.0f)),
+                    sample(texPos + vec3(0.0f, h.y, 0.0f)) - sample(texPos - vec3(0.0f, h.y, 0.0f)),
+                    sample(texPos + vec3(0.0f, 0.0f, h.z)) -
+                        sample(texPos - vec3(0.0f, 0.0f, h.z))} /
+               (2.0f * h);
+    }
+
+    size3_t dims() const { return dims_; }
+
+private:
+    const T* data_;
+    size3_t dims_;
+    size_t channel_;
+    double scale_;
+    double offset_;
+};
+
+/**
+ * Intersect the segment p + s * dir, s in [0,1], with the box [0,1]^3.
+ * @return the parameter range of the intersection, empty if s.x >= s.y
+ */
+vec2 intersectUnitCube(const vec3& p, const vec3& dir) {
+    vec2 s{0.0f, 1.0f};
+    for (glm::length_t i = 0; i < 3; ++i) {
+        if (std::abs(dir[i]) < std::numeric_limits<float>::epsilon()) {
+            if (p[i] < 0.0f || p[i] > 1.0f) return vec2{1.0f, 0.0f};
+        } else {
+            float a = -p[i] / dir[i];
+            float b = (1.0f - p[i]) / dir[i];
+            if (a > b) std::swap(a, b);
+            s.x = std::max(s.x, a);
+            s.y = std::min(s.y, b);
+        }
+    }
+    return s;
+}
+
+}  // namespace
+
+VolumeMinMaxBricks::VolumeMinMaxBricks(const Volume& volume, size_t channel, size_t brickSize)
+    : volumeDims_{volume.getDimensions()}
+    , brickDims_{(volumeDims_ + size3_t(std::max<size_t>(brickSize, 1) - 1)) /
+                 std::max<size_t>(brickSize, 1)}
+    , brickSize_{std::max<size_t>(brickSize, 1)}
+    , channel_{channel}
+    , minMax_(glm::compMul(brickDims_)) {
+
+    volume.getRepresentation<VolumeRAM>()->dispatch<void>([&](auto vrprecision) {
+        using ValueType = util::PrecisionValueType<decltype(vrprecision)>;
+        const NormalizedVoxels<ValueType> voxels{vrprecision->getDataTyped(), volumeDims_,
+                                                 channel_, volume.dataMap_.dataRange};
+
+        util::forEachVoxelParallel(brickDims_, [&](const size3_t& brick) {
+            const size3_t begin = brick * brickSize_;
+            // include the first voxel layer of the next brick for trilinear interpolation
+            const size3_t end = glm::min(begin + size3_t(brickSize_ + 1), volumeDims_);
+
+            vec2 minMax{std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest()};
+            for (size_t z = begin.z; z < end.z; ++z) {
+                for (size_t y = begin.y; y < end.y; ++y) {
+                    for (size_t x = begin.x; x < end.x; ++x) {
+                        const float v = voxels(x, y, z);
+                        minMax.x = std::min(minMax.x, v);
+                        minMax.y = std::max(minMax.y, v);
+                    }
+                }
+            }
+            minMax_[brick.x + brickDims_.x * (brick.y + brickDims_.y * brick.z)] = minMax;
+        });
+    });
+}
+
+std::shared_ptr<Image> raycastVolume(const Volume& volume, const TransferFunction& tf,
+                                     const Camera& camera, size2_t dimensions,
+                                     const VolumeRaycastingSettings& settings,
+                                     const VolumeMinMaxBricks* bricks) {
+    auto colorRep = std::make_shared<LayerRAMPrecision<glm::u8vec4>>(dimensions);
+    auto depthRep = std::make_shared<LayerRAMPrecision<float>>(dimensions, LayerType::Depth);
+    auto colorData = colorRep->getDataTyped();
+    auto depthData = depthRep->getDataTyped();
+    std::fill(colorData, colorData + glm::compMul(dimensions), glm::u8vec4{0});
+    std::fill(depthData, depthData + glm::compMul(dimensions), 1.0f);
+
+    auto image = std::make_shared<Image>(std::vector<std::shared_ptr<Layer>>{
+        std::make_shared<Layer>(colorRep), std::make_shared<Layer>(depthRep)});
+
+    const auto volumeDims = volume.getDimensions();
+    if (glm::compMul(dimensions) == 0 || glm::compMul(volumeDims) == 0) return image;
+
+    if (bricks &&
+        (bricks->getVolumeDimensions() != volumeDims || bricks->getChannel() != settings.channel)) {
+        bricks = nullptr;
+    }
+
+    const auto& transformer = volume.getCoordinateTransformer();
+    const mat4 textureToWorld = transformer.getTextureToWorldMatrix();
+    const mat4 clipToTexture = transformer.getWorldToTextureMatrix() *
+                               camera.getInverseViewMatrix() * camera.getInverseProjectionMatrix();
+    const mat4 worldToClip = camera.getProjectionMatrix() * camera.getViewMatrix();
+    // transforms texture space gradients into world space
+    const mat3 gradientToWorld = glm::transpose(glm::inverse(mat3(textureToWorld)));
+
+    // transfer function table and the number of non-transparent entries up to each position
+    const vec4* tfTable = static_cast<const LayerRAMPrecision<vec4>*>(
+                              tf.getData()->getRepresentation<LayerRAM>())
+                              ->getDataTyped();
+    const size_t tfSize = tf.getTextureSize();
+    std::vector<size_t> opaqueCount(tfSize + 1, 0);
+    for (size_t i = 0; i < tfSize; ++i) {
+        opaqueCount[i + 1] = opaqueCount[i] + (tfTable[i].a > 0.0f ? 1 : 0);
+    }
+    if (opaqueCount.back() == 0) return image;
+
+    const auto classify = [&](float v) {
+        const float x = glm::clamp(v, 0.0f, 1.0f) * static_cast<float>(tfSize - 1);
+        const size_t i0 = static_cast<size_t>(x);
+        const size_t i1 = std::min(i0 + 1, tfSize - 1);
+        return glm::mix(tfTable[i0], tfTable[i1], x - static_cast<float>(i0));
+    };
+    const auto isTransparent = [&](const vec2& minMax) {
+        const auto toIndex = [&](float v) {
+            return glm::clamp(v, 0.0f, 1.0f) * static_cast<float>(tfSize - 1);
+        };
+        const auto i0 = static_cast<size_t>(toIndex(minMax.x));
+        const auto i1 = std::min(static_cast<size_t>(std::ceil(toIndex(minMax.y))), tfSize - 1);
+        return opaqueCount[i1 + 1] == opaqueCount[i0];
+    };
+
+    volume.getRepresentation<VolumeRAM>()->dispatch<void>([&](auto vrprecision) {
+        using ValueType = util::PrecisionValueType<decltype(vrprecision)>;
+        const NormalizedVoxels<ValueType> voxels{vrprecision->getDataTyped(), volumeDims,
+                                                 settings.channel, volume.dataMap_.dataRange};
+
+        const vec3 fdims{volumeDims};
+        const size_t brickSize = bricks ? bricks->getBrickSize() : 1;
+        const size3_t brickDims = bricks ? bricks->getBrickDimensions() : size3_t{1};
+
+        // Returns the ray parameter where the ray leaves the region of texture space whose samples
+        // only depend on voxels within the given brick.
+        const auto brickExit = [&](const size3_t& brick, const vec3& entry, const vec3& dir) {
+            float tExit = std::numeric_limits<float>::infinity();
+            for (glm::length_t i = 0; i < 3; ++i) {
+                if (dir[i] > 0.0f && brick[i] + 1 < brickDims[i]) {
+                    const float bound = ((brick[i] + 1) * brickSize + 0.5f) / fdims[i];
+                    tExit = std::min(tExit, (bound - entry[i]) / dir[i]);
+                } else if (dir[i] < 0.0f && brick[i] > 0) {
+                    const float bound = (brick[i] * brickSize + 0.5f) / fdims[i];
+                    tExit = std::min(tExit, (bound - entry[i]) / dir[i]);
+                }
+            }
+            return tExit;
+        };
+
+        const auto brickOf = [&](const vec3& texPos) {
+            const size3_t voxel{glm::clamp(texPos * fdims - 0.5f, vec3(0.0f), fdims - 1.0f)};
+            return voxel / brickSize;
+        };
+
+        const auto renderPixel = [&](const size2_t& pixel) {
+            const vec2 ndc = (vec2(pixel) + 0.5f) / vec2(dimensions) * 2.0f - 1.0f;
+            const vec4 nearPoint = clipToTexture * vec4(ndc, -1.0f, 1.0f);
+            const vec4 farPoint = clipToTexture * vec4(ndc, 1.0f, 1.0f);
+            const vec3 nearPos = vec3(nearPoint) / nearPoint.w;
+            const vec3 farPos = vec3(farPoint) / farPoint.w;
+
+            const vec2 s = intersectUnitCube(nearPos, farPos - nearPos);
+            if (s.x >= s.y) return;
+            const vec3 entryPoint = nearPos + s.x * (farPos - nearPos);
+            const vec3 exitPoint = nearPos + s.y * (farPos - nearPos);
+
+            // Same sampling as in raycasting.frag
+            vec3 rayDirection = exitPoint - entryPoint;
+            const float tEnd = glm::length(rayDirection);
+            if (tEnd <= 0.0f) return;
+            float tIncr =
+                std::min(tEnd, tEnd / (settings.samplingRate * glm::length(rayDirection * fdims)));
+            const float samples = std::ceil(tEnd / tIncr);
+            tIncr = tEnd / samples;
+            rayDirection /= tEnd;
+
+            const vec3 toCameraDir = glm::normalize(vec3(textureToWorld * vec4(entryPoint, 1.0f)) -
+                                                    vec3(textureToWorld * vec4(exitPoint, 1.0f)));
+            const float alphaExponent = tIncr * refSamplingInterval;
+
+            vec4 result{0.0f};
+            float tDepth = -1.0f;
+            float t = 0.5f * tIncr;
+            while (t < tEnd) {
+                const vec3 samplePos = entryPoint + t * rayDirection;
+
+                if (bricks) {
+                    const auto brick = brickOf(samplePos);
+                    if (isTransparent(bricks->get(brick))) {
+                        // advance to the first sample beyond the brick, keeping the sample
+                        // positions of the ray unchanged
+                        const float tExit = brickExit(brick, entryPoint, rayDirection);
+                        if (tExit >= tEnd) break;
+                        t += std::max(1.0f, std::ceil((tExit - t) / tIncr - 1.0e-3f)) * tIncr;
+                        continue;
+                    }
+                }
+
+                vec4 color = classify(voxels.sample(samplePos));
+                if (color.a > 0.0f) {
+                    if (tDepth < 0.0f) tDepth = t;
+
+                    if (settings.lighting.shadingMode != ShadingMode::None) {
+                        const vec3 gradient = gradientToWorld * voxels.gradient(samplePos);
+                        const float length = glm::length(gradient);
+                        // Note that the gradient is reversed since we define the normal of a
+                        // surface as the direction towards a lower intensity medium
+                        const vec3 normal = length > 0.0f ? -gradient / length : vec3(0.0f);
+                        const vec3 worldPos{textureToWorld * vec4(samplePos, 1.0f)};
+                        // Same material colors as in raycasting.frag
+                        color = vec4(util::applyLighting(settings.lighting, vec3(color),
+                                                         vec3(color), vec3(1.0f), worldPos, normal,
+                                                         toCameraDir),
+                                     color.a);
+                    }
+
+                    color.a = 1.0f - std::pow(1.0f - color.a, alphaExponent);
+                    result += vec4(vec3(color) * color.a, color.a) * (1.0f - result.a);
+                }
+
+                // early ray termination
+                if (result.a > ertThreshold) break;
+                t += tIncr;
+            }
+
+            const size_t index = pixel.x + pixel.y * dimensions.x;
+            colorData[index] =
+                glm::u8vec4(glm::clamp(result * 255.0f + 0.5f, vec4(0.0f), vec4(255.0f)));
+            if (tDepth >= 0.0f) {
+                const vec4 clip =
+                    worldToClip * textureToWorld * vec4(entryPoint + tDepth * rayDirection, 1.0f);
+                depthData[index] = glm::clamp(clip.z / clip.w * 0.5f + 0.5f, 0.0f, 1.0f);
+            }
+        };
+
+        // Rays are processed in tiles to keep the memory access of neighboring rays coherent
+        const size2_t tileSize = glm::max(settings.tileSize, size2_t{1});
+        const size2_t tiles = (dimensions + tileSize - size2_t{1}) / tileSize;
+        const size_t numTiles = tiles.x * tiles.y;
+        std::atomic<size_t> nextTile{0};
+        const auto worker = [&]() {
+            for (size_t tile = nextTile++; tile < numTiles; tile = nextTile++) {
+                const size2_t begin = size2_t{tile % tiles.x, tile / tiles.x} * tileSize;
+                const size2_t end = glm::min(begin + tileSize, dimensions);
+                size2_t pixel;
+                for (pixel.y = begin.y; pixel.y < end.y; ++pixel.y) {
+                    for (pixel.x = begin.x; pixel.x < end.x; ++pixel.x) {
+                        renderPixel(pixel);
+                    }
+                }
+            }
+        };
+
+        const size_t poolSize =
+            InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+        if (poolSize == 0) {
+            worker();
+        } else {
+            std::vector<std::future<void>> futures;
+            for (size_t i = 0; i < std::min(poolSize, numTiles); ++i) {
+                futures.push_back(dispatchPool(worker));
+            }
+            for (auto& f : futures) {
+                f.get();
+            }
+        }
+    });
+
+    return image;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
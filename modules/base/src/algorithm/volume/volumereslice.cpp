@@ -0,0 +1,276 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/volume/volumereslice.h>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/geometry/plane.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <limits>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+/**
+ * Samples the voxels of a volume in texture space, the voxel values are converted to the float
+ * type F with the same extent as the voxel type T.
+ */
+template <typename F, typename T>
+class ResliceSampler {
+public:
+    ResliceSampler(const T* data, size3_t dims, InterpolationType interpolation)
+        : data_{data}, dims_{dims}, interpolation_{interpolation} {}
+
+    /**
+     * Sample at \p texPos and store the value in \p result.
+     * @return false if texPos is outside of the volume
+     */
+    bool sample(const vec3& texPos, F& result) const {
+        if (glm::any(glm::lessThan(texPos, vec3(0.0f))) ||
+            glm::any(glm::greaterThan(texPos, vec3(1.0f)))) {
+            return false;
+        }
+        const vec3 p = texPos * vec3(dims_);
+        if (interpolation_ == InterpolationType::Nearest) {
+            const size3_t i = glm::min(size3_t(p), dims_ - size3_t(1));
+            result = voxel(i.x, i.y, i.z);
+            return true;
+        }
+
+        const vec3 q = glm::clamp(p - 0.5f, vec3(0.0f), vec3(dims_ - size3_t(1)));
+        const size3_t i0{q};
+        const size3_t i1 = glm::min(i0 + size3_t(1), dims_ - size3_t(1));
+        const vec3 f = q - vec3(i0);
+
+        const F c00 = lerp(voxel(i0.x, i0.y, i0.z), voxel(i1.x, i0.y, i0.z), f.x);
+        const F c10 = lerp(voxel(i0.x, i1.y, i0.z), voxel(i1.x, i1.y, i0.z), f.x);
+        const F c01 = lerp(voxel(i0.x, i0.y, i1.z), voxel(i1.x, i0.y, i1.z), f.x);
+        const F c11 = lerp(voxel(i0.x, i1.y, i1.z), voxel(i1.x, i1.y, i1.z), f.x);
+        result = lerp(lerp(c00, c10, f.y), lerp(c01, c11, f.y), f.z);
+        return true;
+    }
+
+private:
+    F voxel(size_t x, size_t y, size_t z) const {
+        return static_cast<F>(data_[x + dims_.x * (y + dims_.y * z)]);
+    }
+    static F lerp(const F& a, const F& b, float t) { return a + (b - a) * t; }
+
+    const T* data_;
+    size3_t dims_;
+    InterpolationType interpolation_;
+};
+
+SwizzleMask swizzleMaskFor(size_t components) {
+    switch (components) {
+        case 1:
+            return swizzlemasks::luminance;
+        case 2:
+            return {{ImageChannel::Red, ImageChannel::Green, ImageChannel::Zero,
+                     ImageChannel::One}};
+        case 3:
+            return swizzlemasks::rgb;
+        default:
+            return swizzlemasks::rgba;
+    }
+}
+
+}  // namespace
+
+vec3 ResliceRect::normal() const { return glm::normalize(glm::cross(uAxis, vAxis)); }
+
+mat4 ResliceRect::getTextureToWorldMatrix() const {
+    return mat4{vec4{uAxis, 0.0f}, vec4{vAxis, 0.0f}, vec4{normal(), 0.0f}, vec4{origin, 1.0f}};
+}
+
+ResliceRect fitResliceRect(const Volume& volume, const Plane& plane, const vec3& up) {
+    const vec3 normal = glm::normalize(plane.getNormal());
+
+    // use the world axis least aligned with the normal if up is (almost) parallel to it
+    vec3 upDir = up - glm::dot(up, normal) * normal;
+    if (glm::length(upDir) < 1.0e-4f * glm::length(up) || glm::length(up) == 0.0f) {
+        const vec3 a = glm::abs(normal);
+        const vec3 axis = (a.x <= a.y && a.x <= a.z)
+                              ? vec3{1.0f, 0.0f, 0.0f}
+                              : (a.y <= a.z ? vec3{0.0f, 1.0f, 0.0f} : vec3{0.0f, 0.0f, 1.0f});
+        upDir = axis - glm::dot(axis, normal) * normal;
+    }
+    const vec3 v = glm::normalize(upDir);
+    const vec3 u = glm::cross(v, normal);
+
+    const mat4 textureToWorld = volume.getCoordinateTransformer().getTextureToWorldMatrix();
+    vec2 minPos{std::numeric_limits<float>::max()};
+    vec2 maxPos{std::numeric_limits<float>::lowest()};
+    for (int corner = 0; corner < 8; ++corner) {
+        const vec3 tex{static_cast<float>(corner & 1), static_cast<float>((corner >> 1) & 1),
+                       static_cast<float>((corner >> 2) & 1)};
+        const vec3 pos = vec3{textureToWorld * vec4{tex, 1.0f}} - plane.getPoint();
+        const vec2 proj{glm::dot(pos, u), glm::dot(pos, v)};
+        minPos = glm::min(minPos, proj);
+        maxPos = glm::max(maxPos, proj);
+    }
+
+    ResliceRect rect;
+    rect.origin = plane.getPoint() + minPos.x * u + minPos.y * v;
+    rect.uAxis = (maxPos.x - minPos.x) * u;
+    rect.vAxis = (maxPos.y - minPos.y) * v;
+    return rect;
+}
+
+std::shared_ptr<Layer> resliceVolume(const Volume& volume, const ResliceRect& rect,
+                                     size2_t dimensions, const VolumeResliceSettings& settings) {
+    const mat4 worldToTexture = volume.getCoordinateTransformer().getWorldToTextureMatrix();
+    const vec3 texOrigin{worldToTexture * vec4{rect.origin, 1.0f}};
+    const vec3 texU = mat3{worldToTexture} * rect.uAxis / static_cast<float>(dimensions.x);
+    const vec3 texV = mat3{worldToTexture} * rect.vAxis / static_cast<float>(dimensions.y);
+    const vec3 texNormal = mat3{worldToTexture} * rect.normal();
+
+    const auto volumeDims = volume.getDimensions();
+    const size_t slabSamples = [&]() -> size_t {
+        if (settings.thickness <= 0.0f) return 1;
+        if (settings.slabSamples > 0) return settings.slabSamples;
+        const float voxels = glm::length(texNormal * vec3(volumeDims)) * settings.thickness;
+        return std::max(size_t{1}, static_cast<size_t>(std::ceil(voxels)));
+    }();
+    const float slabStep =
+        settings.thickness > 0.0f ? settings.thickness / static_cast<float>(slabSamples) : 0.0f;
+    const vec3 texSlabStart = texNormal * (0.5f * slabStep - 0.5f * settings.thickness);
+    const vec3 texSlabStep = texNormal * slabStep;
+
+    const dvec2 dataRange = volume.dataMap_.dataRange;
+
+    auto layer = volume.getRepresentation<VolumeRAM>()->dispatch<std::shared_ptr<Layer>>(
+        [&](const auto vrprecision) {
+            using T = util::PrecisionValueType<decltype(vrprecision)>;
+            using F = typename util::same_extent<T, float>::type;
+            constexpr size_t components = util::extent<T>::value;
+
+            const ResliceSampler<F, T> sampler(vrprecision->getDataTyped(), volumeDims,
+                                               settings.interpolation);
+
+            auto layerRAM = std::make_shared<LayerRAMPrecision<F>>(
+                dimensions, util::RAMInit::Uninitialized, LayerType::Color,
+                swizzleMaskFor(components), settings.interpolation);
+            F* dest = layerRAM->getDataTyped();
+
+            // an empty data range is only shifted to zero
+            const double extent = dataRange.y - dataRange.x;
+            const float scale =
+                settings.normalize && extent != 0.0 ? static_cast<float>(1.0 / extent) : 1.0f;
+            const float offset = settings.normalize ? static_cast<float>(-dataRange.x) : 0.0f;
+            const F fill{static_cast<float>(settings.fillValue)};
+
+            const auto resamplePixel = [&](const size2_t& pixel) {
+                const vec3 texPos = texOrigin + (static_cast<float>(pixel.x) + 0.5f) * texU +
+                                    (static_cast<float>(pixel.y) + 0.5f) * texV + texSlabStart;
+                F result{0.0f};
+                size_t count = 0;
+                F value;
+                for (size_t i = 0; i < slabSamples; ++i) {
+                    if (!sampler.sample(texPos + static_cast<float>(i) * texSlabStep, value)) {
+                        continue;
+                    }
+                    if (count == 0) {
+                        result = value;
+                    } else if (settings.projection == SlabProjection::Maximum) {
+                        result = glm::max(result, value);
+                    } else if (settings.projection == SlabProjection::Minimum) {
+                        result = glm::min(result, value);
+                    } else {
+                        result += value;
+                    }
+                    ++count;
+                }
+
+                F& out = dest[pixel.x + pixel.y * dimensions.x];
+                if (count == 0) {
+                    out = fill;
+                    return;
+                }
+                if (settings.projection == SlabProjection::Average) {
+                    result /= static_cast<float>(count);
+                }
+                out = (result + offset) * scale;
+            };
+
+            // Pixels are processed in tiles to keep the memory access of neighboring samples
+            // coherent
+            const size2_t tileSize = glm::max(settings.tileSize, size2_t{1});
+            const size2_t tiles = (dimensions + tileSize - size2_t{1}) / tileSize;
+            const size_t numTiles = tiles.x * tiles.y;
+            std::atomic<size_t> nextTile{0};
+            const auto worker = [&]() {
+                for (size_t tile = nextTile++; tile < numTiles; tile = nextTile++) {
+                    const size2_t begin = size2_t{tile % tiles.x, tile / tiles.x} * tileSize;
+                    const size2_t end = glm::min(begin + tileSize, dimensions);
+                    size2_t pixel;
+                    for (pixel.y = begin.y; pixel.y < end.y; ++pixel.y) {
+                        for (pixel.x = begin.x; pixel.x < end.x; ++pixel.x) {
+                            resamplePixel(pixel);
+                        }
+                    }
+                }
+            };
+
+            const size_t poolSize =
+                InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+            if (poolSize == 0) {
+                worker();
+            } else {
+                std::vector<std::future<void>> futures;
+                for (size_t i = 0; i < std::min(poolSize, numTiles); ++i) {
+                    futures.push_back(dispatchPool(worker));
+                }
+                for (auto& f : futures) {
+                    f.get();
+                }
+            }
+
+            return std::make_shared<Layer>(layerRAM);
+        });
+
+    layer->setBasis(mat2{glm::length(rect.uAxis), 0.0f, 0.0f, glm::length(rect.vAxis)});
+    return layer;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -39,6 +39,7 @@
 #include <modules/base/processors/gridplanes.h>
 #include <modules/base/processors/heightfieldmapper.h>
 #include <modules/base/processors/imageinformation.h>
+#include <modules/base/processors/imagemorphology.h>
 #include <modules/base/processors/inputselector.h>
 #include <modules/base/processors/layerdistancetransformram.h>
 #include <modules/base/processors/imageexport.h>
@@ -55,6 +56,7 @@
 #include <modules/base/processors/meshinformation.h>
 #include <modules/base/processors/meshmapping.h>
 #include <modules/base/processors/meshplaneclipping.h>
+#include <modules/base/processors/meshrasterizercpu.h>
 #include <modules/base/processors/meshsequenceelementselectorprocessor.h>
 #include <modules/base/processors/meshsource.h>
 #include <modules/base/processors/noiseprocessor.h>
@@ -90,6 +92,9 @@
 #include <modules/base/processors/volumedivergencecpuprocessor.h>
 #include <modules/base/processors/volumegradientcpuprocessor.h>
 #include <modules/base/processors/volumelaplacianprocessor.h>
+#include <modules/base/processors/volumemorphology.h>
+#include <modules/base/processors/volumeraycastercpu.h>
+#include <modules/base/processors/volumereslice.h>
 #include <modules/base/processors/volumesequencetospatial4dsampler.h>
 #include <modules/base/processors/worldtransformdeprecated.h>
 #include <modules/base/processors/camerafrustum.h>
@@ -145,6 +150,7 @@ BaseModule::BaseModule(InviwoApplication* app) : InviwoModule(app, "Base") {
     registerProcessor<HeightFieldMapper>();
     registerProcessor<ImageExport>();
     registerProcessor<ImageInformation>();
+    registerProcessor<ImageMorphology>();
     registerProcessor<ImageSnapshot>();
     registerProcessor<ImageSource>();
     registerProcessor<ImageSourceSeries>();
@@ -156,6 +162,7 @@ BaseModule::BaseModule(InviwoApplication* app) : InviwoModule(app, "Base") {
     registerProcessor<MeshInformation>();
     registerProcessor<MeshMapping>();
     registerProcessor<MeshPlaneClipping>();
+    registerProcessor<MeshRasterizerCPU>();
     registerProcessor<NoiseProcessor>();
     registerProcessor<PixelToBufferProcessor>();
     registerProcessor<PointLightSourceProcessor>();
@@ -194,6 +201,9 @@ BaseModule::BaseModule(InviwoApplication* app) : InviwoModule(app, "Base") {
     registerProcessor<VolumeCurlCPUProcessor>();
     registerProcessor<VolumeDivergenceCPUProcessor>();
     registerProcessor<VolumeLaplacianProcessor>();
+    registerProcessor<VolumeMorphology>();
+    registerProcessor<VolumeRaycasterCPU>();
+    registerProcessor<VolumeReslice>();
     registerProcessor<MeshExport>();
     registerProcessor<RandomMeshGenerator>();
     registerProcessor<RandomSphereGenerator>();
@@ -0,0 +1,356 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/io/chunkedvolumeio.h>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/io/datawriterexception.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <deque>
+#include <future>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+constexpr std::array<char, 4> chunkMagic{'I', 'V', 'W', 'C'};
+constexpr std::uint32_t chunkVersion = 1;
+
+/**
+ * Run the job in the thread pool if there is one, otherwise when the result is requested.
+ */
+template <typename Job>
+auto dispatchChunkJob(Job&& job) -> std::future<std::invoke_result_t<Job>> {
+    if (InviwoApplication::isInitialized() && InviwoApplication::getPtr()->getPoolSize() > 0) {
+        return dispatchPool(std::forward<Job>(job));
+    } else {
+        return std::async(std::launch::deferred, std::forward<Job>(job));
+    }
+}
+
+/**
+ * Number of chunk jobs in flight, limits the memory used for chunks waiting to be written or
+ * decompressed.
+ */
+size_t chunkJobWindow() {
+    const size_t poolSize =
+        InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+    return std::max(size_t{1}, 2 * poolSize);
+}
+
+/**
+ * Wait for all pending jobs, the jobs refer to data owned by the caller.
+ */
+template <typename T>
+void waitForAll(std::deque<std::future<T>>& pending) {
+    for (auto& f : pending) {
+        if (f.valid()) f.wait();
+    }
+}
+
+/**
+ * Copy the box [srcOffset, srcOffset + extent) of src into the box [dstOffset, dstOffset +
+ * extent) of dst, one row at a time.
+ */
+void copyBox(const std::byte* src, const size3_t& srcDims, const size3_t& srcOffset,
+             std::byte* dst, const size3_t& dstDims, const size3_t& dstOffset,
+             const size3_t& extent, size_t bytesPerVoxel) {
+    const auto rowBytes = extent.x * bytesPerVoxel;
+    for (size_t z = 0; z < extent.z; ++z) {
+        for (size_t y = 0; y < extent.y; ++y) {
+            const auto s =
+                ((srcOffset.z + z) * srcDims.y + srcOffset.y + y) * srcDims.x + srcOffset.x;
+            const auto d =
+                ((dstOffset.z + z) * dstDims.y + dstOffset.y + y) * dstDims.x + dstOffset.x;
+            std::memcpy(dst + d * bytesPerVoxel, src + s * bytesPerVoxel, rowBytes);
+        }
+    }
+}
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readValue(std::istream& in) {
+    T value{};
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+}
+
+}  // namespace
+
+size3_t VolumeChunks::count() const {
+    return (dimensions + chunkDimensions - size3_t{1}) / chunkDimensions;
+}
+
+size_t VolumeChunks::size() const { return glm::compMul(count()); }
+
+size3_t VolumeChunks::chunkOffset(size_t chunk) const {
+    const auto c = count();
+    return size3_t{chunk % c.x, (chunk / c.x) % c.y, chunk / (c.x * c.y)} * chunkDimensions;
+}
+
+size3_t VolumeChunks::chunkExtent(size_t chunk) const {
+    return glm::min(chunkDimensions, dimensions - chunkOffset(chunk));
+}
+
+void writeVolumeChunks(const std::string& file, const void* data, const VolumeChunks& chunks,
+                       int level) {
+    if (glm::compMin(chunks.chunkDimensions) == 0) {
+        throw DataWriterException("Chunk dimensions must be larger than zero",
+                                  IVW_CONTEXT_CUSTOM("util::writeVolumeChunks"));
+    }
+    auto out = filesystem::ofstream(file, std::ios::out | std::ios::binary);
+    if (!out) {
+        throw DataWriterException("Could not write to file: " + file,
+                                  IVW_CONTEXT_CUSTOM("util::writeVolumeChunks"));
+    }
+
+    const auto nChunks = chunks.size();
+    std::vector<std::uint64_t> offsets(nChunks + 1, 0);
+
+    out.write(chunkMagic.data(), chunkMagic.size());
+    writeValue(out, chunkVersion);
+    writeValue(out, static_cast<std::uint64_t>(nChunks));
+    // Reserve space for the index, it is written once the compressed sizes are known
+    const auto indexPos = out.tellp();
+    out.write(reinterpret_cast<const char*>(offsets.data()),
+              offsets.size() * sizeof(std::uint64_t));
+
+    const auto src = static_cast<const std::byte*>(data);
+    const auto compressChunk = [&chunks, src, level](size_t chunk) {
+        const auto extent = chunks.chunkExtent(chunk);
+        std::vector<std::byte> raw(glm::compMul(extent) * chunks.bytesPerVoxel);
+        copyBox(src, chunks.dimensions, chunks.chunkOffset(chunk), raw.data(), extent, size3_t{0},
+                extent, chunks.bytesPerVoxel);
+
+        auto compressedSize = compressBound(static_cast<uLong>(raw.size()));
+        std::vector<std::byte> compressed(compressedSize);
+        if (compress2(reinterpret_cast<Bytef*>(compressed.data()), &compressedSize,
+                      reinterpret_cast<const Bytef*>(raw.data()), static_cast<uLong>(raw.size()),
+                      level) != Z_OK) {
+            throw DataWriterException("Could not compress volume chunk",
+                                      IVW_CONTEXT_CUSTOM("util::writeVolumeChunks"));
+        }
+        compressed.resize(compressedSize);
+        return compressed;
+    };
+
+    // Compress in the background while writing the finished chunks in order
+    std::deque<std::future<std::vector<std::byte>>> pending;
+    std::uint64_t pos = static_cast<std::uint64_t>(out.tellp());
+    size_t written = 0;
+    const auto writeNext = [&]() {
+        const auto compressed = pending.front().get();
+        pending.pop_front();
+        out.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+        offsets[written++] = pos;
+        pos += compressed.size();
+    };
+
+    try {
+        const auto window = chunkJobWindow();
+        for (size_t chunk = 0; chunk < nChunks; ++chunk) {
+            pending.push_back(
+                dispatchChunkJob([compressChunk, chunk]() { return compressChunk(chunk); }));
+            if (pending.size() >= window) writeNext();
+        }
+        while (!pending.empty()) writeNext();
+    } catch (...) {
+        waitForAll(pending);
+        throw;
+    }
+    offsets[nChunks] = pos;
+
+    out.seekp(indexPos);
+    out.write(reinterpret_cast<const char*>(offsets.data()),
+              offsets.size() * sizeof(std::uint64_t));
+
+    if (!out) {
+        throw DataWriterException("Could not write to file: " + file,
+                                  IVW_CONTEXT_CUSTOM("util::writeVolumeChunks"));
+    }
+}
+
+std::vector<std::uint64_t> readVolumeChunkIndex(const std::string& file, size_t byteOffset,
+                                                const VolumeChunks& chunks) {
+    auto in = filesystem::ifstream(file, std::ios::in | std::ios::binary);
+    if (!in) {
+        throw DataReaderException("Could not open file: " + file,
+                                  IVW_CONTEXT_CUSTOM("util::readVolumeChunkIndex"));
+    }
+    in.seekg(byteOffset);
+
+    std::array<char, 4> magic{};
+    in.read(magic.data(), magic.size());
+    const auto version = readValue<std::uint32_t>(in);
+    const auto nChunks = readValue<std::uint64_t>(in);
+    if (!in || magic != chunkMagic || version != chunkVersion || nChunks != chunks.size()) {
+        throw DataReaderException("Invalid chunk index in file: " + file,
+                                  IVW_CONTEXT_CUSTOM("util::readVolumeChunkIndex"));
+    }
+
+    std::vector<std::uint64_t> offsets(nChunks + 1);
+    in.read(reinterpret_cast<char*>(offsets.data()), offsets.size() * sizeof(std::uint64_t));
+    if (!in || !std::is_sorted(offsets.begin(), offsets.end())) {
+        throw DataReaderException("Invalid chunk index in file: " + file,
+                                  IVW_CONTEXT_CUSTOM("util::readVolumeChunkIndex"));
+    }
+    return offsets;
+}
+
+void readVolumeChunks(const std::string& file, size_t byteOffset, const VolumeChunks& chunks,
+                      const size3_t& offset, const size3_t& dimensions, void* dest) {
+    if (glm::any(glm::greaterThan(offset + dimensions, chunks.dimensions))) {
+        throw DataReaderException("Region is outside of the volume in file: " + file,
+                                  IVW_CONTEXT_CUSTOM("util::readVolumeChunks"));
+    }
+    if (glm::compMul(dimensions) == 0) return;
+
+    const auto offsets = readVolumeChunkIndex(file, byteOffset, chunks);
+    auto in = filesystem::ifstream(file, std::ios::in | std::ios::binary);
+    if (!in) {
+        throw DataReaderException("Could not open file: " + file,
+                                  IVW_CONTEXT_CUSTOM("util::readVolumeChunks"));
+    }
+
+    const auto dst = static_cast<std::byte*>(dest);
+    const auto decompressChunk = [&](size_t chunk, const std::vector<std::byte>& compressed) {
+        const auto chunkOffset = chunks.chunkOffset(chunk);
+        const auto extent = chunks.chunkExtent(chunk);
+        std::vector<std::byte> raw(glm::compMul(extent) * chunks.bytesPerVoxel);
+        auto rawSize = static_cast<uLongf>(raw.size());
+        if (uncompress(reinterpret_cast<Bytef*>(raw.data()), &rawSize,
+                       reinterpret_cast<const Bytef*>(compressed.data()),
+                       static_cast<uLong>(compressed.size())) != Z_OK ||
+            rawSize != raw.size()) {
+            throw DataReaderException("Corrupt volume chunk in file: " + file,
+                                      IVW_CONTEXT_CUSTOM("util::readVolumeChunks"));
+        }
+        // Copy the intersection of the chunk and the region
+        const auto begin = glm::max(chunkOffset, offset);
+        const auto end = glm::min(chunkOffset + extent, offset + dimensions);
+        copyBox(raw.data(), extent, begin - chunkOffset, dst, dimensions, begin - offset,
+                end - begin, chunks.bytesPerVoxel);
+    };
+
+    // Read the chunks intersecting the region and decompress them in the background
+    const auto count = chunks.count();
+    const auto first = offset / chunks.chunkDimensions;
+    const auto last = (offset + dimensions - size3_t{1}) / chunks.chunkDimensions;
+    std::deque<std::future<void>> pending;
+    try {
+        const auto window = chunkJobWindow();
+        for (size_t z = first.z; z <= last.z; ++z) {
+            for (size_t y = first.y; y <= last.y; ++y) {
+                for (size_t x = first.x; x <= last.x; ++x) {
+                    const size_t chunk = (z * count.y + y) * count.x + x;
+                    std::vector<std::byte> compressed(offsets[chunk + 1] - offsets[chunk]);
+                    in.seekg(byteOffset + offsets[chunk]);
+                    in.read(reinterpret_cast<char*>(compressed.data()), compressed.size());
+                    if (!in) {
+                        throw DataReaderException("Could not read volume chunk in file: " + file,
+                                                  IVW_CONTEXT_CUSTOM("util::readVolumeChunks"));
+                    }
+                    pending.push_back(dispatchChunkJob(
+                        [decompressChunk, chunk, compressed = std::move(compressed)]() {
+                            decompressChunk(chunk, compressed);
+                        }));
+                    if (pending.size() >= window) {
+                        pending.front().get();
+                        pending.pop_front();
+                    }
+                }
+            }
+        }
+        while (!pending.empty()) {
+            pending.front().get();
+            pending.pop_front();
+        }
+    } catch (...) {
+        waitForAll(pending);
+        throw;
+    }
+}
+
+}  // namespace util
+
+ChunkedVolumeRAMLoader::ChunkedVolumeRAMLoader(const std::string& file, size_t byteOffset,
+                                               const size3_t& chunkDimensions)
+    : file_{file}, byteOffset_{byteOffset}, chunkDimensions_{chunkDimensions} {}
+
+ChunkedVolumeRAMLoader* ChunkedVolumeRAMLoader::clone() const {
+    return new ChunkedVolumeRAMLoader(*this);
+}
+
+std::shared_ptr<VolumeRepresentation> ChunkedVolumeRAMLoader::createRepresentation(
+    const VolumeRepresentation& src) const {
+
+    // all voxels are read from file, no need to clear the data
+    auto volumeRAM = createVolumeRAM(src.getDimensions(), src.getDataFormat(),
+                                     util::RAMInit::Uninitialized, src.getSwizzleMask(),
+                                     src.getInterpolation(), src.getWrapping());
+    const util::VolumeChunks chunks{src.getDimensions(), chunkDimensions_,
+                                    src.getDataFormat()->getSize()};
+    util::readVolumeChunks(file_, byteOffset_, chunks, size3_t{0}, src.getDimensions(),
+                           volumeRAM->getData());
+    return volumeRAM;
+}
+
+void ChunkedVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
+                                                  const VolumeRepresentation& src) const {
+    auto volumeDst = std::static_pointer_cast<VolumeRAM>(dest);
+
+    if (src.getDimensions() != volumeDst->getDimensions()) {
+        volumeDst->setDimensions(src.getDimensions());
+    }
+
+    const util::VolumeChunks chunks{src.getDimensions(), chunkDimensions_,
+                                    src.getDataFormat()->getSize()};
+    util::readVolumeChunks(file_, byteOffset_, chunks, size3_t{0}, src.getDimensions(),
+                           volumeDst->getData());
+
+    volumeDst->setSwizzleMask(src.getSwizzleMask());
+    volumeDst->setInterpolation(src.getInterpolation());
+    volumeDst->setWrapping(src.getWrapping());
+}
+
+}  // namespace inviwo
@@ -46,13 +46,14 @@ void IvfSequenceVolumeWriter::writeData(const VolumeSequence* data, std::string
                                         std::string path,
                                         std::string reltivePathToTimesteps) const {
 
-    util::writeIvfVolumeSequence(*data, name, path, reltivePathToTimesteps, overwrite_);
+    util::writeIvfVolumeSequence(*data, name, path, reltivePathToTimesteps, overwrite_,
+                                 compression_);
 }
 
 namespace util {
 std::string writeIvfVolumeSequence(const VolumeSequence& volumes, std::string name,
                                    std::string path, std::string reltivePathToTimesteps,
-                                   bool overwrite) {
+                                   bool overwrite, const IvfCompression& compression) {
 
     auto ivfwFile = path + "/" + name + ".ivfs";
 
@@ -67,6 +68,7 @@ std::string writeIvfVolumeSequence(const VolumeSequence& volumes, std::string na
     filesystem::createDirectoryRecursively(path + "/" + reltivePathToTimesteps);
     IvfVolumeWriter writer;
     writer.setOverwrite(overwrite);
+    writer.setCompression(compression);
     std::vector<std::string> filenames;
     size_t i = 0;
     for (const auto& vol : volumes) {
@@ -34,6 +34,7 @@
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/io/datareaderexception.h>
 #include <inviwo/core/io/rawvolumeramloader.h>
+#include <modules/base/io/chunkedvolumeio.h>
 
 namespace inviwo {
 
@@ -43,25 +44,35 @@ IvfVolumeReader::IvfVolumeReader() : DataReaderType<Volume>() {
 
 IvfVolumeReader* IvfVolumeReader::clone() const { return new IvfVolumeReader(*this); }
 
-std::shared_ptr<Volume> IvfVolumeReader::readData(const std::string& filePath) {
+namespace {
+
+struct IvfHeader {
+    std::shared_ptr<Volume> volume;
+    std::string rawFile;
+    size_t byteOffset = 0u;
+    bool littleEndian = true;
+    std::string compression;
+    size3_t chunkDimensions{0};
+};
+
+IvfHeader readIvfHeader(const std::string& filePath) {
     if (!filesystem::fileExists(filePath)) {
-        throw DataReaderException("Error could not find input file: " + filePath, IVW_CONTEXT);
+        throw DataReaderException("Error could not find input file: " + filePath,
+                                  IVW_CONTEXT_CUSTOM("IvfVolumeReader"));
     }
 
     std::string fileDirectory = filesystem::getFileDirectory(filePath);
 
     Deserializer d(filePath);
 
-    std::string rawFile;
+    IvfHeader header;
     size3_t dimensions{0u};
-    size_t byteOffset = 0u;
     const DataFormatBase* format = nullptr;
-    bool littleEndian = true;
 
     d.registerFactory(InviwoApplication::getPtr()->getMetaDataFactory());
-    d.deserialize("RawFile", rawFile);
-    rawFile = fileDirectory + "/" + rawFile;
-    d.deserialize("ByteOffset", byteOffset);
+    d.deserialize("RawFile", header.rawFile);
+    header.rawFile = fileDirectory + "/" + header.rawFile;
+    d.deserialize("ByteOffset", header.byteOffset);
     std::string formatFlag;
     d.deserialize("Format", formatFlag);
     format = DataFormatBase::get(formatFlag);
@@ -74,6 +85,18 @@ std::shared_ptr<Volume> IvfVolumeReader::readData(const std::string& filePath) {
     d.deserialize("SwizzleMask", swizzleMask);
     d.deserialize("Interpolation", interpolation);
     d.deserialize("Wrapping", wrapping);
+    d.deserialize("Compression", header.compression);
+    d.deserialize("ChunkDimensions", header.chunkDimensions);
+
+    if (!header.compression.empty() && header.compression != "zlib") {
+        throw DataReaderException("Unsupported compression '" + header.compression +
+                                      "' in file: " + filePath,
+                                  IVW_CONTEXT_CUSTOM("IvfVolumeReader"));
+    }
+    if (!header.compression.empty() && glm::compMin(header.chunkDimensions) == 0) {
+        throw DataReaderException("Missing or invalid chunk dimensions in file: " + filePath,
+                                  IVW_CONTEXT_CUSTOM("IvfVolumeReader"));
+    }
 
     auto volume =
         std::make_shared<Volume>(dimensions, format, swizzleMask, interpolation, wrapping);
@@ -89,15 +112,83 @@ std::shared_ptr<Volume> IvfVolumeReader::readData(const std::string& filePath) {
     d.deserialize("Unit", volume->dataMap_.valueUnit);
 
     volume->getMetaDataMap()->deserialize(d);
-    littleEndian = volume->getMetaData<BoolMetaData>("LittleEndian", littleEndian);
-    auto vd = std::make_shared<VolumeDisk>(filePath, dimensions, format, swizzleMask, interpolation,
-                                           wrapping);
+    header.littleEndian = volume->getMetaData<BoolMetaData>("LittleEndian", header.littleEndian);
+    header.volume = volume;
+    return header;
+}
 
-    auto loader = std::make_unique<RawVolumeRAMLoader>(rawFile, byteOffset, littleEndian);
-    vd->setLoader(loader.release());
+}  // namespace
+
+std::shared_ptr<Volume> IvfVolumeReader::readData(const std::string& filePath) {
+    auto header = readIvfHeader(filePath);
+    auto& volume = header.volume;
+
+    auto vd = std::make_shared<VolumeDisk>(
+        filePath, volume->getDimensions(), volume->getDataFormat(), volume->getSwizzleMask(),
+        volume->getInterpolation(), volume->getWrapping());
+
+    if (header.compression.empty()) {
+        auto loader = std::make_unique<RawVolumeRAMLoader>(header.rawFile, header.byteOffset,
+                                                           header.littleEndian);
+        vd->setLoader(loader.release());
+    } else {
+        auto loader = std::make_unique<ChunkedVolumeRAMLoader>(header.rawFile, header.byteOffset,
+                                                               header.chunkDimensions);
+        vd->setLoader(loader.release());
+    }
 
     volume->addRepresentation(vd);
     return volume;
 }
 
+namespace util {
+
+std::shared_ptr<Volume> readIvfVolumeRegion(const std::string& filePath, const size3_t& offset,
+                                            const size3_t& dimensions) {
+    auto header = readIvfHeader(filePath);
+    const auto& full = *header.volume;
+    const auto fullDims = full.getDimensions();
+
+    if (glm::any(glm::greaterThan(offset + dimensions, fullDims))) {
+        throw DataReaderException("Region is outside of the volume in file: " + filePath,
+                                  IVW_CONTEXT_CUSTOM("util::readIvfVolumeRegion"));
+    }
+
+    std::shared_ptr<VolumeRAM> ram;
+    if (header.compression.empty()) {
+        // Without a chunk index the whole file has to be read, return a view of the region
+        IvfVolumeReader reader;
+        auto volume = reader.readData(filePath);
+        ram = createVolumeRAMView(*volume->getRepresentation<VolumeRAM>(), offset, dimensions);
+    } else {
+        // Only the chunks intersecting the region are read
+        ram = createVolumeRAM(dimensions, full.getDataFormat(), util::RAMInit::Uninitialized,
+                              full.getSwizzleMask(), full.getInterpolation(), full.getWrapping());
+        const VolumeChunks chunks{fullDims, header.chunkDimensions,
+                                  full.getDataFormat()->getSize()};
+        readVolumeChunks(header.rawFile, header.byteOffset, chunks, offset, dimensions,
+                         ram->getData());
+    }
+
+    auto region = std::make_shared<Volume>(ram);
+    region->copyMetaDataFrom(full);
+    region->dataMap_ = full.dataMap_;
+    region->setWorldMatrix(full.getWorldMatrix());
+
+    // Place the region where it was in the full volume
+    const mat3 basis = full.getBasis();
+    mat3 regionBasis = basis;
+    const vec3 dimRatio = static_cast<vec3>(dimensions) / static_cast<vec3>(fullDims);
+    regionBasis[0] *= dimRatio[0];
+    regionBasis[1] *= dimRatio[1];
+    regionBasis[2] *= dimRatio[2];
+    region->setBasis(regionBasis);
+    region->setOffset(full.getOffset() +
+                      basis * (static_cast<vec3>(offset) / static_cast<vec3>(fullDims)));
+
+    return region;
+}
+
+}  // namespace util
+
 }  // namespace inviwo
@@ -28,6 +28,7 @@
  *********************************************************************************/
 
 #include <modules/base/io/ivfvolumewriter.h>
+#include <modules/base/io/chunkedvolumeio.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/io/datawriterexception.h>
@@ -45,11 +46,18 @@ IvfVolumeWriter& IvfVolumeWriter::operator=(const IvfVolumeWriter& that) = defau
 IvfVolumeWriter* IvfVolumeWriter::clone() const { return new IvfVolumeWriter(*this); }
 
 void IvfVolumeWriter::writeData(const Volume* volume, const std::string filePath) const {
-    util::writeIvfVolume(*volume, filePath, getOverwrite());
+    util::writeIvfVolume(*volume, filePath, getOverwrite(), compression_);
 }
 
+void IvfVolumeWriter::setCompression(const util::IvfCompression& compression) {
+    compression_ = compression;
+}
+
+const util::IvfCompression& IvfVolumeWriter::getCompression() const { return compression_; }
+
 namespace util {
-void writeIvfVolume(const Volume& data, const std::string filePath, bool overwrite) {
+void writeIvfVolume(const Volume& data, const std::string filePath, bool overwrite,
+                    const IvfCompression& compression) {
     std::string rawPath = filesystem::replaceFileExtension(filePath, "raw");
 
     if (filesystem::fileExists(filePath) && !overwrite)
@@ -60,6 +68,10 @@ void writeIvfVolume(const Volume& data, const std::string filePath, bool overwri
         throw DataWriterException("Output file: " + rawPath + " already exists",
                                   IVW_CONTEXT_CUSTOM("util::writeIvfVolume"));
 
+    if (compression.enabled && glm::compMin(compression.chunkDimensions) == 0)
+        throw DataWriterException("Chunk dimensions must be larger than zero",
+                                  IVW_CONTEXT_CUSTOM("util::writeIvfVolume"));
+
     const std::string fileName = filesystem::getFileNameWithoutExtension(filePath);
     const VolumeRAM* vr = data.getRepresentation<VolumeRAM>();
     Serializer s(filePath);
@@ -76,11 +88,19 @@ void writeIvfVolume(const Volume& data, const std::string filePath, bool overwri
     s.serialize("SwizzleMask", vr->getSwizzleMask());
     s.serialize("Interpolation", vr->getInterpolation());
     s.serialize("Wrapping", vr->getWrapping());
+    if (compression.enabled) {
+        s.serialize("Compression", std::string{"zlib"});
+        s.serialize("ChunkDimensions", compression.chunkDimensions);
+    }
 
     data.getMetaDataMap()->serialize(s);
     s.writeFile();
 
-    if (auto fout = filesystem::ofstream(rawPath, std::ios::out | std::ios::binary)) {
+    if (compression.enabled) {
+        const VolumeChunks chunks{vr->getDimensions(), compression.chunkDimensions,
+                                  vr->getDataFormat()->getSize()};
+        writeVolumeChunks(rawPath, vr->getData(), chunks, compression.level);
+    } else if (auto fout = filesystem::ofstream(rawPath, std::ios::out | std::ios::binary)) {
         fout.write(static_cast<const char*>(vr->getData()),
                    glm::compMul(vr->getDimensions()) * vr->getDataFormat()->getSize());
     } else {
@@ -0,0 +1,87 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/processors/imagemorphology.h>
+#include <inviwo/core/datastructures/image/image.h>
+#include <inviwo/core/datastructures/image/layerram.h>
+
+namespace inviwo {
+
+const ProcessorInfo ImageMorphology::processorInfo_{
+    "org.inviwo.ImageMorphology",  // Class identifier
+    "Image Morphology",            // Display name
+    "Image Operation",             // Category
+    CodeState::Experimental,       // Code state
+    Tags::CPU,                     // Tags
+};
+const ProcessorInfo ImageMorphology::getProcessorInfo() const { return processorInfo_; }
+
+ImageMorphology::ImageMorphology()
+    : Processor()
+    , inport_("inputImage")
+    , outport_("outputImage", false)
+    , operation_("operation", "Operation",
+                 {{"erode", "Erode", util::MorphologyOperation::Erode},
+                  {"dilate", "Dilate", util::MorphologyOperation::Dilate},
+                  {"open", "Open", util::MorphologyOperation::Open},
+                  {"close", "Close", util::MorphologyOperation::Close}},
+                 0)
+    , shape_("shape", "Shape",
+             {{"box", "Box", util::MorphologyShape::Box},
+              {"disk", "Disk", util::MorphologyShape::Sphere}},
+             0)
+    , radius_("radius", "Radius", size2_t(1), size2_t(0), size2_t(32))
+    , binary_("binary", "Binary", false)
+    , foreground_("foreground", "Foreground Range", 0.5, 1.0, 0.0, 1.0) {
+
+    addPort(inport_);
+    addPort(outport_);
+    addProperties(operation_, shape_, radius_, binary_, foreground_);
+
+    foreground_.visibilityDependsOn(binary_, [](const auto& p) { return p.get(); });
+}
+
+void ImageMorphology::process() {
+    const auto image = inport_.getData();
+    const auto layer = image->getColorLayer();
+    const auto ram = layer->getRepresentation<LayerRAM>();
+
+    auto result = std::make_shared<Layer>(
+        binary_ ? util::layerBinaryMorphology(ram, foreground_.get(), operation_.get(),
+                                              shape_.get(), radius_.get())
+                : util::layerMorphology(ram, operation_.get(), shape_.get(), radius_.get()));
+    result->setModelMatrix(layer->getModelMatrix());
+    result->setWorldMatrix(layer->getWorldMatrix());
+
+    auto output = std::make_shared<Image>(result);
+    output->copyMetaDataFrom(*image);
+    outport_.setData(output);
+}
+
+}  // namespace inviwo
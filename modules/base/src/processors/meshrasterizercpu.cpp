@@ -0,0 +1,77 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/processors/meshrasterizercpu.h>
+#include <modules/base/algorithm/mesh/meshrasterizer.h>
+#include <inviwo/core/algorithm/boundingbox.h>
+#include <inviwo/core/datastructures/image/image.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo MeshRasterizerCPU::processorInfo_{
+    "org.inviwo.MeshRasterizerCPU",  // Class identifier
+    "Mesh Renderer CPU",             // Display name
+    "Mesh Rendering",                // Category
+    CodeState::Experimental,         // Code state
+    "CPU, Mesh, Rendering",          // Tags
+};
+const ProcessorInfo MeshRasterizerCPU::getProcessorInfo() const { return processorInfo_; }
+
+MeshRasterizerCPU::MeshRasterizerCPU()
+    : Processor()
+    , inport_("geometry")
+    , outport_("image")
+    , camera_("camera", "Camera", util::boundingBox(inport_))
+    , lighting_("lighting", "Lighting", &camera_)
+    , trackball_(&camera_)
+    , flatShading_("flatShading", "Flat Shading", false)
+    , defaultColor_("defaultColor", "Default Color", vec4(0.7f, 0.7f, 0.7f, 1.0f), vec4(0.0f),
+                    vec4(1.0f), vec4(0.01f), InvalidationLevel::InvalidOutput,
+                    PropertySemantics::Color)
+    , pointSize_("pointSize", "Point Size", 3.0f, 1.0f, 32.0f) {
+
+    addPort(inport_);
+    addPort(outport_);
+
+    addProperties(camera_, lighting_, trackball_, flatShading_, defaultColor_, pointSize_);
+}
+
+void MeshRasterizerCPU::process() {
+    util::MeshRasterizationSettings settings;
+    settings.lighting = util::lightingSettings(lighting_);
+    settings.flatShading = flatShading_.get();
+    settings.defaultColor = defaultColor_.get();
+    settings.pointSize = pointSize_.get();
+
+    outport_.setData(util::rasterizeMeshes(inport_.getVectorData(), camera_.get(),
+                                           outport_.getDimensions(), settings));
+}
+
+}  // namespace inviwo
@@ -38,6 +38,8 @@
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/zip.h>
+#include <algorithm>
+#include <cmath>
 #include <numeric>
 
 #include <inviwo/core/util/rendercontext.h>
@@ -45,6 +47,37 @@
 
 namespace inviwo {
 
+namespace {
+
+std::shared_ptr<Mesh> extractSurface(SurfaceExtraction::Method method,
+                                     std::shared_ptr<const Volume> vol, double iso, vec4 color,
+                                     bool invert, bool enclose,
+                                     std::function<void(float)> progress) {
+    RenderContext::getPtr()->activateLocalRenderContext();
+
+    switch (method) {
+        case SurfaceExtraction::Method::MarchingCubes:
+            return util::marchingcubes(vol, iso, color, invert, enclose, progress);
+        case SurfaceExtraction::Method::MarchingCubesOpt:
+            return util::marchingCubesOpt(vol, iso, color, invert, enclose, progress);
+        case SurfaceExtraction::Method::MarchingTetrahedron:
+        default:
+            return util::marchingtetrahedron(vol, iso, color, invert, enclose, progress);
+    }
+}
+
+size_t sizeInBytes(const std::vector<std::shared_ptr<Mesh>>& meshes) {
+    size_t size = 0;
+    for (const auto& mesh : meshes) {
+        if (!mesh) continue;
+        for (const auto& item : mesh->getBuffers()) size += item.second->getSizeInBytes();
+        for (const auto& item : mesh->getIndexBuffers()) size += item.second->getSizeInBytes();
+    }
+    return size;
+}
+
+}  // namespace
+
 const ProcessorInfo SurfaceExtraction::processorInfo_{
     "org.inviwo.SurfaceExtraction",  // Class identifier
     "Surface Extraction",            // Display name
@@ -66,7 +99,11 @@ SurfaceExtraction::SurfaceExtraction()
     , isoValue_("iso", "ISO Value", 0.5f, 0.0f, 1.0f, 0.01f)
     , invertIso_("invert", "Invert ISO", false)
     , encloseSurface_("enclose", "Enclose Surface", true)
-    , colors_("meshColors", "Mesh Colors") {
+    , colors_("meshColors", "Mesh Colors")
+    , speculate_("speculate", "Precompute Neighbouring ISO Values", true,
+                 InvalidationLevel::Valid)
+    , cacheSize_("cacheSize", "Cache Size (MB)", 256, 0, 4096, 1, InvalidationLevel::Valid)
+    , cache_{cacheSize_.get() * 1024 * 1024, sizeInBytes} {
 
     addPort(volume_);
     addPort(outport_);
@@ -76,6 +113,14 @@ SurfaceExtraction::SurfaceExtraction()
     addProperty(invertIso_);
     addProperty(encloseSurface_);
     addProperty(colors_);
+    addProperty(speculate_);
+    addProperty(cacheSize_);
+
+    cacheSize_.visibilityDependsOn(speculate_, [](const auto& p) { return p.get(); });
+    speculate_.onChange([this]() {
+        if (!speculate_.get()) cache_.clear();
+    });
+    cacheSize_.onChange([this]() { cache_.setMemoryCap(cacheSize_.get() * 1024 * 1024); });
 
     volume_.onChange([this]() {
         updateColors();
@@ -103,17 +148,7 @@ void SurfaceExtraction::process() {
         return [vol, color, method = method_.get(), iso = isoValue_.get(),
                 invert = invertIso_.get(),
                 enclose = encloseSurface_.get()](pool::Progress progress) -> std::shared_ptr<Mesh> {
-            RenderContext::getPtr()->activateLocalRenderContext();
-
-            switch (method) {
-                case Method::MarchingCubes:
-                    return util::marchingcubes(vol, iso, color, invert, enclose, progress);
-                case Method::MarchingCubesOpt:
-                    return util::marchingCubesOpt(vol, iso, color, invert, enclose, progress);
-                case Method::MarchingTetrahedron:
-                default:
-                    return util::marchingtetrahedron(vol, iso, color, invert, enclose, progress);
-            }
+            return extractSurface(method, vol, iso, color, invert, enclose, progress);
         };
     };
 
@@ -154,7 +189,58 @@ void SurfaceExtraction::process() {
     const bool stateChange = method_.isModified() || isoValue_.isModified() ||
                              invertIso_.isModified() || encloseSurface_.isModified();
 
-    if (stateChange || size != meshes_.size()) {  // Need to recompute all...
+    // The cached surfaces are only valid for the current volumes, method, and colors
+    const bool colorChange = std::any_of(colors_.begin(), colors_.end(),
+                                         [](const Property* p) { return p->isModified(); });
+    if (volume_.isChanged() || method_.isModified() || invertIso_.isModified() ||
+        encloseSurface_.isModified() || colorChange) {
+        cache_.clear();
+    }
+
+    // ISO values on the increment grid of the property can be cached and precomputed. The cache
+    // is keyed on the quantized ISO value, which keeps the entries valid if the increment changes.
+    const double increment = isoValue_.getIncrement();
+    const double steps = increment > 0.0 ? isoValue_.get() / increment : 0.5;
+    const auto step = std::round(steps);
+    const bool cacheable = speculate_.get() && std::abs(steps - step) < 1.0e-3;
+
+    if ((stateChange || size != meshes_.size()) && cacheable) {
+        std::vector<vec4> colors;
+        for (size_t i = 0; i < size; ++i) colors.push_back(getColor(i));
+
+        const auto makeJob = [volumes = std::vector<std::shared_ptr<const Volume>>(
+                                  volume_.begin(), volume_.end()),
+                              colors, method = method_.get(), invert = invertIso_.get(),
+                              enclose = encloseSurface_.get()](double iso) {
+            return [volumes, colors, method, invert, enclose, iso](pool::Progress progress) {
+                std::vector<std::shared_ptr<Mesh>> meshes;
+                const auto count = static_cast<float>(volumes.size());
+                for (size_t i = 0; i < volumes.size(); ++i) {
+                    const auto offset = static_cast<float>(i);
+                    meshes.push_back(extractSurface(
+                        method, volumes[i], iso, colors[i], invert, enclose,
+                        [&](float p) { progress((offset + p) / count); }));
+                }
+                return meshes;
+            };
+        };
+
+        std::vector<double> neighbours;
+        for (const auto neighbour : {step + 1.0, step - 1.0}) {
+            const auto iso = neighbour * increment;
+            if (iso >= isoValue_.getMinValue() && iso <= isoValue_.getMaxValue()) {
+                neighbours.push_back(iso);
+            }
+        }
+
+        dispatchSpeculative(cache_, step * increment, neighbours, makeJob,
+                            [this](std::vector<std::shared_ptr<Mesh>> result) {
+                                meshes_ = result;
+                                outport_.setData(
+                                    std::make_shared<std::vector<std::shared_ptr<Mesh>>>(meshes_));
+                                newResults();
+                            });
+    } else if (stateChange || size != meshes_.size()) {  // Need to recompute all...
         std::vector<decltype(computeSurface(vec4{}, std::shared_ptr<const Volume>{}))> jobs;
         for (auto [i, vol] : util::enumerate(volume_)) {
             jobs.push_back(computeSurface(getColor(i), vol));
@@ -224,6 +310,8 @@ void SurfaceExtraction::updateColors() {
     }
 }
 
+const pool::CacheStats& SurfaceExtraction::getCacheStats() const { return cache_.getStats(); }
+
 vec4 SurfaceExtraction::getColor(size_t i) const {
     return static_cast<const FloatVec4Property*>(colors_[i])->get();
 }
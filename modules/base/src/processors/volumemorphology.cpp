@@ -0,0 +1,95 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/processors/volumemorphology.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+
+namespace inviwo {
+
+const ProcessorInfo VolumeMorphology::processorInfo_{
+    "org.inviwo.VolumeMorphology",  // Class identifier
+    "Volume Morphology",            // Display name
+    "Volume Operation",             // Category
+    CodeState::Experimental,        // Code state
+    Tags::CPU,                      // Tags
+};
+const ProcessorInfo VolumeMorphology::getProcessorInfo() const { return processorInfo_; }
+
+VolumeMorphology::VolumeMorphology()
+    : Processor()
+    , inport_("inputVolume")
+    , outport_("outputVolume")
+    , operation_("operation", "Operation",
+                 {{"erode", "Erode", util::MorphologyOperation::Erode},
+                  {"dilate", "Dilate", util::MorphologyOperation::Dilate},
+                  {"open", "Open", util::MorphologyOperation::Open},
+                  {"close", "Close", util::MorphologyOperation::Close}},
+                 0)
+    , shape_("shape", "Shape",
+             {{"box", "Box", util::MorphologyShape::Box},
+              {"sphere", "Sphere", util::MorphologyShape::Sphere}},
+             0)
+    , radius_("radius", "Radius", size3_t(1), size3_t(0), size3_t(32))
+    , binary_("binary", "Binary", false)
+    , foreground_("foreground", "Foreground Range", 0.5, 1.0, 0.0, 1.0) {
+
+    addPort(inport_);
+    addPort(outport_);
+    addProperties(operation_, shape_, radius_, binary_, foreground_);
+
+    foreground_.visibilityDependsOn(binary_, [](const auto& p) { return p.get(); });
+
+    inport_.onChange([this]() {
+        if (inport_.hasData()) {
+            foreground_.setRangeNormalized(inport_.getData()->dataMap_.dataRange);
+        }
+    });
+}
+
+void VolumeMorphology::process() {
+    const auto volume = inport_.getData();
+    const auto ram = volume->getRepresentation<VolumeRAM>();
+
+    std::shared_ptr<Volume> result;
+    if (binary_) {
+        result = std::make_shared<Volume>(util::volumeBinaryMorphology(
+            ram, foreground_.get(), operation_.get(), shape_.get(), radius_.get()));
+        result->dataMap_.dataRange = dvec2(0.0, 255.0);
+    } else {
+        result = std::make_shared<Volume>(
+            util::volumeMorphology(ram, operation_.get(), shape_.get(), radius_.get()));
+        result->dataMap_ = volume->dataMap_;
+    }
+    result->copyMetaDataFrom(*volume);
+    result->setModelMatrix(volume->getModelMatrix());
+    result->setWorldMatrix(volume->getWorldMatrix());
+    outport_.setData(result);
+}
+
+}  // namespace inviwo
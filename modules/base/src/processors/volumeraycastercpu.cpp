@@ -0,0 +1,108 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/processors/volumeraycastercpu.h>
+#include <inviwo/core/algorithm/boundingbox.h>
+#include <inviwo/core/datastructures/image/image.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo VolumeRaycasterCPU::processorInfo_{
+    "org.inviwo.VolumeRaycasterCPU",  // Class identifier
+    "Volume Raycaster CPU",           // Display name
+    "Volume Rendering",               // Category
+    CodeState::Experimental,          // Code state
+    "CPU, DVR, Raycasting",           // Tags
+};
+const ProcessorInfo VolumeRaycasterCPU::getProcessorInfo() const { return processorInfo_; }
+
+VolumeRaycasterCPU::VolumeRaycasterCPU()
+    : Processor()
+    , volumePort_("volume")
+    , outport_("outport")
+    , channel_("channel", "Render Channel", {{"channel1", "Channel 1", 0}})
+    , transferFunction_("transferFunction", "Transfer Function", &volumePort_)
+    , samplingRate_("samplingRate", "Sampling Rate", 2.0f, 1.0f, 10.0f)
+    , emptySpaceSkipping_("emptySpaceSkipping", "Empty Space Skipping", true)
+    , brickSize_("brickSize", "Brick Size", 8, 2, 64)
+    , camera_("camera", "Camera", util::boundingBox(volumePort_))
+    , lighting_("lighting", "Lighting", &camera_)
+    , trackball_(&camera_) {
+
+    addPort(volumePort_);
+    addPort(outport_);
+    setPreviewSupported(true);
+
+    channel_.setSerializationMode(PropertySerializationMode::All);
+
+    // adjust option property for available channels when the input volume changes
+    volumePort_.onChange([this]() {
+        if (volumePort_.hasData()) {
+            size_t channels = volumePort_.getData()->getDataFormat()->getComponents();
+
+            if (channels == channel_.size()) return;
+
+            std::vector<OptionPropertyIntOption> channelOptions;
+            for (size_t i = 0; i < channels; i++) {
+                channelOptions.emplace_back("channel" + toString(i + 1),
+                                            "Channel " + toString(i + 1), static_cast<int>(i));
+            }
+            channel_.replaceOptions(channelOptions);
+            channel_.setCurrentStateAsDefault();
+        }
+    });
+
+    addProperties(channel_, transferFunction_, samplingRate_, emptySpaceSkipping_, brickSize_,
+                  camera_, lighting_, trackball_);
+}
+
+void VolumeRaycasterCPU::process() {
+    auto volume = volumePort_.getData();
+
+    const auto channel = static_cast<size_t>(channel_.get());
+    if (!emptySpaceSkipping_) {
+        bricks_.reset();
+    } else if (!bricks_ || volumePort_.isChanged() || bricks_->getChannel() != channel ||
+               bricks_->getBrickSize() != brickSize_.get()) {
+        bricks_ = std::make_unique<util::VolumeMinMaxBricks>(*volume, channel, brickSize_.get());
+    }
+
+    util::VolumeRaycastingSettings settings;
+    settings.channel = channel;
+    // a quarter of the samples while previewing, the opacity correction keeps the appearance
+    settings.samplingRate = isPreview() ? 0.25f * samplingRate_.get() : samplingRate_.get();
+    settings.lighting = util::lightingSettings(lighting_);
+
+    outport_.setData(util::raycastVolume(*volume, transferFunction_.get(), camera_.get(),
+                                         outport_.getDimensions(), settings, bricks_.get()));
+}
+
+}  // namespace inviwo
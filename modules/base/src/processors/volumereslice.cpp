@@ -0,0 +1,132 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/processors/volumereslice.h>
+#include <inviwo/core/datastructures/geometry/plane.h>
+#include <inviwo/core/datastructures/image/image.h>
+#include <inviwo/core/datastructures/image/layer.h>
+
+namespace inviwo {
+
+const ProcessorInfo VolumeReslice::processorInfo_{
+    "org.inviwo.VolumeReslice",  // Class identifier
+    "Volume Reslice",            // Display name
+    "Volume Operation",          // Category
+    CodeState::Experimental,     // Code state
+    Tags::CPU,                   // Tags
+};
+const ProcessorInfo VolumeReslice::getProcessorInfo() const { return processorInfo_; }
+
+VolumeReslice::VolumeReslice()
+    : Processor()
+    , inport_("inputVolume")
+    , outport_("outputImage", DataFloat32::get(), false)
+    , view_("view", "View",
+            {{"axial", "Axial", View::Axial},
+             {"coronal", "Coronal", View::Coronal},
+             {"sagittal", "Sagittal", View::Sagittal},
+             {"custom", "Custom", View::Custom}},
+            0)
+    , position_("position", "Plane Position", vec3(0.5f), vec3(0.0f), vec3(1.0f))
+    , normal_("normal", "Plane Normal", vec3(0.0f, 0.0f, 1.0f), vec3(-1.0f), vec3(1.0f))
+    , up_("up", "Up Vector", vec3(0.0f, 1.0f, 0.0f), vec3(-1.0f), vec3(1.0f))
+    , zoom_("zoom", "Zoom", 1.0f, 0.1f, 10.0f)
+    , dimensions_("dimensions", "Output Dimensions", size2_t(512), size2_t(1), size2_t(4096))
+    , interpolation_("interpolation", "Interpolation",
+                     {{"linear", "Linear", InterpolationType::Linear},
+                      {"nearest", "Nearest", InterpolationType::Nearest}},
+                     0)
+    , thickness_("thickness", "Slab Thickness", 0.0f, 0.0f, 10.0f)
+    , projection_("projection", "Slab Projection",
+                  {{"maximum", "Maximum", util::SlabProjection::Maximum},
+                   {"minimum", "Minimum", util::SlabProjection::Minimum},
+                   {"average", "Average", util::SlabProjection::Average}},
+                  0)
+    , normalize_("normalize", "Normalize", true)
+    , fillValue_("fillValue", "Fill Value", 0.0, -1.0e6, 1.0e6) {
+
+    addPort(inport_);
+    addPort(outport_);
+    addProperties(view_, position_, normal_, up_, zoom_, dimensions_, interpolation_, thickness_,
+                  projection_, normalize_, fillValue_);
+
+    projection_.visibilityDependsOn(thickness_, [](const auto& p) { return p.get() > 0.0f; });
+    view_.onChange([this]() { updateView(); });
+    updateView();
+}
+
+void VolumeReslice::updateView() {
+    const bool custom = view_.get() == View::Custom;
+    normal_.setReadOnly(!custom);
+    up_.setReadOnly(!custom);
+    switch (view_.get()) {
+        case View::Axial:
+            normal_.set(vec3(0.0f, 0.0f, 1.0f));
+            up_.set(vec3(0.0f, 1.0f, 0.0f));
+            break;
+        case View::Coronal:
+            normal_.set(vec3(0.0f, -1.0f, 0.0f));
+            up_.set(vec3(0.0f, 0.0f, 1.0f));
+            break;
+        case View::Sagittal:
+            normal_.set(vec3(1.0f, 0.0f, 0.0f));
+            up_.set(vec3(0.0f, 0.0f, 1.0f));
+            break;
+        case View::Custom:
+        default:
+            break;
+    }
+}
+
+void VolumeReslice::process() {
+    const auto volume = inport_.getData();
+
+    const vec3 normal = glm::length(normal_.get()) > 0.0f ? normal_.get() : vec3(0.0f, 0.0f, 1.0f);
+    const vec3 point{volume->getCoordinateTransformer().getTextureToWorldMatrix() *
+                     vec4(position_.get(), 1.0f)};
+
+    auto rect = util::fitResliceRect(*volume, Plane(point, glm::normalize(normal)), up_.get());
+    // zoom around the center of the rectangle
+    const vec3 center = rect.origin + 0.5f * (rect.uAxis + rect.vAxis);
+    rect.uAxis /= zoom_.get();
+    rect.vAxis /= zoom_.get();
+    rect.origin = center - 0.5f * (rect.uAxis + rect.vAxis);
+
+    util::VolumeResliceSettings settings;
+    settings.interpolation = interpolation_.get();
+    settings.thickness = thickness_.get();
+    settings.projection = projection_.get();
+    settings.normalize = normalize_.get();
+    settings.fillValue = fillValue_.get();
+
+    auto layer = util::resliceVolume(*volume, rect, dimensions_.get(), settings);
+    outport_.setData(std::make_shared<Image>(layer));
+}
+
+}  // namespace inviwo
@@ -58,13 +58,14 @@ VolumeSequenceSingleTimestepSamplerProcessor::VolumeSequenceSingleTimestepSample
     timestamp_.setSerializationMode(PropertySerializationMode::All);
 
     volumeSequence_.onChange([&]() {
-        if (!sampler_.hasData()) return;
         auto seq = volumeSequence_.getData();
-        if (!util::hasTimestamps(*seq, false)) {
+        timeIndex_ = util::TimeIndex(*seq);
+        if (!sampler_.hasData()) return;
+        if (!timeIndex_.hasTimestamps()) {
             LogWarn("Input volume Sequence does not have timestamps, behaviour is undefined");
         }
 
-        auto newrange = util::getTimestampRange(*seq);
+        auto newrange = timeIndex_.getRange();
         float t = static_cast<float>((timestamp_.get() - timestamp_.getMinValue()) /
                                      (timestamp_.getMaxValue() - timestamp_.getMinValue()));
 
@@ -77,20 +78,16 @@ VolumeSequenceSingleTimestepSamplerProcessor::VolumeSequenceSingleTimestepSample
 }
 
 void VolumeSequenceSingleTimestepSamplerProcessor::process() {
-
-    float t = 0;
-    auto vols = util::getVolumesForTimestep(*volumeSequence_.getData(), timestamp_.get());
-
-    if (util::hasTimestamp(vols.first) && util::hasTimestamp(vols.second)) {
-        auto t0 = util::getTimestamp(vols.first);
-        auto t1 = util::getTimestamp(vols.second);
-        if (t0 != t1) {
-            t = static_cast<float>((timestamp_.get() - t0) / (t1 - t0));
-        }
+    const auto& seq = *volumeSequence_.getData();
+    if (!timeIndex_.isIndexOf(seq)) {
+        timeIndex_ = util::TimeIndex(seq);
     }
 
-    auto sampler =
-        std::make_shared<VolumeSequenceSingleTimestepSampler>(t, vols.first, vols.second);
+    const auto interval = timeIndex_.interpolate(timestamp_.get());
+    // Without timestamps there is nothing to interpolate between, only use the first volume
+    const double weight = timeIndex_.hasTimestamps() ? interval.weight : 0.0;
+    auto sampler = std::make_shared<VolumeSequenceSingleTimestepSampler>(
+        weight, seq[interval.first], seq[interval.second]);
     sampler_.setData(sampler);
 }
 
@@ -34,13 +34,102 @@
 
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumebrickedprecision.h>
 #include <inviwo/core/datastructures/image/imageram.h>
 #include <inviwo/core/datastructures/image/layerramprecision.h>
 
-#include <inviwo/core/util/indexmapper.h>
-
 namespace inviwo {
 
+namespace {
+
+size2_t sliceDimensions(CartesianCoordinateAxis axis, const size3_t& voldim) {
+    switch (axis) {
+        default:
+        case CartesianCoordinateAxis::X:
+            return size2_t(voldim.z, voldim.y);
+        case CartesianCoordinateAxis::Y:
+            return size2_t(voldim.x, voldim.z);
+        case CartesianCoordinateAxis::Z:
+            return size2_t(voldim.x, voldim.y);
+    }
+}
+
+template <typename T>
+void copySlice(const T* voldata, const size3_t& voldim, CartesianCoordinateAxis axis,
+               size_t slice, T* layerdata) {
+    switch (axis) {
+        case CartesianCoordinateAxis::X: {
+            const auto x = glm::clamp(slice, size_t{0}, voldim.x - 1);
+            const size_t sliceSize = voldim.x * voldim.y;
+            // write the image rows contiguously, each row reads one voxel per volume slice
+            for (size_t y = 0; y < voldim.y; y++) {
+                const T* src = voldata + y * voldim.x + x;
+                T* dest = layerdata + y * voldim.z;
+                for (size_t z = 0; z < voldim.z; z++) {
+                    dest[z] = src[z * sliceSize];
+                }
+            }
+            break;
+        }
+        case CartesianCoordinateAxis::Y: {
+            const auto y = glm::clamp(slice, size_t{0}, voldim.y - 1);
+            const size_t dataSize = voldim.x;
+            const size_t initialStartPos = y * voldim.x;
+            for (size_t j = 0; j < voldim.z; j++) {
+                const size_t offsetVolume = (j * voldim.x * voldim.y) + initialStartPos;
+                const size_t offsetImage = j * voldim.x;
+                std::copy(voldata + offsetVolume, voldata + offsetVolume + dataSize,
+                          layerdata + offsetImage);
+            }
+            break;
+        }
+        case CartesianCoordinateAxis::Z: {
+            const auto z = glm::clamp(slice, size_t{0}, voldim.z - 1);
+            const size_t dataSize = voldim.x * voldim.y;
+            const size_t initialStartPos = z * voldim.x * voldim.y;
+            std::copy(voldata + initialStartPos, voldata + initialStartPos + dataSize, layerdata);
+            break;
+        }
+    }
+}
+
+/**
+ * Get an unused image of type \p T and size \p imgdim from the \p cache, fill it using
+ * `fill(T* layerdata)`, and add it to the cache.
+ */
+template <typename T, typename Fill>
+std::shared_ptr<Image> createSlice(ImageReuseCache& cache, const size2_t& imgdim, Fill fill) {
+    auto res = cache.getTypedUnused<T>(imgdim);
+    auto sliceImage = res.first;
+    auto layerrep = res.second;
+
+    switch (util::extent<T, 0>::value) {
+        case 0:  // util::extent<T, 0>::value returns zero for non-glm types
+        case 1:
+            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Red, ImageChannel::Red,
+                                       ImageChannel::One}});
+            break;
+        case 2:
+            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green, ImageChannel::Zero,
+                                       ImageChannel::One}});
+            break;
+        case 3:
+            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green, ImageChannel::Blue,
+                                       ImageChannel::One}});
+            break;
+        default:
+        case 4:
+            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green, ImageChannel::Blue,
+                                       ImageChannel::Alpha}});
+    }
+
+    fill(layerrep->getDataTyped());
+    cache.add(sliceImage);
+    return sliceImage;
+}
+
+}  // namespace
+
 const ProcessorInfo VolumeSlice::processorInfo_{
     "org.inviwo.VolumeSlice",  // Class identifier
     "Volume Slice Extracter",  // Display name
@@ -60,6 +149,7 @@ VolumeSlice::VolumeSlice()
                        {"z", "Z axis", CartesianCoordinateAxis::Z}},
                       0)
     , sliceNumber_("sliceNumber", "Slice Number", 4, 1, 8)
+    , useBrickedLayout_("useBrickedLayout", "Use Bricked Layout", false)
     , handleInteractionEvents_("handleEvents", "Handle interaction events", true,
                                InvalidationLevel::Valid)
     , mouseShiftSlice_(
@@ -83,6 +173,7 @@ VolumeSlice::VolumeSlice()
     addPort(outport_);
     addProperty(sliceAlongAxis_);
     addProperty(sliceNumber_);
+    addProperty(useBrickedLayout_);
     addProperty(handleInteractionEvents_);
 
     addProperty(stepSliceUp_);
@@ -137,96 +228,38 @@ void VolumeSlice::process() {
             break;
     }
 
-    auto image =
-        vol->getRepresentation<VolumeRAM>()
-            ->dispatch<std::shared_ptr<Image>, dispatching::filter::All>(
-                [axis = static_cast<CartesianCoordinateAxis>(sliceAlongAxis_.get()),
-                 slice = static_cast<size_t>(sliceNumber_.get() - 1),
-                 &cache = imageCache_](const auto vrprecision) {
-                    using T = util::PrecisionValueType<decltype(vrprecision)>;
-
-                    const T* voldata = vrprecision->getDataTyped();
-                    const auto voldim = vrprecision->getDimensions();
-
-                    const auto imgdim = [&]() {
-                        switch (axis) {
-                            default:
-                                return size2_t(voldim.z, voldim.y);
-                            case CartesianCoordinateAxis::X:
-                                return size2_t(voldim.z, voldim.y);
-                            case CartesianCoordinateAxis::Y:
-                                return size2_t(voldim.x, voldim.z);
-                            case CartesianCoordinateAxis::Z:
-                                return size2_t(voldim.x, voldim.y);
-                        }
-                    }();
-
-                    auto res = cache.getTypedUnused<T>(imgdim);
-                    auto sliceImage = res.first;
-                    auto layerrep = res.second;
-                    auto layerdata = layerrep->getDataTyped();
-
-                    switch (util::extent<T, 0>::value) {
-                        case 0:  // util::extent<T, 0>::value returns zero for non-glm types
-                        case 1:
-                            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Red,
-                                                       ImageChannel::Red, ImageChannel::One}});
-                            break;
-                        case 2:
-                            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
-                                                       ImageChannel::Zero, ImageChannel::One}});
-                            break;
-                        case 3:
-                            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
-                                                       ImageChannel::Blue, ImageChannel::One}});
-                            break;
-                        default:
-                        case 4:
-                            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
-                                                       ImageChannel::Blue, ImageChannel::Alpha}});
-                    }
-
-                    size_t offsetVolume;
-                    size_t offsetImage;
-                    switch (axis) {
-                        case CartesianCoordinateAxis::X: {
-                            util::IndexMapper3D vm(voldim);
-                            util::IndexMapper2D im(imgdim);
-                            auto x = glm::clamp(slice, size_t{0}, voldim.x - 1);
-                            for (size_t z = 0; z < voldim.z; z++) {
-                                for (size_t y = 0; y < voldim.y; y++) {
-                                    offsetVolume = vm(x, y, z);
-                                    offsetImage = im(z, y);
-                                    layerdata[offsetImage] = voldata[offsetVolume];
-                                }
-                            }
-                            break;
-                        }
-                        case CartesianCoordinateAxis::Y: {
-                            auto y = glm::clamp(slice, size_t{0}, voldim.y - 1);
-                            const size_t dataSize = voldim.x;
-                            const size_t initialStartPos = y * voldim.x;
-                            for (size_t j = 0; j < voldim.z; j++) {
-                                offsetVolume = (j * voldim.x * voldim.y) + initialStartPos;
-                                offsetImage = j * voldim.x;
-                                std::copy(voldata + offsetVolume, voldata + offsetVolume + dataSize,
-                                          layerdata + offsetImage);
-                            }
-                            break;
-                        }
-                        case CartesianCoordinateAxis::Z: {
-                            auto z = glm::clamp(slice, size_t{0}, voldim.z - 1);
-                            const size_t dataSize = voldim.x * voldim.y;
-                            const size_t initialStartPos = z * voldim.x * voldim.y;
-
-                            std::copy(voldata + initialStartPos,
-                                      voldata + initialStartPos + dataSize, layerdata);
-                            break;
-                        }
-                    }
-                    cache.add(sliceImage);
-                    return sliceImage;
-                });
+    const auto axis = sliceAlongAxis_.get();
+    const auto slice = static_cast<size_t>(sliceNumber_.get() - 1);
+
+    std::shared_ptr<Image> image;
+    if (useBrickedLayout_ || vol->hasRepresentation<VolumeBricked>()) {
+        image = vol->getRepresentation<VolumeBricked>()
+                    ->dispatch<std::shared_ptr<Image>, dispatching::filter::All>(
+                        [&](const auto vbprecision) {
+                            using T = util::PrecisionValueType<decltype(vbprecision)>;
+                            const auto voldim = vbprecision->getDimensions();
+                            return createSlice<T>(
+                                imageCache_, vbprecision->getSliceDimensions(axis),
+                                [&](T* layerdata) {
+                                    const auto s = glm::clamp(slice, size_t{0},
+                                                              voldim[static_cast<int>(axis)] - 1);
+                                    vbprecision->copySlice(axis, s, layerdata);
+                                });
+                        });
+    } else {
+        image = vol->getRepresentation<VolumeRAM>()
+                    ->dispatch<std::shared_ptr<Image>, dispatching::filter::All>(
+                        [&](const auto vrprecision) {
+                            using T = util::PrecisionValueType<decltype(vrprecision)>;
+                            const T* voldata = vrprecision->getDataTyped();
+                            const auto voldim = vrprecision->getDimensions();
+                            return createSlice<T>(imageCache_, sliceDimensions(axis, voldim),
+                                                  [&](T* layerdata) {
+                                                      copySlice(voldata, voldim, axis, slice,
+                                                                layerdata);
+                                                  });
+                        });
+    }
 
     outport_.setData(image);
 }
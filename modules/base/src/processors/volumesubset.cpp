@@ -28,7 +28,7 @@
  *********************************************************************************/
 
 #include <modules/base/processors/volumesubset.h>
-#include <modules/base/algorithm/volume/volumeramsubset.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/network/networklock.h>
 #include <glm/gtx/vector_angle.hpp>
 
@@ -95,7 +95,8 @@ void VolumeSubset::process() {
         if (dim == dims_)
             outport_.setData(inport_.getData());
         else {
-            auto volume = std::make_shared<Volume>(VolumeRAMSubSet::apply(vol, dim, offset));
+            // The subset is a view of the input data, the voxels are only copied if needed
+            auto volume = std::make_shared<Volume>(createVolumeRAMView(*vol, offset, dim));
             // pass meta data on
             volume->copyMetaDataFrom(*inport_.getData());
             volume->dataMap_ = inport_.getData()->dataMap_;
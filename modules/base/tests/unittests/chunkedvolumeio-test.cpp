@@ -0,0 +1,233 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/io/chunkedvolumeio.h>
+#include <modules/base/io/ivfvolumereader.h>
+#include <modules/base/io/ivfvolumewriter.h>
+#include <modules/base/basemodulesharedlibrary.h>
+#include <inviwo/core/common/coremodulesharedlibrary.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/io/datawriterexception.h>
+#include <inviwo/core/util/logcentral.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+TEST(ChunkedVolumeIO, Layout) {
+    const util::VolumeChunks chunks{size3_t{70, 45, 33}, size3_t{16}, 2};
+    EXPECT_EQ(chunks.count(), size3_t(5, 3, 3));
+    EXPECT_EQ(chunks.size(), size_t{45});
+    EXPECT_EQ(chunks.chunkOffset(0), size3_t(0, 0, 0));
+    EXPECT_EQ(chunks.chunkOffset(6), size3_t(16, 16, 0));
+    EXPECT_EQ(chunks.chunkExtent(44), size3_t(6, 13, 1));
+}
+
+TEST(ChunkedVolumeIO, WriteRead) {
+    const size3_t dims{70, 45, 33};
+    const util::VolumeChunks chunks{dims, size3_t{16}, sizeof(std::uint16_t)};
+    std::vector<std::uint16_t> data(glm::compMul(dims));
+    std::iota(data.begin(), data.end(), std::uint16_t{0});
+
+    const auto file =
+        (std::filesystem::temp_directory_path() / "inviwo-chunkedvolumeio-test.raw").string();
+    util::writeVolumeChunks(file, data.data(), chunks);
+
+    std::vector<std::uint16_t> all(data.size());
+    util::readVolumeChunks(file, 0, chunks, size3_t{0}, dims, all.data());
+    EXPECT_EQ(all, data);
+
+    const size3_t offset{5, 17, 3};
+    const size3_t regionDims{40, 20, 29};
+    std::vector<std::uint16_t> region(glm::compMul(regionDims));
+    util::readVolumeChunks(file, 0, chunks, offset, regionDims, region.data());
+    for (size_t z = 0; z < regionDims.z; ++z) {
+        for (size_t y = 0; y < regionDims.y; ++y) {
+            for (size_t x = 0; x < regionDims.x; ++x) {
+                const auto pos = offset + size3_t{x, y, z};
+                ASSERT_EQ(region[(z * regionDims.y + y) * regionDims.x + x],
+                          data[(pos.z * dims.y + pos.y) * dims.x + pos.x]);
+            }
+        }
+    }
+
+    EXPECT_ANY_THROW(util::readVolumeChunks(file, 0, chunks, offset, dims, all.data()));
+
+    std::filesystem::remove(file);
+}
+
+/**
+ * The ivf reader and writer need the metadata factory of an application with the core and base
+ * modules, only set it up for the tests that read and write ivf files.
+ */
+class IvfVolumeIO : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        if (!LogCentral::isInitialized()) LogCentral::init();
+        app_ = std::make_unique<InviwoApplication>("Inviwo-Unittests-Base-Ivf");
+        std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
+        modules.emplace_back(createInviwoCore());
+        modules.emplace_back(createBaseModule());
+        app_->registerModules(std::move(modules));
+        app_->processFront();
+    }
+    static void TearDownTestSuite() { app_.reset(); }
+
+    void TearDown() override {
+        std::filesystem::remove(ivf);
+        std::filesystem::remove(raw);
+    }
+
+    // 70 x 45 x 33 is not a multiple of the chunk size, the chunks at the border are partial
+    static constexpr size3_t dims{70, 45, 33};
+
+    static std::shared_ptr<Volume> createVolume() {
+        auto volume = std::make_shared<Volume>(dims, DataUInt16::get());
+        auto data = static_cast<std::uint16_t*>(
+            volume->getEditableRepresentation<VolumeRAM>()->getData());
+        std::iota(data, data + glm::compMul(dims), std::uint16_t{0});
+        return volume;
+    }
+
+    static std::uint16_t value(const size3_t& pos) {
+        return static_cast<std::uint16_t>((pos.z * dims.y + pos.y) * dims.x + pos.x);
+    }
+
+    static void expectRegion(const Volume& volume, const size3_t& offset) {
+        const auto regionDims = volume.getDimensions();
+        const auto data =
+            static_cast<const std::uint16_t*>(volume.getRepresentation<VolumeRAM>()->getData());
+        for (size_t z = 0; z < regionDims.z; ++z) {
+            for (size_t y = 0; y < regionDims.y; ++y) {
+                for (size_t x = 0; x < regionDims.x; ++x) {
+                    ASSERT_EQ(data[(z * regionDims.y + y) * regionDims.x + x],
+                              value(offset + size3_t{x, y, z}));
+                }
+            }
+        }
+    }
+
+    const std::string ivf =
+        (std::filesystem::temp_directory_path() / "inviwo-chunkedvolumeio-test.ivf").string();
+    const std::string raw =
+        (std::filesystem::temp_directory_path() / "inviwo-chunkedvolumeio-test.raw").string();
+
+    static std::unique_ptr<InviwoApplication> app_;
+};
+
+std::unique_ptr<InviwoApplication> IvfVolumeIO::app_;
+
+TEST_F(IvfVolumeIO, CompressedRoundTrip) {
+    const auto volume = createVolume();
+    IvfVolumeWriter writer;
+    writer.setCompression({true, 1, size3_t{16}});
+    writer.setOverwrite(true);
+    writer.writeData(volume.get(), ivf);
+
+    IvfVolumeReader reader;
+    const auto read = reader.readData(ivf);
+    ASSERT_TRUE(read);
+    EXPECT_EQ(read->getDimensions(), dims);
+    EXPECT_EQ(read->getDataFormat(), DataUInt16::get());
+    expectRegion(*read, size3_t{0});
+}
+
+TEST_F(IvfVolumeIO, ReadRegion) {
+    const auto volume = createVolume();
+    for (const bool compressed : {true, false}) {
+        SCOPED_TRACE(compressed ? "Compressed" : "Uncompressed");
+        util::writeIvfVolume(*volume, ivf, true, {compressed, 1, size3_t{16}});
+
+        {
+            SCOPED_TRACE("Region across chunk boundaries");
+            const size3_t offset{5, 17, 3};
+            const auto region = util::readIvfVolumeRegion(ivf, offset, size3_t{40, 20, 29});
+            ASSERT_TRUE(region);
+            EXPECT_EQ(region->getDimensions(), size3_t(40, 20, 29));
+            expectRegion(*region, offset);
+        }
+        {
+            SCOPED_TRACE("Region in the partial chunks at the border");
+            const size3_t offset{60, 40, 30};
+            const auto region = util::readIvfVolumeRegion(ivf, offset, dims - offset);
+            ASSERT_TRUE(region);
+            EXPECT_EQ(region->getDimensions(), dims - offset);
+            expectRegion(*region, offset);
+        }
+        {
+            SCOPED_TRACE("Region outside of the volume");
+            EXPECT_THROW(util::readIvfVolumeRegion(ivf, size3_t{60, 40, 30}, size3_t{16}),
+                         DataReaderException);
+        }
+    }
+}
+
+TEST_F(IvfVolumeIO, InvalidChunkDimensions) {
+    {
+        SCOPED_TRACE("Compressed header without chunk dimensions");
+        std::ofstream(ivf) << R"(<?xml version="1.0" ?>
+<InviwoTreeData version="1.0">
+    <RawFile content="inviwo-chunkedvolumeio-test.raw" />
+    <Format content="UINT8" />
+    <Dimension x="13" y="7" z="3" />
+    <Compression content="zlib" />
+</InviwoTreeData>
+)";
+        IvfVolumeReader reader;
+        EXPECT_THROW(reader.readData(ivf), DataReaderException);
+        std::filesystem::remove(ivf);
+    }
+
+    {
+        SCOPED_TRACE("Writing with a zero chunk dimension");
+        const util::VolumeChunks chunks{size3_t{13, 7, 3}, size3_t{16, 0, 16}, 1};
+        std::vector<std::uint8_t> data(glm::compMul(chunks.dimensions));
+        EXPECT_THROW(util::writeVolumeChunks(raw, data.data(), chunks), DataWriterException);
+
+        Volume volume(size3_t{13, 7, 3}, DataUInt8::get());
+        EXPECT_THROW(util::writeIvfVolume(volume, ivf, true, {true, 1, size3_t{0}}),
+                     DataWriterException);
+        EXPECT_FALSE(std::filesystem::exists(ivf));
+    }
+}
+
+}  // namespace inviwo
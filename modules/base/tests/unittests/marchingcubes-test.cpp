@@ -34,6 +34,8 @@
 
 #include <cmath>
 #include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumesparseprecision.h>
 #include <modules/base/algorithm/volume/volumegeneration.h>
 
 #include <modules/base/algorithm/volume/marchingcubes.h>
@@ -335,4 +337,69 @@ TEST(Marchingcubes, sphere) {
     */
 }
 
+TEST(Marchingcubes, sparse) {
+    // a few blobs, one of them in the partial leaves at the border
+    const size3_t dims{29, 21, 19};
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(dims);
+    auto data = ram->getDataTyped();
+    std::fill(data, data + glm::compMul(dims), 0.0f);
+    for (const auto& [center, radius] : {std::pair{vec3{6.0f, 5.0f, 4.0f}, 4.0f},
+                                         std::pair{vec3{17.0f, 12.0f, 9.0f}, 3.5f},
+                                         std::pair{vec3{27.0f, 19.0f, 17.0f}, 4.0f}}) {
+        for (size_t z = 0; z < dims.z; ++z) {
+            for (size_t y = 0; y < dims.y; ++y) {
+                for (size_t x = 0; x < dims.x; ++x) {
+                    const auto d = glm::distance(vec3{x, y, z}, center);
+                    if (d < radius) {
+                        data[VolumeRAM::posToIndex(size3_t{x, y, z}, dims)] = 1.0f - d / radius;
+                    }
+                }
+            }
+        }
+    }
+    auto dense = std::make_shared<Volume>(ram);
+    auto sparse = std::make_shared<Volume>(createVolumeSparse(*ram));
+    sparse->setModelMatrix(dense->getModelMatrix());
+    sparse->setWorldMatrix(dense->getWorldMatrix());
+
+    auto mesh1 = util::marchingcubes(dense, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false);
+    auto mesh2 = util::marchingcubes(sparse, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false);
+    // the sparse volume is not made dense to extract the surface
+    EXPECT_FALSE(sparse->hasRepresentation<VolumeRAM>());
+
+    auto& pos1 = getBufferData<vec3>(*mesh1, 0);
+    auto& pos2 = getBufferData<vec3>(*mesh2, 0);
+    auto& ind1 = getBufferIndexData(*mesh1, 0);
+    auto& ind2 = getBufferIndexData(*mesh2, 0);
+    ASSERT_FALSE(pos1.empty());
+    ASSERT_EQ(pos1.size(), pos2.size());
+    ASSERT_EQ(ind1.size(), ind2.size());
+
+    auto order = [](auto& a, auto& b) {
+        return std::lexicographical_compare(glm::value_ptr(a), glm::value_ptr(a) + 3,
+                                            glm::value_ptr(b), glm::value_ptr(b) + 3);
+    };
+    // the cells are visited in a different order, compare the sorted vertices and triangles
+    std::vector<vec3> spos1(pos1);
+    std::vector<vec3> spos2(pos2);
+    std::sort(spos1.begin(), spos1.end(), order);
+    std::sort(spos2.begin(), spos2.end(), order);
+    EXPECT_EQ(spos1, spos2);
+
+    auto triangles = [&](const std::vector<vec3>& pos, const std::vector<uint32_t>& ind) {
+        std::vector<std::array<vec3, 3>> tris;
+        for (size_t i = 0; i + 2 < ind.size(); i += 3) {
+            std::array<vec3, 3> tri{pos[ind[i]], pos[ind[i + 1]], pos[ind[i + 2]]};
+            // keep the winding, start at the smallest vertex
+            std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end(), order), tri.end());
+            tris.push_back(tri);
+        }
+        std::sort(tris.begin(), tris.end(), [&](auto& a, auto& b) {
+            return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), order);
+        });
+        return tris;
+    };
+    EXPECT_EQ(triangles(pos1, ind1), triangles(pos2, ind2));
+}
+
 }  // namespace inviwo
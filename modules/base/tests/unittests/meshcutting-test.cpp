@@ -119,7 +119,7 @@ TEST(MeshCutting, SutherlandHodgman) {
 
 TEST(MeshCutting, GatherLoops) {
     const std::vector<vec3> positions{vec3{-1, -1, 0}, vec3{1, -1, 0}, vec3{0, 1, 0}};
-    std::vector<glm::u32vec2> edges{{0, 1}, {1, 2}, {2, 0}};
+    std::pmr::vector<glm::u32vec2> edges{{0, 1}, {1, 2}, {2, 0}};
 
     const auto loops = meshutil::detail::gatherLoops(edges, positions, 0.0000001f);
 
@@ -0,0 +1,133 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+#include <modules/base/algorithm/mesh/meshrasterizer.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/camera/orthographiccamera.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/datastructures/image/image.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<const Mesh> makeMesh(std::vector<vec3> positions, const vec4& color) {
+    auto mesh = std::make_shared<Mesh>(DrawType::Triangles, ConnectivityType::None);
+    std::vector<vec4> colors(positions.size(), color);
+    mesh->addBuffer(BufferType::PositionAttrib, util::makeBuffer(std::move(positions)));
+    mesh->addBuffer(BufferType::ColorAttrib, util::makeBuffer(std::move(colors)));
+    return mesh;
+}
+
+template <typename T>
+const T* layerData(const Image& image, LayerType type) {
+    const auto layer = image.getLayer(type);
+    return static_cast<const LayerRAMPrecision<T>*>(layer->getRepresentation<LayerRAM>())
+        ->getDataTyped();
+}
+
+// Orthographic camera looking down the negative z axis, one world unit is one pixel and the world
+// origin is at the center of the 16x16 image. The plane z = 0 ends up at depth 0.5 and the plane
+// z = -1 at depth 0.625.
+const size2_t dims{16, 16};
+OrthographicCamera makeCamera() {
+    return OrthographicCamera{vec3(0.0f, 0.0f, 5.0f), vec3(0.0f), vec3(0.0f, 1.0f, 0.0f), 1.0f,
+                              9.0f, 16.0f, 1.0f};
+}
+
+// Triangle with the corners (2,2), (12.5,2), and (2,12.5) in pixel coordinates, covering the
+// pixel centers with x, y >= 2 and x + y <= 13. No pixel center is on an edge.
+std::shared_ptr<const Mesh> makeTriangle() {
+    return makeMesh({vec3(-6.0f, -6.0f, 0.0f), vec3(4.5f, -6.0f, 0.0f), vec3(-6.0f, 4.5f, 0.0f)},
+                    vec4(1, 0, 0, 1));
+}
+bool inTriangle(size_t x, size_t y) { return x >= 2 && y >= 2 && x + y <= 13; }
+
+}  // namespace
+
+TEST(MeshRasterizer, TriangleCoverage) {
+    const auto image = util::rasterizeMeshes({makeTriangle()}, makeCamera(), dims, {});
+    const auto color = layerData<glm::u8vec4>(*image, LayerType::Color);
+    const auto depth = layerData<float>(*image, LayerType::Depth);
+
+    size_t covered = 0;
+    for (size_t y = 0; y < dims.y; ++y) {
+        for (size_t x = 0; x < dims.x; ++x) {
+            const size_t i = x + y * dims.x;
+            if (inTriangle(x, y)) {
+                ++covered;
+                EXPECT_EQ(color[i], glm::u8vec4(255, 0, 0, 255)) << "pixel " << x << ", " << y;
+                EXPECT_NEAR(depth[i], 0.5f, 1.0e-6f) << "pixel " << x << ", " << y;
+            } else {
+                EXPECT_EQ(color[i], glm::u8vec4(0)) << "pixel " << x << ", " << y;
+                EXPECT_EQ(depth[i], 1.0f) << "pixel " << x << ", " << y;
+            }
+        }
+    }
+    EXPECT_EQ(covered, 55);
+}
+
+TEST(MeshRasterizer, DepthTest) {
+    const auto triangle = makeTriangle();
+    // quad covering the whole image behind the triangle
+    const auto quad = makeMesh({vec3(-10.0f, -10.0f, -1.0f), vec3(10.0f, -10.0f, -1.0f),
+                                vec3(10.0f, 10.0f, -1.0f), vec3(-10.0f, -10.0f, -1.0f),
+                                vec3(10.0f, 10.0f, -1.0f), vec3(-10.0f, 10.0f, -1.0f)},
+                               vec4(0, 0, 1, 1));
+
+    // the result does not depend on the drawing order
+    for (const auto& meshes : {std::vector<std::shared_ptr<const Mesh>>{triangle, quad},
+                               std::vector<std::shared_ptr<const Mesh>>{quad, triangle}}) {
+        const auto image = util::rasterizeMeshes(meshes, makeCamera(), dims, {});
+        const auto color = layerData<glm::u8vec4>(*image, LayerType::Color);
+        const auto depth = layerData<float>(*image, LayerType::Depth);
+
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                const size_t i = x + y * dims.x;
+                if (inTriangle(x, y)) {
+                    EXPECT_EQ(color[i], glm::u8vec4(255, 0, 0, 255)) << "pixel " << x << ", " << y;
+                    EXPECT_NEAR(depth[i], 0.5f, 1.0e-6f) << "pixel " << x << ", " << y;
+                } else {
+                    EXPECT_EQ(color[i], glm::u8vec4(0, 0, 255, 255)) << "pixel " << x << ", " << y;
+                    EXPECT_NEAR(depth[i], 0.625f, 1.0e-6f) << "pixel " << x << ", " << y;
+                }
+            }
+        }
+    }
+}
+
+}  // namespace inviwo
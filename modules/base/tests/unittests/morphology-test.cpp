@@ -0,0 +1,135 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+#include <modules/base/algorithm/morphology.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace {
+
+template <typename T>
+size_t countNonZero(const T* data, size_t size) {
+    return static_cast<size_t>(std::count_if(data, data + size, [](T v) { return v != T{0}; }));
+}
+
+}  // namespace
+
+TEST(Morphology, VolumeBoxDilate) {
+    const size3_t dims{7, 7, 7};
+    VolumeRAMPrecision<float> volume(dims);
+    const util::IndexMapper3D im(dims);
+    volume.getDataTyped()[im(3, 3, 3)] = 2.0f;
+    volume.getDataTyped()[im(0, 0, 0)] = 1.0f;
+
+    const auto result = util::volumeMorphology(&volume, util::MorphologyOperation::Dilate,
+                                               util::MorphologyShape::Box, size3_t{1, 2, 0});
+    const auto data = static_cast<const VolumeRAMPrecision<float>*>(result.get())->getDataTyped();
+
+    EXPECT_EQ(15u + 6u, countNonZero(data, glm::compMul(dims)));
+    EXPECT_EQ(2.0f, data[im(4, 5, 3)]);
+    EXPECT_EQ(0.0f, data[im(4, 5, 2)]);
+    EXPECT_EQ(1.0f, data[im(1, 2, 0)]);
+}
+
+TEST(Morphology, VolumeErodeRestoresDilate) {
+    const size3_t dims{9, 8, 7};
+    VolumeRAMPrecision<unsigned char> volume(dims);
+    const util::IndexMapper3D im(dims);
+    std::fill(volume.getDataTyped(), volume.getDataTyped() + glm::compMul(dims), 10);
+    volume.getDataTyped()[im(4, 4, 3)] = 20;
+
+    const auto open = util::volumeMorphology(&volume, util::MorphologyOperation::Open,
+                                             util::MorphologyShape::Sphere, size3_t{2});
+    const auto close = util::volumeMorphology(&volume, util::MorphologyOperation::Close,
+                                              util::MorphologyShape::Sphere, size3_t{2});
+    const auto opened =
+        static_cast<const VolumeRAMPrecision<unsigned char>*>(open.get())->getDataTyped();
+    const auto closed =
+        static_cast<const VolumeRAMPrecision<unsigned char>*>(close.get())->getDataTyped();
+
+    // opening removes the peak, closing keeps it
+    EXPECT_EQ(10, opened[im(4, 4, 3)]);
+    EXPECT_EQ(20, closed[im(4, 4, 3)]);
+    EXPECT_EQ(10, closed[im(4, 4, 4)]);
+}
+
+TEST(Morphology, VolumeBinarySphere) {
+    const size3_t dims{7, 7, 7};
+    VolumeRAMPrecision<float> volume(dims);
+    const util::IndexMapper3D im(dims);
+    volume.getDataTyped()[im(3, 3, 3)] = 1.0f;
+
+    const auto dilated =
+        util::volumeBinaryMorphology(&volume, dvec2{0.5, 1.0}, util::MorphologyOperation::Dilate,
+                                     util::MorphologyShape::Sphere, size3_t{2});
+    ASSERT_EQ(DataUInt8::id(), dilated->getDataFormatId());
+    const auto mask =
+        static_cast<const VolumeRAMPrecision<std::uint8_t>*>(dilated.get())->getDataTyped();
+    // number of integer points within a distance of 2
+    EXPECT_EQ(33u, countNonZero(mask, glm::compMul(dims)));
+    EXPECT_EQ(255, mask[im(3, 3, 5)]);
+    EXPECT_EQ(0, mask[im(3, 4, 5)]);
+
+    const auto eroded =
+        util::volumeBinaryMorphology(dilated.get(), dvec2{1.0, 255.0},
+                                     util::MorphologyOperation::Erode,
+                                     util::MorphologyShape::Sphere, size3_t{2});
+    const auto center =
+        static_cast<const VolumeRAMPrecision<std::uint8_t>*>(eroded.get())->getDataTyped();
+    EXPECT_EQ(1u, countNonZero(center, glm::compMul(dims)));
+    EXPECT_EQ(255, center[im(3, 3, 3)]);
+}
+
+TEST(Morphology, LayerErode) {
+    const size2_t dims{6, 5};
+    LayerRAMPrecision<float> layer(dims);
+    const util::IndexMapper2D im(dims);
+    for (size_t y = 1; y < 4; ++y) {
+        for (size_t x = 1; x < 5; ++x) {
+            layer.getDataTyped()[im(x, y)] = 1.0f;
+        }
+    }
+    const auto result = util::layerMorphology(&layer, util::MorphologyOperation::Erode,
+                                              util::MorphologyShape::Box, size2_t{1, 1});
+    const auto data = static_cast<const LayerRAMPrecision<float>*>(result.get())->getDataTyped();
+    EXPECT_EQ(2u, countNonZero(data, glm::compMul(dims)));
+    EXPECT_EQ(1.0f, data[im(2, 2)]);
+    EXPECT_EQ(1.0f, data[im(3, 2)]);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,116 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+#include <modules/base/algorithm/volume/volumeconnectedcomponents.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/indexmapper.h>
+
+namespace inviwo {
+
+namespace {
+
+// Two 2x2x2 cubes touching at the corner (2,2,2), and a single voxel at (5,0,0)
+std::shared_ptr<VolumeRAMPrecision<unsigned char>> createVolume() {
+    const size3_t dims{6, 5, 5};
+    auto ram = std::make_shared<VolumeRAMPrecision<unsigned char>>(dims);
+    auto data = ram->getDataTyped();
+    const util::IndexMapper3D im(dims);
+    for (size_t z = 0; z < 2; ++z) {
+        for (size_t y = 0; y < 2; ++y) {
+            for (size_t x = 0; x < 2; ++x) {
+                data[im(x + 1, y + 1, z + 1)] = 10;
+                data[im(x + 3, y + 3, z + 3)] = 20;
+            }
+        }
+    }
+    data[im(5, 0, 0)] = 30;
+    return ram;
+}
+
+}  // namespace
+
+TEST(VolumeConnectedComponents, FaceConnectivity) {
+    const auto ram = createVolume();
+    const auto result =
+        util::volumeConnectedComponents(*ram, dvec2{1.0, 255.0}, util::VoxelConnectivity::Face);
+
+    ASSERT_EQ(3u, result.components.size());
+
+    // components are numbered in raster order of their first voxel
+    EXPECT_EQ(size3_t(5, 0, 0), result.components[0].lower);
+    EXPECT_EQ(1u, result.components[0].voxelCount);
+    EXPECT_DOUBLE_EQ(30.0, result.components[0].meanIntensity);
+
+    EXPECT_EQ(8u, result.components[1].voxelCount);
+    EXPECT_EQ(size3_t(1, 1, 1), result.components[1].lower);
+    EXPECT_EQ(size3_t(2, 2, 2), result.components[1].upper);
+    EXPECT_DOUBLE_EQ(1.5, result.components[1].centroid.x);
+    EXPECT_DOUBLE_EQ(10.0, result.components[1].meanIntensity);
+
+    EXPECT_EQ(8u, result.components[2].voxelCount);
+    EXPECT_DOUBLE_EQ(3.5, result.components[2].centroid.z);
+
+    const auto labels = static_cast<const VolumeRAMPrecision<std::uint32_t>*>(
+                            result.labels->getRepresentation<VolumeRAM>())
+                            ->getDataTyped();
+    const util::IndexMapper3D im(ram->getDimensions());
+    EXPECT_EQ(0u, labels[im(0, 0, 0)]);
+    EXPECT_EQ(1u, labels[im(5, 0, 0)]);
+    EXPECT_EQ(2u, labels[im(2, 2, 2)]);
+    EXPECT_EQ(3u, labels[im(3, 3, 3)]);
+}
+
+TEST(VolumeConnectedComponents, VertexConnectivity) {
+    const auto ram = createVolume();
+    const auto edge =
+        util::volumeConnectedComponents(*ram, dvec2{1.0, 255.0}, util::VoxelConnectivity::Edge);
+    EXPECT_EQ(3u, edge.components.size());
+
+    const auto vertex =
+        util::volumeConnectedComponents(*ram, dvec2{1.0, 255.0}, util::VoxelConnectivity::Vertex);
+    ASSERT_EQ(2u, vertex.components.size());
+    EXPECT_EQ(16u, vertex.components[1].voxelCount);
+    EXPECT_EQ(size3_t(4, 4, 4), vertex.components[1].upper);
+    EXPECT_DOUBLE_EQ(15.0, vertex.components[1].meanIntensity);
+}
+
+TEST(VolumeConnectedComponents, ForegroundRange) {
+    const auto ram = createVolume();
+    const auto result =
+        util::volumeConnectedComponents(*ram, dvec2{15.0, 25.0}, util::VoxelConnectivity::Vertex);
+    ASSERT_EQ(1u, result.components.size());
+    EXPECT_EQ(size3_t(3, 3, 3), result.components[0].lower);
+}
+
+}  // namespace inviwo
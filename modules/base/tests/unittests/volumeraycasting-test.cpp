@@ -0,0 +1,127 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+#include <modules/base/algorithm/volume/volumeraycasting.h>
+#include <inviwo/core/datastructures/camera/perspectivecamera.h>
+#include <inviwo/core/datastructures/image/image.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/datastructures/transferfunction.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace {
+
+// Volume in [0,1]^3 world space with two blobs in a background of zeros, one of them at the border
+std::shared_ptr<Volume> makeVolume(const size3_t& dims) {
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(dims);
+    auto data = ram->getDataTyped();
+    std::fill(data, data + glm::compMul(dims), 0.0f);
+    const util::IndexMapper3D im(dims);
+    for (const auto& [center, radius] : {std::pair{vec3{12.0f, 14.0f, 10.0f}, 7.0f},
+                                         std::pair{vec3{37.0f, 30.0f, 33.0f}, 6.0f}}) {
+        for (size_t z = 0; z < dims.z; ++z) {
+            for (size_t y = 0; y < dims.y; ++y) {
+                for (size_t x = 0; x < dims.x; ++x) {
+                    const auto d = glm::distance(vec3{x, y, z}, center);
+                    if (d < radius) data[im(x, y, z)] = 1.0f - d / radius;
+                }
+            }
+        }
+    }
+    auto volume = std::make_shared<Volume>(ram);
+    volume->setModelMatrix(mat4(1.0f));
+    volume->setWorldMatrix(mat4(1.0f));
+    volume->dataMap_.dataRange = dvec2(0.0, 1.0);
+    volume->dataMap_.valueRange = dvec2(0.0, 1.0);
+    return volume;
+}
+
+template <typename T>
+const T* layerData(const Image& image, LayerType type) {
+    const auto layer = image.getLayer(type);
+    return static_cast<const LayerRAMPrecision<T>*>(layer->getRepresentation<LayerRAM>())
+        ->getDataTyped();
+}
+
+}  // namespace
+
+TEST(VolumeRaycasting, EmptySpaceSkipping) {
+    const auto volume = makeVolume(size3_t{40, 36, 38});
+    const TransferFunction tf(
+        {{0.0, vec4(0.0f)}, {0.3, vec4(0.0f)}, {0.6, vec4(1.0f, 0.5f, 0.2f, 0.1f)},
+         {1.0, vec4(0.2f, 0.6f, 1.0f, 0.6f)}});
+    const util::VolumeMinMaxBricks bricks(*volume, 0, 8);
+
+    const size2_t dims{64, 48};
+    const float aspect = static_cast<float>(dims.x) / static_cast<float>(dims.y);
+    const std::vector<PerspectiveCamera> cameras{
+        PerspectiveCamera(vec3(0.5f, 0.5f, 3.0f), vec3(0.5f), vec3(0.0f, 1.0f, 0.0f), 0.1f,
+                          10.0f, 38.0f, aspect),
+        PerspectiveCamera(vec3(-1.2f, 2.1f, -0.9f), vec3(0.5f), vec3(0.0f, 1.0f, 0.0f), 0.1f,
+                          10.0f, 38.0f, aspect)};
+
+    for (auto shading : {ShadingMode::None, ShadingMode::Phong}) {
+        util::VolumeRaycastingSettings settings;
+        settings.tileSize = size2_t{16, 16};
+        settings.lighting.shadingMode = shading;
+        settings.lighting.lightPosition = vec3(2.0f, 2.0f, 4.0f);
+
+        for (const auto& camera : cameras) {
+            const auto reference = util::raycastVolume(*volume, tf, camera, dims, settings);
+            const auto skipped = util::raycastVolume(*volume, tf, camera, dims, settings, &bricks);
+
+            const auto refColor = layerData<glm::u8vec4>(*reference, LayerType::Color);
+            const auto color = layerData<glm::u8vec4>(*skipped, LayerType::Color);
+            const auto refDepth = layerData<float>(*reference, LayerType::Depth);
+            const auto depth = layerData<float>(*skipped, LayerType::Depth);
+
+            const size_t size = glm::compMul(dims);
+            ASSERT_TRUE(std::any_of(refColor, refColor + size,
+                                    [](const glm::u8vec4& c) { return c.a > 0; }));
+            // skipping keeps the sample positions along the rays, the result is identical
+            for (size_t i = 0; i < size; ++i) {
+                ASSERT_EQ(color[i], refColor[i]) << "pixel " << i;
+                ASSERT_EQ(depth[i], refDepth[i]) << "pixel " << i;
+            }
+        }
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,172 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+#include <modules/base/algorithm/volume/volumereslice.h>
+#include <inviwo/core/datastructures/geometry/plane.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/indexmapper.h>
+
+namespace inviwo {
+
+namespace {
+
+// Volume in [0,1]^3 world space where voxel (x,y,z) has the value x + 10y + 100z
+std::shared_ptr<Volume> makeVolume(const size3_t& dims) {
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(dims);
+    const util::IndexMapper3D im(dims);
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                ram->getDataTyped()[im(x, y, z)] = static_cast<float>(x + 10 * y + 100 * z);
+            }
+        }
+    }
+    auto volume = std::make_shared<Volume>(ram);
+    volume->setModelMatrix(mat4(1.0f));
+    volume->setWorldMatrix(mat4(1.0f));
+    volume->dataMap_.dataRange = dvec2(0.0, 1000.0);
+    return volume;
+}
+
+const float* layerData(const Layer& layer) {
+    return static_cast<const LayerRAMPrecision<float>*>(layer.getRepresentation<LayerRAM>())
+        ->getDataTyped();
+}
+
+}  // namespace
+
+TEST(VolumeReslice, FitRect) {
+    const auto volume = makeVolume(size3_t{6, 5, 4});
+    const auto rect =
+        util::fitResliceRect(*volume, Plane(vec3(0.5f), vec3(1.0f, 0.0f, 0.0f)), vec3(0, 0, 1));
+    EXPECT_NEAR(rect.origin.x, 0.5f, 1.0e-5f);
+    EXPECT_NEAR(rect.origin.y, 0.0f, 1.0e-5f);
+    EXPECT_NEAR(rect.origin.z, 0.0f, 1.0e-5f);
+    EXPECT_NEAR(glm::distance(rect.uAxis, vec3(0.0f, 1.0f, 0.0f)), 0.0f, 1.0e-5f);
+    EXPECT_NEAR(glm::distance(rect.vAxis, vec3(0.0f, 0.0f, 1.0f)), 0.0f, 1.0e-5f);
+    EXPECT_NEAR(glm::distance(rect.normal(), vec3(1.0f, 0.0f, 0.0f)), 0.0f, 1.0e-5f);
+}
+
+TEST(VolumeReslice, AxisAlignedPlanes) {
+    const size3_t dims{6, 5, 4};
+    const auto volume = makeVolume(dims);
+    util::VolumeResliceSettings settings;
+    settings.interpolation = InterpolationType::Nearest;
+
+    // axial plane through voxel layer z = 2
+    const auto axial = util::fitResliceRect(
+        *volume, Plane(vec3(0.5f, 0.5f, 2.5f / 4.0f), vec3(0.0f, 0.0f, 1.0f)), vec3(0, 1, 0));
+    const auto axialLayer = util::resliceVolume(*volume, axial, size2_t{6, 5}, settings);
+    EXPECT_EQ(axialLayer->getDimensions(), size2_t(6, 5));
+    EXPECT_FLOAT_EQ(axialLayer->getBasis()[0][0], 1.0f);
+    const auto axialData = layerData(*axialLayer);
+    for (size_t j = 0; j < 5; ++j) {
+        for (size_t i = 0; i < 6; ++i) {
+            EXPECT_EQ(axialData[i + 6 * j], static_cast<float>(i + 10 * j + 200));
+        }
+    }
+
+    // sagittal plane through voxel layer x = 1, the image x axis is along y and y along z
+    const auto sagittal = util::fitResliceRect(
+        *volume, Plane(vec3(1.5f / 6.0f, 0.5f, 0.5f), vec3(1.0f, 0.0f, 0.0f)), vec3(0, 0, 1));
+    const auto sagittalData =
+        layerData(*util::resliceVolume(*volume, sagittal, size2_t{5, 4}, settings));
+    for (size_t j = 0; j < 4; ++j) {
+        for (size_t i = 0; i < 5; ++i) {
+            EXPECT_EQ(sagittalData[i + 5 * j], static_cast<float>(1 + 10 * i + 100 * j));
+        }
+    }
+}
+
+TEST(VolumeReslice, Interpolation) {
+    const auto volume = makeVolume(size3_t{6, 5, 4});
+    // a plane halfway between voxel layers z = 1 and z = 2
+    const auto rect = util::fitResliceRect(
+        *volume, Plane(vec3(0.5f), vec3(0.0f, 0.0f, 1.0f)), vec3(0, 1, 0));
+    util::VolumeResliceSettings settings;
+    settings.normalize = true;
+    const auto data = layerData(*util::resliceVolume(*volume, rect, size2_t{6, 5}, settings));
+    EXPECT_NEAR(data[3 + 6 * 2], (3.0f + 20.0f + 150.0f) / 1000.0f, 1.0e-5f);
+}
+
+TEST(VolumeReslice, NormalizeEmptyDataRange) {
+    const auto volume = makeVolume(size3_t{6, 5, 4});
+    volume->dataMap_.dataRange = dvec2(100.0, 100.0);
+    const auto rect = util::fitResliceRect(
+        *volume, Plane(vec3(0.5f, 0.5f, 2.5f / 4.0f), vec3(0.0f, 0.0f, 1.0f)), vec3(0, 1, 0));
+    util::VolumeResliceSettings settings;
+    settings.interpolation = InterpolationType::Nearest;
+    settings.normalize = true;
+    const auto data = layerData(*util::resliceVolume(*volume, rect, size2_t{6, 5}, settings));
+    EXPECT_FLOAT_EQ(data[3 + 6 * 2], 3.0f + 20.0f + 200.0f - 100.0f);
+}
+
+TEST(VolumeReslice, SlabProjection) {
+    const auto volume = makeVolume(size3_t{6, 5, 4});
+    const auto rect = util::fitResliceRect(
+        *volume, Plane(vec3(0.5f), vec3(0.0f, 0.0f, 1.0f)), vec3(0, 1, 0));
+    util::VolumeResliceSettings settings;
+    settings.interpolation = InterpolationType::Nearest;
+    settings.thickness = 1.0f;
+
+    settings.projection = util::SlabProjection::Maximum;
+    const auto max = layerData(*util::resliceVolume(*volume, rect, size2_t{6, 5}, settings));
+    settings.projection = util::SlabProjection::Minimum;
+    const auto min = layerData(*util::resliceVolume(*volume, rect, size2_t{6, 5}, settings));
+    settings.projection = util::SlabProjection::Average;
+    const auto avg = layerData(*util::resliceVolume(*volume, rect, size2_t{6, 5}, settings));
+
+    EXPECT_EQ(max[4 + 6 * 3], 334.0f);
+    EXPECT_EQ(min[4 + 6 * 3], 34.0f);
+    EXPECT_FLOAT_EQ(avg[4 + 6 * 3], 184.0f);
+}
+
+TEST(VolumeReslice, FillOutside) {
+    const auto volume = makeVolume(size3_t{6, 5, 4});
+    util::ResliceRect rect;
+    rect.origin = vec3(-1.0f, 0.0f, 0.5f);
+    rect.uAxis = vec3(2.0f, 0.0f, 0.0f);
+    rect.vAxis = vec3(0.0f, 1.0f, 0.0f);
+    util::VolumeResliceSettings settings;
+    settings.fillValue = -1.0;
+    const auto data = layerData(*util::resliceVolume(*volume, rect, size2_t{4, 1}, settings));
+    EXPECT_EQ(data[0], -1.0f);
+    EXPECT_EQ(data[1], -1.0f);
+    EXPECT_NE(data[2], -1.0f);
+    EXPECT_NE(data[3], -1.0f);
+}
+
+}  // namespace inviwo
@@ -45,7 +45,7 @@ uniform bool pickingEnabled = false;
 void main() {
     color_ = in_Color;
     texCoord_ = in_TexCoord;
-    pickColor_ = vec4(pickingIndexToColor(in_PickId), pickingEnabled ? 1.0 : 0.0);
+    pickColor_ = pickingEnabled ? pickingIndexToRGBA(in_PickId) : vec4(0.0);
 
     gl_Position = projectionMatrix * in_Vertex;
 }
\ No newline at end of file
@@ -121,6 +121,7 @@ void CubeRenderer::process() {
 
         shader.activate();
         utilgl::BlendModeState blendModeStateGL(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        utilgl::PickingBlendState pickingBlendState;
 
         TextureUnitContainer units;
         utilgl::bindAndSetUniforms(shader, units, metaColor_);
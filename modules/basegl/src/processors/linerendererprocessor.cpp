@@ -67,6 +67,7 @@ void LineRendererProcessor::process() {
     utilgl::activateTargetAndClearOrCopySource(outport_, imageInport_);
 
     utilgl::BlendModeState blending(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    utilgl::PickingBlendState pickingBlending;
     utilgl::DepthMaskState depthMask(writeDepth_.get());
 
     utilgl::DepthFuncState depthFunc(GL_LEQUAL);
@@ -150,6 +150,7 @@ void MeshRenderProcessorGL::process() {
     utilgl::GlBoolState depthTest(GL_DEPTH_TEST, enableDepthTest_);
     utilgl::CullFaceState culling(cullFace_);
     utilgl::BlendModeState blendModeStateGL(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    utilgl::PickingBlendState pickingBlendState;
 
     utilgl::setUniforms(shader_, camera_, lightingProperty_, overrideColor_);
     for (auto mesh : inport_) {
@@ -136,6 +136,7 @@ void SphereRenderer::configureShader(Shader& shader) {
 void SphereRenderer::process() {
     utilgl::activateTargetAndClearOrCopySource(outport_, imageInport_);
     utilgl::BlendModeState blendModeStateGL(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    utilgl::PickingBlendState pickingBlendState;
 
     for (const auto& [port, mesh] : inport_.getSourceVectorData()) {
         if (mesh->getNumberOfBuffers() == 0) continue;
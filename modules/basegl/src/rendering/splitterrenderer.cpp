@@ -134,6 +134,7 @@ void SplitterRenderer::render(const SplitterSettings& settings, splitter::Direct
 
     utilgl::DepthFuncState depthFunc(GL_ALWAYS);
     utilgl::BlendModeState blending(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    utilgl::PickingBlendState pickingBlending;
     MeshDrawerGL::DrawObject drawer(mesh_.getRepresentation<MeshGL>(), mesh_.getDefaultMeshInfo());
 
     shader_.activate();
@@ -0,0 +1,82 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/minmaxproperty.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/ports/volumeport.h>
+#include <inviwo/core/ports/dataoutport.h>
+#include <inviwo/core/ports/datainport.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <modules/base/algorithm/volume/volumeconnectedcomponents.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.VolumeConnectedComponents, Volume Connected Components}
+ * ![](org.inviwo.VolumeConnectedComponents.png?classIdentifier=org.inviwo.VolumeConnectedComponents)
+ * Labels the connected components of the foreground voxels of a volume. The volume is labeled
+ * in parallel slabs which are merged using union-find, @see util::volumeConnectedComponents.
+ *
+ * ### Inports
+ *   * __volume__  source volume, the first channel is used
+ *
+ * ### Outports
+ *   * __labels__     label volume (uint32) where 0 is background and components are numbered
+ *                    from 1 in raster order of their first voxel
+ *   * __dataframe__  one row per component with its label, voxel count, bounding box and
+ *                    centroid in voxel index space, and mean intensity
+ *
+ * ### Properties
+ *   * __Foreground Range__ voxels with values inside this range (in data range) are foreground
+ *   * __Connectivity__ 6 (faces), 18 (faces and edges), or 26 (faces, edges, and vertices)
+ *                      connected neighborhood
+ */
+class IVW_MODULE_DATAFRAME_API VolumeConnectedComponents : public Processor {
+public:
+    VolumeConnectedComponents();
+    virtual ~VolumeConnectedComponents() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    DataInport<Volume> inport_;
+    VolumeOutport labels_;
+    DataOutport<DataFrame> dataframe_;
+
+    DoubleMinMaxProperty foreground_;
+    TemplateOptionProperty<util::VoxelConnectivity> connectivity_;
+};
+
+}  // namespace inviwo
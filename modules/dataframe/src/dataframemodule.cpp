@@ -36,6 +36,7 @@
 #include <inviwo/dataframe/processors/dataframeexporter.h>
 #include <inviwo/dataframe/processors/imagetodataframe.h>
 #include <inviwo/dataframe/processors/syntheticdataframe.h>
+#include <inviwo/dataframe/processors/volumeconnectedcomponents.h>
 #include <inviwo/dataframe/processors/volumetodataframe.h>
 #include <inviwo/dataframe/processors/volumesequencetodataframe.h>
 #include <inviwo/dataframe/properties/colormapproperty.h>
@@ -60,6 +61,7 @@ DataFrameModule::DataFrameModule(InviwoApplication* app) : InviwoModule(app, "Da
     registerProcessor<DataFrameFloat32Converter>();
     registerProcessor<ImageToDataFrame>();
     registerProcessor<SyntheticDataFrame>();
+    registerProcessor<VolumeConnectedComponents>();
     registerProcessor<VolumeToDataFrame>();
     registerProcessor<VolumeSequenceToDataFrame>();
 
@@ -0,0 +1,121 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/processors/volumeconnectedcomponents.h>
+
+#include <array>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo VolumeConnectedComponents::processorInfo_{
+    "org.inviwo.VolumeConnectedComponents",  // Class identifier
+    "Volume Connected Components",           // Display name
+    "Volume Operation",                      // Category
+    CodeState::Experimental,                 // Code state
+    "CPU, DataFrame, Volume",                // Tags
+};
+const ProcessorInfo VolumeConnectedComponents::getProcessorInfo() const { return processorInfo_; }
+
+VolumeConnectedComponents::VolumeConnectedComponents()
+    : Processor()
+    , inport_{"volume"}
+    , labels_{"labels"}
+    , dataframe_{"dataframe"}
+    , foreground_{"foreground", "Foreground Range", 0.5, 1.0, 0.0, 1.0}
+    , connectivity_{"connectivity",
+                    "Connectivity",
+                    {{"face", "6 (Faces)", util::VoxelConnectivity::Face},
+                     {"edge", "18 (Faces, Edges)", util::VoxelConnectivity::Edge},
+                     {"vertex", "26 (Faces, Edges, Vertices)", util::VoxelConnectivity::Vertex}},
+                    0} {
+
+    addPort(inport_);
+    addPort(labels_);
+    addPort(dataframe_);
+    addProperty(foreground_);
+    addProperty(connectivity_);
+
+    inport_.onChange([this]() {
+        if (inport_.hasData()) {
+            foreground_.setRangeNormalized(inport_.getData()->dataMap_.dataRange);
+        }
+    });
+}
+
+void VolumeConnectedComponents::process() {
+    const auto volume = inport_.getData();
+    const auto result =
+        util::volumeConnectedComponents(*volume, foreground_.get(), connectivity_.get());
+
+    const auto& components = result.components;
+    const auto size = components.size();
+
+    std::vector<std::uint32_t> label(size);
+    std::vector<std::uint32_t> count(size);
+    std::array<std::vector<std::uint32_t>, 3> lower;
+    std::array<std::vector<std::uint32_t>, 3> upper;
+    std::array<std::vector<double>, 3> centroid;
+    std::vector<double> intensity(size);
+    for (int i = 0; i < 3; ++i) {
+        lower[i].resize(size);
+        upper[i].resize(size);
+        centroid[i].resize(size);
+    }
+    for (size_t c = 0; c < size; ++c) {
+        const auto& comp = components[c];
+        label[c] = static_cast<std::uint32_t>(c + 1);
+        count[c] = static_cast<std::uint32_t>(comp.voxelCount);
+        for (int i = 0; i < 3; ++i) {
+            lower[i][c] = static_cast<std::uint32_t>(comp.lower[i]);
+            upper[i][c] = static_cast<std::uint32_t>(comp.upper[i]);
+            centroid[i][c] = comp.centroid[i];
+        }
+        intensity[c] = comp.meanIntensity;
+    }
+
+    auto dataFrame = std::make_shared<DataFrame>(static_cast<glm::u32>(size));
+    dataFrame->addColumn("Label", std::move(label));
+    dataFrame->addColumn("Voxel Count", std::move(count));
+    const std::array<std::string, 3> axes{"X", "Y", "Z"};
+    for (int i = 0; i < 3; ++i) {
+        dataFrame->addColumn("Min " + axes[i], std::move(lower[i]));
+        dataFrame->addColumn("Max " + axes[i], std::move(upper[i]));
+    }
+    for (int i = 0; i < 3; ++i) {
+        dataFrame->addColumn("Centroid " + axes[i], std::move(centroid[i]));
+    }
+    dataFrame->addColumn("Mean Intensity", std::move(intensity));
+    dataFrame->updateIndexBuffer();
+
+    labels_.setData(result.labels);
+    dataframe_.setData(dataFrame);
+}
+
+}  // namespace inviwo
@@ -57,5 +57,5 @@ void main() {
     normal_ = geometry.dataToWorldNormalMatrix * in_Normal * vec3(1.0);
     viewNormal_ = (camera.worldToView * vec4(normal_,0)).xyz;
     gl_Position = camera.worldToClip * worldPosition_;
-    pickColor_ = vec4(pickingIndexToColor(in_PickId), pickingEnabled ? 1.0 : 0.0);
+    pickColor_ = pickingEnabled ? pickingIndexToRGBA(in_PickId) : vec4(0.0);
 }
\ No newline at end of file
@@ -67,5 +67,16 @@ uint pickingColorToIndex(vec3 color) {
     return index;
 }
 
+// RGBA encoding for picking indices larger than 2^24, the alpha channel holds 255 minus the upper
+// bits of the index. An alpha of 0 means no picking.
+vec4 pickingIndexToRGBA(uint id) {
+    return vec4(pickingIndexToColor(id), float(255u - ((id >> 24) & 0xFFu)) / 255.0);
+}
+
+uint pickingRGBAToIndex(vec4 color) {
+    uint a = uint(color[3] * 255.0 + 0.5);
+    if (a == 0u) return 0u;
+    return pickingColorToIndex(color.rgb) | ((255u - a) << 24);
+}
 
 #endif // IVW_PICKING_UTILS_GLSL
\ No newline at end of file
@@ -132,6 +132,50 @@ protected:
     bool state_;
 };
 
+/**
+ * @brief RAII object for OpenGL bool states of a single indexed target, e.g. GL_BLEND for one
+ * draw buffer
+ * @see glIsEnabledi, glEnablei, glDisablei
+ */
+struct IVW_MODULE_OPENGL_API GlIndexedBoolState {
+    GlIndexedBoolState(GLenum target, GLuint index, bool state);
+
+    GlIndexedBoolState() = delete;
+    GlIndexedBoolState(GlIndexedBoolState const&) = delete;
+    GlIndexedBoolState& operator=(GlIndexedBoolState const& that) = delete;
+    GlIndexedBoolState(GlIndexedBoolState&& rhs);
+    GlIndexedBoolState& operator=(GlIndexedBoolState&& that);
+
+    operator bool();
+
+    ~GlIndexedBoolState();
+
+protected:
+    GLenum target_;
+    GLuint index_;
+    bool oldState_;
+    bool state_;
+};
+
+/**
+ * @brief RAII object that disables blending for the picking draw buffer. Picking indices are
+ * encoded in all four channels of the picking buffer, blending them with the previous content
+ * would corrupt the index. Use together with BlendModeState when rendering with picking.
+ * @see ImageGL::activateBuffer, PickingManager
+ */
+struct IVW_MODULE_OPENGL_API PickingBlendState : protected GlIndexedBoolState {
+    /**
+     * Draw buffer index of the picking layer when activating an ImageGL with picking
+     */
+    static constexpr GLuint pickingDrawBuffer = 1;
+
+    PickingBlendState();
+    PickingBlendState(PickingBlendState const&) = delete;
+    PickingBlendState& operator=(PickingBlendState const& that) = delete;
+    PickingBlendState(PickingBlendState&& rhs) = default;
+    PickingBlendState& operator=(PickingBlendState&& that) = default;
+};
+
 /**
  * @brief RAII object for OpenGL cull face state, which enables GL_CULL_FACE if
  * mode is different from GL_NONE
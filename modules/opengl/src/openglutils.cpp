@@ -283,6 +283,47 @@ GlBoolState::~GlBoolState() {
     }
 }
 
+GlIndexedBoolState& GlIndexedBoolState::operator=(GlIndexedBoolState&& that) {
+    if (this != &that) {
+        target_ = 0;
+        std::swap(target_, that.target_);
+        index_ = that.index_;
+        state_ = that.oldState_;
+        std::swap(state_, that.state_);
+        oldState_ = that.oldState_;
+    }
+    return *this;
+}
+
+GlIndexedBoolState::GlIndexedBoolState(GlIndexedBoolState&& rhs)
+    : target_(rhs.target_), index_(rhs.index_), oldState_(rhs.oldState_), state_(rhs.state_) {
+    rhs.state_ = rhs.oldState_;
+}
+
+GlIndexedBoolState::GlIndexedBoolState(GLenum target, GLuint index, bool state)
+    : target_(target), index_(index), oldState_{}, state_(state) {
+    oldState_ = (glIsEnabledi(target_, index_) == GL_TRUE);
+    if (oldState_ != state_) {
+        if (state)
+            glEnablei(target_, index_);
+        else
+            glDisablei(target_, index_);
+    }
+}
+
+GlIndexedBoolState::operator bool() { return state_; }
+
+GlIndexedBoolState::~GlIndexedBoolState() {
+    if (oldState_ != state_) {
+        if (oldState_)
+            glEnablei(target_, index_);
+        else
+            glDisablei(target_, index_);
+    }
+}
+
+PickingBlendState::PickingBlendState() : GlIndexedBoolState(GL_BLEND, pickingDrawBuffer, false) {}
+
 TexParameter::TexParameter(const TextureUnit& unit, GLenum target, GLenum name, GLint value)
     : unit_(unit.getEnum()), target_(target), name_(name), oldValue_{} {
     glActiveTexture(unit_);
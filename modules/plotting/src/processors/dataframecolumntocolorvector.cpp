@@ -70,6 +70,8 @@ void DataFrameColumnToColorVector::process() {
                 [&](auto buf) {
                     auto colors = std::make_shared<std::vector<vec4>>();
                     auto& vec = buf->getDataContainer();
+                    if (vec.empty()) return colors;
+
                     auto minMax = std::minmax_element(vec.begin(), vec.end());
                     double minV = static_cast<double>(*minMax.first);
                     double maxV = static_cast<double>(*minMax.second);
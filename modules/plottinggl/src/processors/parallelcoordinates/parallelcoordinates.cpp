@@ -567,6 +567,7 @@ void ParallelCoordinates::drawLines(size2_t size) {
                     utilgl::BlendModeEquationState(GL_NONE, GL_NONE, GL_FUNC_ADD));
         };
     }();
+    utilgl::PickingBlendState pickingBlending;
 
     // Draw lines
 
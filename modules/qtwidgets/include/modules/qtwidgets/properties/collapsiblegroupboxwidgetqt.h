@@ -34,6 +34,8 @@
 #include <inviwo/core/properties/propertyownerobserver.h>
 #include <inviwo/core/processors/processor.h>
 
+#include <unordered_set>
+
 class QLineEdit;
 class QToolButton;
 class QGroupBox;
@@ -120,8 +122,28 @@ protected:
 
     std::unique_ptr<QWidget> createPropertyLayoutWidget();
     void addButtonLayout(QGridLayout* layout, int row, Property* prop);
+    /**
+     * Insert \p prop at \p index. The widget of the property is not created right away but in a
+     * later iteration of the event loop, or once the group is expanded if it is collapsed. Adding
+     * many properties in a row thus only costs one batched widget creation.
+     */
     void insertProperty(Property* prop, size_t index);
     void insertPropertyWidget(PropertyWidgetQt* propertyWidget, bool insertAtEnd);
+    void createPropertyWidget(size_t index);
+    /**
+     * Create the widgets of pending properties. At most pendingWidgetBatchSize widgets are created
+     * at once, the rest are created in later iterations of the event loop to keep the editor
+     * responsive for groups with many properties.
+     */
+    void createPendingWidgets();
+    /**
+     * Schedule createPendingWidgets for the next iteration of the event loop, unless the group is
+     * collapsed or a call is already scheduled.
+     */
+    void schedulePendingWidgets();
+    void updateTabOrder();
+
+    static constexpr size_t pendingWidgetBatchSize = 32;
 
     virtual void updateFocusPolicy();
 
@@ -131,8 +153,10 @@ protected:
     QToolButton* resetButton_;
 
     std::vector<Property*> properties_;
-    std::vector<PropertyWidgetQt*> propertyWidgets_;
+    std::vector<PropertyWidgetQt*> propertyWidgets_;  //< nullptr for properties without a widget
     std::vector<std::unique_ptr<PropertyWidgetQt>> oldWidgets_;
+    std::unordered_set<Property*> pendingProperties_;  //< properties waiting for a widget
+    bool pendingWidgetsScheduled_ = false;
 
 private:
     QToolButton* btnCollapse_;
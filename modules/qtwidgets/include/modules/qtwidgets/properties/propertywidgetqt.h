@@ -38,6 +38,7 @@
 #include <warn/ignore/all>
 #include <QWidget>
 #include <warn/pop>
+#include <chrono>
 #include <memory>
 
 class QMenu;
@@ -68,6 +69,20 @@ public:
     static const int spacing;
     static const int margin;
 
+    /**
+     * Minimum time between two updates of a widget caused by property changes.
+     */
+    static const std::chrono::milliseconds minimumUpdateInterval;
+
+    /**
+     * Throttles the updates caused by property changes. Hidden widgets, e.g. in collapsed
+     * composites, are only marked as dirty and updated when they are shown again. Visible widgets
+     * are updated directly unless they were updated within minimumUpdateInterval, then the update
+     * is deferred and merged with any further changes. Requests from other threads are forwarded
+     * to the thread of the widget.
+     */
+    virtual void requestUpdateFromProperty() override;
+
     void setSpacingAndMargins(QLayout* layout);
     static void setSpacingAndMargins(QWidget* w, QLayout* layout);
 
@@ -110,6 +125,7 @@ protected:
 
     virtual bool event(QEvent* event) override;  //< for custom tooltips.
     virtual void paintEvent(QPaintEvent* pe) override;
+    virtual void showEvent(QShowEvent* event) override;
 
     QPoint mousePressedPosition_;  /// Assigned on mousePressEvent
 
@@ -118,6 +134,7 @@ protected:
 private:
     void addModuleMenuActions(QMenu* menu, InviwoApplication* app);
     void addPresetMenuActions(QMenu* menu, InviwoApplication* app);
+    void flushUpdate();
 
     PropertyWidgetQt* parent_;
 
@@ -125,6 +142,10 @@ private:
 
     const int maxNumNestedShades_;  //< This number has do match the number of shades in the qss.
     int nestedDepth_;
+
+    bool updatePending_ = false;
+    bool updateScheduled_ = false;
+    std::chrono::steady_clock::time_point lastUpdate_{};
 };
 
 }  // namespace inviwo
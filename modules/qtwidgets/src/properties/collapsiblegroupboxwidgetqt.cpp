@@ -59,6 +59,7 @@
 #include <QClipboard>
 #include <QMimeData>
 #include <QApplication>
+#include <QTimer>
 #include <warn/pop>
 
 namespace inviwo {
@@ -342,6 +343,7 @@ void CollapsibleGroupBoxWidgetQt::setCollapsed(bool collapse) {
     propertyWidgetGroup_->setVisible(!collapse);
     btnCollapse_->setChecked(collapse);
     setUpdatesEnabled(true);
+    if (!collapse) createPendingWidgets();
 }
 
 void CollapsibleGroupBoxWidgetQt::updateFromProperty() { oldWidgets_.clear(); }
@@ -359,6 +361,7 @@ void CollapsibleGroupBoxWidgetQt::onWillRemoveProperty(Property* /*prop*/, size_
     });
 
     PropertyWidgetQt* propertyWidget = propertyWidgets_[index];
+    pendingProperties_.erase(properties_[index]);
 
     if (propertyWidget) {
         if (isChildRemovable()) {
@@ -399,10 +402,11 @@ void CollapsibleGroupBoxWidgetQt::onSetSemantics(Property* prop, const PropertyS
     });
 
     auto pit = std::find(properties_.begin(), properties_.end(), prop);
-    auto wit = std::find_if(propertyWidgets_.begin(), propertyWidgets_.end(),
-                            [&](auto w) { return w->getProperty() == prop; });
+    if (pit == properties_.end()) return;
+    // Properties without a widget, e.g. waiting to be expanded, will get the right one later.
+    auto wit = propertyWidgets_.begin() + std::distance(properties_.begin(), pit);
 
-    if (pit != properties_.end() && wit != propertyWidgets_.end()) {
+    if (*wit) {
         if (auto newWidget = static_cast<PropertyWidgetQt*>(factory->create(prop).release())) {
             propertyWidgetGroupLayout_->replaceWidget(*wit, newWidget, Qt::FindDirectChildrenOnly);
 
@@ -420,11 +424,7 @@ void CollapsibleGroupBoxWidgetQt::onSetSemantics(Property* prop, const PropertyS
             newWidget->initState();
             RenderContext::getPtr()->activateDefaultRenderContext();
 
-            // need to re-set tab order for all following widgets to ensure tab order is correct
-            // (see http://doc.qt.io/qt-5/qwidget.html#setTabOrder)
-            for (auto it = propertyWidgets_.begin() + 1; it != propertyWidgets_.end(); ++it) {
-                setTabOrder((*(it - 1)), (*it));
-            }
+            updateTabOrder();
         } else {
             LogWarn("Could not change semantic for property: " << prop->getClassIdentifier());
         }
@@ -451,7 +451,7 @@ void CollapsibleGroupBoxWidgetQt::onSetVisible(Property* property, bool visible)
 
     if (isChildRemovable()) {
         for (auto&& elem : util::zip(properties_, propertyWidgets_)) {
-            if (elem.first() == property) {
+            if (elem.first() == property && elem.second()) {
                 const int widgetIndex = propertyWidgetGroupLayout_->indexOf(elem.second());
                 int row = 0, col = 0, rowSpan = 0, colSpan = 0;
                 propertyWidgetGroupLayout_->getItemPosition(widgetIndex, &row, &col, &rowSpan,
@@ -570,39 +570,76 @@ void CollapsibleGroupBoxWidgetQt::addButtonLayout(QGridLayout* layout, int row,
 }
 
 void CollapsibleGroupBoxWidgetQt::insertProperty(Property* prop, size_t index) {
-    setUpdatesEnabled(false);
-    propertyWidgetGroupLayout_->setEnabled(false);
-    util::OnScopeExit enableUpdates([&]() {
-        propertyWidgetGroupLayout_->setEnabled(true);
-        setUpdatesEnabled(true);
-    });
-
     const size_t insertIndex = std::min(index, properties_.size());
-    const bool insertAtEnd = (insertIndex == properties_.size());
-
-    auto insertPoint = properties_.begin() + insertIndex;
-    auto widgetInsertPoint = propertyWidgets_.begin() + insertIndex;
 
-    properties_.insert(insertPoint, prop);
+    properties_.insert(properties_.begin() + insertIndex, prop);
+    propertyWidgets_.insert(propertyWidgets_.begin() + insertIndex, nullptr);
     PropertyObserver::addObservation(prop);
 
+    pendingProperties_.insert(prop);
+    schedulePendingWidgets();
+}
+
+void CollapsibleGroupBoxWidgetQt::createPropertyWidget(size_t index) {
+    auto prop = properties_[index];
     auto factory = InviwoApplication::getPtr()->getPropertyWidgetFactory();
     if (auto propertyWidget = static_cast<PropertyWidgetQt*>(factory->create(prop).release())) {
-        propertyWidgets_.insert(widgetInsertPoint, propertyWidget);
-
+        propertyWidgets_[index] = propertyWidget;
+        const bool insertAtEnd =
+            std::all_of(propertyWidgets_.begin() + index + 1, propertyWidgets_.end(),
+                        [](PropertyWidgetQt* w) { return w == nullptr; });
         insertPropertyWidget(propertyWidget, insertAtEnd);
         RenderContext::getPtr()->activateDefaultRenderContext();
-
-        // need to re-set tab order for all following widgets to ensure tab order is correct
-        // (see http://doc.qt.io/qt-5/qwidget.html#setTabOrder)
-        for (auto wit = propertyWidgets_.begin() + 1; wit != propertyWidgets_.end(); ++wit) {
-            setTabOrder(*(wit - 1), *wit);
-        }
     } else {
+        // keep the nullptr to keep the property widget vector in sync with property vector
         LogWarn("Could not find a widget for property: " << prop->getClassIdentifier());
+    }
+}
+
+void CollapsibleGroupBoxWidgetQt::createPendingWidgets() {
+    // If a batch is already scheduled the remaining widgets will be created by it
+    if (pendingProperties_.empty() || btnCollapse_->isChecked() || pendingWidgetsScheduled_) {
+        return;
+    }
+
+    setUpdatesEnabled(false);
+    propertyWidgetGroupLayout_->setEnabled(false);
+    util::OnScopeExit enableUpdates([&]() {
+        propertyWidgetGroupLayout_->setEnabled(true);
+        setUpdatesEnabled(true);
+    });
+
+    size_t created = 0;
+    for (size_t i = 0; i < properties_.size() && created < pendingWidgetBatchSize; ++i) {
+        if (pendingProperties_.erase(properties_[i]) != 0) {
+            createPropertyWidget(i);
+            ++created;
+        }
+    }
+    updateTabOrder();
+
+    schedulePendingWidgets();
+}
+
+void CollapsibleGroupBoxWidgetQt::schedulePendingWidgets() {
+    if (pendingProperties_.empty() || btnCollapse_->isChecked() || pendingWidgetsScheduled_) {
+        return;
+    }
+    pendingWidgetsScheduled_ = true;
+    QTimer::singleShot(0, this, [this]() {
+        pendingWidgetsScheduled_ = false;
+        createPendingWidgets();
+    });
+}
 
-        // insert empty element to keep property widget vector in sync with property vector
-        propertyWidgets_.insert(widgetInsertPoint, nullptr);
+void CollapsibleGroupBoxWidgetQt::updateTabOrder() {
+    // need to re-set tab order for all widgets to ensure tab order is correct
+    // (see http://doc.qt.io/qt-5/qwidget.html#setTabOrder)
+    PropertyWidgetQt* prev = nullptr;
+    for (auto w : propertyWidgets_) {
+        if (!w) continue;
+        if (prev) setTabOrder(prev, w);
+        prev = w;
     }
 }
 
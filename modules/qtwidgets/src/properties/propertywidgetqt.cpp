@@ -57,6 +57,8 @@
 #include <QMimeData>
 #include <QMessageBox>
 #include <QActionGroup>
+#include <QThread>
+#include <QTimer>
 #include <warn/pop>
 
 namespace inviwo {
@@ -64,6 +66,7 @@ namespace inviwo {
 const int PropertyWidgetQt::minimumWidth = 200;
 const int PropertyWidgetQt::spacing = 7;
 const int PropertyWidgetQt::margin = 0;
+const std::chrono::milliseconds PropertyWidgetQt::minimumUpdateInterval{33};
 
 // The factor should be 16.0 at font size 12pt, we use Segoe UI at 9pt which gives an em at 9.0px
 const double PropertyWidgetQt::minimumWidthEm =
@@ -497,4 +500,40 @@ void PropertyWidgetQt::paintEvent(QPaintEvent*) {
     style()->drawPrimitive(QStyle::PE_Widget, &o, &p, this);
 }
 
+void PropertyWidgetQt::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    flushUpdate();
+}
+
+void PropertyWidgetQt::requestUpdateFromProperty() {
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(
+            this, [this]() { requestUpdateFromProperty(); }, Qt::QueuedConnection);
+        return;
+    }
+
+    updatePending_ = true;
+    if (!isVisible() || updateScheduled_) return;
+
+    using namespace std::chrono;
+    const auto elapsed = duration_cast<milliseconds>(steady_clock::now() - lastUpdate_);
+    if (elapsed >= minimumUpdateInterval) {
+        flushUpdate();
+    } else {
+        updateScheduled_ = true;
+        const auto wait = static_cast<int>((minimumUpdateInterval - elapsed).count());
+        QTimer::singleShot(wait, this, [this]() {
+            updateScheduled_ = false;
+            flushUpdate();
+        });
+    }
+}
+
+void PropertyWidgetQt::flushUpdate() {
+    if (!updatePending_ || !isVisible()) return;
+    updatePending_ = false;
+    lastUpdate_ = std::chrono::steady_clock::now();
+    updateFromProperty();
+}
+
 }  // namespace inviwo
@@ -67,5 +67,5 @@ void main() {
         color_ = overrideColor;
     }
 
-    pickColor_ = vec4(pickingIndexToColor(pickId), pickingEnabled ? 1.0 : 0.0);
+    pickColor_ = pickingEnabled ? pickingIndexToRGBA(pickId) : vec4(0.0);
 }
@@ -39,6 +39,7 @@
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/network/networklock.h>
 #include <inviwo/core/network/processornetworkevaluator.h>
+#include <inviwo/core/network/evaluationscheduler.h>
 #include <inviwo/core/ports/portfactory.h>
 #include <inviwo/core/ports/portinspectorfactory.h>
 #include <inviwo/core/ports/portinspectormanager.h>
@@ -178,6 +179,20 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
         resourceManager_->setEnabled(false);
     }
 
+    evaluationScheduler_ = std::make_unique<EvaluationScheduler>(
+        processorNetwork_.get(), processorNetworkEvaluator_.get(), getTimerThread());
+    const auto updateScheduler = [this]() {
+        evaluationScheduler_->setEnabled(systemSettings_->previewWhileInteracting_);
+        evaluationScheduler_->setFrameTimeBudget(
+            std::chrono::milliseconds{systemSettings_->frameTimeBudget_});
+        evaluationScheduler_->setIdleDelay(
+            std::chrono::milliseconds{systemSettings_->interactionIdleDelay_});
+    };
+    updateScheduler();
+    systemSettings_->previewWhileInteracting_.onChange(updateScheduler);
+    systemSettings_->frameTimeBudget_.onChange(updateScheduler);
+    systemSettings_->interactionIdleDelay_.onChange(updateScheduler);
+
     moduleManager_.onModulesDidRegister([this]() {
         if (resourceManager_->isEnabled() && resourceManager_->numberOfResources() > 0) {
             LogWarn(
@@ -267,6 +282,10 @@ ProcessorNetworkEvaluator* InviwoApplication::getProcessorNetworkEvaluator() {
     return processorNetworkEvaluator_.get();
 }
 
+EvaluationScheduler* InviwoApplication::getEvaluationScheduler() {
+    return evaluationScheduler_.get();
+}
+
 WorkspaceManager* InviwoApplication::getWorkspaceManager() { return workspaceManager_.get(); }
 
 PropertyPresetManager* InviwoApplication::getPropertyPresetManager() {
@@ -29,6 +29,7 @@
 
 #include <inviwo/core/datastructures/histogramtools.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumesparseprecision.h>
 #include <inviwo/core/common/inviwoapplication.h>
 
 namespace inviwo {
@@ -55,6 +56,34 @@ HistogramSupplier& HistogramSupplier::operator=(const HistogramSupplier& that) {
 
 std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
     std::shared_ptr<const VolumeRAM> volumeRam, dvec2 dataRange, size_t bins) const {
+    return startCalculation(dataRange, bins, [volumeRam, dataRange, bins]() {
+        return volumeRam->dispatch<HistogramContainer>([&](auto vr) {
+            return HistogramContainer(dataRange, bins, vr->getDataTyped(),
+                                      vr->getDataTyped() + glm::compMul(vr->getDimensions()));
+        });
+    });
+}
+
+std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
+    std::shared_ptr<const VolumeSparse> volumeSparse, dvec2 dataRange, size_t bins) const {
+    return startCalculation(dataRange, bins, [volumeSparse, dataRange, bins]() {
+        return volumeSparse->dispatch<HistogramContainer>([&](auto vs) {
+            using ValueType = util::PrecisionValueType<decltype(vs)>;
+            detail::HistogramAccumulator<ValueType> accumulator(dataRange, bins);
+            size_t active = 0;
+            vs->forEachActiveVoxel([&](const size3_t&, const ValueType& value) {
+                accumulator.add(value);
+                ++active;
+            });
+            const size_t background = glm::compMul(vs->getDimensions()) - active;
+            if (background > 0) accumulator.add(vs->getBackground(), background);
+            return HistogramContainer(std::move(accumulator));
+        });
+    });
+}
+
+std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
+    dvec2 dataRange, size_t bins, std::function<HistogramContainer()> calculate) const {
     if (!calculation_ || calculation_->getBins() != bins ||
         calculation_->getDataRange() != dataRange) {
 
@@ -62,11 +91,8 @@ std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
         calculation_ = std::make_shared<HistogramCalculationState>(histograms_, bins, dataRange);
 
         dispatchPool([weakState = std::weak_ptr<HistogramCalculationState>(calculation_),
-                      stop = calculation_->stop_, volumeRam, dataRange, bins]() {
-            auto histograms = volumeRam->dispatch<HistogramContainer>([&](auto vr) {
-                return HistogramContainer(dataRange, bins, vr->getDataTyped(),
-                                          vr->getDataTyped() + glm::compMul(vr->getDimensions()));
-            });
+                      stop = calculation_->stop_, calculate]() {
+            auto histograms = calculate();
             if (*stop) return;
             dispatchFrontAndForget([hist = std::move(histograms), weakState]() {
                 if (auto s = weakState.lock()) {
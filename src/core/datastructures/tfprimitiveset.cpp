@@ -388,31 +388,52 @@ vec4 TFPrimitiveSet::interpolateColor(double t) const {
 }
 
 void TFPrimitiveSet::interpolateAndStoreColors(vec4* dataArray, const size_t dataSize) const {
+    interpolateAndStoreColors(dataArray, dataSize, 0, dataSize);
+}
+
+void TFPrimitiveSet::interpolateAndStoreColors(vec4* dataArray, const size_t dataSize,
+                                               size_t first, size_t last) const {
+    last = std::min(last, dataSize);
+    if (first >= last) return;
+
     const auto toInd = [&](const TFPrimitive& p) {
         return static_cast<size_t>(ceil(p.getPosition() * (dataSize - 1)));
     };
+    const auto fill = [&](size_t a, size_t b, const vec4& color) {
+        a = std::max(a, first);
+        b = std::min(b, last);
+        if (a < b) std::fill(dataArray + a, dataArray + b, color);
+    };
 
     if (empty()) {  // in case of 0 points
-        std::fill(dataArray, dataArray + dataSize, vec4(0.0f));
+        fill(0, dataSize, vec4(0.0f));
     } else if (size() == 1) {  // in case of 1 point
-        std::fill(dataArray, dataArray + dataSize, front().getColor());
+        fill(0, dataSize, front().getColor());
     } else {  // in case of more than 1 points
         const size_t leftX = toInd(front());
         const size_t rightX = toInd(back());
 
-        std::fill(dataArray, dataArray + leftX + 1, front().getColor());
-        std::fill(dataArray + rightX, dataArray + dataSize, back().getColor());
+        fill(0, leftX + 1, front().getColor());
+        fill(rightX, dataSize, back().getColor());
 
-        auto pLeft = begin();
-        auto pRight = ++begin();
+        // skip all segments ending before the requested range
+        auto pRight = std::upper_bound(++begin(), end(), first, [&](size_t i, const auto& p) {
+            return i < toInd(p);
+        });
+        if (pRight == end()) return;
+        auto pLeft = std::prev(pRight);
 
         while (pRight != end()) {
+            const auto leftInd = toInd(*pLeft);
+            if (leftInd >= last) break;
+
             const auto lrgba = pLeft->getColor();
             const auto rrgba = pRight->getColor();
             const auto lx = pLeft->getPosition() * (dataSize - 1);
             const auto rx = pRight->getPosition() * (dataSize - 1);
 
-            for (size_t n = toInd(*pLeft); n < toInd(*pRight); ++n) {
+            const auto rightInd = std::min(toInd(*pRight), last);
+            for (size_t n = std::max(leftInd, first); n < rightInd; ++n) {
                 const float x = static_cast<float>((n - lx) / (rx - lx));
                 dataArray[n] = glm::mix(lrgba, rrgba, x);
             }
@@ -45,6 +45,7 @@
 #include <inviwo/core/util/zip.h>
 
 #include <cmath>
+#include <future>
 
 namespace inviwo {
 
@@ -61,7 +62,9 @@ TransferFunction::TransferFunction(const std::vector<TFPrimitiveData>& values,
     , maskMax_(1.0)
     , invalidData_(true)
     , dataRepr_{std::make_shared<LayerRAMPrecision<vec4>>(size2_t(textureSize, 1))}
-    , data_(std::make_unique<Layer>(dataRepr_)) {
+    , data_(std::make_unique<Layer>(dataRepr_))
+    , tableState_{}
+    , tableMask_{0.0, 0.0} {
     clearMask();
 }
 
@@ -71,7 +74,9 @@ TransferFunction::TransferFunction(const TransferFunction& rhs)
     , maskMax_(rhs.maskMax_)
     , invalidData_(true)
     , dataRepr_(std::shared_ptr<LayerRAMPrecision<vec4>>(rhs.dataRepr_->clone()))
-    , data_(std::make_unique<Layer>(dataRepr_)) {}
+    , data_(std::make_unique<Layer>(dataRepr_))
+    , tableState_{}
+    , tableMask_{0.0, 0.0} {}
 
 TransferFunction& TransferFunction::operator=(const TransferFunction& rhs) {
     if (this != &rhs) {
@@ -82,6 +87,7 @@ TransferFunction& TransferFunction::operator=(const TransferFunction& rhs) {
         maskMin_ = rhs.maskMin_;
         maskMax_ = rhs.maskMax_;
         invalidData_ = rhs.invalidData_;
+        tableState_.clear();
 
         TFPrimitiveSet::operator=(rhs);
     }
@@ -138,6 +144,36 @@ vec4 TransferFunction::sample(double v) const { return interpolateColor(v); }
 
 vec4 TransferFunction::sample(float v) const { return interpolateColor(v); }
 
+const vec4* TransferFunction::getTableData() const {
+    if (invalidData_) calcTransferValues();
+    return dataRepr_->getDataTyped();
+}
+
+void TransferFunction::forEachChunk(size_t size,
+                                    const std::function<void(size_t, size_t)>& func) {
+    // Below this size the overhead of dispatching jobs outweighs the gain
+    constexpr size_t minChunkSize = 1 << 16;
+
+    const size_t poolSize =
+        InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+    if (poolSize == 0 || size < 2 * minChunkSize) {
+        func(0, size);
+        return;
+    }
+
+    const size_t jobs = std::min(4 * poolSize, size / minChunkSize);
+    std::vector<std::future<void>> futures;
+    futures.reserve(jobs);
+    for (size_t job = 0; job < jobs; ++job) {
+        const size_t begin = (size * job) / jobs;
+        const size_t end = (size * (job + 1)) / jobs;
+        futures.push_back(dispatchPool([&func, begin, end]() { func(begin, end); }));
+    }
+    for (auto& f : futures) {
+        f.get();
+    }
+}
+
 std::vector<FileExtension> TransferFunction::getSupportedExtensions() const {
     return {{"itf", "Inviwo Transfer Function"}, {"png", "Transfer Function Image"}};
 }
@@ -260,12 +296,49 @@ void TransferFunction::calcTransferValues() const {
     auto dataArray = dataRepr_->getDataTyped();
     const auto size = dataRepr_->getDimensions().x;
 
-    interpolateAndStoreColors(dataArray, size);
+    const auto toInd = [&](const TFPrimitiveData& p) {
+        return static_cast<size_t>(ceil(p.pos * (size - 1)));
+    };
+
+    // Determine the part of the table that is affected by the changes since the last update.
+    // Primitives which are unchanged at the beginning and at the end of the sorted sequence
+    // do not affect the table before/after their respective position.
+    const auto [first, last] = [&]() -> std::pair<size_t, size_t> {
+        if (tableMask_ != dvec2{maskMin_, maskMax_} || tableState_.empty() || empty()) {
+            return {0, size};
+        }
+        const size_t oldSize = tableState_.size();
+        const size_t newSize = sorted_.size();
+        const size_t common = std::min(oldSize, newSize);
+
+        size_t prefix = 0;
+        while (prefix < common && tableState_[prefix] == sorted_[prefix]->getData()) ++prefix;
+        if (prefix == oldSize && oldSize == newSize) return {0, 0};
+
+        size_t suffix = 0;
+        while (suffix < common - prefix &&
+               tableState_[oldSize - 1 - suffix] == sorted_[newSize - 1 - suffix]->getData()) {
+            ++suffix;
+        }
 
-    for (size_t i = 0; i < size_t(maskMin_ * size); i++) dataArray[i].a = 0.0;
-    for (size_t i = size_t(maskMax_ * size); i < size; i++) dataArray[i].a = 0.0;
+        return {prefix == 0 ? 0 : toInd(sorted_[prefix - 1]->getData()),
+                suffix == 0 ? size : toInd(sorted_[newSize - suffix]->getData())};
+    }();
+
+    if (first < last) {
+        interpolateAndStoreColors(dataArray, size, first, last);
+
+        const auto maskBegin = std::min(size_t(maskMin_ * size), last);
+        for (size_t i = first; i < maskBegin; i++) dataArray[i].a = 0.0;
+        const auto maskEnd = std::max(size_t(maskMax_ * size), first);
+        for (size_t i = maskEnd; i < last; i++) dataArray[i].a = 0.0;
+
+        data_->invalidateAllOther(dataRepr_.get());
+    }
 
-    data_->invalidateAllOther(dataRepr_.get());
+    tableState_.clear();
+    for (auto p : sorted_) tableState_.push_back(p->getData());
+    tableMask_ = dvec2{maskMin_, maskMax_};
 
     invalidData_ = false;
 }
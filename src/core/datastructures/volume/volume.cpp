@@ -29,6 +29,7 @@
 
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumesparse.h>
 #include <inviwo/core/util/document.h>
 
 namespace inviwo {
@@ -221,6 +222,10 @@ const StructuredCameraCoordinateTransformer<3>& Volume::getCoordinateTransformer
 }
 
 std::shared_ptr<HistogramCalculationState> Volume::calculateHistograms(size_t bins) const {
+    // Sparse volumes are not made dense, only their active voxels are visited
+    if (auto sparse = std::dynamic_pointer_cast<const VolumeSparse>(lastValidRepresentation_)) {
+        return HistogramSupplier::startCalculation(sparse, dataMap_.dataRange, bins);
+    }
 
     getRepresentation<VolumeRAM>();  // make sure lastValidRepresentation_ is VolumeRAM
     return HistogramSupplier::startCalculation(
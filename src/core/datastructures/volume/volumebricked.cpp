@@ -0,0 +1,78 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/volume/volumebricked.h>
+#include <inviwo/core/datastructures/volume/volumebrickedprecision.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+namespace inviwo {
+
+VolumeBricked::VolumeBricked(const DataFormatBase* format) : VolumeRepresentation(format) {}
+
+std::type_index VolumeBricked::getTypeIndex() const {
+    return std::type_index(typeid(VolumeBricked));
+}
+
+size2_t VolumeBricked::getSliceDimensions(CartesianCoordinateAxis axis) const {
+    const auto dims = getDimensions();
+    switch (axis) {
+        case CartesianCoordinateAxis::X:
+            return size2_t(dims.z, dims.y);
+        case CartesianCoordinateAxis::Y:
+            return size2_t(dims.x, dims.z);
+        case CartesianCoordinateAxis::Z:
+        default:
+            return size2_t(dims.x, dims.y);
+    }
+}
+
+std::shared_ptr<VolumeBricked> createVolumeBricked(const VolumeRAM& ram) {
+    return ram.dispatch<std::shared_ptr<VolumeBricked>>([&](auto vrprecision) {
+        using ValueType = util::PrecisionValueType<decltype(vrprecision)>;
+        auto bricked = std::make_shared<VolumeBrickedPrecision<ValueType>>(
+            vrprecision->getDimensions(), vrprecision->getSwizzleMask(),
+            vrprecision->getInterpolation(), vrprecision->getWrapping());
+        bricked->setFromLinear(vrprecision->getDataTyped());
+        return bricked;
+    });
+}
+
+std::shared_ptr<VolumeRAM> createVolumeRAM(const VolumeBricked& bricked) {
+    return bricked.dispatch<std::shared_ptr<VolumeRAM>>([&](auto vbprecision) {
+        using ValueType = util::PrecisionValueType<decltype(vbprecision)>;
+        auto ram = std::make_shared<VolumeRAMPrecision<ValueType>>(
+            vbprecision->getDimensions(), util::RAMInit::Uninitialized,
+            vbprecision->getSwizzleMask(), vbprecision->getInterpolation(),
+            vbprecision->getWrapping());
+        vbprecision->copyToLinear(ram->getDataTyped());
+        return ram;
+    });
+}
+
+}  // namespace inviwo
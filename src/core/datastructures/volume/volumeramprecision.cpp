@@ -42,6 +42,15 @@ struct VolumeRamCreationDispatcher {
         return std::make_shared<VolumeRAMPrecision<F>>(static_cast<F*>(dataPtr), dimensions,
                                                        swizzleMask, interpolation, wrapping);
     }
+    template <typename Result, typename T>
+    std::shared_ptr<VolumeRAM> operator()(util::RAMInit init, const size3_t& dimensions,
+                                          const SwizzleMask& swizzleMask,
+                                          InterpolationType interpolation,
+                                          const Wrapping3D& wrapping) {
+        using F = typename T::type;
+        return std::make_shared<VolumeRAMPrecision<F>>(dimensions, init, swizzleMask,
+                                                       interpolation, wrapping);
+    }
 };
 
 std::shared_ptr<VolumeRAM> createVolumeRAM(const size3_t& dimensions, const DataFormatBase* format,
@@ -53,4 +62,22 @@ std::shared_ptr<VolumeRAM> createVolumeRAM(const size3_t& dimensions, const Data
         format->getId(), disp, dataPtr, dimensions, swizzleMask, interpolation, wrapping);
 }
 
+std::shared_ptr<VolumeRAM> createVolumeRAM(const size3_t& dimensions, const DataFormatBase* format,
+                                           util::RAMInit init, const SwizzleMask& swizzleMask,
+                                           InterpolationType interpolation,
+                                           const Wrapping3D& wrapping) {
+    VolumeRamCreationDispatcher disp;
+    return dispatching::dispatch<std::shared_ptr<VolumeRAM>, dispatching::filter::All>(
+        format->getId(), disp, init, dimensions, swizzleMask, interpolation, wrapping);
+}
+
+std::shared_ptr<VolumeRAM> createVolumeRAMView(const VolumeRAM& parent, const size3_t& offset,
+                                               const size3_t& dimensions, const size3_t& stride) {
+    return parent.dispatch<std::shared_ptr<VolumeRAM>>([&](auto vrprecision) {
+        using ValueType = util::PrecisionValueType<decltype(vrprecision)>;
+        return std::make_shared<VolumeRAMPrecision<ValueType>>(*vrprecision, offset, dimensions,
+                                                               stride);
+    });
+}
+
 }  // namespace inviwo
@@ -0,0 +1,66 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/volume/volumesparse.h>
+#include <inviwo/core/datastructures/volume/volumesparseprecision.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+namespace inviwo {
+
+VolumeSparse::VolumeSparse(const DataFormatBase* format) : VolumeRepresentation(format) {}
+
+std::type_index VolumeSparse::getTypeIndex() const {
+    return std::type_index(typeid(VolumeSparse));
+}
+
+std::shared_ptr<VolumeSparse> createVolumeSparse(const VolumeRAM& ram, dvec4 background) {
+    return ram.dispatch<std::shared_ptr<VolumeSparse>>([&](auto vrprecision) {
+        using ValueType = util::PrecisionValueType<decltype(vrprecision)>;
+        auto sparse = std::make_shared<VolumeSparsePrecision<ValueType>>(
+            vrprecision->getDimensions(), util::glm_convert<ValueType>(background),
+            vrprecision->getSwizzleMask(), vrprecision->getInterpolation(),
+            vrprecision->getWrapping());
+        sparse->setFromDense(vrprecision->getDataTyped());
+        return sparse;
+    });
+}
+
+std::shared_ptr<VolumeRAM> createVolumeRAM(const VolumeSparse& sparse) {
+    return sparse.dispatch<std::shared_ptr<VolumeRAM>>([&](auto vsprecision) {
+        using ValueType = util::PrecisionValueType<decltype(vsprecision)>;
+        auto ram = std::make_shared<VolumeRAMPrecision<ValueType>>(
+            vsprecision->getDimensions(), util::RAMInit::Uninitialized,
+            vsprecision->getSwizzleMask(), vsprecision->getInterpolation(),
+            vsprecision->getWrapping());
+        vsprecision->copyToDense(ram->getDataTyped());
+        return ram;
+    });
+}
+
+}  // namespace inviwo
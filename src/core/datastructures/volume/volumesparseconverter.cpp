@@ -0,0 +1,85 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/volume/volumesparseconverter.h>
+#include <inviwo/core/datastructures/volume/volumesparseprecision.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/exception.h>
+
+namespace inviwo {
+
+namespace {
+
+void checkFormats(const VolumeRepresentation& source, const VolumeRepresentation& destination) {
+    if (source.getDataFormat() != destination.getDataFormat()) {
+        throw ConverterException("Source and destination formats differ",
+                                 IVW_CONTEXT_CUSTOM("VolumeSparseConverter"));
+    }
+}
+
+}  // namespace
+
+std::shared_ptr<VolumeSparse> VolumeRAM2SparseConverter::createFrom(
+    std::shared_ptr<const VolumeRAM> source) const {
+    return createVolumeSparse(*source);
+}
+
+void VolumeRAM2SparseConverter::update(std::shared_ptr<const VolumeRAM> source,
+                                       std::shared_ptr<VolumeSparse> destination) const {
+    checkFormats(*source, *destination);
+    destination->dispatch<void>([&](auto vsprecision) {
+        using ValueType = util::PrecisionValueType<decltype(vsprecision)>;
+        vsprecision->setDimensions(source->getDimensions());
+        vsprecision->setFromDense(static_cast<const ValueType*>(source->getData()));
+        vsprecision->setSwizzleMask(source->getSwizzleMask());
+        vsprecision->setInterpolation(source->getInterpolation());
+        vsprecision->setWrapping(source->getWrapping());
+    });
+}
+
+std::shared_ptr<VolumeRAM> VolumeSparse2RAMConverter::createFrom(
+    std::shared_ptr<const VolumeSparse> source) const {
+    return createVolumeRAM(*source);
+}
+
+void VolumeSparse2RAMConverter::update(std::shared_ptr<const VolumeSparse> source,
+                                       std::shared_ptr<VolumeRAM> destination) const {
+    checkFormats(*source, *destination);
+    destination->dispatch<void>([&](auto vrprecision) {
+        using ValueType = util::PrecisionValueType<decltype(vrprecision)>;
+        vrprecision->setDimensions(source->getDimensions());
+        static_cast<const VolumeSparsePrecision<ValueType>&>(*source).copyToDense(
+            vrprecision->getDataTyped());
+        vrprecision->setSwizzleMask(source->getSwizzleMask());
+        vrprecision->setInterpolation(source->getInterpolation());
+        vrprecision->setWrapping(source->getWrapping());
+    });
+}
+
+}  // namespace inviwo
@@ -63,6 +63,10 @@ vec3 PickingAction::getColor(size_t id) const {
     return vec3(PickingManager::indexToColor(getPickingId(id))) / 255.0f;
 }
 
+vec4 PickingAction::getColorRGBA(size_t id) const {
+    return vec4(PickingManager::indexToRGBA(getPickingId(id))) / 255.0f;
+}
+
 size_t PickingAction::getSize() const { return size_; }
 
 bool PickingAction::isEnabled() const { return enabled_; }
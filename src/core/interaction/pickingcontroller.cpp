@@ -56,7 +56,7 @@ void PickingController::propagateEvent(Event* event, EventPropagator* propagator
         if (auto src = src_.lock()) {
             const auto value = src->readPixel(coord, LayerType::Picking);
             if (value.a > 0.0) {
-                return PickingManager::colorToIndex(uvec3(value));
+                return PickingManager::colorToIndex(uvec4(value));
             }
         }
         return 0;
@@ -202,7 +202,8 @@ PickingManager::Result PickingController::findPickingAction(const uvec2& coord)
     if (auto src = src_.lock(); src && pickingEnabled()) {
         auto value = src->readPixel(size2_t(coord), LayerType::Picking);
         if (value.a > 0.0) {
-            return PickingManager::getPtr()->getPickingActionFromColor(uvec3(value));
+            return PickingManager::getPtr()->getPickingActionFromIndex(
+                PickingManager::colorToIndex(uvec4(value)));
         }
     }
     return {0, nullptr};
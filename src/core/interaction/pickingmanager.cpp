@@ -46,25 +46,34 @@ PickingAction* PickingManager::registerPickingAction(Processor* processor,
     PickingAction* pickObj = nullptr;
 
     // Find the smallest object with capacity >= size
-    auto it = std::lower_bound(unusedObjects_.begin(), unusedObjects_.end(), size,
-                               [](PickingAction* p, size_t s) { return p->getCapacity() < s; });
-
-    if (it != unusedObjects_.end()) {
-        pickObj = *it;
+    if (auto it = unusedObjects_.lower_bound(size); it != unusedObjects_.end()) {
+        pickObj = it->second;
         unusedObjects_.erase(it);
+        slots_[pickObj].unused.reset();
         pickObj->setSize(size);
     }
 
     if (!pickObj) {
+        const auto position = pickingActions_.size();
         pickingActions_.push_back(std::make_unique<PickingAction>(lastIndex_, size));
+        pickObj = pickingActions_.back().get();
+        slots_.emplace(pickObj, Slot{position, std::nullopt});
         lastIndex_ += size;
-        // we can only differentiate up to 2^24-1 picking IDs due to the use of u8vec3 for picking
-        // colors
-        if (lastIndex_ >= (1 << 24)) {
-            LogWarn("More than " << (1 << 24)
+
+        if (size > 0) {
+            const auto lastBlock = (lastIndex_ - 1) >> blockBits;
+            while (blockLookup_.size() <= lastBlock) blockLookup_.push_back(position);
+        }
+        // we can only differentiate up to maxIndex picking IDs due to the use of u8vec4 for
+        // picking colors, and up to 2^24 for renderers only using RGB picking colors
+        if (lastIndex_ > maxIndex + 1) {
+            LogWarn("More than " << maxIndex
                                  << " picking IDs in use. Unreliable picking behavior expected.");
+        } else if (lastIndex_ > maxRGBIndex + 1) {
+            LogWarn("More than " << maxRGBIndex
+                                 << " picking IDs in use. Unreliable picking behavior expected "
+                                    "for renderers using RGB picking colors.");
         }
-        pickObj = pickingActions_.back().get();
     }
     pickObj->setAction(std::move(action));
     pickObj->setProcessor(processor);
@@ -72,57 +81,56 @@ PickingAction* PickingManager::registerPickingAction(Processor* processor,
 }
 
 bool PickingManager::unregisterPickingAction(const PickingAction* p) {
-    auto it1 = std::find(unusedObjects_.begin(), unusedObjects_.end(), p);
-    if (it1 == unusedObjects_.end()) {
-
-        auto it2 = util::find_if(
-            pickingActions_, [p](const std::unique_ptr<PickingAction>& o) { return p == o.get(); });
-
-        if (!pickingActions_.empty() && it2 == pickingActions_.end() - 1) {
-            // unregistering the last picking action, don't put it into unused and perform clean-up
-            lastIndex_ -= (*it2)->getCapacity();
-            pickingActions_.pop_back();
-
-            // clean-up unused queue
-            while (!pickingActions_.empty()) {
-                auto it = std::find(unusedObjects_.begin(), unusedObjects_.end(),
-                                    pickingActions_.back().get());
-                if (it == unusedObjects_.end()) {
-                    break;
-                }
-                unusedObjects_.erase(it);
-                lastIndex_ -= pickingActions_.back()->getCapacity();
-                pickingActions_.pop_back();
-            }
-            return true;
-        } else if (it2 != pickingActions_.end()) {
-            (*it2)->setAction(nullptr);
-            (*it2)->setProcessor(nullptr);
-
-            auto insit = std::upper_bound(unusedObjects_.begin(), unusedObjects_.end(),
-                                          (*it2)->getCapacity(),
-                                          [](const size_t& capacity, PickingAction* po) {
-                                              return capacity < po->getCapacity();
-                                          });
-
-            unusedObjects_.insert(insit, (*it2).get());
-            return true;
+    auto it = slots_.find(p);
+    if (it == slots_.end() || it->second.unused) return false;
+
+    if (it->second.position + 1 == pickingActions_.size()) {
+        // unregistering the last picking action, don't put it into unused and perform clean-up
+        removeLastAction();
+
+        // clean-up unused queue
+        while (!pickingActions_.empty()) {
+            auto& slot = slots_[pickingActions_.back().get()];
+            if (!slot.unused) break;
+            unusedObjects_.erase(*slot.unused);
+            removeLastAction();
         }
+    } else {
+        auto pickObj = pickingActions_[it->second.position].get();
+        pickObj->setAction(nullptr);
+        pickObj->setProcessor(nullptr);
+        it->second.unused = unusedObjects_.emplace(pickObj->getCapacity(), pickObj);
     }
+    return true;
+}
 
-    return false;
+void PickingManager::removeLastAction() {
+    const auto position = pickingActions_.size() - 1;
+    lastIndex_ -= pickingActions_.back()->getCapacity();
+    slots_.erase(pickingActions_.back().get());
+    pickingActions_.pop_back();
+    while (!blockLookup_.empty() && blockLookup_.back() >= position) blockLookup_.pop_back();
 }
 
 auto PickingManager::getPickingActionFromIndex(size_t index) -> Result {
     if (index == 0) return {index, nullptr};
 
+    const auto block = index >> blockBits;
+    if (block >= blockLookup_.size()) return {index, nullptr};
+
+    // Only the picking objects overlapping the block of the index need to be searched.
+    const auto begin = pickingActions_.begin() + blockLookup_[block];
+    const auto end = block + 1 < blockLookup_.size()
+                         ? pickingActions_.begin() + blockLookup_[block + 1] + 1
+                         : pickingActions_.end();
+
     // This will find the first picking object with an start greater then index.
-    auto pIt = std::upper_bound(pickingActions_.begin(), pickingActions_.end(), index,
+    auto pIt = std::upper_bound(begin, end, index,
                                 [](const size_t& i, const std::unique_ptr<PickingAction>& p) {
-                                    return i < p->getPickingId(0);
+                                    return i < p->start_;
                                 });
 
-    if (std::distance(pickingActions_.begin(), pIt) > 0) {
+    if (pIt != begin) {
         auto po = (*(--pIt)).get();
         if (po->isIndex(index)) {
             return {index, po};
@@ -149,8 +157,7 @@ bool PickingManager::pickingEnabled() {
 }
 
 bool PickingManager::isPickingActionRegistered(const PickingAction* action) const {
-    return std::any_of(pickingActions_.begin(), pickingActions_.end(),
-                       [&](auto& item) { return item.get() == action; });
+    return slots_.count(action) != 0;
 }
 
 // First the left four bits are swapped with the right four bits.
@@ -193,4 +200,13 @@ size_t PickingManager::colorToIndex(uvec3 color) {
     return index;
 }
 
+uvec4 PickingManager::indexToRGBA(size_t index) {
+    return uvec4{indexToColor(index), 255 - ((index >> 24) & 0xFF)};
+}
+
+size_t PickingManager::colorToIndex(uvec4 color) {
+    if (color.a == 0) return 0;
+    return colorToIndex(uvec3(color)) | (size_t{255 - glm::min(color.a, 255u)} << 24);
+}
+
 }  // namespace inviwo
@@ -29,37 +29,231 @@
 
 #include <inviwo/core/io/bytereaderutil.h>
 #include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/formats.h>
+#include <inviwo/core/util/formatdispatching.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <vector>
 
 namespace inviwo {
 
-void util::readBytesIntoBuffer(const std::string& file, size_t offset, size_t bytes,
-                               bool littleEndian, size_t elementSize, void* dest) {
+namespace {
+
+// Number of bytes read before the chunk is handed over to the thread pool
+constexpr size_t chunkSize = 8 * 1024 * 1024;
+
+constexpr std::uint16_t byteSwap(std::uint16_t v) {
+    return static_cast<std::uint16_t>((v >> 8) | (v << 8));
+}
+constexpr std::uint32_t byteSwap(std::uint32_t v) {
+    return ((v & 0x000000FFu) << 24) | ((v & 0x0000FF00u) << 8) | ((v & 0x00FF0000u) >> 8) |
+           ((v & 0xFF000000u) >> 24);
+}
+constexpr std::uint64_t byteSwap(std::uint64_t v) {
+    return (static_cast<std::uint64_t>(byteSwap(static_cast<std::uint32_t>(v))) << 32) |
+           byteSwap(static_cast<std::uint32_t>(v >> 32));
+}
+
+// The shift and mask form above is recognized by the compilers and, together with the simple
+// loop, turned into vectorized byte shuffles.
+template <typename T>
+void swapElements(char* data, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        T value;
+        std::memcpy(&value, data + i * sizeof(T), sizeof(T));
+        value = byteSwap(value);
+        std::memcpy(data + i * sizeof(T), &value, sizeof(T));
+    }
+}
+
+std::ifstream openFile(const std::string& file, size_t offset) {
     auto fin = filesystem::ifstream(file, std::ios::in | std::ios::binary);
-    OnScopeExit close([&fin]() { fin.close(); });
+    if (!fin.good()) {
+        throw DataReaderException("Error: Could not read from file: " + file,
+                                  IVW_CONTEXT_CUSTOM("readBytesIntoBuffer"));
+    }
+    fin.seekg(offset);
+    return fin;
+}
 
-    if (fin.good()) {
-        fin.seekg(offset);
-        fin.read(static_cast<char*>(dest), bytes);
+void readChunk(std::ifstream& fin, const std::string& file, char* dest, size_t bytes) {
+    fin.read(dest, bytes);
+    if (static_cast<size_t>(fin.gcount()) != bytes) {
+        throw DataReaderException("Error: Unexpected end of file: " + file,
+                                  IVW_CONTEXT_CUSTOM("readBytesIntoBuffer"));
+    }
+}
 
-        if (!littleEndian && elementSize > 1) {
-            char* temp = new char[elementSize];
+/*
+ * Calls read(begin, size) for each chunk of \p chunkBytes on the calling thread and
+ * process(begin, size) for that chunk on the thread pool, such that the reading of the next
+ * chunk overlaps the processing of the previous ones. At most 2 x pool size chunks are in flight.
+ * Without a thread pool everything is done serially.
+ */
+template <typename Read, typename Process>
+void forEachChunk(size_t bytes, size_t chunkBytes, Read read, Process process) {
+    const size_t poolSize =
+        InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
 
-            for (std::size_t i = 0; i < bytes; i += elementSize) {
-                for (std::size_t j = 0; j < elementSize; j++)
-                    temp[j] = static_cast<char*>(dest)[i + j];
+    if (poolSize == 0) {
+        for (size_t begin = 0; begin < bytes; begin += chunkBytes) {
+            const auto size = std::min(chunkBytes, bytes - begin);
+            read(begin, size);
+            process(begin, size);
+        }
+        return;
+    }
 
-                for (std::size_t j = 0; j < elementSize; j++)
-                    static_cast<char*>(dest)[i + j] = temp[elementSize - j - 1];
+    std::deque<std::future<void>> futures;
+    try {
+        for (size_t begin = 0; begin < bytes; begin += chunkBytes) {
+            const auto size = std::min(chunkBytes, bytes - begin);
+            if (futures.size() >= 2 * poolSize) {
+                futures.front().get();
+                futures.pop_front();
             }
+            read(begin, size);
+            futures.push_back(dispatchPool([process, begin, size]() { process(begin, size); }));
+        }
+    } catch (...) {
+        for (auto& f : futures) f.wait();
+        throw;
+    }
+    for (auto& f : futures) f.get();
+}
 
-            delete[] temp;
+#include <warn/push>
+#include <warn/ignore/conversion>
+template <typename Src>
+struct ConvertTo {
+    template <typename Result, typename DstFormat>
+    void operator()(const char* src, size_t count, void* dest) {
+        using Dst = typename DstFormat::type;
+        auto dst = static_cast<Dst*>(dest);
+        for (size_t i = 0; i < count; ++i) {
+            Src value;
+            std::memcpy(&value, src + i * sizeof(Src), sizeof(Src));
+            dst[i] = static_cast<Dst>(value);
         }
-    } else {
-        throw DataReaderException("Error: Could not read from file: " + file,
-                                  IVW_CONTEXT_CUSTOM("readBytesIntoBuffer"));
     }
+};
+#include <warn/pop>
+
+struct Convert {
+    template <typename Result, typename SrcFormat>
+    void operator()(const char* src, size_t count, DataFormatId dstId, void* dest) {
+        dispatching::dispatch<void, dispatching::filter::Scalars>(
+            dstId, ConvertTo<typename SrcFormat::type>{}, src, count, dest);
+    }
+};
+
+const DataFormatBase* componentFormat(const DataFormatBase* format) {
+    return DataFormatBase::get(format->getNumericType(), 1, format->getPrecision());
+}
+
+}  // namespace
+
+void util::swapBytes(void* data, size_t bytes, size_t elementSize) {
+    auto ptr = static_cast<char*>(data);
+    switch (elementSize) {
+        case 0:
+        case 1:
+            break;
+        case 2:
+            swapElements<std::uint16_t>(ptr, bytes / 2);
+            break;
+        case 4:
+            swapElements<std::uint32_t>(ptr, bytes / 4);
+            break;
+        case 8:
+            swapElements<std::uint64_t>(ptr, bytes / 8);
+            break;
+        default:
+            for (size_t i = 0; i + elementSize <= bytes; i += elementSize) {
+                std::reverse(ptr + i, ptr + i + elementSize);
+            }
+            break;
+    }
+}
+
+void util::readBytesIntoBuffer(const std::string& file, size_t offset, size_t bytes,
+                               bool littleEndian, size_t elementSize, void* dest) {
+    auto fin = openFile(file, offset);
+    OnScopeExit close([&fin]() { fin.close(); });
+
+    auto dst = static_cast<char*>(dest);
+    if (littleEndian || elementSize <= 1) {
+        readChunk(fin, file, dst, bytes);
+        return;
+    }
+
+    // Swap in place, the chunks have to contain whole elements
+    const auto chunkBytes = std::max<size_t>(1, chunkSize / elementSize) * elementSize;
+    forEachChunk(
+        bytes, chunkBytes,
+        [&](size_t begin, size_t size) { readChunk(fin, file, dst + begin, size); },
+        [dst, elementSize](size_t begin, size_t size) {
+            swapBytes(dst + begin, size, elementSize);
+        });
+}
+
+void util::readBytesIntoBuffer(const std::string& file, size_t offset, size_t count,
+                               bool littleEndian, const DataFormatBase* srcFormat,
+                               const DataFormatBase* dstFormat, void* dest) {
+    if (srcFormat->getComponents() != dstFormat->getComponents()) {
+        throw DataReaderException(
+            "Error: Can not convert from " + std::string(srcFormat->getString()) + " to " +
+                std::string(dstFormat->getString()) + ", the number of components differ",
+            IVW_CONTEXT_CUSTOM("readBytesIntoBuffer"));
+    }
+
+    const auto srcComp = componentFormat(srcFormat);
+    const auto dstComp = componentFormat(dstFormat);
+    const size_t srcCompSize = srcComp->getSize();
+    const size_t dstCompSize = dstComp->getSize();
+    const size_t components = count * srcFormat->getComponents();
+
+    if (srcFormat == dstFormat) {
+        readBytesIntoBuffer(file, offset, components * srcCompSize, littleEndian, srcCompSize,
+                            dest);
+        return;
+    }
+
+    auto fin = openFile(file, offset);
+    OnScopeExit close([&fin]() { fin.close(); });
+
+    // Here the chunks are counted in components, each chunk is read into a staging buffer that
+    // is swapped and converted into dest by the thread pool.
+    const auto chunkComponents = std::max<size_t>(1, chunkSize / srcCompSize);
+    const auto nChunks = (components + chunkComponents - 1) / chunkComponents;
+    std::vector<std::vector<char>> staging(nChunks);
+    const auto dstId = dstComp->getId();
+    auto dst = static_cast<char*>(dest);
+
+    forEachChunk(
+        components, chunkComponents,
+        [&](size_t begin, size_t size) {
+            auto& buffer = staging[begin / chunkComponents];
+            buffer.resize(size * srcCompSize);
+            readChunk(fin, file, buffer.data(), buffer.size());
+        },
+        [&staging, chunkComponents, littleEndian, srcComp, srcCompSize, dstCompSize, dstId,
+         dst](size_t begin, size_t size) {
+            auto& buffer = staging[begin / chunkComponents];
+            if (!littleEndian) swapBytes(buffer.data(), buffer.size(), srcCompSize);
+            dispatching::dispatch<void, dispatching::filter::Scalars>(
+                srcComp->getId(), Convert{}, buffer.data(), size, dstId,
+                static_cast<void*>(dst + begin * dstCompSize));
+            std::vector<char>{}.swap(buffer);
+        });
 }
 
 }  // namespace inviwo
@@ -41,15 +41,13 @@ RawVolumeRAMLoader* RawVolumeRAMLoader::clone() const { return new RawVolumeRAML
 std::shared_ptr<VolumeRepresentation> RawVolumeRAMLoader::createRepresentation(
     const VolumeRepresentation& src) const {
 
-    const auto size = glm::compMul(src.getDimensions()) * src.getDataFormat()->getSize();
-    auto data = std::make_unique<char[]>(size);
-    util::readBytesIntoBuffer(rawFile_, offset_, size, littleEndian_,
-                              src.getDataFormat()->getSize(), data.get());
-
-    auto volumeRAM =
-        createVolumeRAM(src.getDimensions(), src.getDataFormat(), data.get(), src.getSwizzleMask(),
-                        src.getInterpolation(), src.getWrapping());
-    data.release();
+    // all voxels are read from file, no need to clear the data
+    auto volumeRAM = createVolumeRAM(src.getDimensions(), src.getDataFormat(),
+                                     util::RAMInit::Uninitialized, src.getSwizzleMask(),
+                                     src.getInterpolation(), src.getWrapping());
+    util::readBytesIntoBuffer(rawFile_, offset_, volumeRAM->getNumberOfBytes(), littleEndian_,
+                              src.getDataFormat()->getSize() / src.getDataFormat()->getComponents(),
+                              volumeRAM->getData());
 
     return volumeRAM;
 }
@@ -64,7 +62,9 @@ void RawVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentati
 
     const auto size = glm::compMul(src.getDimensions());
     util::readBytesIntoBuffer(rawFile_, offset_, size * src.getDataFormat()->getSize(),
-                              littleEndian_, src.getDataFormat()->getSize(), volumeDst->getData());
+                              littleEndian_,
+                              src.getDataFormat()->getSize() / src.getDataFormat()->getComponents(),
+                              volumeDst->getData());
 
     volumeDst->setSwizzleMask(src.getSwizzleMask());
     volumeDst->setInterpolation(src.getInterpolation());
@@ -0,0 +1,208 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/network/evaluationscheduler.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/processornetworkevaluator.h>
+#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/util/stdextensions.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace inviwo {
+
+namespace {
+
+// weight of a new sample in the moving averages
+constexpr double smoothing = 0.25;
+
+void addSample(EvaluationScheduler::Duration& average, size_t& count,
+               EvaluationScheduler::Duration sample) {
+    average = count == 0 ? sample : average + (sample - average) * smoothing;
+    ++count;
+}
+
+}  // namespace
+
+EvaluationScheduler::EvaluationScheduler(ProcessorNetwork* network,
+                                         ProcessorNetworkEvaluator* evaluator,
+                                         TimerThread& timerThread)
+    : network_{network}
+    , evaluator_{evaluator}
+    , enabled_{true}
+    , interacting_{false}
+    , evaluating_{false}
+    , budget_{33}
+    , entries_{}
+    , processed_{}
+    , previews_{}
+    , evaluationStart_{}
+    , lastEvaluationTime_{0}
+    , idle_{Milliseconds{300}, [this]() { endInteraction(); }, timerThread} {
+
+    network_->addObserver(this);
+    evaluator_->addObserver(this);
+    network_->forEachProcessor([this](Processor* p) { onProcessorNetworkDidAddProcessor(p); });
+}
+
+EvaluationScheduler::~EvaluationScheduler() {
+    idle_.cancel();
+    for (auto p : previews_) p->setPreview(false);
+}
+
+void EvaluationScheduler::setEnabled(bool enabled) {
+    if (enabled_ == enabled) return;
+    enabled_ = enabled;
+    if (!enabled_ && interacting_) {
+        idle_.cancel();
+        endInteraction();
+    }
+}
+
+bool EvaluationScheduler::isEnabled() const { return enabled_; }
+
+void EvaluationScheduler::setFrameTimeBudget(Milliseconds budget) { budget_ = budget; }
+
+auto EvaluationScheduler::getFrameTimeBudget() const -> Milliseconds { return budget_; }
+
+void EvaluationScheduler::setIdleDelay(Milliseconds delay) { idle_.setDefaultDelay(delay); }
+
+auto EvaluationScheduler::getIdleDelay() const -> Milliseconds {
+    return idle_.getDefaultDelay();
+}
+
+void EvaluationScheduler::interact() {
+    if (!enabled_) return;
+    interacting_ = true;
+    idle_.start();
+}
+
+bool EvaluationScheduler::isInteracting() const { return interacting_; }
+
+auto EvaluationScheduler::getTiming(const Processor* processor) const -> const Timing* {
+    auto it = entries_.find(processor);
+    if (it == entries_.end() || it->second.timing.fullCount + it->second.timing.previewCount == 0) {
+        return nullptr;
+    }
+    return &it->second.timing;
+}
+
+auto EvaluationScheduler::getLastEvaluationTime() const -> Duration {
+    return lastEvaluationTime_;
+}
+
+void EvaluationScheduler::onProcessorNetworkDidAddProcessor(Processor* processor) {
+    processor->ProcessorObservable::addObserver(this);
+}
+
+void EvaluationScheduler::onProcessorNetworkWillRemoveProcessor(Processor* processor) {
+    processor->ProcessorObservable::removeObserver(this);
+    entries_.erase(processor);
+    util::erase_remove(processed_, processor);
+    util::erase_remove(previews_, processor);
+}
+
+void EvaluationScheduler::onAboutPropertyChange(Property*) {
+    // Changes made by the processors themselves or while loading a workspace are not interaction
+    if (evaluating_ || network_->isDeserializing()) return;
+    interact();
+}
+
+void EvaluationScheduler::onProcessorAboutToProcess(Processor* processor) {
+    entries_[processor].start = clock_t::now();
+}
+
+void EvaluationScheduler::onProcessorFinishedProcess(Processor* processor) {
+    auto& entry = entries_[processor];
+    const Duration time = clock_t::now() - entry.start;
+    if (processor->isPreview()) {
+        addSample(entry.timing.preview, entry.timing.previewCount, time);
+    } else {
+        addSample(entry.timing.full, entry.timing.fullCount, time);
+    }
+    processed_.push_back(processor);
+}
+
+void EvaluationScheduler::onProcessorNetworkEvaluationBegin() {
+    evaluating_ = true;
+    processed_.clear();
+    evaluationStart_ = clock_t::now();
+}
+
+void EvaluationScheduler::onProcessorNetworkEvaluationEnd() {
+    evaluating_ = false;
+    lastEvaluationTime_ = clock_t::now() - evaluationStart_;
+    if (enabled_ && interacting_) updatePreviews();
+}
+
+void EvaluationScheduler::updatePreviews() {
+    std::sort(processed_.begin(), processed_.end());
+    processed_.erase(std::unique(processed_.begin(), processed_.end()), processed_.end());
+
+    // The expected time of evaluating the same processors again in their current modes. The
+    // preview time of a processor that has not yet been processed in preview mode is unknown and
+    // assumed to be negligible, it is corrected by the next evaluation.
+    Duration expected{0};
+    std::vector<std::pair<Duration, Processor*>> candidates;
+    for (auto processor : processed_) {
+        const auto& timing = entries_[processor].timing;
+        if (processor->isPreview()) {
+            expected += timing.preview;
+        } else {
+            expected += timing.full;
+            if (processor->isPreviewSupported()) candidates.emplace_back(timing.full, processor);
+        }
+    }
+    if (expected <= budget_) return;
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (const auto& [full, processor] : candidates) {
+        if (expected <= budget_) break;
+        const auto& timing = entries_[processor].timing;
+        expected -= full - (timing.previewCount > 0 ? timing.preview : Duration{0});
+        processor->setPreview(true);
+        previews_.push_back(processor);
+    }
+}
+
+void EvaluationScheduler::endInteraction() {
+    interacting_ = false;
+    if (previews_.empty()) return;
+
+    NetworkLock lock(network_);
+    for (auto processor : std::exchange(previews_, {})) {
+        processor->setPreview(false);
+        processor->invalidate(InvalidationLevel::InvalidOutput);
+    }
+}
+
+}  // namespace inviwo
@@ -35,22 +35,70 @@
 #include <inviwo/core/network/networkutils.h>
 #include <inviwo/core/network/networklock.h>
 #include <inviwo/core/util/clock.h>
+#include <inviwo/core/util/threadarena.h>
+
+#include <algorithm>
+#include <functional>
+#include <unordered_set>
 
 namespace inviwo {
 
+namespace {
+
+bool isActive(Processor* p, Inport* from, Outport* to) { return p->isConnectionActive(from, to); }
+
+template <typename Func>
+void forEachActiveSuccessor(Processor* processor, Func f) {
+    for (auto outport : processor->getOutports()) {
+        for (auto inport : outport->getConnectedInports()) {
+            auto successor = inport->getProcessor();
+            if (successor->isConnectionActive(inport, outport)) f(successor);
+        }
+    }
+}
+
+template <typename Func>
+void forEachActivePredecessor(Processor* processor, Func f) {
+    for (auto inport : processor->getInports()) {
+        for (auto outport : inport->getConnectedOutports()) {
+            if (processor->isConnectionActive(inport, outport)) f(outport->getProcessor());
+        }
+    }
+}
+
+}  // namespace
+
 ProcessorNetworkEvaluator::ProcessorNetworkEvaluator(ProcessorNetwork* processorNetwork)
     : processorNetwork_(processorNetwork)
-    , processorsSorted_(util::topologicalSortFiltered(processorNetwork_))
+    , processorOrder_{}
+    , orderIndex_{}
+    , addedConnections_{}
+    , activeConnectionsChanged_{}
+    , orderModified_(true)
+    , fullSortNeeded_(true)
+    , demanded_{}
+    , dirty_{}
+    , isDirty_{}
+    , evaluationQueue_{}
+    , evaluating_(false)
+    , evaluationPosition_(0)
     , evaulationQueued_(false)
-    , exceptionHandler_(StandardEvaluationErrorHandler()) {
+    , exceptionHandler_(StandardEvaluationErrorHandler())
+    , lastEvaluationAllocations_{} {
 
     processorNetwork_->addObserver(this);
+    processorNetwork_->forEachProcessor(
+        [this](Processor* p) { onProcessorNetworkDidAddProcessor(p); });
 }
 
 void ProcessorNetworkEvaluator::setExceptionHandler(EvaluationErrorHandler handler) {
     exceptionHandler_ = handler;
 }
 
+const util::AllocationStats& ProcessorNetworkEvaluator::getLastEvaluationAllocations() const {
+    return lastEvaluationAllocations_;
+}
+
 void ProcessorNetworkEvaluator::onProcessorNetworkEvaluateRequest() {
     // Direct request, thus we don't want to queue the evaluation anymore
     evaulationQueued_ = false;
@@ -94,6 +142,8 @@ void ProcessorNetworkEvaluator::requestEvaluate() {
 }
 
 void ProcessorNetworkEvaluator::evaluate() {
+    util::AllocationCounter allocations;
+
     // lock processor network to avoid concurrent evaluation
     NetworkLock lock(processorNetwork_);
 
@@ -101,84 +151,296 @@ void ProcessorNetworkEvaluator::evaluate() {
 
     IVW_CPU_PROFILING_IF(500, "Evaluated Processor Network");
 
-    for (auto processor : processorsSorted_) {
-        if (!processor->isValid()) {
-            if (processor->isReady()) {
-                try {
-                    // re-initialize resources (e.g., shaders) if necessary
-                    if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
-                        processor->initializeResources();
-                    }
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::InitResource, IVW_CONTEXT);
-                    continue;
-                }
+    updateProcessorOrder();
 
-                try {
-                    // call onChange for all invalid inports
-                    for (auto inport : processor->getInports()) {
-                        inport->callOnChangeIfChanged();
-                    }
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::PortOnChange, IVW_CONTEXT);
-                    continue;
-                }
+    evaluationQueue_.clear();
+    for (auto processor : dirty_) {
+        if (demanded_.count(processor) != 0) evaluationQueue_.push_back(orderIndex_[processor]);
+    }
+    // an ascending sequence is a valid min-heap, dirty_ has no duplicates
+    std::sort(evaluationQueue_.begin(), evaluationQueue_.end());
+
+    // Processors invalidated during the evaluation are added to the queue by
+    // onProcessorInvalidationEnd if they come after the current position
+    {
+        util::KeepTrueWhileInScope evaluating{&evaluating_};
+        bool first = true;
+        while (!evaluationQueue_.empty()) {
+            std::pop_heap(evaluationQueue_.begin(), evaluationQueue_.end(), std::greater<>{});
+            const auto position = evaluationQueue_.back();
+            evaluationQueue_.pop_back();
+            // skip processors queued several times
+            if (!first && position <= evaluationPosition_) continue;
+            first = false;
+            evaluationPosition_ = position;
+
+            // removed processors are set to nullptr in processorOrder_
+            if (auto processor = processorOrder_[evaluationPosition_]) {
+                evaluateProcessor(processor);
+            }
+        }
+    }
+
+    // keep the processors that are still invalid, e.g. not ready or not demanded
+    util::erase_remove_if(dirty_, [this](Processor* p) {
+        if (!p->isValid()) return false;
+        isDirty_.erase(p);
+        return true;
+    });
+
+    notifyObserversProcessorNetworkEvaluationEnd();
 
-                processor->notifyObserversAboutToProcess(processor);
+    lastEvaluationAllocations_ = allocations.get();
+}
 
-                try {
-                    IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
-                    // do the actual processing
-                    processor->process();
+void ProcessorNetworkEvaluator::evaluateProcessor(Processor* processor) {
+    if (processor->isValid()) return;
 
-                    // Set processor as valid only if we still are ready.
-                    // Callbacks might have made our inports invalid, if so abort
-                    // the evaluation by not setting the processor valid.
-                    if (processor->isReady()) processor->setValid();
+    if (processor->isReady()) {
+        try {
+            // re-initialize resources (e.g., shaders) if necessary
+            if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
+                processor->initializeResources();
+            }
+        } catch (...) {
+            exceptionHandler_(processor, EvaluationType::InitResource, IVW_CONTEXT);
+            return;
+        }
 
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::Process, IVW_CONTEXT);
-                }
+        try {
+            // call onChange for all invalid inports
+            for (auto inport : processor->getInports()) {
+                inport->callOnChangeIfChanged();
+            }
+        } catch (...) {
+            exceptionHandler_(processor, EvaluationType::PortOnChange, IVW_CONTEXT);
+            return;
+        }
+
+        processor->notifyObserversAboutToProcess(processor);
+
+        try {
+            IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
+            // do the actual processing, temporary data from the arena is released afterwards
+            util::ArenaScope arena;
+            processor->process();
+
+            // Set processor as valid only if we still are ready.
+            // Callbacks might have made our inports invalid, if so abort
+            // the evaluation by not setting the processor valid.
+            if (processor->isReady()) processor->setValid();
 
-                processor->notifyObserversFinishedProcess(processor);
+        } catch (...) {
+            exceptionHandler_(processor, EvaluationType::Process, IVW_CONTEXT);
+        }
+
+        processor->notifyObserversFinishedProcess(processor);
 
-            } else {
-                try {
-                    processor->doIfNotReady();
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::NotReady, IVW_CONTEXT);
+    } else {
+        try {
+            processor->doIfNotReady();
+        } catch (...) {
+            exceptionHandler_(processor, EvaluationType::NotReady, IVW_CONTEXT);
+        }
+    }
+}
+
+void ProcessorNetworkEvaluator::updateProcessorOrder() {
+    if (!orderModified_) return;
+    orderModified_ = false;
+
+    // remove processors that are no longer in the network
+    if (processorOrder_.size() != orderIndex_.size()) {
+        util::erase_remove(processorOrder_, nullptr);
+        for (size_t i = 0; i < processorOrder_.size(); ++i) {
+            orderIndex_[processorOrder_[i]] = i;
+        }
+    }
+
+    // Inserting many edges one by one is slower than sorting everything once
+    constexpr size_t minBatchSize = 16;
+    const size_t changes = addedConnections_.size() + activeConnectionsChanged_.size();
+    if (changes > std::max(minBatchSize, processorOrder_.size() / 4)) fullSortNeeded_ = true;
+
+    if (!fullSortNeeded_) {
+        for (const auto& connection : addedConnections_) {
+            auto inport = connection.getInport();
+            auto outport = connection.getOutport();
+            if (inport->getProcessor()->isConnectionActive(inport, outport) &&
+                !insertEdge(outport->getProcessor(), inport->getProcessor())) {
+                fullSortNeeded_ = true;
+                break;
+            }
+        }
+    }
+    if (!fullSortNeeded_) {
+        for (auto processor : activeConnectionsChanged_) {
+            forEachActivePredecessor(processor, [&](Processor* predecessor) {
+                if (!fullSortNeeded_ && !insertEdge(predecessor, processor)) {
+                    fullSortNeeded_ = true;
                 }
+            });
+            if (fullSortNeeded_) break;
+        }
+    }
+    addedConnections_.clear();
+    activeConnectionsChanged_.clear();
+
+    if (fullSortNeeded_) {
+        fullSortNeeded_ = false;
+        sortAll();
+    }
+
+    // only processors connected to a sink are evaluated
+    demanded_.clear();
+    for (auto processor : processorOrder_) {
+        if (processor->isSink()) {
+            util::traverseNetwork<util::TraversalDirection::Up, util::VisitPattern::Post>(
+                demanded_, processor, [](Processor*) {}, isActive);
+        }
+    }
+}
+
+bool ProcessorNetworkEvaluator::insertEdge(Processor* src, Processor* dst) {
+    const auto srcIt = orderIndex_.find(src);
+    const auto dstIt = orderIndex_.find(dst);
+    if (srcIt == orderIndex_.end() || dstIt == orderIndex_.end()) return false;
+
+    const size_t lower = dstIt->second;
+    const size_t upper = srcIt->second;
+    if (upper < lower) return true;  // already in order
+    if (upper == lower) return false;
+
+    // Only processors strictly between dst and src can be affected. Bounding both searches keeps
+    // edges that are still pending in a batch from dragging in processors outside the region.
+    const auto inRegion = [&](Processor* p) {
+        const auto index = orderIndex_[p];
+        return index > lower && index < upper;
+    };
+
+    // processors in the affected region that have to stay after dst
+    std::vector<Processor*> forward{dst};
+    std::unordered_set<Processor*> visited{dst, src};
+    bool cycle = false;
+    for (size_t i = 0; i < forward.size() && !cycle; ++i) {
+        forEachActiveSuccessor(forward[i], [&](Processor* p) {
+            if (p == src) {
+                cycle = true;
+            } else if (inRegion(p) && visited.insert(p).second) {
+                forward.push_back(p);
             }
+        });
+    }
+    if (cycle) return false;
+
+    // processors in the affected region that have to stay before src
+    std::vector<Processor*> backward{src};
+    for (size_t i = 0; i < backward.size(); ++i) {
+        forEachActivePredecessor(backward[i], [&](Processor* p) {
+            if (inRegion(p) && visited.insert(p).second) backward.push_back(p);
+        });
+    }
+
+    // reuse the positions of the affected processors, placing all of backward before forward
+    const auto byIndex = [&](Processor* a, Processor* b) {
+        return orderIndex_[a] < orderIndex_[b];
+    };
+    std::sort(backward.begin(), backward.end(), byIndex);
+    std::sort(forward.begin(), forward.end(), byIndex);
+    std::vector<size_t> positions;
+    positions.reserve(backward.size() + forward.size());
+    for (auto p : backward) positions.push_back(orderIndex_[p]);
+    for (auto p : forward) positions.push_back(orderIndex_[p]);
+    std::sort(positions.begin(), positions.end());
+
+    auto position = positions.begin();
+    for (auto list : {&backward, &forward}) {
+        for (auto p : *list) {
+            processorOrder_[*position] = p;
+            orderIndex_[p] = *position;
+            ++position;
         }
     }
+    return true;
+}
 
-    notifyObserversProcessorNetworkEvaluationEnd();
+void ProcessorNetworkEvaluator::sortAll() {
+    const auto processors = processorNetwork_->getProcessors();
+
+    std::unordered_set<Processor*> state;
+    processorOrder_.clear();
+    const auto visit = [&](Processor* processor) {
+        util::traverseNetwork<util::TraversalDirection::Up, util::VisitPattern::Post>(
+            state, processor, [&](Processor* p) { processorOrder_.push_back(p); }, isActive);
+    };
+    // start with the sinks to get the same order as util::topologicalSortFiltered
+    for (auto processor : processors) {
+        if (processor->isSink()) visit(processor);
+    }
+    for (auto processor : processors) {
+        visit(processor);
+    }
+
+    orderIndex_.clear();
+    for (size_t i = 0; i < processorOrder_.size(); ++i) {
+        orderIndex_[processorOrder_[i]] = i;
+    }
 }
 
-void ProcessorNetworkEvaluator::onProcessorSinkChanged(Processor*) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+void ProcessorNetworkEvaluator::markDirty(Processor* processor) {
+    if (isDirty_.insert(processor).second) dirty_.push_back(processor);
 }
 
-void ProcessorNetworkEvaluator::onProcessorActiveConnectionsChanged(Processor*) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+void ProcessorNetworkEvaluator::onProcessorInvalidationEnd(Processor* p) {
+    if (p->isValid()) return;
+    markDirty(p);
+    if (evaluating_ && demanded_.count(p) != 0) {
+        auto it = orderIndex_.find(p);
+        if (it != orderIndex_.end() && it->second > evaluationPosition_) {
+            evaluationQueue_.push_back(it->second);
+            std::push_heap(evaluationQueue_.begin(), evaluationQueue_.end(), std::greater<>{});
+        }
+    }
+}
+
+void ProcessorNetworkEvaluator::onProcessorSinkChanged(Processor*) { orderModified_ = true; }
+
+void ProcessorNetworkEvaluator::onProcessorActiveConnectionsChanged(Processor* p) {
+    activeConnectionsChanged_.push_back(p);
+    orderModified_ = true;
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidAddProcessor(Processor* p) {
     p->ProcessorObservable::addObserver(this);
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    orderIndex_[p] = processorOrder_.size();
+    processorOrder_.push_back(p);
+    markDirty(p);
+    orderModified_ = true;
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveProcessor(Processor* p) {
     p->ProcessorObservable::removeObserver(this);
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    auto it = orderIndex_.find(p);
+    if (it != orderIndex_.end()) {
+        processorOrder_[it->second] = nullptr;
+        orderIndex_.erase(it);
+    }
+    util::erase_remove(activeConnectionsChanged_, p);
+    demanded_.erase(p);
+    if (isDirty_.erase(p) != 0) util::erase_remove(dirty_, p);
+    orderModified_ = true;
 }
 
-void ProcessorNetworkEvaluator::onProcessorNetworkDidAddConnection(const PortConnection&) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+void ProcessorNetworkEvaluator::onProcessorNetworkDidAddConnection(
+    const PortConnection& connection) {
+    addedConnections_.push_back(connection);
+    orderModified_ = true;
 }
 
-void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveConnection(const PortConnection&) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveConnection(
+    const PortConnection& connection) {
+    util::erase_remove(addedConnections_, connection);
+    orderModified_ = true;
 }
 
 }  // namespace inviwo
@@ -43,6 +43,7 @@
 #include <inviwo/core/util/dialogfactory.h>
 #include <inviwo/core/io/imagewriterutil.h>
 #include <inviwo/core/network/networklock.h>
+#include <inviwo/core/interaction/events/resizeevent.h>
 
 namespace inviwo {
 
@@ -60,6 +61,10 @@ CanvasProcessor::CanvasProcessor(InviwoApplication* app)
     , keepAspectRatio_("keepAspectRatio", "Lock Aspect Ratio", true, InvalidationLevel::Valid)
     , aspectRatioScaling_("aspectRatioScaling", "Image Scale", 1.f, 0.1f, 4.f, 0.01f,
                           InvalidationLevel::Valid)
+    , progressiveResize_("progressiveResize", "Progressive Resize", false,
+                         InvalidationLevel::Valid)
+    , progressiveResizeScale_("progressiveResizeScale", "Progressive Resize Scale", 0.5f, 0.1f,
+                              1.0f, 0.01f, InvalidationLevel::Valid)
     , position_("position", "Canvas Position", ivec2(128, 128),
                 ivec2(std::numeric_limits<int>::lowest()), ivec2(std::numeric_limits<int>::max()),
                 ivec2(1, 1), InvalidationLevel::Valid, PropertySemantics::Text)
@@ -108,6 +113,17 @@ CanvasProcessor::CanvasProcessor(InviwoApplication* app)
     , allowContextMenu_("allowContextMenu", "Allow Context Menu", true)
     , evaluateWhenHidden_("evaluateWhenHidden", "Evaluate When Hidden", false)
     , previousImageSize_(customInputDimensions_)
+    , progressiveSize_{0}
+    , lastResize_{}
+    , progressiveResizeDelay_{std::chrono::milliseconds{200},
+                              [this]() {
+                                  // Resizing has settled, request the full resolution image.
+                                  NetworkLock lock(this);
+                                  ResizeEvent resizeEvent{dimensions_, progressiveSize_};
+                                  progressiveSize_ = size2_t{0};
+                                  inport_.propagateEvent(&resizeEvent, nullptr);
+                                  invalidate(InvalidationLevel::InvalidOutput);
+                              }}
     , widgetMetaData_{
           createMetaData<ProcessorWidgetMetaData>(ProcessorWidgetMetaData::CLASS_IDENTIFIER)} {
     widgetMetaData_->addObserver(this);
@@ -130,6 +146,12 @@ CanvasProcessor::CanvasProcessor(InviwoApplication* app)
     aspectRatioScaling_.onChange([this]() { sizeChanged(); });
     aspectRatioScaling_.setVisible(false);
 
+    progressiveResize_.onChange([this]() {
+        progressiveResizeScale_.setVisible(progressiveResize_);
+        if (!progressiveResize_) progressiveResizeDelay_.cancel();
+    });
+    progressiveResizeScale_.setVisible(false);
+
     position_.onChange([this]() { widgetMetaData_->setPosition(position_.get()); });
 
     colorLayer_.setSerializationMode(PropertySerializationMode::All);
@@ -153,7 +175,8 @@ CanvasProcessor::CanvasProcessor(InviwoApplication* app)
     imageTypeExt_.setSerializationMode(PropertySerializationMode::None);
 
     inputSize_.addProperties(dimensions_, enableCustomInputDimensions_, customInputDimensions_,
-                             keepAspectRatio_, aspectRatioScaling_);
+                             keepAspectRatio_, aspectRatioScaling_, progressiveResize_,
+                             progressiveResizeScale_);
 
     addProperties(inputSize_, position_, visibleLayer_, colorLayer_, saveLayerDirectory_,
                   imageTypeExt_, saveLayerButton_, saveLayerToFileButton_, fullScreen_,
@@ -335,7 +358,7 @@ void CanvasProcessor::propagateEvent(Event* event, Outport* source) {
         dimensions_.set(resizeEvent->size());
         if (enableCustomInputDimensions_) {
             sizeChanged();
-        } else {
+        } else if (!progressiveResize(*resizeEvent)) {
             inport_.propagateEvent(resizeEvent, nullptr);
             // Make sure this processor is invalidated.
             invalidate(InvalidationLevel::InvalidOutput);
@@ -353,6 +376,28 @@ void CanvasProcessor::propagateEvent(Event* event, Outport* source) {
     }
 }
 
+bool CanvasProcessor::progressiveResize(const ResizeEvent& resizeEvent) {
+    const auto now = std::chrono::steady_clock::now();
+    const bool continuous = now - lastResize_ < progressiveResizeDelay_.getDefaultDelay();
+    lastResize_ = now;
+
+    if (!progressiveResize_ || !continuous) {
+        progressiveResizeDelay_.cancel();
+        progressiveSize_ = size2_t{0};
+        return false;
+    }
+
+    const size2_t reduced{
+        glm::max(size2_t{1}, size2_t{vec2{resizeEvent.size()} * progressiveResizeScale_.get()})};
+    ResizeEvent reducedEvent{reduced, progressiveSize_ == size2_t{0} ? resizeEvent.previousSize()
+                                                                     : progressiveSize_};
+    progressiveSize_ = reduced;
+    inport_.propagateEvent(&reducedEvent, nullptr);
+    invalidate(InvalidationLevel::InvalidOutput);
+    progressiveResizeDelay_.start();
+    return true;
+}
+
 bool CanvasProcessor::isContextMenuAllowed() const { return allowContextMenu_; }
 
 void CanvasProcessor::setEvaluateWhenHidden(bool value) {
@@ -301,6 +301,17 @@ bool Processor::isSink() const { return isSink_; }
 
 bool Processor::isReady() const { return isReady_; }
 
+bool Processor::isPreviewSupported() const { return previewSupported_; }
+
+bool Processor::isPreview() const { return preview_; }
+
+void Processor::setPreview(bool preview) { preview_ = previewSupported_ && preview; }
+
+void Processor::setPreviewSupported(bool supported) {
+    previewSupported_ = supported;
+    if (!supported) preview_ = false;
+}
+
 bool Processor::allInportsAreReady() const {
     return util::all_of(inports_, [](Inport* p) { return p->isReady() || p->isOptional(); });
 }
@@ -162,7 +162,7 @@ void Property::clearInitiatingWidget() { initiatingWidget_ = nullptr; }
 void Property::updateWidgets() {
     for (auto& elem : propertyWidgets_) {
         if (elem != nullptr && elem != initiatingWidget_) {
-            elem->updateFromProperty();
+            elem->requestUpdateFromProperty();
         }
     }
 }
@@ -42,6 +42,8 @@ PropertyWidget::~PropertyWidget() {
     if (property_) property_->deregisterWidget(this);
 }
 
+void PropertyWidget::requestUpdateFromProperty() { updateFromProperty(); }
+
 Property* PropertyWidget::getProperty() { return property_; }
 
 PropertyEditorWidget* PropertyWidget::getEditorWidget() const { return nullptr; }
@@ -0,0 +1,102 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/io/bytereaderutil.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/util/formats.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+std::string writeBigEndian(const std::vector<std::uint16_t>& data, const std::string& name) {
+    const auto file = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream out(file, std::ios::binary);
+    for (auto v : data) {
+        const char bytes[2] = {static_cast<char>(v >> 8), static_cast<char>(v & 0xFF)};
+        out.write(bytes, 2);
+    }
+    return file;
+}
+
+}  // namespace
+
+TEST(ByteReaderUtil, SwapBytes) {
+    std::uint32_t v32 = 0x01020304u;
+    util::swapBytes(&v32, sizeof(v32), sizeof(v32));
+    EXPECT_EQ(v32, 0x04030201u);
+
+    std::uint64_t v64 = 0x0102030405060708ull;
+    util::swapBytes(&v64, sizeof(v64), sizeof(v64));
+    EXPECT_EQ(v64, 0x0807060504030201ull);
+
+    char v3[6] = {1, 2, 3, 4, 5, 6};
+    util::swapBytes(v3, 6, 3);
+    EXPECT_EQ(v3[0], 3);
+    EXPECT_EQ(v3[2], 1);
+    EXPECT_EQ(v3[3], 6);
+    EXPECT_EQ(v3[5], 4);
+}
+
+TEST(ByteReaderUtil, ReadBigEndian) {
+    std::vector<std::uint16_t> data(100000);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<std::uint16_t>(i * 7);
+    const auto file = writeBigEndian(data, "inviwo-bytereaderutil-test.raw");
+
+    std::vector<std::uint16_t> result(data.size());
+    util::readBytesIntoBuffer(file, 0, result.size() * 2, false, 2, result.data());
+    EXPECT_EQ(result, data);
+
+    std::vector<float> converted(data.size() / 2);
+    util::readBytesIntoBuffer(file, 2, converted.size() / 2, false, DataVec2UInt16::get(),
+                              DataVec2Float32::get(), converted.data());
+    for (size_t i = 0; i < converted.size(); ++i) {
+        EXPECT_EQ(converted[i], static_cast<float>(data[i + 1]));
+    }
+
+    EXPECT_THROW(util::readBytesIntoBuffer(file, 0, data.size(), false, DataVec2UInt16::get(),
+                                           DataFloat32::get(), converted.data()),
+                 DataReaderException);
+    EXPECT_THROW(util::readBytesIntoBuffer(file, 2, data.size() * 2, false, 2, result.data()),
+                 DataReaderException);
+
+    std::filesystem::remove(file);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,142 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/canvas.h>
+#include <inviwo/core/util/settings/systemsettings.h>
+#include <inviwo/core/interaction/events/eventpropagator.h>
+#include <inviwo/core/interaction/events/mouseevent.h>
+#include <inviwo/core/interaction/events/resizeevent.h>
+
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+struct TestCanvas : Canvas {
+    TestCanvas() : Canvas(size2_t{8, 8}) {}
+
+    virtual void render(std::shared_ptr<const Image>, LayerType, size_t) override {}
+    virtual size2_t getImageDimensions() const override { return getCanvasDimensions(); }
+    virtual void update() override {}
+    virtual void activate() override {}
+    virtual std::unique_ptr<Canvas> createHiddenCanvas() override { return nullptr; }
+    virtual ContextID activeContext() const override { return nullptr; }
+    virtual ContextID contextId() const override { return nullptr; }
+    virtual void releaseContext() override {}
+
+protected:
+    virtual void setFullScreenInternal(bool) override {}
+};
+
+struct TestPropagator : EventPropagator {
+    virtual void propagateEvent(Event* event, Outport*) override {
+        if (auto re = event->getAs<ResizeEvent>()) {
+            resizes.push_back(*re);
+        } else if (auto me = event->getAs<MouseEvent>()) {
+            mouse.push_back(*me);
+        }
+    }
+    std::vector<ResizeEvent> resizes;
+    std::vector<MouseEvent> mouse;
+};
+
+MouseEvent mouseEvent(MouseState state, double x) {
+    return MouseEvent(MouseButton::None, state, MouseButtons(flags::empty),
+                      KeyModifiers(flags::empty), dvec2{x, 0.5}, uvec2{8, 8});
+}
+
+}  // namespace
+
+TEST(Canvas, CoalesceEvents) {
+    auto app = InviwoApplication::getPtr();
+    auto& coalesce = app->getSystemSettings().coalesceCanvasEvents_;
+    const bool oldCoalesce = coalesce.get();
+    coalesce.set(true);
+
+    TestCanvas canvas;
+    TestPropagator propagator;
+    canvas.setEventPropagator(&propagator);
+
+    {
+        SCOPED_TRACE("Resize");
+        canvas.resize(size2_t{10, 10});
+        canvas.resize(size2_t{20, 20});
+        canvas.resize(size2_t{30, 30});
+        EXPECT_TRUE(propagator.resizes.empty());
+        app->processFront();
+        ASSERT_EQ(propagator.resizes.size(), size_t{1});
+        EXPECT_EQ(propagator.resizes[0].size(), size2_t(30, 30));
+        EXPECT_EQ(propagator.resizes[0].previousSize(), size2_t(8, 8));
+    }
+
+    {
+        SCOPED_TRACE("Mouse move");
+        for (const auto x : {0.1, 0.2, 0.3}) {
+            auto move = mouseEvent(MouseState::Move, x);
+            canvas.propagateEvent(&move);
+            EXPECT_TRUE(move.hasBeenUsed());
+        }
+        EXPECT_TRUE(propagator.mouse.empty());
+        app->processFront();
+        ASSERT_EQ(propagator.mouse.size(), size_t{1});
+        EXPECT_EQ(propagator.mouse[0].posNormalized(), dvec2(0.3, 0.5));
+    }
+
+    {
+        SCOPED_TRACE("Other events flush pending moves first");
+        propagator.mouse.clear();
+        auto move = mouseEvent(MouseState::Move, 0.4);
+        canvas.propagateEvent(&move);
+        auto press = mouseEvent(MouseState::Press, 0.5);
+        canvas.propagateEvent(&press);
+        ASSERT_EQ(propagator.mouse.size(), size_t{2});
+        EXPECT_EQ(propagator.mouse[0].state(), MouseState::Move);
+        EXPECT_EQ(propagator.mouse[1].state(), MouseState::Press);
+        app->processFront();
+        EXPECT_EQ(propagator.mouse.size(), size_t{2});
+    }
+
+    const auto& metrics = canvas.getEventMetrics();
+    EXPECT_EQ(metrics.resizeEvents, size_t{3});
+    EXPECT_EQ(metrics.resizePropagations, size_t{1});
+    EXPECT_EQ(metrics.moveEvents, size_t{4});
+    EXPECT_EQ(metrics.movePropagations, size_t{2});
+    EXPECT_EQ(metrics.skippedPropagations(), size_t{4});
+
+    coalesce.set(oldCoalesce);
+}
+
+}  // namespace inviwo
@@ -39,11 +39,19 @@
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/network/processornetworkevaluator.h>
 #include <inviwo/core/network/networklock.h>
+#include <inviwo/core/network/evaluationscheduler.h>
 
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/ports/dataoutport.h>
 
+#include <inviwo/core/util/allocationcounter.h>
+
+#include <algorithm>
+#include <chrono>
 #include <functional>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace inviwo {
 
@@ -66,6 +74,13 @@ struct TestProcessor : Processor {
         if (onDoIfNotReady) onDoIfNotReady(*this);
     }
 
+    void setSink(bool sink) {
+        isSink_.setUpdate([sink]() { return sink; });
+        isSink_.update();
+    }
+
+    void enablePreview() { setPreviewSupported(true); }
+
     std::function<void(TestProcessor&)> onInitializeResources;
     std::function<void(TestProcessor&)> onProcess;
     std::function<void(TestProcessor&)> onDoIfNotReady;
@@ -257,4 +272,248 @@ TEST(NetworkEvaluator, Error) {
     }
 }
 
+const auto createNode = [](const std::string& id, std::vector<std::string>& processed) {
+    auto pt = std::make_unique<TestProcessor>(id);
+    pt->addPort(std::make_unique<DataInport<int>>("in"));
+    pt->addPort(std::make_unique<DataOutport<int>>("out"));
+    pt->onProcess = [&processed](TestProcessor& p) {
+        processed.push_back(p.getIdentifier());
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(0));
+    };
+    return pt;
+};
+
+TEST(NetworkEvaluator, Order) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+
+    std::vector<std::string> processed;
+
+    auto a = network.addProcessor(createA());
+    static_cast<TestProcessor*>(a)->onProcess = [&processed](TestProcessor& p) {
+        processed.push_back(p.getIdentifier());
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(0));
+    };
+
+    auto connect = [&](Processor* src, Processor* dst) {
+        network.addConnection(src->getOutports()[0], dst->getInports()[0]);
+    };
+
+    {
+        SCOPED_TRACE("Connections added one by one");
+        // add the processors in reverse order to make the insertion order differ from the
+        // topological order
+        auto sink = network.addProcessor(createB());
+        auto n2 = network.addProcessor(createNode("n2", processed));
+        auto n1 = network.addProcessor(createNode("n1", processed));
+        connect(n2, sink);
+        connect(n1, n2);
+        processed.clear();
+        connect(a, n1);
+        EXPECT_EQ(processed, (std::vector<std::string>{"a", "n1", "n2"}));
+    }
+
+    {
+        SCOPED_TRACE("Connections added while locked");
+        std::vector<Processor*> nodes;
+        std::vector<std::string> expected;
+        {
+            NetworkLock lock(&network);
+            for (int i = 0; i < 50; ++i) {
+                const auto id = "m" + std::to_string(i);
+                nodes.push_back(network.addProcessor(createNode(id, processed)));
+                expected.push_back(id);
+            }
+            for (int i = 49; i > 0; --i) {
+                connect(nodes[i - 1], nodes[i]);
+            }
+            connect(nodes[49], network.addProcessor(createB()));
+            processed.clear();
+            connect(a, nodes[0]);
+            EXPECT_TRUE(processed.empty());
+        }
+        std::vector<std::string> chain;
+        std::copy_if(processed.begin(), processed.end(), std::back_inserter(chain),
+                     [](const std::string& id) { return id[0] == 'm'; });
+        EXPECT_EQ(chain, expected);
+    }
+
+    {
+        SCOPED_TRACE("Small batch added while locked");
+        // the edges are reordered one at a time, while all of them are already in the network
+        {
+            NetworkLock lock(&network);
+            auto x = network.addProcessor(createNode("x", processed));
+            auto y = network.addProcessor(createNode("y", processed));
+            auto z = network.addProcessor(createNode("z", processed));
+            auto w = network.addProcessor(createNode("w", processed));
+            connect(x, z);
+            connect(y, x);
+            connect(w, y);
+            connect(z, network.addProcessor(createB()));
+            processed.clear();
+            connect(a, w);
+        }
+        std::vector<std::string> chain;
+        std::copy_if(processed.begin(), processed.end(), std::back_inserter(chain),
+                     [](const std::string& id) { return id.find_first_of("xyzw") == 0; });
+        EXPECT_EQ(chain, (std::vector<std::string>{"w", "y", "x", "z"}));
+    }
+}
+
+TEST(NetworkEvaluator, Demand) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+
+    auto a = static_cast<TestProcessor*>(network.addProcessor(createA()));
+    Instrument ai(*a);
+    a->onProcess = [func = a->onProcess](TestProcessor& p) {
+        func(p);
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(0));
+    };
+
+    auto b1 = static_cast<TestProcessor*>(network.addProcessor(createB()));
+    Instrument b1i(*b1);
+    auto b2 = static_cast<TestProcessor*>(network.addProcessor(createB()));
+    Instrument b2i(*b2);
+
+    {
+        SCOPED_TRACE("Sink not demanded");
+        b2->setSink(false);
+        network.addConnection(a->getOutports()[0], b1->getInports()[0]);
+        network.addConnection(a->getOutports()[0], b2->getInports()[0]);
+        ai.checkAndReset(1, 1, 0);
+        b1i.checkAndReset(1, 1, 0);
+        b2i.checkAndReset(0, 0, 0);
+        EXPECT_FALSE(b2->isValid());
+    }
+    {
+        SCOPED_TRACE("Only the demanded branch is evaluated");
+        a->invalidate(InvalidationLevel::InvalidOutput);
+        ai.checkAndReset(0, 1, 0);
+        b1i.checkAndReset(0, 1, 0);
+        b2i.checkAndReset(0, 0, 0);
+    }
+    {
+        SCOPED_TRACE("No sink demanded");
+        b1->setSink(false);
+        a->invalidate(InvalidationLevel::InvalidOutput);
+        ai.checkAndReset(0, 0, 0);
+        b1i.checkAndReset(0, 0, 0);
+        b2i.checkAndReset(0, 0, 0);
+    }
+    {
+        SCOPED_TRACE("Sink demanded again");
+        b2->setSink(true);
+        b2->invalidate(InvalidationLevel::InvalidOutput);
+        ai.checkAndReset(0, 1, 0);
+        b1i.checkAndReset(0, 0, 0);
+        b2i.checkAndReset(1, 1, 0);
+        EXPECT_TRUE(b2->isValid());
+        EXPECT_FALSE(b1->isValid());
+    }
+}
+
+TEST(NetworkEvaluator, Allocations) {
+    if (!util::isAllocationCountingEnabled()) {
+        GTEST_SKIP() << "Needs IVW_CFG_ALLOCATION_COUNTING";
+    }
+
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+
+    // the processors reuse the same data to not allocate themselves
+    const auto data = std::make_shared<const int>(0);
+    const auto setData = [&data](TestProcessor& p) {
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(data);
+    };
+
+    auto a = static_cast<TestProcessor*>(network.addProcessor(createA()));
+    a->onProcess = setData;
+
+    auto prev = static_cast<Processor*>(a);
+    for (int i = 0; i < 10; ++i) {
+        auto node = std::make_unique<TestProcessor>("n" + std::to_string(i));
+        node->addPort(std::make_unique<DataInport<int>>("in"));
+        node->addPort(std::make_unique<DataOutport<int>>("out"));
+        node->onProcess = setData;
+        auto current = network.addProcessor(std::move(node));
+        network.addConnection(prev->getOutports()[0], current->getInports()[0]);
+        prev = current;
+    }
+
+    auto sink = std::make_unique<TestProcessor>("sink");
+    auto inport = &sink->addPort(std::make_unique<FlatMultiDataInport<int>>("in"));
+    int sum = 0;
+    sink->onProcess = [&](TestProcessor&) {
+        for (const auto& value : *inport) sum += *value;
+    };
+    network.addProcessor(std::move(sink));
+    network.addConnection(prev->getOutports()[0], inport);
+    network.addConnection(a->getOutports()[0], inport);
+
+    // the first evaluations after changing the network might allocate
+    a->invalidate(InvalidationLevel::InvalidOutput);
+    a->invalidate(InvalidationLevel::InvalidOutput);
+
+    util::AllocationCounter counter;
+    a->invalidate(InvalidationLevel::InvalidOutput);
+    EXPECT_EQ(counter.get().allocations, size_t{0});
+    EXPECT_EQ(evaluator.getLastEvaluationAllocations().allocations, size_t{0});
+    EXPECT_TRUE(inport->getProcessor()->isValid());
+}
+
+TEST(EvaluationScheduler, PreviewWhileInteracting) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    EvaluationScheduler scheduler{&network, &evaluator};
+    scheduler.setEnabled(true);
+    scheduler.setFrameTimeBudget(std::chrono::milliseconds{1});
+    scheduler.setIdleDelay(std::chrono::milliseconds{60000});
+
+    auto at = createA();
+    auto a = at.get();
+    a->enablePreview();
+    a->onProcess = [](TestProcessor& p) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{p.isPreview() ? 0 : 5});
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(0));
+    };
+    auto bt = createB();
+    auto b = bt.get();
+
+    network.addProcessor(std::move(at));
+    network.addProcessor(std::move(bt));
+    network.addConnection(a->getOutports()[0], b->getInports()[0]);
+    {
+        SCOPED_TRACE("Not interacting");
+        EXPECT_FALSE(a->isPreview());
+        ASSERT_NE(scheduler.getTiming(a), nullptr);
+        EXPECT_EQ(scheduler.getTiming(a)->fullCount, size_t{1});
+        EXPECT_GE(scheduler.getTiming(a)->full, std::chrono::milliseconds{5});
+    }
+    {
+        SCOPED_TRACE("Interacting, over budget");
+        scheduler.interact();
+        a->invalidate(InvalidationLevel::InvalidOutput);
+        EXPECT_TRUE(scheduler.isInteracting());
+        EXPECT_TRUE(a->isPreview());
+        EXPECT_FALSE(b->isPreview());
+        EXPECT_EQ(scheduler.getTiming(a)->fullCount, size_t{2});
+    }
+    {
+        SCOPED_TRACE("Preview");
+        a->invalidate(InvalidationLevel::InvalidOutput);
+        EXPECT_TRUE(a->isPreview());
+        EXPECT_EQ(scheduler.getTiming(a)->previewCount, size_t{1});
+    }
+    {
+        SCOPED_TRACE("Disabled");
+        scheduler.setEnabled(false);
+        EXPECT_FALSE(scheduler.isInteracting());
+        EXPECT_FALSE(a->isPreview());
+        // switching back to full quality invalidates the processor
+        EXPECT_EQ(scheduler.getTiming(a)->fullCount, size_t{3});
+    }
+}
+
 }  // namespace inviwo
@@ -87,6 +87,70 @@ TEST(PickingTests, Unique) {
     EXPECT_EQ(colors.size(), ncolors);
 }
 
+TEST(PickingTests, RGBA) {
+    EXPECT_EQ(PickingManager::indexToRGBA(1), uvec4(0, 0, 128, 255));
+    EXPECT_EQ(PickingManager::colorToIndex(uvec4(0, 0, 0, 0)), 0);
+    EXPECT_EQ(PickingManager::colorToIndex(uvec4(0, 0, 128, 0)), 0);
+
+    for (size_t i : {size_t{1}, size_t{12345}, (size_t{1} << 24) - 1, size_t{1} << 24,
+                     size_t{123456789}, size_t{3000000000}, PickingManager::maxIndex}) {
+        const auto c = PickingManager::indexToRGBA(i);
+        EXPECT_NE(c.a, 0u);
+        EXPECT_EQ(PickingManager::colorToIndex(c), i);
+        if (i < (size_t{1} << 24)) {
+            EXPECT_EQ(uvec3(c), PickingManager::indexToColor(i));
+            EXPECT_EQ(c.a, 255u);
+        }
+    }
+}
+
+TEST(PickingManagerTests, RegisterAndLookup) {
+    PickingManager manager;
+    std::vector<PickingAction*> actions;
+    for (size_t i = 0; i < 2000; ++i) {
+        actions.push_back(manager.registerPickingAction(nullptr, [](PickingEvent*) {}, 1 + i % 7));
+    }
+
+    for (auto action : actions) {
+        EXPECT_TRUE(manager.isPickingActionRegistered(action));
+        for (size_t i = 0; i < action->getSize(); ++i) {
+            const auto res = manager.getPickingActionFromIndex(action->getPickingId(i));
+            EXPECT_EQ(res.action, action);
+            EXPECT_EQ(res.getLocalPickingId(), i);
+        }
+    }
+    EXPECT_EQ(manager.getPickingActionFromIndex(0).action, nullptr);
+    const auto last = actions.back()->getPickingId(actions.back()->getSize() - 1);
+    EXPECT_EQ(manager.getPickingActionFromIndex(last + 1).action, nullptr);
+}
+
+TEST(PickingManagerTests, Reuse) {
+    PickingManager manager;
+    auto a = manager.registerPickingAction(nullptr, [](PickingEvent*) {}, 100);
+    auto b = manager.registerPickingAction(nullptr, [](PickingEvent*) {}, 50);
+    auto c = manager.registerPickingAction(nullptr, [](PickingEvent*) {}, 10);
+
+    EXPECT_TRUE(manager.unregisterPickingAction(a));
+    EXPECT_FALSE(manager.unregisterPickingAction(a));
+    EXPECT_TRUE(manager.unregisterPickingAction(b));
+
+    // The smallest unused action with enough capacity is reused.
+    auto d = manager.registerPickingAction(nullptr, [](PickingEvent*) {}, 20);
+    EXPECT_EQ(d, b);
+    EXPECT_EQ(d->getSize(), 20);
+    EXPECT_EQ(manager.getPickingActionFromIndex(d->getPickingId(19)).action, d);
+
+    // Removing the last action also releases the unused actions before it.
+    EXPECT_TRUE(manager.unregisterPickingAction(c));
+    EXPECT_TRUE(manager.unregisterPickingAction(d));
+    EXPECT_FALSE(manager.isPickingActionRegistered(a));
+
+    auto e = manager.registerPickingAction(nullptr, [](PickingEvent*) {}, 5000);
+    EXPECT_EQ(e->getPickingId(0), 1);
+    EXPECT_EQ(manager.getPickingActionFromIndex(4000).action, e);
+    EXPECT_EQ(manager.getPickingActionFromIndex(5001).action, nullptr);
+}
+
 TEST(PickingMapperTests, Create) {
     PickingManager manager;
     PickingMapper mapper(
@@ -0,0 +1,125 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/ramallocator.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+namespace inviwo {
+
+TEST(RAMAllocator, Alignment) {
+    for (size_t bytes : {size_t{1}, size_t{100}, size_t{4} << 20}) {
+        auto data = util::allocateRAMData<char>(bytes, util::RAMInit::Uninitialized);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(data.get()) %
+                      util::ramAllocatorSettings().alignment,
+                  std::uintptr_t{0});
+    }
+}
+
+TEST(RAMAllocator, Zero) {
+    const size_t size = 12345;
+    auto data = util::allocateRAMData<float>(size, util::RAMInit::Zero);
+    EXPECT_TRUE(std::all_of(data.get(), data.get() + size, [](float v) { return v == 0.0f; }));
+}
+
+TEST(RAMAllocator, ParallelFirstTouch) {
+    const auto prevSettings = util::ramAllocatorSettings();
+    auto settings = prevSettings;
+    settings.parallelFirstTouch = true;
+    settings.parallelTouchThreshold = 1 << 20;
+    util::setRAMAllocatorSettings(settings);
+
+    const size_t size = (size_t{16} << 20) + 3;
+    auto data = util::allocateRAMData<std::uint8_t>(size, util::RAMInit::Zero);
+    EXPECT_TRUE(std::all_of(data.get(), data.get() + size, [](auto v) { return v == 0; }));
+
+    util::setRAMAllocatorSettings(prevSettings);
+}
+
+TEST(RAMAllocator, Representations) {
+    VolumeRAMPrecision<float> volume(size3_t{8, 9, 10});
+    const auto begin = volume.getDataTyped();
+    const auto end = begin + glm::compMul(volume.getDimensions());
+    EXPECT_TRUE(std::all_of(begin, end, [](float v) { return v == 0.0f; }));
+    std::iota(begin, end, 0.0f);
+
+    auto copy = std::unique_ptr<VolumeRAMPrecision<float>>(volume.clone());
+    EXPECT_TRUE(std::equal(begin, end, copy->getDataTyped()));
+
+    // data handed over from outside is released with delete[]
+    VolumeRAMPrecision<float> external(new float[8], size3_t{2, 2, 2});
+    external.setData(new float[27], size3_t{3, 3, 3});
+    EXPECT_EQ(external.getDimensions(), size3_t(3, 3, 3));
+
+    LayerRAMPrecision<float> depth(size2_t{7, 5}, LayerType::Depth);
+    EXPECT_TRUE(std::all_of(depth.getDataTyped(), depth.getDataTyped() + 35,
+                            [](float v) { return v == 1.0f; }));
+}
+
+TEST(RAMAllocator, CopyOnWrite) {
+    VolumeRAMPrecision<float> volume(size3_t{4, 4, 4});
+    volume.getDataTyped()[0] = 1.0f;
+
+    auto copy = std::unique_ptr<VolumeRAMPrecision<float>>(volume.clone());
+    const auto& constVolume = volume;
+    const auto& constCopy = *copy;
+    EXPECT_EQ(constCopy.getDataTyped(), constVolume.getDataTyped());
+
+    copy->getDataTyped()[0] = 2.0f;
+    EXPECT_NE(constCopy.getDataTyped(), constVolume.getDataTyped());
+    EXPECT_EQ(volume.getAsDouble(size3_t{0}), 1.0);
+    EXPECT_EQ(copy->getAsDouble(size3_t{0}), 2.0);
+
+    LayerRAMPrecision<float> layer(size2_t{3, 3});
+    LayerRAMPrecision<float> layerCopy(layer);
+    layerCopy.setFromDouble(size2_t{1, 1}, 5.0);
+    EXPECT_EQ(layer.getAsDouble(size2_t{1, 1}), 0.0);
+    EXPECT_EQ(layerCopy.getAsDouble(size2_t{1, 1}), 5.0);
+
+    BufferRAMPrecision<float> buffer(std::vector<float>{1.0f, 2.0f, 3.0f});
+    auto bufferCopy = std::unique_ptr<BufferRAMPrecision<float>>(buffer.clone());
+    bufferCopy->add(4.0f);
+    EXPECT_EQ(buffer.getSize(), size_t{3});
+    EXPECT_EQ(bufferCopy->getSize(), size_t{4});
+    buffer.clear();
+    EXPECT_EQ(bufferCopy->getSize(), size_t{4});
+}
+
+}  // namespace inviwo
@@ -0,0 +1,244 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/processors/poolprocessor.h>
+#include <inviwo/core/network/processornetwork.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace inviwo {
+
+TEST(SpeculativeCache, FindAndStats) {
+    pool::SpeculativeCache<int, int> cache{100, [](const int&) { return size_t{10}; }};
+
+    EXPECT_EQ(cache.find(1), nullptr);
+    cache.insert(1, 11);
+    cache.insert(2, 22);
+    ASSERT_NE(cache.find(1), nullptr);
+    EXPECT_EQ(*cache.find(1), 11);
+    EXPECT_EQ(*cache.find(2), 22);
+
+    const auto& stats = cache.getStats();
+    EXPECT_EQ(stats.hits, size_t{3});
+    EXPECT_EQ(stats.misses, size_t{1});
+    EXPECT_DOUBLE_EQ(stats.hitRate(), 0.75);
+    EXPECT_EQ(stats.memory, size_t{20});
+
+    cache.resetStats();
+    EXPECT_EQ(cache.getStats().hits, size_t{0});
+    EXPECT_EQ(cache.getStats().memory, size_t{20});
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), size_t{0});
+    EXPECT_EQ(cache.getStats().memory, size_t{0});
+    EXPECT_FALSE(cache.contains(1));
+}
+
+TEST(SpeculativeCache, MemoryCap) {
+    pool::SpeculativeCache<int, size_t> cache{10, [](const size_t& size) { return size; }};
+
+    cache.insert(1, 4);
+    cache.insert(2, 4);
+    cache.find(1);
+    // exceeds the cap, the least recently used result is evicted
+    cache.insert(3, 4);
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_TRUE(cache.contains(3));
+    EXPECT_EQ(cache.getStats().evictions, size_t{1});
+    EXPECT_EQ(cache.getStats().memory, size_t{8});
+
+    // larger than the cap, not cached
+    cache.insert(4, 11);
+    EXPECT_FALSE(cache.contains(4));
+    EXPECT_EQ(cache.size(), size_t{2});
+
+    cache.setMemoryCap(4);
+    EXPECT_EQ(cache.size(), size_t{1});
+    EXPECT_TRUE(cache.contains(3));
+}
+
+namespace {
+
+struct SpeculativeProcessor : PoolProcessor {
+    SpeculativeProcessor() : PoolProcessor(pool::Options{flags::empty}, "speculative") {}
+
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    static const ProcessorInfo processorInfo_;
+
+    virtual void process() override {
+        inProcess = true;
+        const auto makeJob = [this](int key) {
+            return [this, key]() {
+                {
+                    std::scoped_lock lock{mutex};
+                    ++computed[key];
+                }
+                // keys from 100 and up block until released by the test
+                while (key >= 100 && !release) std::this_thread::yield();
+                return 10 * key;
+            };
+        };
+        dispatchSpeculative(cache, key, {key + 1, key - 1}, makeJob, [this](int result) {
+            results.push_back(result);
+            doneInProcess.push_back(inProcess);
+        });
+        inProcess = false;
+    }
+
+    int computedCount(int k) {
+        std::scoped_lock lock{mutex};
+        return computed[k];
+    }
+
+    pool::SpeculativeCache<int, int> cache{1024, [](const int&) { return sizeof(int); }};
+    int key = 0;
+    bool inProcess = false;
+    std::vector<int> results;
+    std::vector<bool> doneInProcess;
+    std::atomic<bool> release{false};
+    std::mutex mutex;
+    std::map<int, int> computed;
+};
+
+const ProcessorInfo SpeculativeProcessor::processorInfo_{
+    "org.inviwo.SpeculativeProcessor",  // Class identifier
+    "SpeculativeProcessor",             // Display name
+    "Testing",                          // Category
+    CodeState::Stable,                  // Code state
+    Tags::CPU,                          // Tags
+};
+
+template <typename Pred>
+bool processFrontUntil(InviwoApplication* app, Pred pred) {
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > timeout) return false;
+        app->processFront();
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST(SpeculativeCache, DispatchSpeculative) {
+    auto app = InviwoApplication::getPtr();
+    // speculation needs two idle worker threads for both neighbours, the thread that finishes a
+    // job might not be idle yet when the neighbours are speculated
+    const auto poolSize = app->getPoolSize();
+    app->resizePool(std::max<size_t>(poolSize, 3));
+
+    ProcessorNetwork network{app};
+    auto& p = static_cast<SpeculativeProcessor&>(
+        *network.addProcessor(std::make_unique<SpeculativeProcessor>()));
+
+    {
+        SCOPED_TRACE("Miss, the result is computed and its neighbours speculated");
+        p.key = 5;
+        p.process();
+        ASSERT_TRUE(processFrontUntil(app, [&]() { return p.results.size() == 1; }));
+        EXPECT_EQ(p.results.back(), 50);
+        EXPECT_FALSE(p.doneInProcess.back());
+        ASSERT_TRUE(processFrontUntil(
+            app, [&]() { return p.cache.contains(4) && p.cache.contains(6); }));
+        EXPECT_EQ(p.cache.getStats().speculations, size_t{2});
+    }
+
+    {
+        SCOPED_TRACE("Hit, done is called synchronously within process");
+        p.key = 6;
+        p.process();
+        ASSERT_EQ(p.results.size(), size_t{2});
+        EXPECT_EQ(p.results.back(), 60);
+        EXPECT_TRUE(p.doneInProcess.back());
+        EXPECT_EQ(p.computedCount(6), 1);
+        ASSERT_TRUE(processFrontUntil(app, [&]() { return p.cache.contains(7); }));
+        EXPECT_EQ(p.computedCount(5), 1);
+    }
+
+    {
+        SCOPED_TRACE("Speculative results are discarded after clear");
+        p.key = 98;
+        p.process();
+        ASSERT_TRUE(processFrontUntil(app, [&]() { return p.results.size() == 3; }));
+        ASSERT_TRUE(processFrontUntil(
+            app, [&]() { return p.cache.contains(97) && p.cache.contains(99); }));
+
+        // the speculative job for 100 blocks until released
+        p.key = 99;
+        p.process();
+        EXPECT_TRUE(p.doneInProcess.back());
+        EXPECT_TRUE(p.cache.isPending(100));
+        ASSERT_TRUE(processFrontUntil(app, [&]() { return p.computedCount(100) == 1; }));
+        p.cache.clear();
+        EXPECT_FALSE(p.cache.isPending(100));
+        p.release = true;
+        app->waitForPool();
+        EXPECT_FALSE(p.cache.contains(100));
+        EXPECT_EQ(p.computedCount(100), 1);
+    }
+
+    {
+        SCOPED_TRACE("Miss of a pending key, waits for the speculative job");
+        p.release = false;
+        p.key = 99;
+        p.process();
+        ASSERT_TRUE(processFrontUntil(app, [&]() { return p.results.size() == 5; }));
+        EXPECT_EQ(p.results.back(), 990);
+        ASSERT_TRUE(p.cache.isPending(100));
+
+        p.key = 100;
+        p.process();
+        EXPECT_EQ(p.results.size(), size_t{5});
+        p.release = true;
+        ASSERT_TRUE(processFrontUntil(app, [&]() { return p.results.size() == 6; }));
+        EXPECT_EQ(p.results.back(), 1000);
+        EXPECT_FALSE(p.doneInProcess.back());
+        // the request was served by the speculative job, not by a second computation
+        EXPECT_EQ(p.computedCount(100), 2);
+        app->waitForPool();
+    }
+
+    app->resizePool(poolSize);
+}
+
+}  // namespace inviwo
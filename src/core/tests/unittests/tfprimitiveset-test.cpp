@@ -35,8 +35,11 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/datastructures/tfprimitiveset.h>
 #include <inviwo/core/datastructures/transferfunction.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
 
 #include <iostream>
+#include <limits>
 
 namespace inviwo {
 
@@ -82,4 +85,86 @@ TEST(TFSampling, linear) {
     EXPECT_EQ(color2, tf.sample(1.0));
 }
 
+namespace {
+
+const vec4* tfTable(const TransferFunction& tf) {
+    return static_cast<const LayerRAMPrecision<vec4>*>(
+               tf.getData()->getRepresentation<LayerRAM>())
+        ->getDataTyped();
+}
+
+void expectNear(const vec4& expected, const vec4& actual, float tolerance) {
+    for (glm::length_t i = 0; i < 4; ++i) {
+        EXPECT_NEAR(expected[i], actual[i], tolerance);
+    }
+}
+
+}  // namespace
+
+TEST(TFSampling, incrementalTable) {
+    vec4 color1{0.0f, 1.0f, 0.0f, 0.5f};
+    vec4 color2{1.0f, 0.0f, 0.5f, 1.0f};
+    vec4 color3{0.2f, 0.4f, 0.6f, 0.8f};
+    TransferFunction tf{{{0.1, color1}, {0.4, color2}, {0.8, color3}}, 256};
+    tfTable(tf);
+
+    tf[1].setPosition(0.6);
+    tf.add(0.9, color1);
+    tf.remove(tf[0]);
+
+    const TransferFunction ref{tf.get(), 256};
+
+    const auto incremental = tfTable(tf);
+    const auto full = tfTable(ref);
+    for (size_t i = 0; i < tf.getTextureSize(); ++i) {
+        EXPECT_EQ(full[i], incremental[i]) << "Table entry " << i << " differs";
+    }
+}
+
+TEST(TFSampling, batch) {
+    vec4 color1{0.0f, 1.0f, 0.0f, 0.5f};
+    vec4 color2{1.0f, 0.0f, 0.5f, 1.0f};
+    TransferFunction tf{{{0.25, color1}, {0.75, color2}}};
+
+    const std::vector<float> values{-1.0f, 0.0f, 0.25f, 0.4f, 0.5f, 0.75f, 1.0f, 2.0f};
+    std::vector<vec4> colors(values.size());
+    tf.sample(values.data(), colors.data(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        expectNear(tf.sample(glm::clamp(values[i], 0.0f, 1.0f)), colors[i], 0.005f);
+    }
+
+    const std::vector<int> ints{0, 25, 50, 75, 100};
+    std::vector<vec4> intColors(ints.size());
+    tf.sample(ints.data(), intColors.data(), ints.size(), dvec2{0.0, 100.0});
+    for (size_t i = 0; i < ints.size(); ++i) {
+        expectNear(tf.sample(ints[i] / 100.0), intColors[i], 0.005f);
+    }
+}
+
+TEST(TFSampling, batchDegenerate) {
+    vec4 color1{0.0f, 1.0f, 0.0f, 0.5f};
+    vec4 color2{1.0f, 0.0f, 0.5f, 1.0f};
+    TransferFunction tf{{{0.25, color1}, {0.75, color2}}};
+
+    {
+        SCOPED_TRACE("Constant range");
+        const std::vector<double> values{3.0, 3.0, 3.0};
+        std::vector<vec4> colors(values.size(), vec4{-1.0f});
+        tf.sample(values.data(), colors.data(), values.size(), dvec2{3.0, 3.0});
+        for (const auto& color : colors) EXPECT_EQ(color1, color);
+    }
+
+    {
+        SCOPED_TRACE("Non-finite values");
+        const std::vector<float> values{std::numeric_limits<float>::quiet_NaN(),
+                                        std::numeric_limits<float>::infinity(),
+                                        -std::numeric_limits<float>::infinity()};
+        std::vector<vec4> colors(values.size(), vec4{-1.0f});
+        tf.sample(values.data(), colors.data(), values.size());
+        EXPECT_EQ(color1, colors[0]);
+        EXPECT_EQ(color2, colors[1]);
+        EXPECT_EQ(color1, colors[2]);
+    }
+}
+
 }  // namespace inviwo
@@ -0,0 +1,81 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/threadarena.h>
+
+#include <numeric>
+#include <thread>
+
+namespace inviwo {
+
+TEST(ThreadArena, NoScope) {
+    EXPECT_EQ(util::threadArena(), std::pmr::get_default_resource());
+}
+
+TEST(ThreadArena, Scope) {
+    {
+        util::ArenaScope scope;
+        EXPECT_EQ(util::threadArena(), scope.resource());
+        EXPECT_NE(scope.resource(), std::pmr::get_default_resource());
+        {
+            util::ArenaScope inner;
+            EXPECT_EQ(inner.resource(), scope.resource());
+        }
+        auto vec = util::arenaVector<int>(100);
+        vec.resize(100);
+        std::iota(vec.begin(), vec.end(), 0);
+        EXPECT_EQ(vec.get_allocator().resource(), scope.resource());
+        EXPECT_EQ(std::accumulate(vec.begin(), vec.end(), 0), 4950);
+    }
+    EXPECT_EQ(util::threadArena(), std::pmr::get_default_resource());
+}
+
+TEST(ThreadArena, Grow) {
+    std::thread thread{[]() {
+        EXPECT_EQ(util::threadArenaCapacity(), size_t{0});
+        const size_t bytes = 1024 * 1024;
+        {
+            util::ArenaScope scope;
+            const auto initial = util::threadArenaCapacity();
+            EXPECT_LT(initial, bytes);
+            std::pmr::vector<char> vec(bytes, 'a', scope.resource());
+            EXPECT_EQ(vec.back(), 'a');
+        }
+        // The buffer should have grown to fit the previous scope
+        EXPECT_GE(util::threadArenaCapacity(), bytes);
+    }};
+    thread.join();
+}
+
+}  // namespace inviwo
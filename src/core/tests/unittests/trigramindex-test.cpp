@@ -0,0 +1,120 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/trigramindex.h>
+
+#include <algorithm>
+#include <random>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<int> sorted(std::vector<int> vec) {
+    std::sort(vec.begin(), vec.end());
+    return vec;
+}
+
+}  // namespace
+
+TEST(TrigramIndex, Find) {
+    util::TrigramIndex<int> index;
+    index.insert(1, "VolumeRaycaster");
+    index.insert(1, "Volume Raycaster");
+    index.insert(2, "MeshRenderer");
+    index.insert(3, "VolumeSource");
+
+    EXPECT_EQ(index.size(), 3);
+    EXPECT_EQ(sorted(index.find("volume")), (std::vector<int>{1, 3}));
+    EXPECT_EQ(sorted(index.find("RAYCAST")), (std::vector<int>{1}));
+    EXPECT_EQ(sorted(index.find("e r")), (std::vector<int>{1}));
+    EXPECT_EQ(sorted(index.find("er")), (std::vector<int>{1, 2}));
+    EXPECT_EQ(sorted(index.find("")), (std::vector<int>{1, 2, 3}));
+    EXPECT_TRUE(index.find("volumemesh").empty());
+    EXPECT_TRUE(index.find("x").empty());
+
+    EXPECT_TRUE(index.matches(2, "render"));
+    EXPECT_FALSE(index.matches(2, "volume"));
+    EXPECT_FALSE(index.matches(4, "volume"));
+}
+
+TEST(TrigramIndex, Erase) {
+    util::TrigramIndex<int> index;
+    index.insert(1, "abcdef");
+    index.insert(2, "bcdefg");
+
+    index.erase(1);
+    EXPECT_FALSE(index.contains(1));
+    EXPECT_EQ(sorted(index.find("bcd")), (std::vector<int>{2}));
+    EXPECT_TRUE(index.find("abc").empty());
+
+    index.insert(1, "xyz");
+    EXPECT_EQ(sorted(index.find("yz")), (std::vector<int>{1}));
+    index.clear();
+    EXPECT_TRUE(index.empty());
+    EXPECT_TRUE(index.find("yz").empty());
+}
+
+TEST(TrigramIndex, CompareToLinearSearch) {
+    std::mt19937 rng(7);
+    const std::string chars = "abcAB_ ";
+    const auto randomString = [&](size_t size) {
+        std::string str;
+        for (size_t i = 0; i < size; ++i) str.push_back(chars[rng() % chars.size()]);
+        return str;
+    };
+    const auto lower = [](std::string str) {
+        std::transform(str.begin(), str.end(), str.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return str;
+    };
+
+    util::TrigramIndex<int> index;
+    std::vector<std::string> texts;
+    for (int i = 0; i < 200; ++i) {
+        texts.push_back(randomString(1 + rng() % 12));
+        index.insert(i, texts.back());
+    }
+
+    for (int q = 0; q < 200; ++q) {
+        const auto query = randomString(1 + rng() % 5);
+        std::vector<int> expected;
+        for (int i = 0; i < 200; ++i) {
+            if (lower(texts[i]).find(lower(query)) != std::string::npos) expected.push_back(i);
+        }
+        EXPECT_EQ(sorted(index.find(query)), expected) << "query: '" << query << "'";
+    }
+}
+
+}  // namespace inviwo
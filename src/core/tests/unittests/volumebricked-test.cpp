@@ -0,0 +1,135 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/volume/volumebrickedprecision.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+TEST(VolumeBricked, SetGet) {
+    const size3_t dims{19, 8, 3};
+    VolumeBrickedPrecision<int> volume(dims);
+    EXPECT_EQ(volume.getBrickDimensions(), size3_t(3, 1, 1));
+    EXPECT_EQ(volume.get(size3_t{18, 7, 2}), 0);
+
+    volume.set(size3_t{18, 7, 2}, 5);
+    volume.set(size3_t{0, 0, 0}, 7);
+    EXPECT_EQ(volume.get(size3_t{18, 7, 2}), 5);
+    EXPECT_EQ(volume.get(size3_t{0, 0, 0}), 7);
+    EXPECT_EQ(volume.getAsDouble(size3_t{18, 7, 2}), 5.0);
+    EXPECT_EQ(volume.get(size3_t{17, 7, 2}), 0);
+}
+
+TEST(VolumeBricked, MortonOrder) {
+    std::vector<size_t> indices;
+    for (size_t z = 0; z < VolumeBricked::brickSize; ++z) {
+        for (size_t y = 0; y < VolumeBricked::brickSize; ++y) {
+            for (size_t x = 0; x < VolumeBricked::brickSize; ++x) {
+                indices.push_back(VolumeBrickedPrecision<float>::voxelIndex(size3_t{x, y, z}));
+            }
+        }
+    }
+    std::sort(indices.begin(), indices.end());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        EXPECT_EQ(indices[i], i);
+    }
+    EXPECT_EQ(VolumeBrickedPrecision<float>::voxelIndex(size3_t{1, 1, 1}), 7u);
+}
+
+TEST(VolumeBricked, RoundTrip) {
+    const size3_t dims{37, 21, 45};
+    VolumeRAMPrecision<float> ram(dims);
+    auto data = ram.getDataTyped();
+    std::iota(data, data + glm::compMul(dims), 0.0f);
+
+    auto bricked = createVolumeBricked(ram);
+    EXPECT_EQ(bricked->getDimensions(), dims);
+    const auto& typed = static_cast<const VolumeBrickedPrecision<float>&>(*bricked);
+
+    size_t count = 0;
+    typed.forEachVoxel([&](const size3_t& pos, const float& value) {
+        EXPECT_EQ(value, data[VolumeRAM::posToIndex(pos, dims)]);
+        ++count;
+    });
+    EXPECT_EQ(count, glm::compMul(dims));
+
+    auto linear = createVolumeRAM(*bricked);
+    EXPECT_EQ(linear->getDimensions(), dims);
+    const auto linearData = static_cast<const float*>(linear->getData());
+    EXPECT_TRUE(std::equal(data, data + glm::compMul(dims), linearData));
+}
+
+TEST(VolumeBricked, CopySlice) {
+    const size3_t dims{11, 17, 9};
+    VolumeRAMPrecision<int> ram(dims);
+    auto data = ram.getDataTyped();
+    std::iota(data, data + glm::compMul(dims), 0);
+    auto bricked = createVolumeBricked(ram);
+    const auto& typed = static_cast<const VolumeBrickedPrecision<int>&>(*bricked);
+
+    // the slices are stored with the first dimension of getSliceDimensions fastest
+    const auto volumePos = [](CartesianCoordinateAxis axis, size_t slice, size_t u, size_t v) {
+        switch (axis) {
+            case CartesianCoordinateAxis::X:
+                return size3_t{slice, v, u};
+            case CartesianCoordinateAxis::Y:
+                return size3_t{u, slice, v};
+            case CartesianCoordinateAxis::Z:
+            default:
+                return size3_t{u, v, slice};
+        }
+    };
+
+    for (auto axis :
+         {CartesianCoordinateAxis::X, CartesianCoordinateAxis::Y, CartesianCoordinateAxis::Z}) {
+        const auto sliceDims = bricked->getSliceDimensions(axis);
+        std::vector<int> slice(glm::compMul(sliceDims), -1);
+        for (size_t s : {size_t{0}, size_t{7}, size_t{8}}) {
+            typed.copySlice(axis, s, slice.data());
+            for (size_t v = 0; v < sliceDims.y; ++v) {
+                for (size_t u = 0; u < sliceDims.x; ++u) {
+                    EXPECT_EQ(slice[u + v * sliceDims.x],
+                              data[VolumeRAM::posToIndex(volumePos(axis, s, u, v), dims)]);
+                }
+            }
+        }
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,94 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <numeric>
+
+namespace inviwo {
+
+TEST(VolumeRAM, View) {
+    const size3_t dims{6, 5, 4};
+    VolumeRAMPrecision<int> volume(dims);
+    std::iota(volume.getDataTyped(), volume.getDataTyped() + glm::compMul(dims), 0);
+
+    const size3_t offset{1, 2, 1};
+    const size3_t viewDims{2, 3, 3};
+    const size3_t stride{2, 1, 1};
+    VolumeRAMPrecision<int> view(volume, offset, viewDims, stride);
+    EXPECT_TRUE(view.isView());
+    EXPECT_EQ(view.getDimensions(), viewDims);
+
+    const auto expected = [&](const size3_t& pos) {
+        return static_cast<double>(VolumeRAM::posToIndex(offset + pos * stride, dims));
+    };
+
+    // modifying the parent does not affect the view
+    volume.setFromDouble(offset, -1.0);
+
+    for (size_t z = 0; z < viewDims.z; ++z) {
+        for (size_t y = 0; y < viewDims.y; ++y) {
+            for (size_t x = 0; x < viewDims.x; ++x) {
+                EXPECT_EQ(view.getAsDouble(size3_t{x, y, z}), expected(size3_t{x, y, z}));
+            }
+        }
+    }
+
+    const auto& constView = view;
+    const auto data = constView.getDataTyped();
+    for (size_t z = 0; z < viewDims.z; ++z) {
+        for (size_t y = 0; y < viewDims.y; ++y) {
+            for (size_t x = 0; x < viewDims.x; ++x) {
+                const size3_t pos{x, y, z};
+                EXPECT_EQ(static_cast<double>(data[VolumeRAM::posToIndex(pos, viewDims)]),
+                          expected(pos));
+            }
+        }
+    }
+
+    // a view of a view
+    auto subView = createVolumeRAMView(view, size3_t{1, 1, 1}, size3_t{1, 2, 2});
+    EXPECT_EQ(subView->getAsDouble(size3_t{0, 1, 1}), expected(size3_t{1, 2, 2}));
+
+    view.setFromDouble(size3_t{0, 0, 0}, 100.0);
+    EXPECT_FALSE(view.isView());
+    EXPECT_EQ(view.getAsDouble(size3_t{0, 0, 0}), 100.0);
+    EXPECT_EQ(view.getAsDouble(size3_t{1, 2, 2}), expected(size3_t{1, 2, 2}));
+    EXPECT_EQ(subView->getAsDouble(size3_t{0, 0, 0}), expected(size3_t{1, 1, 1}));
+
+    EXPECT_THROW(VolumeRAMPrecision<int>(volume, size3_t{5, 0, 0}, size3_t{2, 1, 1}), Exception);
+}
+
+}  // namespace inviwo
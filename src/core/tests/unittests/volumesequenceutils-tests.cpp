@@ -33,6 +33,7 @@
 #include <warn/pop>
 
 #include <inviwo/core/util/volumesequenceutils.h>
+#include <inviwo/core/util/exception.h>
 #include <inviwo/core/metadata/metadata.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 
@@ -158,4 +159,78 @@ TEST(VolumeSequenceUtilsTests, getVolumesForTimestepTest) {
     EXPECT_EQ(p6.second.get(), s2[2].get());
 }
 
+TEST(VolumeSequenceUtilsTests, timeIndexTest) {
+    VolumeSequence s1;
+    s1.push_back(createVolume(0.2));
+    s1.push_back(createVolume(0.0));
+    s1.push_back(createVolume(0.1));
+
+    util::TimeIndex index(s1);
+    EXPECT_TRUE(index.hasTimestamps());
+    EXPECT_TRUE(index.isIndexOf(s1));
+    EXPECT_EQ(index.getRange().first, 0.0);
+    EXPECT_EQ(index.getRange().second, 0.2);
+    EXPECT_EQ(index.getSequenceIndex(0), 1u);
+    EXPECT_EQ(index.find(0.15), 1u);
+    EXPECT_EQ(index.find(-1.0), 0u);
+
+    auto i0 = index.interpolate(0.05);
+    EXPECT_EQ(i0.first, 1u);
+    EXPECT_EQ(i0.second, 2u);
+    EXPECT_NEAR(i0.weight, 0.5, 1.0e-12);
+
+    auto i1 = index.interpolate(0.3);
+    EXPECT_EQ(i1.first, 0u);
+    EXPECT_EQ(i1.second, 0u);
+    EXPECT_EQ(i1.weight, 0.0);
+
+    auto p0 = index.getVolumes(s1, 0.1);
+    EXPECT_EQ(p0.first.get(), s1[2].get());
+    EXPECT_EQ(p0.second.get(), s1[0].get());
+    EXPECT_EQ(p0, util::getVolumesForTimestep(s1, 0.1, false));
+
+    util::TimeIndex cached;
+    EXPECT_EQ(p0, util::getVolumesForTimestep(s1, 0.1, cached));
+    EXPECT_TRUE(cached.isIndexOf(s1));
+
+    VolumeSequence s2 = s1;
+    s2.push_back(createVolume(0.3));
+    EXPECT_FALSE(index.isIndexOf(s2));
+    EXPECT_EQ(util::getVolumesForTimestep(s2, 0.4, cached).first.get(), s2[3].get());
+    EXPECT_TRUE(cached.isIndexOf(s2));
+
+    VolumeSequence s3;
+    s3.push_back(createVolume());
+    s3.push_back(createVolume());
+    s3.push_back(createVolume());
+    util::TimeIndex uniform(s3);
+    EXPECT_FALSE(uniform.hasTimestamps());
+    auto i2 = uniform.interpolate(0.75);
+    EXPECT_EQ(i2.first, 1u);
+    EXPECT_EQ(i2.second, 2u);
+    EXPECT_NEAR(i2.weight, 0.5, 1.0e-12);
+
+    // changed timestamps of the same volumes invalidate the index
+    s1[1]->setMetaData<DoubleMetaData, double>("timestamp", 0.15);
+    EXPECT_FALSE(index.isIndexOf(s1));
+    EXPECT_EQ(util::getVolumesForTimestep(s1, 0.12, cached).first.get(), s1[2].get());
+    EXPECT_TRUE(cached.isIndexOf(s1));
+}
+
+TEST(VolumeSequenceUtilsTests, emptyTimeIndexTest) {
+    VolumeSequence empty;
+    util::TimeIndex index(empty);
+    EXPECT_TRUE(index.empty());
+    EXPECT_TRUE(index.isIndexOf(empty));
+    EXPECT_THROW(index.find(0.5), RangeException);
+    EXPECT_THROW(index.interpolate(0.5), RangeException);
+
+    const auto volumes = index.getVolumes(empty, 0.5);
+    EXPECT_EQ(volumes.first, nullptr);
+    EXPECT_EQ(volumes.second, nullptr);
+
+    util::TimeIndex cached;
+    EXPECT_EQ(util::getVolumesForTimestep(empty, 0.5, cached).first, nullptr);
+}
+
 }  // namespace inviwo
\ No newline at end of file
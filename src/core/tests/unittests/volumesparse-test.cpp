@@ -0,0 +1,199 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumesparseprecision.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/histogramtools.h>
+#include <inviwo/core/util/volumesampler.h>
+#include <inviwo/core/util/volumesparsesampler.h>
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace inviwo {
+
+TEST(VolumeSparse, SetGet) {
+    const size3_t dims{300, 200, 100};
+    VolumeSparsePrecision<int> volume(dims, 3);
+    EXPECT_EQ(volume.getLeafCount(), 0u);
+    EXPECT_EQ(volume.get(size3_t{10, 20, 30}), 3);
+
+    // setting the background does not allocate anything
+    volume.set(size3_t{10, 20, 30}, 3);
+    EXPECT_EQ(volume.getLeafCount(), 0u);
+
+    volume.set(size3_t{10, 20, 30}, 5);
+    volume.set(size3_t{299, 199, 99}, 7);
+    EXPECT_EQ(volume.getLeafCount(), 2u);
+    EXPECT_TRUE(volume.isAllocated(size3_t{8, 16, 24}));
+    EXPECT_FALSE(volume.isAllocated(size3_t{0, 0, 0}));
+    EXPECT_EQ(volume.get(size3_t{10, 20, 30}), 5);
+    EXPECT_EQ(volume.get(size3_t{11, 20, 30}), 3);
+    EXPECT_EQ(volume.getAsDouble(size3_t{299, 199, 99}), 7.0);
+    EXPECT_EQ(volume.getActiveVoxelCount(), 2u);
+
+    volume.set(size3_t{10, 20, 30}, 3);
+    volume.prune();
+    EXPECT_EQ(volume.getLeafCount(), 1u);
+    EXPECT_EQ(volume.get(size3_t{299, 199, 99}), 7);
+}
+
+TEST(VolumeSparse, Dense) {
+    const size3_t dims{37, 21, 45};
+    VolumeRAMPrecision<float> ram(dims);
+    auto data = ram.getDataTyped();
+    std::fill(data, data + glm::compMul(dims), 0.0f);
+    size_t active = 0;
+    for (size_t i = 0; i < glm::compMul(dims); i += 2000) {
+        data[i] = static_cast<float>(i);
+        if (i != 0) ++active;
+    }
+
+    auto sparse = createVolumeSparse(ram);
+    EXPECT_EQ(sparse->getDimensions(), dims);
+    EXPECT_EQ(sparse->getActiveVoxelCount(), active);
+    EXPECT_LT(sparse->getNumberOfBytes(), ram.getNumberOfBytes());
+
+    const auto& typed = static_cast<const VolumeSparsePrecision<float>&>(*sparse);
+    typed.forEachActiveVoxel([&](const size3_t& pos, const float& value) {
+        EXPECT_EQ(value, data[VolumeRAM::posToIndex(pos, dims)]);
+    });
+
+    auto dense = createVolumeRAM(*sparse);
+    auto result = static_cast<const float*>(dense->getData());
+    EXPECT_TRUE(std::equal(data, data + glm::compMul(dims), result));
+}
+
+namespace {
+
+/**
+ * A dense volume and a sparse volume of the same data, a few blobs in a background of zeros with
+ * one of them in the partial leaves at the border.
+ */
+std::pair<std::shared_ptr<Volume>, std::shared_ptr<Volume>> createDenseAndSparse() {
+    const size3_t dims{45, 37, 29};
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(dims);
+    auto data = ram->getDataTyped();
+    std::fill(data, data + glm::compMul(dims), 0.0f);
+    for (const auto& [center, radius] : {std::pair{vec3{12.0f, 10.0f, 8.0f}, 5.0f},
+                                         std::pair{vec3{30.0f, 20.0f, 14.0f}, 3.5f},
+                                         std::pair{vec3{43.0f, 35.0f, 27.0f}, 4.0f}}) {
+        for (size_t z = 0; z < dims.z; ++z) {
+            for (size_t y = 0; y < dims.y; ++y) {
+                for (size_t x = 0; x < dims.x; ++x) {
+                    const auto d = glm::distance(vec3{x, y, z}, center);
+                    if (d < radius) {
+                        data[VolumeRAM::posToIndex(size3_t{x, y, z}, dims)] = 1.0f - d / radius;
+                    }
+                }
+            }
+        }
+    }
+
+    auto dense = std::make_shared<Volume>(ram);
+    auto sparse = std::make_shared<Volume>(createVolumeSparse(*ram));
+    for (auto& volume : {dense, sparse}) {
+        volume->dataMap_.dataRange = dvec2{0.0, 1.0};
+        volume->dataMap_.valueRange = dvec2{0.0, 1.0};
+    }
+    return {dense, sparse};
+}
+
+std::optional<HistogramContainer> waitForHistograms(
+    std::shared_ptr<HistogramCalculationState> state) {
+    std::optional<HistogramContainer> result;
+    state->whenDone([&](const HistogramContainer& histograms) { result = histograms; });
+
+    auto app = InviwoApplication::getPtr();
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!result && std::chrono::steady_clock::now() < timeout) {
+        app->waitForPool();
+        app->processFront();
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(VolumeSparse, Histograms) {
+    auto [dense, sparse] = createDenseAndSparse();
+    ASSERT_TRUE(sparse->hasRepresentation<VolumeSparse>());
+    ASSERT_FALSE(sparse->hasRepresentation<VolumeRAM>());
+
+    const auto denseHistograms = waitForHistograms(dense->calculateHistograms(64));
+    const auto sparseHistograms = waitForHistograms(sparse->calculateHistograms(64));
+    ASSERT_TRUE(denseHistograms);
+    ASSERT_TRUE(sparseHistograms);
+    // the sparse volume is not made dense to calculate the histograms
+    EXPECT_FALSE(sparse->hasRepresentation<VolumeRAM>());
+
+    ASSERT_EQ(sparseHistograms->size(), denseHistograms->size());
+    for (size_t i = 0; i < denseHistograms->size(); ++i) {
+        const auto& expected = (*denseHistograms)[i];
+        const auto& actual = (*sparseHistograms)[i];
+        ASSERT_EQ(actual.getData().size(), expected.getData().size());
+        for (size_t bin = 0; bin < expected.getData().size(); ++bin) {
+            EXPECT_DOUBLE_EQ(actual[bin], expected[bin]) << "channel " << i << " bin " << bin;
+        }
+        EXPECT_DOUBLE_EQ(actual.stats_.min, expected.stats_.min);
+        EXPECT_DOUBLE_EQ(actual.stats_.max, expected.stats_.max);
+        EXPECT_NEAR(actual.stats_.mean, expected.stats_.mean, 1.0e-9);
+        EXPECT_NEAR(actual.stats_.standardDeviation, expected.stats_.standardDeviation, 1.0e-6);
+    }
+}
+
+TEST(VolumeSparse, Sampler) {
+    auto [dense, sparse] = createDenseAndSparse();
+    const VolumeDoubleSampler<1> denseSampler(dense);
+    const VolumeSparseDoubleSampler<1> sparseSampler(sparse);
+
+    const size_t steps = 23;
+    for (size_t z = 0; z <= steps; ++z) {
+        for (size_t y = 0; y <= steps; ++y) {
+            for (size_t x = 0; x <= steps; ++x) {
+                const dvec3 pos = dvec3{x, y, z} / static_cast<double>(steps);
+                ASSERT_DOUBLE_EQ(sparseSampler.sample(pos).x, denseSampler.sample(pos).x);
+            }
+        }
+    }
+    // outside of the volume
+    EXPECT_EQ(sparseSampler.sample(dvec3{1.5, 0.5, 0.5}).x, 0.0);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,165 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/allocationcounter.h>
+
+#if defined(IVW_ALLOCATION_COUNTING)
+#include <cstdlib>
+#include <new>
+#endif
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+// Trivial types only, these are accessed from operator new, possibly before or after any
+// dynamic initialization of the thread.
+thread_local size_t threadAllocations = 0;
+thread_local size_t threadAllocatedBytes = 0;
+
+}  // namespace
+
+bool isAllocationCountingEnabled() {
+#if defined(IVW_ALLOCATION_COUNTING)
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocationStats threadAllocationStats() {
+    return AllocationStats{threadAllocations, threadAllocatedBytes};
+}
+
+AllocationCounter::AllocationCounter() : start_{threadAllocationStats()} {}
+
+AllocationStats AllocationCounter::get() const { return threadAllocationStats() - start_; }
+
+void AllocationCounter::reset() { start_ = threadAllocationStats(); }
+
+void detail::countAllocation(size_t bytes) noexcept {
+    ++threadAllocations;
+    threadAllocatedBytes += bytes;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
+
+#if defined(IVW_ALLOCATION_COUNTING)
+
+namespace {
+
+void* countedAllocate(std::size_t size) {
+    inviwo::util::detail::countAllocation(size);
+    if (size == 0) size = 1;
+    while (true) {
+        if (auto ptr = std::malloc(size)) return ptr;
+        if (auto handler = std::get_new_handler()) {
+            handler();
+        } else {
+            throw std::bad_alloc{};
+        }
+    }
+}
+
+void* countedAllocate(std::size_t size, std::align_val_t alignment) {
+    inviwo::util::detail::countAllocation(size);
+    const auto align = static_cast<std::size_t>(alignment);
+    // aligned_alloc requires the size to be a multiple of the alignment
+    size = size == 0 ? align : (size + align - 1) / align * align;
+    while (true) {
+#if defined(_MSC_VER)
+        if (auto ptr = _aligned_malloc(size, align)) return ptr;
+#else
+        if (auto ptr = std::aligned_alloc(align, size)) return ptr;
+#endif
+        if (auto handler = std::get_new_handler()) {
+            handler();
+        } else {
+            throw std::bad_alloc{};
+        }
+    }
+}
+
+void countedFree(void* ptr, std::align_val_t) noexcept {
+#if defined(_MSC_VER)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return countedAllocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return countedAllocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return countedAllocate(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return countedAllocate(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t alignment) noexcept {
+    countedFree(ptr, alignment);
+}
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept {
+    countedFree(ptr, alignment);
+}
+void operator delete(void* ptr, std::size_t, std::align_val_t alignment) noexcept {
+    countedFree(ptr, alignment);
+}
+void operator delete[](void* ptr, std::size_t, std::align_val_t alignment) noexcept {
+    countedFree(ptr, alignment);
+}
+
+#endif
@@ -38,10 +38,13 @@
 #include <inviwo/core/interaction/events/wheelevent.h>
 #include <inviwo/core/interaction/events/touchevent.h>
 #include <inviwo/core/network/networklock.h>
+#include <inviwo/core/network/evaluationscheduler.h>
 #include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/settings/systemsettings.h>
 
+#include <utility>
+
 namespace inviwo {
 
 Canvas::Canvas(size2_t dimensions)
@@ -50,29 +53,98 @@ Canvas::Canvas(size2_t dimensions)
     , pickingController_()
     , ownerWidget_(nullptr) {}
 
+Canvas::~Canvas() = default;
+
 void Canvas::resize(size2_t canvasSize) {
-    auto previousScreenDimensions = screenDimensions_;
+    ++metrics_.resizeEvents;
+    // Keep the size from before the first pending resize, the latest size wins.
+    if (!pendingResize_) pendingPreviousDimensions_ = screenDimensions_;
+    pendingResize_ = true;
     screenDimensions_ = canvasSize;
 
-    if (propagator_) {
-        NetworkLock lock;
-        RenderContext::getPtr()->activateDefaultRenderContext();
-        ResizeEvent resizeEvent(screenDimensions_, previousScreenDimensions);
-        propagator_->propagateEvent(&resizeEvent, nullptr);
+    if (coalesceEvents()) {
+        scheduleFlush();
+    } else {
+        flushEvents();
     }
 }
 
 size2_t Canvas::getCanvasDimensions() const { return screenDimensions_; }
 
 void Canvas::propagateEvent(Event* event) {
+    if (isInteraction(*event) && InviwoApplication::isInitialized()) {
+        if (auto scheduler = InviwoApplication::getPtr()->getEvaluationScheduler()) {
+            scheduler->interact();
+        }
+    }
+
+    if (auto me = event->getAs<MouseEvent>(); me && me->state() == MouseState::Move) {
+        ++metrics_.moveEvents;
+        if (coalesceEvents() && propagator_) {
+            pendingMove_.reset(me->clone());
+            // The canvas has taken care of the event, the copy is propagated later
+            me->markAsUsed();
+            scheduleFlush();
+            return;
+        }
+    }
+
     NetworkLock lock;
+    // Make sure any pending events reach the network before this one to keep the ordering.
+    flushEvents();
     if (!propagator_) return;
 
+    if (auto me = event->getAs<MouseEvent>(); me && me->state() == MouseState::Move) {
+        ++metrics_.movePropagations;
+    }
     pickingController_.propagateEvent(event, propagator_);
     if (event->hasBeenUsed()) return;
     propagator_->propagateEvent(event, nullptr);
 }
 
+void Canvas::flushEvents() {
+    flushToken_.reset();
+    if (!pendingResize_ && !pendingMove_) return;
+
+    auto move = std::move(pendingMove_);
+    const bool resize = std::exchange(pendingResize_, false);
+    if (!propagator_) return;
+
+    NetworkLock lock;
+    if (resize) {
+        ++metrics_.resizePropagations;
+        RenderContext::getPtr()->activateDefaultRenderContext();
+        ResizeEvent resizeEvent(screenDimensions_, pendingPreviousDimensions_);
+        propagator_->propagateEvent(&resizeEvent, nullptr);
+    }
+    if (move) {
+        ++metrics_.movePropagations;
+        pickingController_.propagateEvent(move.get(), propagator_);
+        if (!move->hasBeenUsed()) propagator_->propagateEvent(move.get(), nullptr);
+    }
+}
+
+const Canvas::EventMetrics& Canvas::getEventMetrics() const { return metrics_; }
+
+bool Canvas::isInteraction(const Event& event) {
+    // hovering does not count, only dragging, scrolling, and touching
+    if (auto me = event.getAs<MouseEvent>()) return !me->buttonState().empty();
+    return event.getAs<WheelEvent>() || event.getAs<TouchEvent>() || event.getAs<GestureEvent>();
+}
+
+bool Canvas::coalesceEvents() const {
+    return InviwoApplication::isInitialized() &&
+           InviwoApplication::getPtr()->getSystemSettings().coalesceCanvasEvents_;
+}
+
+void Canvas::scheduleFlush() {
+    if (flushToken_) return;
+    flushToken_ = std::make_shared<bool>(true);
+    dispatchFrontAndForget([this, token = std::weak_ptr<bool>(flushToken_)]() {
+        if (token.lock()) flushEvents();
+    });
+}
+
 void Canvas::setEventPropagator(EventPropagator* propagator) { propagator_ = propagator; }
 
 ProcessorWidget* Canvas::getProcessorWidgetOwner() const { return ownerWidget_; }
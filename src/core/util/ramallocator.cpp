@@ -0,0 +1,142 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/ramallocator.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+constexpr size_t hugePageSize = size_t{2} << 20;
+constexpr size_t pageSize = 4096;
+
+/**
+ * Calls \p func for consecutive page aligned chunks of [data, data + bytes) on separate threads.
+ * Plain threads are used instead of the thread pool since allocations frequently happen within
+ * pool jobs, where waiting for other pool jobs could dead lock.
+ */
+template <typename Func>
+void forEachChunkInParallel(char* data, size_t bytes, Func func) {
+    const size_t maxThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t threads = std::min(maxThreads, bytes / (size_t{4} << 20) + 1);
+    const size_t chunk = ((bytes / threads) / pageSize + 1) * pageSize;
+
+    std::vector<std::thread> workers;
+    for (size_t begin = chunk; begin < bytes; begin += chunk) {
+        workers.emplace_back(func, data + begin, std::min(chunk, bytes - begin));
+    }
+    func(data, std::min(chunk, bytes));
+    for (auto& worker : workers) worker.join();
+}
+
+std::mutex& settingsMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+RAMAllocatorSettings& globalSettings() {
+    static RAMAllocatorSettings settings;
+    return settings;
+}
+
+}  // namespace
+
+RAMAllocatorSettings ramAllocatorSettings() {
+    std::scoped_lock lock{settingsMutex()};
+    return globalSettings();
+}
+
+void setRAMAllocatorSettings(const RAMAllocatorSettings& settings) {
+    std::scoped_lock lock{settingsMutex()};
+    globalSettings() = settings;
+}
+
+void* allocateRAM(size_t bytes, RAMInit init) {
+    const auto settings = ramAllocatorSettings();
+    const size_t size = std::max<size_t>(bytes, 1);
+    const bool hugePages = settings.transparentHugePages && size >= hugePageSize;
+    const size_t alignment = std::max({settings.alignment, alignof(std::max_align_t),
+                                       hugePages ? hugePageSize : size_t{1}});
+
+#if defined(_WIN32)
+    void* ptr = _aligned_malloc(size, alignment);
+#else
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, alignment, size) != 0) ptr = nullptr;
+#endif
+    if (!ptr) throw std::bad_alloc();
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (hugePages) madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+
+    auto data = static_cast<char*>(ptr);
+    const bool parallel = settings.parallelFirstTouch && size >= settings.parallelTouchThreshold;
+    if (init == RAMInit::Zero) {
+        if (parallel) {
+            forEachChunkInParallel(data, size,
+                                   [](char* begin, size_t length) { std::memset(begin, 0, length); });
+        } else {
+            std::memset(data, 0, size);
+        }
+    } else if (parallel) {
+        forEachChunkInParallel(data, size, [](char* begin, size_t length) {
+            for (size_t i = 0; i < length; i += pageSize) begin[i] = 0;
+        });
+    }
+    return ptr;
+}
+
+void deallocateRAM(void* ptr) noexcept {
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+}  // namespace util
+
+}  // namespace inviwo
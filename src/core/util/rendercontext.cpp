@@ -60,6 +60,8 @@ void RenderContext::activateLocalRenderContext() const {
         activateDefaultRenderContext();
         return;
     }
+    // Without a default context, e.g. without OpenGL, there are no contexts to share
+    if (!defaultContext_) return;
 
     Canvas* localContext = nullptr;
     {
@@ -49,6 +49,10 @@ SystemSettings::SystemSettings(InviwoApplication* app)
     , enableTouchProperty_("enableTouch", "Enable touch", true)
 #endif
     , enablePickingProperty_("enablePicking", "Enable picking", true)
+    , coalesceCanvasEvents_("coalesceCanvasEvents", "Coalesce canvas events", true)
+    , previewWhileInteracting_("previewWhileInteracting", "Preview while interacting", true)
+    , frameTimeBudget_("frameTimeBudget", "Frame time budget (ms)", 33, 1, 1000)
+    , interactionIdleDelay_("interactionIdleDelay", "Interaction idle delay (ms)", 300, 0, 5000)
     , enableSoundProperty_("enableSound", "Enable sound", true)
     , logStackTraceProperty_("logStackTraceProperty", "Error stack trace log", false)
     , runtimeModuleReloading_("runtimeModuleReloding", "Runtime Module Reloading", false)
@@ -70,6 +74,10 @@ SystemSettings::SystemSettings(InviwoApplication* app)
     addProperty(portInspectorSize_);
     addProperty(enableTouchProperty_);
     addProperty(enablePickingProperty_);
+    addProperty(coalesceCanvasEvents_);
+    addProperty(previewWhileInteracting_);
+    addProperty(frameTimeBudget_);
+    addProperty(interactionIdleDelay_);
     addProperty(enableSoundProperty_);
     addProperty(logStackTraceProperty_);
     addProperty(runtimeModuleReloading_);
@@ -0,0 +1,125 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/threadarena.h>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+constexpr size_t initialArenaSize = 64 * 1024;
+constexpr size_t maxRetainedArenaSize = 16 * 1024 * 1024;
+
+/**
+ * Forwards to new/delete and keeps track of how much the arena had to allocate on top of its
+ * buffer, used to grow the buffer for the next scope.
+ */
+class OverflowResource : public std::pmr::memory_resource {
+public:
+    size_t allocated = 0;
+
+private:
+    virtual void* do_allocate(size_t bytes, size_t alignment) override {
+        allocated += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    virtual void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+    virtual bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+class Arena {
+public:
+    std::pmr::memory_resource* enter() {
+        if (depth_++ == 0 && !resource_) {
+            reset(initialArenaSize);
+        }
+        return &*resource_;
+    }
+
+    void exit() {
+        if (--depth_ != 0) return;
+
+        const auto size = overflow_.allocated == 0
+                              ? size_
+                              : std::min(maxRetainedArenaSize, size_ + overflow_.allocated);
+        reset(size);
+    }
+
+    std::pmr::memory_resource* resource() {
+        return depth_ > 0 ? &*resource_ : std::pmr::get_default_resource();
+    }
+    size_t capacity() const { return size_; }
+
+private:
+    void reset(size_t size) {
+        // Destroying the resource returns any overflow allocations
+        resource_.reset();
+        overflow_.allocated = 0;
+        if (size != size_) {
+            buffer_.reset(new std::byte[size]);
+            size_ = size;
+        }
+        resource_.emplace(buffer_.get(), size_, &overflow_);
+    }
+
+    size_t depth_ = 0;
+    size_t size_ = 0;
+    std::unique_ptr<std::byte[]> buffer_;
+    OverflowResource overflow_;
+    std::optional<std::pmr::monotonic_buffer_resource> resource_;
+};
+
+Arena& arena() {
+    thread_local Arena arena;
+    return arena;
+}
+
+}  // namespace
+
+ArenaScope::ArenaScope() : resource_{arena().enter()} {}
+
+ArenaScope::~ArenaScope() { arena().exit(); }
+
+std::pmr::memory_resource* threadArena() noexcept { return arena().resource(); }
+
+size_t threadArenaCapacity() noexcept { return arena().capacity(); }
+
+}  // namespace util
+
+}  // namespace inviwo
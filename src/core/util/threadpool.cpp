@@ -75,6 +75,13 @@ size_t ThreadPool::getQueueSize() {
     return tasks.size();
 }
 
+size_t ThreadPool::getIdleCount() {
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    const auto free = static_cast<size_t>(std::count_if(
+        workers.begin(), workers.end(), [](auto& worker) { return worker->state == State::Free; }));
+    return free > tasks.size() ? free - tasks.size() : 0;
+}
+
 ThreadPool::~ThreadPool() {
     for (auto& worker : workers) worker->state = State::Abort;
     condition.notify_all();
@@ -36,6 +36,7 @@ VolumeSequenceSampler::VolumeSequenceSampler(
     std::shared_ptr<const std::vector<std::shared_ptr<Volume>>> volumeSequence, bool allowLooping)
     : Spatial4DSampler<3, double>(volumeSequence->front())
     , wrappers_()
+    , timeIndex_()
     , allowLooping_(allowLooping)
     , timeRange_(0, 0)
     , totDuration_(0) {
@@ -129,6 +130,12 @@ VolumeSequenceSampler::VolumeSequenceSampler(
 
     timeRange_.x = wrappers_.front()->timestamp_;
     timeRange_.y = wrappers_.back()->timestamp_ + wrappers_.back()->duration_;
+
+    std::vector<double> timestamps;
+    for (auto& w : wrappers_) {
+        timestamps.push_back(w->timestamp_);
+    }
+    timeIndex_ = util::TimeIndex(std::move(timestamps));
 }
 
 VolumeSequenceSampler::~VolumeSequenceSampler() {}
@@ -149,11 +156,7 @@ dvec3 VolumeSequenceSampler::sampleDataSpace(const dvec4& pos) const {
         }
     }
 
-    auto it = std::upper_bound(
-        wrappers_.begin(), wrappers_.end(), t,
-        [](double t2, const std::shared_ptr<Wrapper> a) { return t2 < a->timestamp_; });
-    --it;
-    auto wrapper = *it;
+    const auto& wrapper = wrappers_[timeIndex_.find(t)];
 
     auto val0 = dvec3(wrapper->sampler_.sample(spatialPos));
     if (wrapper->next_.expired()) {
@@ -30,6 +30,10 @@
 #include <inviwo/core/util/volumesequenceutils.h>
 
 #include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <numeric>
 
 namespace inviwo {
 namespace util {
@@ -106,9 +110,8 @@ std::pair<SharedVolume, SharedVolume> getVolumesForTimestep(const VolumeSequence
         return std::make_pair(seq[i], seq[i2]);
     } else if (sorted) {
         // find first volume with timestamp greater than t
-        auto it = std::find_if(seq.begin(), seq.end(), [t](const SharedVolume& v) {
-            auto vt = getTimestamp(v);
-            return t < vt;
+        auto it = std::upper_bound(seq.begin(), seq.end(), t, [](double t2, const SharedVolume& v) {
+            return t2 < getTimestamp(v);
         });
 
         if (it == seq.end()) {
@@ -122,7 +125,7 @@ std::pair<SharedVolume, SharedVolume> getVolumesForTimestep(const VolumeSequence
         // return predecessor and current iterator to enclose t
         return std::make_pair(*std::prev(it), *it);
     } else {
-        return getVolumesForTimestep(sortSequence(seq), t, true);
+        return TimeIndex(seq).getVolumes(seq, t);
     }
 }
 
@@ -132,5 +135,96 @@ double getTimestamp(SharedVolume vol) {
     return vol->getMetaData<DoubleMetaData>("timestamp")->get();
 }
 
+namespace {
+
+std::vector<double> sequenceTimestamps(const VolumeSequence& seq, bool useMetaData) {
+    std::vector<double> timestamps(seq.size(), 0.0);
+    if (useMetaData) {
+        std::transform(seq.begin(), seq.end(), timestamps.begin(),
+                       [](const SharedVolume& v) { return getTimestamp(v); });
+    } else if (seq.size() > 1) {
+        for (size_t i = 0; i < seq.size(); ++i) {
+            timestamps[i] = static_cast<double>(i) / static_cast<double>(seq.size() - 1);
+        }
+    }
+    return timestamps;
+}
+
+}  // namespace
+
+TimeIndex::TimeIndex(const VolumeSequence& seq)
+    : TimeIndex(sequenceTimestamps(seq, util::hasTimestamps(seq, false))) {
+    hasTimestamps_ = util::hasTimestamps(seq, false);
+    volumes_.assign(seq.begin(), seq.end());
+}
+
+TimeIndex::TimeIndex(std::vector<double> timestamps)
+    : timestamps_{std::move(timestamps)}, order_(timestamps_.size()), hasTimestamps_{true} {
+    std::iota(order_.begin(), order_.end(), size_t{0});
+    if (!std::is_sorted(timestamps_.begin(), timestamps_.end())) {
+        std::stable_sort(order_.begin(), order_.end(),
+                         [&](size_t a, size_t b) { return timestamps_[a] < timestamps_[b]; });
+        std::vector<double> sorted(timestamps_.size());
+        std::transform(order_.begin(), order_.end(), sorted.begin(),
+                       [&](size_t i) { return timestamps_[i]; });
+        timestamps_ = std::move(sorted);
+    }
+}
+
+std::pair<double, double> TimeIndex::getRange() const {
+    if (timestamps_.empty()) return {0.0, 1.0};
+    return {timestamps_.front(), timestamps_.back()};
+}
+
+size_t TimeIndex::find(double t) const {
+    if (timestamps_.empty()) throw RangeException("Lookup in an empty time index", IVW_CONTEXT);
+    const auto it = std::upper_bound(timestamps_.begin(), timestamps_.end(), t);
+    if (it == timestamps_.begin()) return 0;
+    return static_cast<size_t>(std::distance(timestamps_.begin(), it)) - 1;
+}
+
+TimeIndex::Interval TimeIndex::interpolate(double t) const {
+    if (timestamps_.empty()) throw RangeException("Lookup in an empty time index", IVW_CONTEXT);
+    const auto it = std::upper_bound(timestamps_.begin(), timestamps_.end(), t);
+    if (it == timestamps_.begin()) {
+        return {order_.front(), order_.front(), 0.0};
+    } else if (it == timestamps_.end()) {
+        return {order_.back(), order_.back(), 0.0};
+    }
+    const auto i = static_cast<size_t>(std::distance(timestamps_.begin(), it));
+    const double weight = (t - timestamps_[i - 1]) / (timestamps_[i] - timestamps_[i - 1]);
+    return {order_[i - 1], order_[i], weight};
+}
+
+std::pair<SharedVolume, SharedVolume> TimeIndex::getVolumes(const VolumeSequence& seq,
+                                                            double t) const {
+    if (timestamps_.empty()) return {nullptr, nullptr};
+    const auto interval = interpolate(t);
+    return {seq[interval.first], seq[interval.second]};
+}
+
+bool TimeIndex::isIndexOf(const VolumeSequence& seq) const {
+    if (volumes_.size() != seq.size() ||
+        !std::equal(volumes_.begin(), volumes_.end(), seq.begin(),
+                    [](const std::weak_ptr<const Volume>& a, const SharedVolume& b) {
+                        return !a.owner_before(b) && !b.owner_before(a);
+                    })) {
+        return false;
+    }
+    // The timestamps of the volumes might have changed since the index was built
+    if (hasTimestamps_ != util::hasTimestamps(seq, false)) return false;
+    if (!hasTimestamps_) return true;
+    for (size_t i = 0; i < timestamps_.size(); ++i) {
+        if (getTimestamp(seq[order_[i]]) != timestamps_[i]) return false;
+    }
+    return true;
+}
+
+std::pair<SharedVolume, SharedVolume> getVolumesForTimestep(const VolumeSequence& seq, double t,
+                                                            TimeIndex& index) {
+    if (!index.isIndexOf(seq)) index = TimeIndex(seq);
+    return index.getVolumes(seq, t);
+}
+
 }  // namespace util
 }  // namespace inviwo
@@ -61,72 +61,70 @@ NetworkSearch::NetworkSearch(InviwoMainWindow* win)
     , edit_{new QLineEdit(this)}
     , items_{
           {"class", "c", "processor class identifier", true,
-           [](Processor* p, const std::string& s) -> bool {
-               return find(p->getClassIdentifier(), s);
-           }},
+           [](Processor* p) -> std::vector<std::string> { return {p->getClassIdentifier()}; }},
           {"identifier", "i", "processor identifier", true,
-           [](Processor* p, const std::string& s) -> bool { return find(p->getIdentifier(), s); }},
+           [](Processor* p) -> std::vector<std::string> { return {p->getIdentifier()}; }},
           {"name", "n", "processor display name", true,
-           [](Processor* p, const std::string& s) -> bool { return find(p->getDisplayName(), s); }},
+           [](Processor* p) -> std::vector<std::string> { return {p->getDisplayName()}; }},
           {"category", "", "processor category", true,
-           [](Processor* p, const std::string& s) -> bool { return find(p->getCategory(), s); }},
+           [](Processor* p) -> std::vector<std::string> { return {p->getCategory()}; }},
           {"tag", "t", "search processor tags", true,
-           [](Processor* p, const std::string& s) -> bool {
-               bool tag = false;
+           [](Processor* p) {
+               std::vector<std::string> tags;
                for (const auto& t : p->getTags().tags_) {
-                   tag |= find(t.getString(), s);
+                   tags.push_back(t.getString());
                }
-               return tag;
+               return tags;
            }},
           {"state", "s", "processor state", true,
-           [](Processor* p, const std::string& s) -> bool {
-               return find(toString(p->getCodeState()), s);
-           }},
+           [](Processor* p) -> std::vector<std::string> { return {toString(p->getCodeState())}; }},
           {"inport", "", "search inport class identifiers", true,
-           [](Processor* p, const std::string& s) -> bool {
-               bool inport = false;
+           [](Processor* p) {
+               std::vector<std::string> inports;
                for (const auto& pt : p->getInports()) {
-                   inport |= find(pt->getClassIdentifier(), s);
+                   inports.push_back(pt->getClassIdentifier());
                }
-               return inport;
+               return inports;
            }},
           {"outport", "", "search outport class identifiers", true,
-           [](Processor* p, const std::string& s) -> bool {
-               bool outport = false;
+           [](Processor* p) {
+               std::vector<std::string> outports;
                for (const auto& pt : p->getOutports()) {
-                   outport |= find(pt->getClassIdentifier(), s);
+                   outports.push_back(pt->getClassIdentifier());
                }
-               return outport;
+               return outports;
            }},
           {"port", "", "search port class identifiers", false,
-           [](Processor* p, const std::string& s) -> bool {
-               bool port = false;
+           [](Processor* p) {
+               std::vector<std::string> ports;
                for (const auto& pt : p->getOutports()) {
-                   port |= find(pt->getClassIdentifier(), s);
+                   ports.push_back(pt->getClassIdentifier());
                }
                for (const auto& pt : p->getInports()) {
-                   port |= find(pt->getClassIdentifier(), s);
+                   ports.push_back(pt->getClassIdentifier());
                }
-               return port;
+               return ports;
            }},
           {"property", "p", "search property identifiers", true,
-           [](Processor* p, const std::string& s) -> bool {
-               bool property = false;
+           [](Processor* p) {
+               std::vector<std::string> properties;
                for (const auto& pr : p->getPropertiesRecursive()) {
-                   property |= find(pr->getIdentifier(), s);
+                   properties.push_back(pr->getIdentifier());
                }
-               return property;
+               return properties;
            }},
           {"module", "m", "processor module", true,
-           [this](Processor* p, const std::string& s) -> bool {
-               auto moduleMap = getModuleMap(win_->getInviwoApplication());
-               bool module = false;
-               auto mit = moduleMap.find(p->getClassIdentifier());
-               if (mit != moduleMap.end()) {
-                   module |= find(mit->second, s);
+           [this](Processor* p) -> std::vector<std::string> {
+               if (moduleMap_.empty()) {
+                   moduleMap_ = getModuleMap(win_->getInviwoApplication());
                }
-               return module;
-           }}} {
+               auto mit = moduleMap_.find(p->getClassIdentifier());
+               if (mit != moduleMap_.end()) {
+                   return {mit->second};
+               }
+               return {};
+           }}}
+    , indices_(items_.size()) {
 
     setObjectName("NetworkSearch");
     auto hLayout = new QHBoxLayout();
@@ -157,23 +155,19 @@ NetworkSearch::NetworkSearch(InviwoMainWindow* win)
     }
     setToolTip(utilqt::toQString(doc));
 
-    for (auto& item : items_) {
-        map_[item.name] = item.match;
-        if (!item.shortcut.empty()) {
-            map_[item.shortcut] = item.match;
+    for (size_t i = 0; i < items_.size(); ++i) {
+        map_[items_[i].name] = i;
+        if (!items_[i].shortcut.empty()) {
+            map_[items_[i].shortcut] = i;
         }
     }
 
-    map_["*"] = [this](Processor* p, const std::string& s) -> bool {
-        for (auto& item : items_) {
-            if (item.global && item.match(p, s)) {
-                return true;
-            }
-        }
-        return false;
-    };
-
     connect(edit_, &QLineEdit::textChanged, this, &NetworkSearch::updateSearch);
+
+    auto network = win_->getInviwoApplication()->getProcessorNetwork();
+    network->addObserver(this);
+    network->forEachProcessor([&](Processor* p) { onProcessorNetworkDidAddProcessor(p); });
+    win_->getInviwoApplication()->getProcessorFactory()->addObserver(this);
 }
 
 void NetworkSearch::updateSearch(const QString& str) {
@@ -187,25 +181,138 @@ void NetworkSearch::updateSearch(const QString& str) {
         return;
     }
 
+    updateIndex();
     auto tokens = tokenize(utilqt::fromQString(str));
 
-    network->forEachProcessor([&](Processor* p) {
-        bool match = true;
-        for (const auto& token : tokens) {
-            const auto& s = token.second;
-            const auto& k = token.first;
-
-            auto it = map_.find(k);
-            if (it != map_.end()) {
-                match &= it->second(p, s);
+    // Terms are intersecting, no terms matches all processors.
+    bool all = true;
+    std::unordered_set<Processor*> matches;
+    for (const auto& token : tokens) {
+        const auto& s = token.second;
+        const auto& k = token.first;
+
+        std::unordered_set<Processor*> found;
+        const auto insert = [&](Processor* p) { found.insert(p); };
+        if (k == "*") {
+            for (size_t i = 0; i < items_.size(); ++i) {
+                if (items_[i].global) indices_[i].find(s, insert);
+            }
+        } else if (auto it = map_.find(k); it != map_.end()) {
+            indices_[it->second].find(s, insert);
+        } else {
+            continue;
+        }
+
+        if (all) {
+            matches = std::move(found);
+            all = false;
+        } else {
+            for (auto it = matches.begin(); it != matches.end();) {
+                it = found.count(*it) ? std::next(it) : matches.erase(it);
             }
         }
+    }
+
+    network->forEachProcessor([&](Processor* p) {
         auto pgi = editor->getProcessorGraphicsItem(p);
         pgi->setHighlight(true);
-        pgi->setSelected(match);
+        pgi->setSelected(all || matches.count(p) != 0);
     });
 }
 
+void NetworkSearch::onProcessorNetworkDidAddProcessor(Processor* processor) {
+    processor->ProcessorObservable::addObserver(this);
+    addPropertyOwnerObservation(processor);
+    auto& handles = nameHandles_[processor];
+    handles.push_back(
+        processor->onIdentifierChange([this, processor](std::string_view, std::string_view) {
+            markDirty(processor);
+        }));
+    handles.push_back(
+        processor->onDisplayNameChange([this, processor](std::string_view, std::string_view) {
+            markDirty(processor);
+        }));
+    markDirty(processor);
+}
+
+void NetworkSearch::onProcessorNetworkWillRemoveProcessor(Processor* processor) {
+    for (auto& index : indices_) {
+        index.erase(processor);
+    }
+    dirty_.erase(processor);
+    nameHandles_.erase(processor);
+}
+
+void NetworkSearch::onProcessorPortAdded(Processor* processor, Port*) { markDirty(processor); }
+
+void NetworkSearch::onProcessorPortRemoved(Processor* processor, Port*) { markDirty(processor); }
+
+void NetworkSearch::onDidAddProperty(Property* property, size_t) {
+    addPropertyObservation(property);
+    if (auto owner = property->getOwner()) {
+        markDirty(owner->getProcessor());
+    }
+}
+
+void NetworkSearch::onWillRemoveProperty(Property* property, size_t) {
+    // The processor is re-indexed on the next search, after the property has been removed.
+    if (auto owner = property->getOwner()) {
+        markDirty(owner->getProcessor());
+    }
+}
+
+void NetworkSearch::onSetIdentifier(Property* property, const std::string&) {
+    if (auto owner = property->getOwner()) {
+        markDirty(owner->getProcessor());
+    }
+}
+
+void NetworkSearch::onRegister(ProcessorFactoryObject* item) {
+    moduleMap_.clear();
+    markDirty(item->getClassIdentifier());
+}
+
+void NetworkSearch::onUnRegister(ProcessorFactoryObject* item) {
+    moduleMap_.clear();
+    markDirty(item->getClassIdentifier());
+}
+
+void NetworkSearch::addPropertyObservation(Property* property) {
+    property->PropertyObservable::addObserver(this);
+    if (auto po = dynamic_cast<PropertyOwner*>(property)) {
+        addPropertyOwnerObservation(po);
+    }
+}
+
+void NetworkSearch::addPropertyOwnerObservation(PropertyOwner* po) {
+    po->PropertyOwnerObservable::addObserver(this);
+    for (auto property : po->getProperties()) {
+        addPropertyObservation(property);
+    }
+}
+
+void NetworkSearch::markDirty(Processor* processor) {
+    if (processor) dirty_.insert(processor);
+}
+
+void NetworkSearch::markDirty(const std::string& classIdentifier) {
+    win_->getInviwoApplication()->getProcessorNetwork()->forEachProcessor([&](Processor* p) {
+        if (p->getClassIdentifier() == classIdentifier) markDirty(p);
+    });
+}
+
+void NetworkSearch::updateIndex() {
+    for (auto processor : dirty_) {
+        for (size_t i = 0; i < items_.size(); ++i) {
+            indices_[i].erase(processor);
+            for (const auto& text : items_[i].texts(processor)) {
+                indices_[i].insert(processor, text);
+            }
+        }
+    }
+    dirty_.clear();
+}
+
 void NetworkSearch::focusInEvent(QFocusEvent*) {
     edit_->setFocus();
     updateSearch(edit_->text());
@@ -305,11 +412,4 @@ std::unordered_map<std::string, std::string> NetworkSearch::getModuleMap(InviwoA
     return moduleMap;
 }
 
-bool NetworkSearch::find(const std::string& cont, const std::string& s) {
-    auto icomp = [](std::string::value_type l1, std::string::value_type r1) {
-        return std::tolower(l1) == std::tolower(r1);
-    };
-    return std::search(cont.begin(), cont.end(), s.begin(), s.end(), icomp) != cont.end();
-}
-
 }  // namespace inviwo
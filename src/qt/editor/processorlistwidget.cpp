@@ -330,18 +330,35 @@ void ProcessorTreeWidget::addProcessor(QString className) {
 }
 
 bool ProcessorTreeWidget::processorFits(ProcessorFactoryObject* processor, const QString& filter) {
+    indexProcessor(processor);
     for (auto& substr : filter.split(' ')) {
-        if (!(utilqt::toQString(processor->getDisplayName())
-                  .contains(substr, Qt::CaseInsensitive) ||
-              utilqt::toQString(processor->getClassIdentifier())
-                  .contains(substr, Qt::CaseInsensitive) ||
-              utilqt::toQString(processor->getTags().getString())
-                  .contains(substr, Qt::CaseInsensitive)))
-            return false;
+        if (!filterIndex_.matches(processor, utilqt::fromQString(substr))) return false;
     }
     return true;
 }
 
+void ProcessorTreeWidget::indexProcessor(ProcessorFactoryObject* processor) {
+    if (filterIndex_.contains(processor)) return;
+    filterIndex_.insert(processor, processor->getDisplayName());
+    filterIndex_.insert(processor, processor->getClassIdentifier());
+    filterIndex_.insert(processor, processor->getTags().getString());
+}
+
+std::unordered_set<ProcessorFactoryObject*> ProcessorTreeWidget::findProcessors(
+    const QString& filter) {
+    std::unordered_set<ProcessorFactoryObject*> matches;
+    bool first = true;
+    for (auto& substr : filter.split(' ')) {
+        std::unordered_set<ProcessorFactoryObject*> found;
+        filterIndex_.find(utilqt::fromQString(substr), [&](ProcessorFactoryObject* p) {
+            if (first || matches.count(p)) found.insert(p);
+        });
+        matches = std::move(found);
+        first = false;
+    }
+    return matches;
+}
+
 const QIcon* ProcessorTreeWidget::getCodeStateIcon(CodeState state) const {
     switch (state) {
         case CodeState::Stable:
@@ -376,7 +393,10 @@ QTreeWidgetItem* ProcessorTreeWidget::addToplevelItemTo(QString title, const std
 
 void ProcessorTreeWidget::onRegister(ProcessorFactoryObject* item) { addProcessorsToTree(item); }
 
-void ProcessorTreeWidget::onUnRegister(ProcessorFactoryObject*) { addProcessorsToTree(); }
+void ProcessorTreeWidget::onUnRegister(ProcessorFactoryObject* item) {
+    filterIndex_.erase(item);
+    addProcessorsToTree();
+}
 
 void ProcessorTreeWidget::closeEvent(QCloseEvent* event) {
     QSettings settings;
@@ -418,10 +438,20 @@ void ProcessorTreeWidget::addProcessorsToTree(ProcessorFactoryObject* item) {
         addToplevelItemTo("Broken Processors", "");
     }
 
+    const auto filter = lineEdit_->text();
+    std::unordered_set<ProcessorFactoryObject*> matches;
+    if (!filter.isEmpty()) {
+        for (auto& elem : app_->getModules()) {
+            for (auto& processor : elem->getProcessors()) {
+                indexProcessor(processor);
+            }
+        }
+        matches = findProcessors(filter);
+    }
+
     for (auto& elem : app_->getModules()) {
         for (auto& processor : elem->getProcessors()) {
-            if (processor->isVisible() &&
-                (lineEdit_->text().isEmpty() || processorFits(processor, lineEdit_->text()))) {
+            if (processor->isVisible() && (filter.isEmpty() || matches.count(processor))) {
                 extractInfoAndAddProcessor(processor, elem.get());
             }
         }
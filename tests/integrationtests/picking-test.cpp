@@ -0,0 +1,97 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/image/image.h>
+#include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/interaction/pickingmanager.h>
+#include <modules/opengl/inviwoopengl.h>
+#include <modules/opengl/openglutils.h>
+#include <modules/opengl/shader/shader.h>
+#include <modules/opengl/shader/shaderresource.h>
+#include <modules/opengl/shader/shaderutils.h>
+#include <modules/opengl/texture/textureutils.h>
+
+namespace inviwo {
+
+namespace {
+
+constexpr std::string_view pickingFrag = R"(
+#include "utils/pickingutils.glsl"
+
+uniform vec4 color;
+uniform uint pickingIndex;
+
+void main() {
+    FragData0 = color;
+    PickingData = pickingIndexToRGBA(pickingIndex);
+}
+)";
+
+}  // namespace
+
+TEST(PickingTests, RGBAIndexWithBlending) {
+    Shader shader{{{ShaderType::Vertex, utilgl::findShaderResource("img_identity.vert")},
+                   {ShaderType::Fragment, std::make_shared<StringShaderResource>(
+                                              "picking-test.frag", pickingFrag)}}};
+    ASSERT_TRUE(shader.isReady());
+
+    // needs the alpha channel of the picking color
+    const size_t index = 0x0A123456;
+    ASSERT_GT(index, PickingManager::maxRGBIndex);
+
+    Image image{size2_t{4, 4}, DataVec4UInt8::get()};
+    utilgl::activateTarget(image, ImageType::ColorPicking);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    {
+        utilgl::BlendModeState blending(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        utilgl::PickingBlendState pickingBlending;
+        shader.activate();
+        shader.setUniform("color", vec4{1.0f, 0.0f, 0.0f, 0.5f});
+        shader.setUniform("pickingIndex", static_cast<GLuint>(index));
+        utilgl::singleDrawImagePlaneRect();
+        shader.deactivate();
+    }
+    utilgl::deactivateCurrentTarget();
+
+    const auto picking = image.getPickingLayer()->getRepresentation<LayerRAM>();
+    const auto color = image.getColorLayer()->getRepresentation<LayerRAM>();
+    for (auto pos : {size2_t{0, 0}, size2_t{1, 2}, size2_t{3, 3}}) {
+        EXPECT_EQ(PickingManager::colorToIndex(uvec4{picking->getAsDVec4(pos)}), index);
+        // the color buffer is still blended
+        EXPECT_NEAR(color->getAsDVec4(pos).r, 127.5, 1.0);
+    }
+}
+
+}  // namespace inviwo